@@ -19,6 +19,8 @@ namespace Core
         virtual double getAvgFPS() = 0;
         virtual double getMinFPS() = 0;
         virtual double getMaxFPS() = 0;
+        // Seconds left before the next frame is due, negative when the current frame is late
+        virtual double getRemainingTime() = 0;
     };
 
     struct IApplicationEventListener
@@ -27,6 +29,8 @@ namespace Core
         virtual bool onUpdate() { return true; }
         // [Work Thread]
         virtual bool onRender() { return true; }
+        // [Work Thread] After present and before waiting for the next frame, only when frames are throttled
+        virtual void onIdle() {}
     };
 
     struct FrameStatistics
@@ -61,6 +65,8 @@ namespace Core
         virtual FrameStatistics getFrameStatistics() = 0;
         // [Work Thread]
         virtual FrameRenderStatistics getFrameRenderStatistics() = 0;
+        // [Main thread | Work Thread] No window, GPU or ImGui backend, see ApplicationModel_Headless
+        virtual bool isHeadless() = 0;
 
         // [Main thread | Work Thread]
         virtual void requestExit() = 0;
@@ -0,0 +1,143 @@
+#include "Core/ApplicationModel_Headless.hpp"
+#include "Core/FrameProfiler.hpp"
+#include "Tracy.hpp"
+#include "SDL.h"
+#include "spdlog/spdlog.h"
+#include <chrono>
+
+using Duration = std::chrono::duration<double>;
+using Clock = std::chrono::high_resolution_clock;
+
+namespace Core
+{
+	struct HeadlessScopeTimer
+	{
+		Clock::time_point start;
+		double& t;
+		HeadlessScopeTimer(double& v_ref) : start(Clock::now()), t(v_ref) {}
+		~HeadlessScopeTimer()
+		{
+			Duration dur = Clock::now() - start;
+			t = dur.count();
+		}
+	};
+
+	void ApplicationModel_Headless::runFrame()
+	{
+		size_t const i = (m_framestate_index + 1) % 2;
+		FrameStatistics& d = m_framestate[i];
+		FrameProfiler& profiler = FrameProfiler::get();
+		profiler.beginFrame();
+		HeadlessScopeTimer gt(d.total_time);
+
+		bool update_result = false;
+
+		// Update
+		{
+			ZoneScopedN("OnUpdate");
+			FrameProfileScopeN("OnUpdate");
+			HeadlessScopeTimer t(d.update_time);
+			m_window->handleEvents();
+			update_result = m_listener->onUpdate();
+		}
+
+		bool render_result = false;
+
+		// Render
+		if (update_result)
+		{
+			ZoneScopedN("OnRender");
+			FrameProfileScopeN("OnRender");
+			HeadlessScopeTimer t(d.render_time);
+			m_swapchain->applyRenderAttachment();
+			m_swapchain->clearRenderAttachment();
+			render_result = m_listener->onRender();
+		}
+
+		// Present
+		if (render_result)
+		{
+			ZoneScopedN("OnPresent");
+			FrameProfileScopeN("OnPresent");
+			HeadlessScopeTimer t(d.present_time);
+			m_swapchain->present();
+		}
+
+		// No waiting, only measure the frame time
+		d.wait_time = 0.0;
+		m_frame_rate_controller.udateData(Clock::now());
+
+		profiler.endFrame();
+		m_framestate_index = i;
+		FrameMark;
+
+		m_frame_count += 1;
+		if (m_frame_limit > 0 && m_frame_count >= m_frame_limit)
+		{
+			requestExit();
+		}
+	}
+
+	FrameStatistics ApplicationModel_Headless::getFrameStatistics()
+	{
+		return m_framestate[m_framestate_index];
+	}
+	FrameRenderStatistics ApplicationModel_Headless::getFrameRenderStatistics()
+	{
+		FrameRenderStatistics statistics{};
+		statistics.render_time = m_framestate[m_framestate_index].render_time;
+		return statistics;
+	}
+
+	void ApplicationModel_Headless::requestExit()
+	{
+		m_exit_flag = true;
+	}
+	bool ApplicationModel_Headless::run()
+	{
+		auto const start = Clock::now();
+		m_frame_rate_controller.udateData(start);
+		while (!m_exit_flag)
+		{
+			runFrame();
+		}
+		Duration const total = Clock::now() - start;
+		spdlog::info("[core] Headless run finished: {} frames in {:.3f}s, {:.2f} FPS",
+			m_frame_count, total.count(), total.count() > 0.0 ? (double)m_frame_count / total.count() : 0.0);
+		if (!m_record_path.empty())
+		{
+			if (m_renderer->saveRecordToFile(m_record_path))
+				spdlog::info("[core] Recorded graphics commands saved to '{}'", m_record_path);
+			else
+				spdlog::error("[core] Unable to save recorded graphics commands to '{}'", m_record_path);
+		}
+		return true;
+	}
+
+	ApplicationModel_Headless::ApplicationModel_Headless(IApplicationEventListener* p_listener, InitializeConfigure const& config)
+		: m_listener(p_listener)
+		, m_frame_limit(config.headless_frame_count > 0 ? (uint64_t)config.headless_frame_count : 0)
+		, m_record_path(config.headless_record_path)
+	{
+		assert(m_listener);
+		// Never open a window or an audio output, and let Ctrl+C stop the process
+		SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+		SDL_SetHint(SDL_HINT_AUDIODRIVER, "dummy");
+		SDL_SetHint(SDL_HINT_NO_SIGNAL_HANDLERS, "1");
+		SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO);
+		if (!Graphics::Window_Null::create(~m_window))
+			throw std::runtime_error("Graphics::Window_Null::create");
+		if (!Graphics::Device_Null::create(config.headless_rasterizer_enable, ~m_device))
+			throw std::runtime_error("Graphics::Device_Null::create");
+		if (!Graphics::SwapChain_Null::create(*m_window, *m_device, ~m_swapchain))
+			throw std::runtime_error("Graphics::SwapChain_Null::create");
+		if (!Graphics::Renderer_Null::create(*m_device, ~m_renderer))
+			throw std::runtime_error("Graphics::Renderer_Null::create");
+		if (!Audio::Device_SDL::create(~m_audiosys))
+			throw std::runtime_error("Audio::Device_SDL::create");
+		spdlog::info("[core] Running headless, frame limit: {}", m_frame_limit);
+	}
+	ApplicationModel_Headless::~ApplicationModel_Headless()
+	{
+	}
+}
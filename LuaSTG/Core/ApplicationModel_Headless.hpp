@@ -0,0 +1,59 @@
+#pragma once
+#include "Core/Object.hpp"
+#include "Core/ApplicationModel.hpp"
+#include "Core/ApplicationModel_SDL.hpp"
+#include "Core/InitializeConfigure.hpp"
+#include "Core/Graphics/Window_Null.hpp"
+#include "Core/Graphics/Device_Null.hpp"
+#include "Core/Graphics/SwapChain_Null.hpp"
+#include "Core/Graphics/Renderer_Null.hpp"
+#include "Core/Audio/Device_SDL.hpp"
+#include <string>
+
+namespace Core
+{
+	// Runs the game without a window or GPU: graphics calls go to the null backend, frames are not
+	// throttled, and the model can exit after a fixed number of frames. Used for CPU benchmarks in CI
+	// and, with the software rasterizer, for small golden image tests.
+	class ApplicationModel_Headless : public Object<IApplicationModel>
+	{
+	private:
+		ScopeObject<Graphics::Window_Null> m_window;
+		bool m_exit_flag{};
+
+		ScopeObject<Graphics::Device_Null> m_device;
+		ScopeObject<Graphics::SwapChain_Null> m_swapchain;
+		ScopeObject<Graphics::Renderer_Null> m_renderer;
+		ScopeObject<Audio::Device_SDL> m_audiosys;
+		FrameRateController m_frame_rate_controller;
+		IApplicationEventListener* m_listener{ nullptr };
+		size_t m_framestate_index{ 0 };
+		FrameStatistics m_framestate[2]{};
+
+		uint64_t m_frame_count{ 0 };
+		uint64_t m_frame_limit{ 0 };
+		std::string m_record_path;
+
+	public:
+		void runFrame();
+
+	public:
+		Graphics::IWindow* getWindow() { return *m_window; }
+		void requestExit();
+
+		IFrameRateController* getFrameRateController() { return &m_frame_rate_controller; };
+		Graphics::IDevice* getDevice() { return *m_device; }
+		Graphics::ISwapChain* getSwapChain() { return *m_swapchain; }
+		Graphics::IRenderer* getRenderer() { return *m_renderer; }
+		Audio::IAudioDevice* getAudioDevice() { return m_audiosys.get(); }
+		FrameStatistics getFrameStatistics();
+		FrameRenderStatistics getFrameRenderStatistics();
+		bool isHeadless() { return true; }
+
+		bool run();
+
+	public:
+		ApplicationModel_Headless(IApplicationEventListener* p_listener, InitializeConfigure const& config);
+		~ApplicationModel_Headless();
+	};
+}
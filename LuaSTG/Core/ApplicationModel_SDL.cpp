@@ -1,5 +1,9 @@
 ﻿#include "Core/ApplicationModel_SDL.hpp"
+#include "Core/ApplicationModel_Headless.hpp"
 #include "Core/ApplicationModel.hpp"
+#include "Core/FrameProfiler.hpp"
+#include "Core/InitializeConfigure.hpp"
+#include "Platform/CommandLineArguments.hpp"
 // #include "Core/i18n.hpp"
 // #include "Platform/WindowsVersion.hpp"
 // #include "Platform/DetectCPU.hpp"
@@ -150,6 +154,10 @@ namespace Core
 	{
 		return fps_max_;
 	}
+	double FrameRateController::getRemainingTime()
+	{
+		return wait_ - Duration(Clock::now() - last_).count();
+	}
 
 	FrameRateController::FrameRateController(uint32_t target_FPS)
 	{
@@ -263,6 +271,8 @@ namespace Core
 	{
 		size_t const i = (m_framestate_index + 1) % 2;
 		FrameStatistics& d = m_framestate[i];
+		FrameProfiler& profiler = FrameProfiler::get();
+		profiler.beginFrame();
 		ScopeTimer gt(d.total_time);
 		// size_t const next_frame_query_index = (m_frame_query_index + 1) % m_frame_query_list.size();
 		// FrameQuery& frame_query = m_frame_query_list[next_frame_query_index];
@@ -272,6 +282,7 @@ namespace Core
 		// Update
 		{
 			ZoneScopedN("OnUpdate");
+			FrameProfileScopeN("OnUpdate");
 			ScopeTimer t(d.update_time);
 			m_window->handleEvents();
 			update_result = m_listener->onUpdate();
@@ -284,6 +295,7 @@ namespace Core
 		{
 			ZoneScopedN("OnRender");
 			TracyGpuZone("OnRender");
+			FrameProfileScopeN("OnRender");
 			ScopeTimer t(d.render_time);
 			// frame_query.begin();
 			m_swapchain->applyRenderAttachment();
@@ -297,19 +309,30 @@ namespace Core
 		{
 			ZoneScopedN("OnPresent");
 			TracyGpuZone("OnPresent");
+			FrameProfileScopeN("OnPresent");
 			ScopeTimer t(d.present_time);
 			m_swapchain->present();
 			TracyGpuCollect;
 		}
 
+		// Use the slack before waiting
+		if (update_result)
+		{
+			ZoneScopedN("OnIdle");
+			FrameProfileScopeN("OnIdle");
+			m_listener->onIdle();
+		}
+
 		// Wait for next frame
 		{
 			ZoneScopedN("OnWait");
+			FrameProfileScopeN("OnWait");
 			ScopeTimer t(d.wait_time);
 			// m_swapchain->waitFrameLatency();
 			m_frame_rate_controller.update();
 		}
 
+		profiler.endFrame();
 		m_framestate_index = i;
 		// m_frame_query_index = next_frame_query_index;
 		FrameMark;
@@ -379,7 +402,16 @@ namespace Core
 	{
 		try
 		{
-			*pp_model = new ApplicationModel_SDL(p_app);
+			InitializeConfigure config;
+			config.loadFromFile("config.json");
+			if (config.headless_enable || Platform::CommandLineArguments::Get().IsOptionExist("--headless"))
+			{
+				*pp_model = new ApplicationModel_Headless(p_app, config);
+			}
+			else
+			{
+				*pp_model = new ApplicationModel_SDL(p_app);
+			}
 			return true;
 		}
 		catch (...)
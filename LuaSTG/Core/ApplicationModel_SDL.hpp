@@ -45,6 +45,7 @@ namespace Core
 		double getAvgFPS();
 		double getMinFPS();
 		double getMaxFPS();
+		double getRemainingTime();
 	public:
 		FrameRateController(uint32_t target_FPS = 60);
 		~FrameRateController();
@@ -92,6 +93,7 @@ namespace Core
 		Audio::IAudioDevice* getAudioDevice() { return m_audiosys.get(); }
 		FrameStatistics getFrameStatistics();
 		FrameRenderStatistics getFrameRenderStatistics();
+		bool isHeadless() { return false; }
 
 		// Main thread exclusive
 
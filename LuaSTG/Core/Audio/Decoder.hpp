@@ -19,5 +19,8 @@ namespace Core::Audio
 		virtual bool read(uint64_t pcm_frame, void* buffer, uint64_t* read_pcm_frame) = 0; // s16
 
 		static bool create(StringView path, IDecoder** pp_decoder);
+		static bool create(StringView path, bool stream, IDecoder** pp_decoder); // stream: read the file on demand during playback
+		static void getSourceMemoryUsage(size_t* p_current, size_t* p_peak); // memory held for source files, whole files or stream buffers
+		static void resetSourceMemoryPeak();
 	};
 }
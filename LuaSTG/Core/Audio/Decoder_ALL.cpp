@@ -4,12 +4,16 @@
 namespace Core::Audio
 {
 	bool IDecoder::create(StringView path, IDecoder** pp_decoder)
+	{
+		return create(path, false, pp_decoder);
+	}
+	bool IDecoder::create(StringView path, bool stream, IDecoder** pp_decoder)
 	{
 		ScopeObject<IDecoder> p_decoder;
 
 		try
 		{
-			p_decoder = new Decoder_ma(path);
+			p_decoder = new Decoder_ma(path, stream);
 			*pp_decoder = p_decoder.get();
 			return true;
 		}
@@ -21,4 +25,12 @@ namespace Core::Audio
 		*pp_decoder = nullptr;
 		return false;
 	}
+	void IDecoder::getSourceMemoryUsage(size_t* p_current, size_t* p_peak)
+	{
+		Decoder_ma::getSourceMemoryUsage(p_current, p_peak);
+	}
+	void IDecoder::resetSourceMemoryPeak()
+	{
+		Decoder_ma::resetSourceMemoryPeak();
+	}
 }
@@ -1,6 +1,7 @@
 #include "Core/Audio/Decoder_ma.hpp"
 #include "Core/FileManager.hpp"
 #include "spdlog/spdlog.h"
+#include <atomic>
 #include <cstdint>
 
 static ma_result ma_decoding_backend_init__libvorbis(void* pUserData, ma_read_proc onRead, ma_seek_proc onSeek, ma_tell_proc onTell, void* pReadSeekTellUserData, const ma_decoding_backend_config* pConfig, const ma_allocation_callbacks* pAllocationCallbacks, ma_data_source** ppBackend)
@@ -79,6 +80,10 @@ static ma_decoding_backend_vtable g_ma_decoding_backend_vtable_libvorbis =
 
 namespace Core::Audio
 {
+    // Memory held by all decoders for their source data: whole files, or stream buffers and restart points
+    static std::atomic_size_t g_source_memory{ 0 };
+    static std::atomic_size_t g_source_memory_peak{ 0 };
+
     void Decoder_ma::destroyResources()
     {
         if (m_init)
@@ -86,7 +91,117 @@ namespace Core::Audio
             m_init = false;
             ma_decoder_uninit(&m_decoder);
         }
+        m_stream.reset();
         m_data.clear();
+        updateSourceMemory(0);
+    }
+
+    void Decoder_ma::updateSourceMemory(size_t size)
+    {
+        if (size == m_source_memory)
+            return;
+        size_t const delta = size - m_source_memory; // wraps around when shrinking
+        size_t const current = g_source_memory.fetch_add(delta) + delta;
+        m_source_memory = size;
+        size_t peak = g_source_memory_peak.load();
+        while (current > peak && !g_source_memory_peak.compare_exchange_weak(peak, current)) {}
+    }
+
+    void Decoder_ma::getSourceMemoryUsage(size_t* p_current, size_t* p_peak)
+    {
+        *p_current = g_source_memory.load();
+        *p_peak = g_source_memory_peak.load();
+    }
+
+    void Decoder_ma::resetSourceMemoryPeak()
+    {
+        g_source_memory_peak.store(g_source_memory.load());
+    }
+
+    ma_result Decoder_ma::onStreamOpen(ma_vfs* pVFS, const char*, ma_uint32 openMode, ma_vfs_file* pFile)
+    {
+        if (openMode & MA_OPEN_MODE_WRITE)
+            return MA_ACCESS_DENIED;
+        // The stream is opened by the decoder before initialization, the path is only used to pick the backend
+        IFileStream* stream = static_cast<StreamVFS*>(pVFS)->self->m_stream.get();
+        if (!stream->seek(0))
+            return MA_IO_ERROR;
+        *pFile = stream;
+        return MA_SUCCESS;
+    }
+
+    ma_result Decoder_ma::onStreamClose(ma_vfs*, ma_vfs_file)
+    {
+        return MA_SUCCESS;
+    }
+
+    ma_result Decoder_ma::onStreamRead(ma_vfs* pVFS, ma_vfs_file file, void* pDst, size_t sizeInBytes, size_t* pBytesRead)
+    {
+        IFileStream* stream = static_cast<IFileStream*>(file);
+        size_t read_size = 0;
+        bool const result = stream->read(pDst, sizeInBytes, &read_size);
+        if (pBytesRead)
+            *pBytesRead = read_size;
+        // Deflate streams add restart points while decoding
+        static_cast<StreamVFS*>(pVFS)->self->updateSourceMemory(stream->getMemoryUsage());
+        if (!result)
+            return MA_IO_ERROR;
+        if (read_size == 0 && sizeInBytes > 0)
+            return MA_AT_END;
+        return MA_SUCCESS;
+    }
+
+    ma_result Decoder_ma::onStreamSeek(ma_vfs*, ma_vfs_file file, ma_int64 offset, ma_seek_origin origin)
+    {
+        IFileStream* stream = static_cast<IFileStream*>(file);
+        ma_int64 base = 0;
+        if (origin == ma_seek_origin_current)
+            base = (ma_int64)stream->tell();
+        else if (origin == ma_seek_origin_end)
+            base = (ma_int64)stream->size();
+        ma_int64 const position = base + offset;
+        if (position < 0 || !stream->seek((uint64_t)position))
+            return MA_BAD_SEEK;
+        return MA_SUCCESS;
+    }
+
+    ma_result Decoder_ma::onStreamTell(ma_vfs*, ma_vfs_file file, ma_int64* pCursor)
+    {
+        *pCursor = (ma_int64)static_cast<IFileStream*>(file)->tell();
+        return MA_SUCCESS;
+    }
+
+    ma_result Decoder_ma::onStreamInfo(ma_vfs*, ma_vfs_file file, ma_file_info* pInfo)
+    {
+        pInfo->sizeInBytes = static_cast<IFileStream*>(file)->size();
+        return MA_SUCCESS;
+    }
+
+    bool Decoder_ma::initStream(StringView path, ma_decoder_config const& cfg)
+    {
+        if (!GFileManager().openStreamEx(path, ~m_stream))
+            return false;
+
+        m_vfs.callbacks.onOpen = &onStreamOpen;
+        m_vfs.callbacks.onOpenW = NULL;
+        m_vfs.callbacks.onClose = &onStreamClose;
+        m_vfs.callbacks.onRead = &onStreamRead;
+        m_vfs.callbacks.onWrite = NULL;
+        m_vfs.callbacks.onSeek = &onStreamSeek;
+        m_vfs.callbacks.onTell = &onStreamTell;
+        m_vfs.callbacks.onInfo = &onStreamInfo;
+        m_vfs.self = this;
+
+        std::string const name(path);
+        ma_result r = ma_decoder_init_vfs(&m_vfs, name.c_str(), &cfg, &m_decoder);
+        if (r != MA_SUCCESS)
+        {
+            spdlog::warn("[core] Decoder_ma: could not stream '{}' (r = {}), loading the whole file instead", path, (int)r);
+            m_stream.reset();
+            return false;
+        }
+        updateSourceMemory(m_stream->getMemoryUsage());
+        return true;
     }
 
     uint32_t Decoder_ma::getFrameCount()
@@ -133,15 +248,11 @@ namespace Core::Audio
         return MA_SUCCESS == ma_decoder_read_pcm_frames(&m_decoder, buffer, pcm_frame, (ma_uint64*)read_pcm_frame);
     }
 
-    Decoder_ma::Decoder_ma(StringView path)
-        : m_init(false)
+    Decoder_ma::Decoder_ma(StringView path, bool stream)
+        : m_vfs{}
+        , m_source_memory(0)
+        , m_init(false)
     {
-        if (!GFileManager().loadEx(path, m_data))
-        {
-            destroyResources();
-            throw std::runtime_error("Decoder_ma::Decoder_ma (1)");
-        }
-
         ma_result r;
 
         ma_decoder_config cfg = ma_decoder_config_init(ma_format_f32, 2, 48000);
@@ -153,15 +264,31 @@ namespace Core::Audio
         cfg.pCustomBackendUserData = NULL;
         cfg.ppCustomBackendVTables = pCustomBackendVTables;
         cfg.customBackendCount = sizeof(pCustomBackendVTables) / sizeof(pCustomBackendVTables[0]);
-        r = ma_decoder_init_memory(m_data.data(), m_data.size(), &cfg, &m_decoder);
 
-        if (r != MA_SUCCESS)
+        // Stream players read the file on demand, files that can't be streamed (encrypted zip entries etc.) are loaded into memory
+        if (stream && initStream(path, cfg))
         {
-            destroyResources();
-            spdlog::error("r = {}", r);
-            throw std::runtime_error("Decoder_ma::Decoder_ma (2)");
+            m_init = true; // Mark it as needing cleanup
+        }
+        else
+        {
+            if (!GFileManager().loadEx(path, m_data))
+            {
+                destroyResources();
+                throw std::runtime_error("Decoder_ma::Decoder_ma (1)");
+            }
+
+            r = ma_decoder_init_memory(m_data.data(), m_data.size(), &cfg, &m_decoder);
+
+            if (r != MA_SUCCESS)
+            {
+                destroyResources();
+                spdlog::error("r = {}", r);
+                throw std::runtime_error("Decoder_ma::Decoder_ma (2)");
+            }
+            m_init = true; // Mark it as needing cleanup
+            updateSourceMemory(m_data.size());
         }
-        m_init = true; // Mark it as needing cleanup
 
         if (!seek(0))
         {
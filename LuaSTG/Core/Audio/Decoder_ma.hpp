@@ -1,6 +1,7 @@
 #pragma once
 #include "Core/Object.hpp"
 #include "Core/Audio/Decoder.hpp"
+#include "Core/FileManager.hpp"
 #include "miniaudio.h"
 #include "minivorbis.h"
 
@@ -8,13 +9,37 @@ namespace Core::Audio
 {
     class Decoder_ma : public Object<IDecoder>
     {
+    private:
+        // miniaudio reads streamed files through this VFS, the callbacks receive it as pVFS
+        struct StreamVFS
+        {
+            ma_vfs_callbacks callbacks;
+            Decoder_ma* self;
+        };
+
     private:
         std::vector<uint8_t> m_data;
+        ScopeObject<IFileStream> m_stream;
+        StreamVFS m_vfs;
         ma_decoder m_decoder;
+        size_t m_source_memory;
         bool m_init;
 
     private:
         void destroyResources();
+        void updateSourceMemory(size_t size);
+        bool initStream(StringView path, ma_decoder_config const& cfg);
+
+        static ma_result onStreamOpen(ma_vfs* pVFS, const char* pFilePath, ma_uint32 openMode, ma_vfs_file* pFile);
+        static ma_result onStreamClose(ma_vfs* pVFS, ma_vfs_file file);
+        static ma_result onStreamRead(ma_vfs* pVFS, ma_vfs_file file, void* pDst, size_t sizeInBytes, size_t* pBytesRead);
+        static ma_result onStreamSeek(ma_vfs* pVFS, ma_vfs_file file, ma_int64 offset, ma_seek_origin origin);
+        static ma_result onStreamTell(ma_vfs* pVFS, ma_vfs_file file, ma_int64* pCursor);
+        static ma_result onStreamInfo(ma_vfs* pVFS, ma_vfs_file file, ma_file_info* pInfo);
+
+    public:
+        static void getSourceMemoryUsage(size_t* p_current, size_t* p_peak);
+        static void resetSourceMemoryPeak();
 
     public:
         ma_decoder* getRaw() { return &m_decoder; }
@@ -34,7 +59,7 @@ namespace Core::Audio
         bool read(uint64_t pcm_frame, void* buffer, uint64_t* read_pcm_frame);
 
     public:
-        Decoder_ma(StringView path);
+        Decoder_ma(StringView path, bool stream = false);
         ~Decoder_ma();
     };
 }
\ No newline at end of file
@@ -59,5 +59,6 @@ namespace Core::Audio
 		virtual bool createAudioPlayer(IDecoder* p_decoder, IAudioPlayer** pp_player) = 0; // Decode all into memory
 		virtual bool createLoopAudioPlayer(IDecoder* p_decoder, IAudioPlayer** pp_player) = 0; // Decode all into memory
 		virtual bool createStreamAudioPlayer(IDecoder* p_decoder, IAudioPlayer** pp_player) = 0; // Decode during playback
+		virtual bool createSharedAudioPlayer(IAudioPlayer* p_player, IAudioPlayer** pp_player) = 0; // Share decoded data with a player from createAudioPlayer, for multiple voices of one sound
 	};
 }
@@ -307,6 +307,27 @@ namespace Core::Audio
             return false;
         }
     }
+    bool Device_SDL::createSharedAudioPlayer(IAudioPlayer* p_player, IAudioPlayer** pp_player)
+    {
+        auto* p_source = dynamic_cast<AudioPlayer_SDL*>(p_player);
+        if (!p_source)
+        {
+            spdlog::error("[core] Only players from createAudioPlayer can share decoded data");
+            *pp_player = nullptr;
+            return false;
+        }
+        try
+        {
+            *pp_player = new AudioPlayer_SDL(this, p_source);
+            return true;
+        }
+        catch (std::exception const& e)
+        {
+            spdlog::error("[core] {}", e.what());
+            *pp_player = nullptr;
+            return false;
+        }
+    }
 
     Device_SDL::Device_SDL()
     {
@@ -347,6 +368,23 @@ namespace Core::Audio
         destoryResources();
     }
 
+    void AudioPlayer_SDL::createBuffer()
+    {
+        ma_format format = ma_format_unknown;
+        switch (m_decoder->getSampleSize())
+        {
+        case 1: format = ma_format_u8; break;
+        case 2: format = ma_format_s16; break;
+        case 3: format = ma_format_s24; break;
+        case 4: format = ma_format_f32; break;
+        }
+        uint64_t const frame_count = m_pcm_data->size() / m_decoder->getFrameSize();
+        if (MA_SUCCESS != ma_audio_buffer_ref_init(format, m_decoder->getChannelCount(), m_pcm_data->data(), frame_count, &m_buffer))
+        {
+            throw std::runtime_error("AudioPlayer_SDL::createBuffer");
+        }
+        m_buffer.sampleRate = m_decoder->getSampleRate();
+    }
     bool AudioPlayer_SDL::createResources()
     {
         if (!m_device->getShared()) return false;
@@ -355,7 +393,7 @@ namespace Core::Audio
 
         ma_result r;
 
-        r = ma_sound_init_from_data_source(&m_shared->engine, static_cast<Decoder_ma*>(m_decoder.get())->getRaw(), 0, &m_shared->grp_sfx, &m_sound);
+        r = ma_sound_init_from_data_source(&m_shared->engine, &m_buffer, 0, &m_shared->grp_sfx, &m_sound);
         if (r != MA_SUCCESS)
         {
             spdlog::error("[core] Couldn't init audio player");
@@ -398,7 +436,7 @@ namespace Core::Audio
 
     bool AudioPlayer_SDL::isPlaying()
     {
-        return m_is_playing;
+        return m_is_playing && !ma_sound_at_end(&m_sound);
     }
 
     double AudioPlayer_SDL::getTotalTime() { assert(false); return 0.0; }
@@ -450,13 +488,16 @@ namespace Core::Audio
     {
         // decoding
 
-        m_pcm_data.resize(p_decoder->getFrameCount() * (uint32_t)p_decoder->getFrameSize());
+        std::vector<int8_t> pcm_data(p_decoder->getFrameCount() * (uint32_t)p_decoder->getFrameSize());
         uint64_t frames_read = 0;
-        if (!p_decoder->read(p_decoder->getFrameCount(), m_pcm_data.data(), &frames_read))
+        if (!p_decoder->read(p_decoder->getFrameCount(), pcm_data.data(), &frames_read))
         {
             spdlog::error("[core] (IDecoder::read) Failed to read audio");
             throw std::runtime_error("AudioPlayer_SDL::AudioPlayer_SDL (4)");
         }
+        pcm_data.resize(frames_read * p_decoder->getFrameSize());
+        m_pcm_data = std::make_shared<std::vector<int8_t> const>(std::move(pcm_data));
+        createBuffer();
 
         // create audio
 
@@ -470,10 +511,26 @@ namespace Core::Audio
 
         m_device->addEventListener(this);
     }
+    AudioPlayer_SDL::AudioPlayer_SDL(Device_SDL* p_device, AudioPlayer_SDL* p_source)
+        : m_device(p_device)
+        , m_decoder(p_source->m_decoder)
+        , m_pcm_data(p_source->m_pcm_data)
+    {
+        createBuffer();
+
+        // create audio
+
+        createResources();
+
+        // register
+
+        m_device->addEventListener(this);
+    }
     AudioPlayer_SDL::~AudioPlayer_SDL()
     {
         m_device->removeEventListener(this);
         destoryResources();
+        ma_audio_buffer_ref_uninit(&m_buffer);
     }
 }
 
@@ -5,6 +5,7 @@
 #include "SDL.h"
 #include "miniaudio.h"
 #include <cstdint>
+#include <memory>
 #include <vector>
 
 namespace Core::Audio
@@ -69,6 +70,7 @@ namespace Core::Audio
         bool createAudioPlayer(IDecoder* p_decoder, IAudioPlayer** pp_player);
         bool createLoopAudioPlayer(IDecoder* p_decoder, IAudioPlayer** pp_player);
         bool createStreamAudioPlayer(IDecoder* p_decoder, IAudioPlayer** pp_player);
+        bool createSharedAudioPlayer(IAudioPlayer* p_player, IAudioPlayer** pp_player);
 
     public:
         Device_SDL();
@@ -87,7 +89,9 @@ namespace Core::Audio
         ScopeObject<Shared_SDL> m_shared;
         ScopeObject<IDecoder> m_decoder;
         ma_sound m_sound;
-        std::vector<int8_t> m_pcm_data;
+        // decoded once, shared with every player created by createSharedAudioPlayer
+        std::shared_ptr<std::vector<int8_t> const> m_pcm_data;
+        ma_audio_buffer_ref m_buffer;
         float m_volume = 1.0f;
         float m_output_balance = 0.0f;
         float m_speed = 1.0f;
@@ -96,6 +100,7 @@ namespace Core::Audio
         void onAudioDeviceCreate();
         void onAudioDeviceDestroy();
     private:
+        void createBuffer();
         bool createResources();
         void destoryResources();
 
@@ -129,6 +134,7 @@ namespace Core::Audio
 
     public:
         AudioPlayer_SDL(Device_SDL* p_device, IDecoder* p_decoder);
+        AudioPlayer_SDL(Device_SDL* p_device, AudioPlayer_SDL* p_source);
         ~AudioPlayer_SDL();
     };
 
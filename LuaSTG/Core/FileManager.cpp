@@ -1,4 +1,5 @@
 ﻿#include "Core/FileManager.hpp"
+#include "Core/FileStream.hpp"
 #include <filesystem>
 #include <fstream>
 // #include "utf8.hpp"
@@ -67,9 +68,41 @@ namespace Core
         }
     };
 
+    size_t ArchivePathHash::operator()(std::string_view const& path) const noexcept
+    {
+        // FNV-1a
+        size_t h = (size_t)14695981039346656037ull;
+        for (char c : path)
+        {
+            h ^= (uint8_t)(c == '\\' ? '/' : c);
+            h *= (size_t)1099511628211ull;
+        }
+        return h;
+    }
+    bool ArchivePathEqual::operator()(std::string_view const& a, std::string_view const& b) const noexcept
+    {
+        if (a.size() != b.size())
+        {
+            return false;
+        }
+        for (size_t i = 0; i < a.size(); i += 1)
+        {
+            char const ca = a[i] == '\\' ? '/' : a[i];
+            char const cb = b[i] == '\\' ? '/' : b[i];
+            if (ca != cb)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
     void FileArchive::refresh()
     {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        index.clear();
         list.clear();
+        entry_pos.clear();
         if (!mz_zip_v)
         {
             return;
@@ -88,11 +121,19 @@ namespace Core
                     .type = is_dir ? FileType::Directory : FileType::File,
                     .name = mz_zip_file_v->filename,
                 });
+                entry_pos.emplace_back(mz_zip_handle_v ? mz_zip_get_entry(mz_zip_handle_v) : -1);
             }
         } while (MZ_OK == mz_zip_reader_goto_next_entry(mz_zip_v));
+        // list 不再变化之后才能引用其中的字符串；同名条目以第一个为准，和 mz_zip_reader_locate_entry 一致
+        index.reserve(list.size());
+        for (size_t i = 0; i < list.size(); i += 1)
+        {
+            index.try_emplace(list[i].name, i);
+        }
     }
     size_t FileArchive::findIndex(std::string_view const& name)
     {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
         if (list.empty())
         {
             refresh();
@@ -101,17 +142,207 @@ namespace Core
                 return invalid_index;
             }
         }
+        if (index_enable)
+        {
+            auto const it = index.find(name);
+            return it != index.end() ? it->second : invalid_index;
+        }
         for (auto const& v : list)
         {
-            if (v.name == name)
+            if (ArchivePathEqual{}(v.name, name))
             {
                 return &v - list.data();
             }
         }
         return invalid_index;
     }
+    int64_t FileArchive::openEntry(size_t index)
+    {
+        if (!mz_zip_handle_v || index >= entry_pos.size() || entry_pos[index] < 0)
+        {
+            return -1;
+        }
+        if (MZ_OK == mz_zip_entry_is_open(mz_zip_handle_v))
+        {
+            mz_zip_entry_close(mz_zip_handle_v);
+        }
+        if (MZ_OK != mz_zip_goto_entry(mz_zip_handle_v, entry_pos[index]))
+        {
+            return -1;
+        }
+        mz_zip_file* mz_zip_file_v = nullptr;
+        if (MZ_OK != mz_zip_entry_get_info(mz_zip_handle_v, &mz_zip_file_v))
+        {
+            return -1;
+        }
+        // 和 mz_zip_reader_entry_save_buffer_length 一样限制在 int32 范围内
+        if (mz_zip_file_v->uncompressed_size < 0 || mz_zip_file_v->uncompressed_size > INT32_MAX)
+        {
+            return -1;
+        }
+        if (MZ_OK != mz_zip_entry_read_open(mz_zip_handle_v, 0, password_.empty() ? nullptr : password_.c_str()))
+        {
+            return -1;
+        }
+        return mz_zip_file_v->uncompressed_size;
+    }
+    bool FileArchive::readEntry(void* buffer, int64_t size)
+    {
+        uint8_t* ptr = static_cast<uint8_t*>(buffer);
+        int64_t remain = size;
+        while (remain > 0)
+        {
+            int32_t const read = mz_zip_entry_read(mz_zip_handle_v, ptr, (int32_t)remain);
+            if (read <= 0)
+            {
+                break;
+            }
+            ptr += read;
+            remain -= read;
+        }
+        // 读完整个条目后关闭时会校验 CRC
+        int32_t const close_result = mz_zip_entry_close(mz_zip_handle_v);
+        return remain == 0 && MZ_OK == close_result;
+    }
+    bool FileArchive::loadByIndex(size_t index, std::vector<uint8_t>& buffer)
+    {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        int64_t const size = openEntry(index);
+        if (size < 0)
+        {
+            return false;
+        }
+        try
+        {
+            buffer.resize((size_t)size);
+        }
+        catch (...)
+        {
+            mz_zip_entry_close(mz_zip_handle_v);
+            return false;
+        }
+        return readEntry(buffer.data(), size);
+    }
+    bool FileArchive::loadByIndex(size_t index, IData** pp_data)
+    {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        int64_t const size = openEntry(index);
+        if (size < 0)
+        {
+            return false;
+        }
+        ScopeObject<IData> p_data;
+        if (!IData::create((size_t)size, ~p_data))
+        {
+            mz_zip_entry_close(mz_zip_handle_v);
+            return false;
+        }
+        if (!readEntry(p_data->data(), size))
+        {
+            return false;
+        }
+        *pp_data = p_data.detach();
+        return true;
+    }
+    bool FileArchive::openStreamByIndex(size_t index, IFileStream** pp_stream)
+    {
+        int64_t disk_offset = 0;
+        uint16_t compression_method = 0;
+        int64_t compressed_size = 0;
+        int64_t uncompressed_size = 0;
+        {
+            std::lock_guard<std::recursive_mutex> lock(mutex_);
+            if (!mz_zip_handle_v || index >= entry_pos.size() || entry_pos[index] < 0 || list[index].type != FileType::File)
+            {
+                return false;
+            }
+            if (MZ_OK == mz_zip_entry_is_open(mz_zip_handle_v))
+            {
+                mz_zip_entry_close(mz_zip_handle_v);
+            }
+            mz_zip_file* mz_zip_file_v = nullptr;
+            if (MZ_OK != mz_zip_goto_entry(mz_zip_handle_v, entry_pos[index])
+                || MZ_OK != mz_zip_entry_get_info(mz_zip_handle_v, &mz_zip_file_v))
+            {
+                return false;
+            }
+            if ((mz_zip_file_v->flag & MZ_ZIP_FLAG_ENCRYPTED) || mz_zip_file_v->disk_number != 0)
+            {
+                return false;
+            }
+            disk_offset = mz_zip_file_v->disk_offset;
+            compression_method = mz_zip_file_v->compression_method;
+            compressed_size = mz_zip_file_v->compressed_size;
+            uncompressed_size = mz_zip_file_v->uncompressed_size;
+        }
+        if (disk_offset < 0 || compressed_size < 0 || uncompressed_size < 0)
+        {
+            return false;
+        }
+        if (compression_method != MZ_COMPRESS_METHOD_STORE && compression_method != MZ_COMPRESS_METHOD_DEFLATE)
+        {
+            return false;
+        }
+        // 中央目录中没有本地文件头的文件名和扩展字段长度，读取本地文件头得到数据的位置
+        uint64_t data_offset = 0;
+        {
+            FileStream file;
+            uint8_t header[30]{};
+            size_t read_size = 0;
+            if (!file.open(name_, 0, UINT64_MAX)
+                || !file.seek((uint64_t)disk_offset)
+                || !file.read(header, sizeof(header), &read_size) || read_size != sizeof(header))
+            {
+                return false;
+            }
+            auto const u16 = [&header](size_t i) -> uint32_t { return (uint32_t)header[i] | ((uint32_t)header[i + 1] << 8); };
+            if (u16(0) != 0x4b50 || u16(2) != 0x0403)
+            {
+                // 自解压文件等带有前缀数据的文件包，交给 minizip 处理
+                return false;
+            }
+            data_offset = (uint64_t)disk_offset + sizeof(header) + u16(26) + u16(28);
+        }
+        ScopeObject<IFileStream> p_stream;
+        if (compression_method == MZ_COMPRESS_METHOD_STORE)
+        {
+            if (compressed_size != uncompressed_size)
+            {
+                return false;
+            }
+            ScopeObject<FileStream> p_file;
+            p_file.attach(new FileStream);
+            if (!p_file->open(name_, data_offset, (uint64_t)compressed_size))
+            {
+                return false;
+            }
+            p_stream = p_file.get();
+        }
+        else
+        {
+            ScopeObject<FileStream_Deflate> p_file;
+            p_file.attach(new FileStream_Deflate);
+            if (!p_file->open(name_, data_offset, (uint64_t)compressed_size, (uint64_t)uncompressed_size))
+            {
+                return false;
+            }
+            p_stream = p_file.get();
+        }
+        *pp_stream = p_stream.detach();
+        return true;
+    }
+    bool FileArchive::openStream(std::string_view const& name, IFileStream** pp_stream)
+    {
+        return openStreamByIndex(findIndex(name), pp_stream);
+    }
+    void FileArchive::setIndexEnable(bool enable)
+    {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        index_enable = enable;
+    }
     size_t FileArchive::getCount()
     {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
         if (list.empty())
         {
             refresh();
@@ -128,10 +359,16 @@ namespace Core
     }
     FileType FileArchive::getType(std::string_view const& name)
     {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
         if (!mz_zip_v)
         {
             return FileType::Unknown;
         }
+        if (index_enable)
+        {
+            size_t const i = findIndex(name);
+            return i != invalid_index ? list[i].type : FileType::Unknown;
+        }
         if (MZ_OK != mz_zip_reader_locate_entry(mz_zip_v, name.data(), false))
         {
             return FileType::Unknown;
@@ -149,10 +386,16 @@ namespace Core
     }
     bool FileArchive::contain(std::string_view const& name)
     {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
         if (!mz_zip_v)
         {
             return false;
         }
+        if (index_enable)
+        {
+            size_t const i = findIndex(name);
+            return i != invalid_index && list[i].type == FileType::File;
+        }
         if (MZ_OK != mz_zip_reader_locate_entry(mz_zip_v, name.data(), false))
         {
             return false;
@@ -161,10 +404,15 @@ namespace Core
     }
     bool FileArchive::load(std::string_view const& name, std::vector<uint8_t>& buffer)
     {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
         if (!mz_zip_v)
         {
             return false;
         }
+        if (index_enable)
+        {
+            return loadByIndex(findIndex(name), buffer);
+        }
         if (MZ_OK != mz_zip_reader_locate_entry(mz_zip_v, name.data(), false))
         {
             return false;
@@ -186,10 +434,15 @@ namespace Core
     }
     bool FileArchive::load(std::string_view const& name, IData** pp_data)
     {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
         if (!mz_zip_v)
         {
             return false;
         }
+        if (index_enable)
+        {
+            return loadByIndex(findIndex(name), pp_data);
+        }
         if (MZ_OK != mz_zip_reader_locate_entry(mz_zip_v, name.data(), false))
         {
             return false;
@@ -214,6 +467,7 @@ namespace Core
 
     bool FileArchive::empty()
     {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
         if (!mz_zip_v)
         {
             return true;
@@ -231,6 +485,7 @@ namespace Core
     }
     bool FileArchive::setPassword(std::string_view const& password)
     {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
         if (!mz_zip_v)
         {
             return false;
@@ -241,6 +496,7 @@ namespace Core
     }
     bool FileArchive::loadEncrypted(std::string_view const& name, std::string_view const& password, std::vector<uint8_t>& buffer)
     {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
         if (!mz_zip_v)
         {
             return false;
@@ -276,6 +532,7 @@ namespace Core
     }
     bool FileArchive::loadEncrypted(std::string_view const& name, std::string_view const& password, IData** pp_data)
     {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
         if (!mz_zip_v)
         {
             return false;
@@ -319,7 +576,9 @@ namespace Core
         {
             if (MZ_OK == mz_zip_reader_open_file(mz_zip_v, path.data()))
             {
-                std::ignore = nullptr;
+                mz_zip_reader_get_zip_handle(mz_zip_v, &mz_zip_handle_v);
+                // 加载时建立文件名索引，之后的查找不再扫描中央目录
+                refresh();
             }
         }
     }
@@ -478,10 +737,12 @@ namespace Core
     
     size_t FileManager::getFileArchiveCount()
     {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
         return archive.size();
     }
     FileArchive& FileManager::getFileArchiveByUUID(uint64_t uuid)
     {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
         for (auto& v : archive)
         {
             if (v->getUUID() == uuid)
@@ -493,10 +754,12 @@ namespace Core
     }
     FileArchive& FileManager::getFileArchive(size_t index)
     {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
         return *archive[index];
     }
     FileArchive& FileManager::getFileArchive(std::string_view const& name)
     {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
         for (auto& v : archive)
         {
             if (v->getFileArchiveName() == name)
@@ -508,27 +771,34 @@ namespace Core
     }
     bool FileManager::loadFileArchive(std::string_view const& name)
     {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
         std::shared_ptr<FileArchive> arc = std::make_shared<FileArchive>(name);
         if (arc->empty())
         {
             return false;
         }
+        arc->setIndexEnable(archive_index_enable);
         archive.insert(archive.begin(), arc);
+        archive_index_dirty = true;
         return true;
     }
     bool FileManager::loadFileArchive(std::string_view const& name, std::string_view const& password)
     {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
         std::shared_ptr<FileArchive> arc = std::make_shared<FileArchive>(name);
         if (arc->empty())
         {
             return false;
         }
         arc->setPassword(password);
+        arc->setIndexEnable(archive_index_enable);
         archive.insert(archive.begin(), arc);
+        archive_index_dirty = true;
         return true;
     }
     bool FileManager::containFileArchive(std::string_view const& name)
     {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
         for (auto& v : archive)
         {
             if (v->getFileArchiveName() == name)
@@ -540,11 +810,13 @@ namespace Core
     }
     void FileManager::unloadFileArchive(std::string_view const& name)
     {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
         for (auto it = archive.begin(); it != archive.end();)
         {
             if ((*it)->getFileArchiveName() == name)
             {
                 it = archive.erase(it);
+                archive_index_dirty = true;
             }
             else
             {
@@ -554,16 +826,54 @@ namespace Core
     }
     void FileManager::unloadAllFileArchive()
     {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        archive_index.clear();
         archive.clear();
+        archive_index_dirty = true;
+    }
+    void FileManager::setArchiveIndexEnable(bool enable)
+    {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        archive_index_enable = enable;
+        for (auto& v : archive)
+        {
+            v->setIndexEnable(enable);
+        }
+    }
+    bool FileManager::getArchiveIndexEnable()
+    {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        return archive_index_enable;
+    }
+    FileManager::ArchiveEntry const* FileManager::findArchiveEntry(std::string_view const& name)
+    {
+        if (archive_index_dirty)
+        {
+            // 文件包按优先级从高到低排列，同名文件以先出现的为准
+            archive_index.clear();
+            for (auto& arc : archive)
+            {
+                size_t const count = arc->getCount();
+                for (size_t i = 0; i < count; i += 1)
+                {
+                    archive_index.try_emplace(arc->getName(i), ArchiveEntry{ arc, i });
+                }
+            }
+            archive_index_dirty = false;
+        }
+        auto const it = archive_index.find(name);
+        return it != archive_index.end() ? &it->second : nullptr;
     }
     
     void FileManager::addSearchPath(std::string_view const& path)
     {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
         removeSearchPath(path);
         search_list.emplace_back(path);
     }
     void FileManager::removeSearchPath(std::string_view const& path)
     {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
         for (auto it = search_list.begin(); it != search_list.end();)
         {
             if (*it == path)
@@ -578,17 +888,32 @@ namespace Core
     }
     void FileManager::clearSearchPath()
     {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
         search_list.clear();
     }
     
     bool FileManager::containEx(std::string_view const& name)
     {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
         auto proc = [&](std::string_view const& name) -> bool
         {
             if (contain(name))
             {
                 return true;
             }
+            if (archive_index_enable)
+            {
+                ArchiveEntry const* entry = findArchiveEntry(name);
+                if (!entry)
+                {
+                    return false;
+                }
+                if (entry->archive->getType(entry->index) == FileType::File)
+                {
+                    return true;
+                }
+                // 优先级最高的同名条目是目录，按原来的顺序检查其他文件包
+            }
             for (auto& arc : archive)
             {
                 if (arc->contain(name))
@@ -612,62 +937,82 @@ namespace Core
         }
         return false;
     }
-    bool FileManager::loadEx(std::string_view const& name, std::vector<uint8_t>& buffer)
+    void FileManager::makeLoadPlan(std::string_view const& name, LoadPlan& plan)
     {
-        auto proc = [&](std::string_view const& name, std::vector<uint8_t>& buffer) -> bool
-        {
-            for (auto& arc : archive)
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        plan.index_enable = archive_index_enable;
+        // 文件包被卸载时，正在读取的线程仍然持有它的引用
+        plan.archive = archive;
+        plan.path.reserve(search_list.size() + 1);
+        auto add = [&](std::string path)
+        {
+            LoadPath& v = plan.path.emplace_back();
+            if (archive_index_enable)
             {
-                if (arc->load(name, buffer))
+                if (ArchiveEntry const* entry = findArchiveEntry(path))
                 {
-                    return true;
+                    v.entry = *entry;
                 }
             }
-            if (load(name, buffer))
-            {
-                return true;
-            }
-            return false;
+            v.name = std::move(path);
         };
-        if (proc(name, buffer))
-        {
-            return true;
-        }
+        add(std::string(name));
         for (auto& p : search_list)
         {
             std::string path(p); path.append(name);
-            if (proc(path, buffer))
-            {
-                return true;
-            }
+            add(std::move(path));
         }
-        return false;
     }
-    bool FileManager::loadEx(std::string_view const& name, IData** pp_data)
+    bool FileManager::loadEx(std::string_view const& name, std::vector<uint8_t>& buffer)
     {
-        auto proc = [&](std::string_view const& name, IData** pp_data) -> bool
+        LoadPlan plan;
+        makeLoadPlan(name, plan);
+        for (auto& v : plan.path)
         {
-            for (auto& arc : archive)
+            if (v.entry.archive && v.entry.archive->loadByIndex(v.entry.index, buffer))
+            {
+                return true;
+            }
+            // 没有文件包包含这个文件时不用逐个查找；读取失败（例如密码不对）时按原来的顺序尝试其他文件包
+            if (!plan.index_enable || v.entry.archive)
             {
-                if (arc->load(name, pp_data))
+                for (auto& arc : plan.archive)
                 {
-                    return true;
+                    if (arc->load(v.name, buffer))
+                    {
+                        return true;
+                    }
                 }
             }
-            if (load(name, pp_data))
+            if (load(v.name, buffer))
             {
                 return true;
             }
-            return false;
-        };
-        if (proc(name, pp_data))
-        {
-            return true;
         }
-        for (auto& p : search_list)
+        return false;
+    }
+    bool FileManager::loadEx(std::string_view const& name, IData** pp_data)
+    {
+        LoadPlan plan;
+        makeLoadPlan(name, plan);
+        for (auto& v : plan.path)
         {
-            std::string path(p); path.append(name);
-            if (proc(path, pp_data))
+            if (v.entry.archive && v.entry.archive->loadByIndex(v.entry.index, pp_data))
+            {
+                return true;
+            }
+            // 没有文件包包含这个文件时不用逐个查找；读取失败（例如密码不对）时按原来的顺序尝试其他文件包
+            if (!plan.index_enable || v.entry.archive)
+            {
+                for (auto& arc : plan.archive)
+                {
+                    if (arc->load(v.name, pp_data))
+                    {
+                        return true;
+                    }
+                }
+            }
+            if (load(v.name, pp_data))
             {
                 return true;
             }
@@ -701,6 +1046,69 @@ namespace Core
         return true;
     }
 
+    bool FileManager::openStream(std::string_view const& name, IFileStream** pp_stream)
+    {
+        std::error_code ec;
+        if (!std::filesystem::is_regular_file(name, ec))
+        {
+            return false;
+        }
+        ScopeObject<FileStream> p_file;
+        p_file.attach(new FileStream);
+        if (!p_file->open(name, 0, UINT64_MAX))
+        {
+            return false;
+        }
+        *pp_stream = p_file.detach();
+        return true;
+    }
+    bool FileManager::openStreamEx(std::string_view const& name, IFileStream** pp_stream)
+    {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        // 返回值：1 打开成功，0 找到了文件但不能以文件流打开，-1 没有找到
+        auto proc = [&](std::string_view const& name) -> int
+        {
+            if (archive_index_enable)
+            {
+                ArchiveEntry const* entry = findArchiveEntry(name);
+                if (entry && entry->archive->getType(entry->index) == FileType::File)
+                {
+                    return entry->archive->openStreamByIndex(entry->index, pp_stream) ? 1 : 0;
+                }
+            }
+            else
+            {
+                for (auto& arc : archive)
+                {
+                    if (arc->contain(name))
+                    {
+                        return arc->openStream(name, pp_stream) ? 1 : 0;
+                    }
+                }
+            }
+            if (contain(name))
+            {
+                return openStream(name, pp_stream) ? 1 : 0;
+            }
+            return -1;
+        };
+        int const result = proc(name);
+        if (result >= 0)
+        {
+            return result > 0;
+        }
+        for (auto& p : search_list)
+        {
+            std::string path(p); path.append(name);
+            int const search_result = proc(path);
+            if (search_result >= 0)
+            {
+                return search_result > 0;
+            }
+        }
+        return false;
+    }
+
     FileManager::FileManager()
     {
     }
@@ -4,6 +4,8 @@
 #include <string>
 #include <string_view>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 
 namespace Core
 {
@@ -33,15 +35,44 @@ namespace Core
         virtual bool load(std::string_view const& name, IData** pp_data) = 0;
     };
     
+    // 可以随机读取的只读文件流，按需读取，不把整个文件载入内存
+    struct IFileStream : public IObject
+    {
+        virtual uint64_t size() = 0;
+        virtual uint64_t tell() = 0;
+        virtual bool seek(uint64_t position) = 0;
+        virtual bool read(void* buffer, size_t size, size_t* read_size) = 0;
+        // 缓冲区、解压状态和重启点占用的内存
+        virtual size_t getMemoryUsage() = 0;
+    };
+    
+    // 文件包中的路径比较：'\\' 和 '/' 视为同一个字符，和 mz_zip_reader_locate_entry 一致
+    struct ArchivePathHash
+    {
+        size_t operator()(std::string_view const& path) const noexcept;
+    };
+    struct ArchivePathEqual
+    {
+        bool operator()(std::string_view const& a, std::string_view const& b) const noexcept;
+    };
+    
     class FileArchive : public FileNodeTree
     {
     private:
         std::vector<FileNode> list;
+        std::vector<int64_t> entry_pos; // 与 list 对应，条目在中央目录中的位置，用于直接跳转
+        std::unordered_map<std::string_view, size_t, ArchivePathHash, ArchivePathEqual> index; // 文件名 -> list 下标，键引用 list 中的字符串
         std::string name_;
         std::string password_;
         uint64_t uuid = 0;
         void* mz_zip_v = nullptr;
+        void* mz_zip_handle_v = nullptr;
+        bool index_enable = true;
+        // minizip 的读取句柄不能并发使用，所有访问 mz_zip_v 的方法都要加锁
+        std::recursive_mutex mutex_;
         void refresh();
+        int64_t openEntry(size_t index);
+        bool readEntry(void* buffer, int64_t size);
     public:
         size_t findIndex(std::string_view const& name);
         size_t getCount();
@@ -58,6 +89,14 @@ namespace Core
         bool setPassword(std::string_view const& password);
         bool loadEncrypted(std::string_view const& name, std::string_view const& password, std::vector<uint8_t>& buffer);
         bool loadEncrypted(std::string_view const& name, std::string_view const& password, IData** pp_data);
+        // 按 findIndex 得到的下标直接读取，不再查找中央目录
+        bool loadByIndex(size_t index, std::vector<uint8_t>& buffer);
+        bool loadByIndex(size_t index, IData** pp_data);
+        // 只支持不加密的 stored 和 deflate 条目，文件流使用独立的文件句柄，不占用 minizip 的读取句柄
+        bool openStreamByIndex(size_t index, IFileStream** pp_stream);
+        bool openStream(std::string_view const& name, IFileStream** pp_stream);
+        // 关闭后退回到 minizip 逐条目查找，仅用于对比测试
+        void setIndexEnable(bool enable);
     public:
         FileArchive() = default;
         FileArchive(std::string_view const& path);
@@ -71,7 +110,33 @@ namespace Core
         std::vector<std::string> search_list;
         FileArchive null_archive;
         std::vector<std::shared_ptr<FileArchive>> archive;
+        struct ArchiveEntry
+        {
+            std::shared_ptr<FileArchive> archive;
+            size_t index = 0;
+        };
+        // 所有文件包的文件名 -> 优先级最高的文件包中的条目，文件包增减时重建
+        std::unordered_map<std::string_view, ArchiveEntry, ArchivePathHash, ArchivePathEqual> archive_index;
+        bool archive_index_dirty = true;
+        bool archive_index_enable = true;
+        // loadEx 要查找的路径（文件名和各个搜索路径下的文件名），以及当时的文件包列表
+        struct LoadPath
+        {
+            std::string name;
+            ArchiveEntry entry;
+        };
+        struct LoadPlan
+        {
+            std::vector<LoadPath> path;
+            std::vector<std::shared_ptr<FileArchive>> archive;
+            bool index_enable = true;
+        };
+        // 保护 archive 和 search_list，允许工作线程调用 loadEx/containEx
+        std::recursive_mutex mutex_;
         void refresh();
+        ArchiveEntry const* findArchiveEntry(std::string_view const& name);
+        // 加锁复制查找结果后立即解锁，读取和解压只持有文件包自己的锁，工作线程之间不会互相等待
+        void makeLoadPlan(std::string_view const& name, LoadPlan& plan);
     public:
         size_t findIndex(std::string_view const& name);
         size_t getCount();
@@ -91,6 +156,9 @@ namespace Core
         bool containFileArchive(std::string_view const& name);
         void unloadFileArchive(std::string_view const& name);
         void unloadAllFileArchive();
+        // 关闭后 loadEx/containEx 按优先级逐个文件包查找，仅用于对比测试
+        void setArchiveIndexEnable(bool enable);
+        bool getArchiveIndexEnable();
     public:
         void addSearchPath(std::string_view const& path);
         void removeSearchPath(std::string_view const& path);
@@ -101,6 +169,9 @@ namespace Core
         bool loadEx(std::string_view const& name, IData** pp_data);
         bool write(std::string_view const& name, std::vector<uint8_t> const& buffer);
         bool write(std::string_view const& name, IData* p_data);
+        bool openStream(std::string_view const& name, IFileStream** pp_stream);
+        // 查找顺序和 loadEx 一致；优先级最高的同名文件不能以文件流打开时返回 false，由调用者退回到 loadEx
+        bool openStreamEx(std::string_view const& name, IFileStream** pp_stream);
     public:
         FileManager();
         ~FileManager();
@@ -0,0 +1,319 @@
+#include "Core/FileStream.hpp"
+#include "spdlog/spdlog.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+// 和 minizip 使用同一个 zlib：zlib-ng 原生接口带 zng_ 前缀，兼容模式下和 zlib 相同
+#if __has_include("zlib-ng.h")
+#include "zlib-ng.h"
+#define LUASTG_ZLIB(x) zng_##x
+using zlib_stream = zng_stream;
+#else
+#include "zlib.h"
+#define LUASTG_ZLIB(x) x
+using zlib_stream = z_stream;
+#endif
+
+namespace Core
+{
+    // FileStream
+
+    bool FileStream::seek(uint64_t position)
+    {
+        if (position > m_size)
+        {
+            return false;
+        }
+        if (position != m_cursor)
+        {
+            m_cursor = position;
+            m_file_seek = true;
+        }
+        return true;
+    }
+    bool FileStream::read(void* buffer, size_t size, size_t* read_size)
+    {
+        *read_size = 0;
+        size_t const count = (size_t)std::min<uint64_t>(size, m_size - m_cursor);
+        if (count == 0)
+        {
+            return true;
+        }
+        if (m_file_seek)
+        {
+            m_file.clear();
+            m_file.seekg((std::streamoff)(m_offset + m_cursor), std::ios::beg);
+            m_file_seek = false;
+        }
+        m_file.read(static_cast<char*>(buffer), (std::streamsize)count);
+        size_t const n = (size_t)m_file.gcount();
+        m_cursor += n;
+        *read_size = n;
+        if (n < count)
+        {
+            // 文件被截断，下次读取时重新定位
+            m_file_seek = true;
+            return false;
+        }
+        return true;
+    }
+    size_t FileStream::getMemoryUsage()
+    {
+        return sizeof(FileStream) + BUFSIZ;
+    }
+    bool FileStream::open(std::string_view const& path, uint64_t offset, uint64_t size)
+    {
+        m_file.open(std::string(path), std::ios::in | std::ios::binary);
+        if (!m_file.is_open())
+        {
+            return false;
+        }
+        m_file.seekg(0, std::ios::end);
+        auto const end = m_file.tellg();
+        if (end < 0 || (uint64_t)end < offset)
+        {
+            return false;
+        }
+        uint64_t const file_size = (uint64_t)end;
+        if (size == UINT64_MAX)
+        {
+            size = file_size - offset;
+        }
+        else if (size > file_size - offset)
+        {
+            return false;
+        }
+        m_offset = offset;
+        m_size = size;
+        m_cursor = 0;
+        m_file_seek = true;
+        return true;
+    }
+
+    // FileStream_Deflate
+
+    void* FileStream_Deflate::allocate(void* opaque, unsigned int items, unsigned int size)
+    {
+        // 在分配的内存前面记录大小，用于统计解压状态占用的内存
+        size_t const n = (size_t)items * (size_t)size;
+        auto* p = static_cast<uint8_t*>(std::malloc(n + 16));
+        if (!p)
+        {
+            return nullptr;
+        }
+        std::memcpy(p, &n, sizeof(n));
+        static_cast<FileStream_Deflate*>(opaque)->m_inflate_memory += n;
+        return p + 16;
+    }
+    void FileStream_Deflate::deallocate(void* opaque, void* address)
+    {
+        if (!address)
+        {
+            return;
+        }
+        auto* p = static_cast<uint8_t*>(address) - 16;
+        size_t n = 0;
+        std::memcpy(&n, p, sizeof(n));
+        static_cast<FileStream_Deflate*>(opaque)->m_inflate_memory -= n;
+        std::free(p);
+    }
+    uint64_t FileStream_Deflate::getWindowBegin() const noexcept
+    {
+        return std::max(m_valid, m_output > window_size ? m_output - window_size : 0);
+    }
+    void FileStream_Deflate::copyFromWindow(uint64_t end, size_t size, uint8_t* buffer) const
+    {
+        size_t const begin = (size_t)((end - size) % window_size);
+        size_t const first = std::min(size, window_size - begin);
+        std::memcpy(buffer, m_window.get() + begin, first);
+        std::memcpy(buffer + first, m_window.get(), size - first);
+    }
+    bool FileStream_Deflate::restart(RestartPoint const& point)
+    {
+        auto* z = static_cast<zlib_stream*>(m_inflate);
+        if (Z_OK != LUASTG_ZLIB(inflateReset)(z))
+        {
+            return false;
+        }
+        z->next_in = nullptr;
+        z->avail_in = 0;
+        if (point.bits > 0)
+        {
+            // 重启点落在字节中间，先补上这个字节中还没有读取的位
+            uint8_t byte = 0;
+            size_t n = 0;
+            if (!m_source.seek(point.input - 1) || !m_source.read(&byte, 1, &n) || n != 1)
+            {
+                return false;
+            }
+            if (Z_OK != LUASTG_ZLIB(inflatePrime)(z, point.bits, byte >> (8 - point.bits)))
+            {
+                return false;
+            }
+        }
+        if (!m_source.seek(point.input))
+        {
+            return false;
+        }
+        if (!point.dictionary.empty())
+        {
+            if (Z_OK != LUASTG_ZLIB(inflateSetDictionary)(z, point.dictionary.data(), (uint32_t)point.dictionary.size()))
+            {
+                return false;
+            }
+            // 字典也是回溯窗口的内容，放回 m_window 中对应的位置
+            size_t const begin = (size_t)((point.output - point.dictionary.size()) % window_size);
+            size_t const first = std::min(point.dictionary.size(), window_size - begin);
+            std::memcpy(m_window.get() + begin, point.dictionary.data(), first);
+            std::memcpy(m_window.get(), point.dictionary.data() + first, point.dictionary.size() - first);
+        }
+        m_output = point.output;
+        m_valid = point.output - point.dictionary.size();
+        return true;
+    }
+    bool FileStream_Deflate::inflateStep()
+    {
+        auto* z = static_cast<zlib_stream*>(m_inflate);
+        if (z->avail_in == 0)
+        {
+            size_t n = 0;
+            if (!m_source.read(m_input.get(), input_size, &n) || n == 0)
+            {
+                return false;
+            }
+            z->next_in = m_input.get();
+            z->avail_in = (uint32_t)n;
+        }
+        size_t const offset = (size_t)(m_output % window_size);
+        z->next_out = m_window.get() + offset;
+        z->avail_out = (uint32_t)(window_size - offset);
+        // Z_BLOCK 在每个块结束时返回，这时才能记录重启点
+        int const result = LUASTG_ZLIB(inflate)(z, Z_BLOCK);
+        if (result != Z_OK && result != Z_STREAM_END)
+        {
+            return false;
+        }
+        m_output += (window_size - offset) - z->avail_out;
+        if (m_output > m_size || (result == Z_STREAM_END && m_output != m_size))
+        {
+            return false;
+        }
+        bool const block_end = (z->data_type & 128) != 0 && (z->data_type & 64) == 0;
+        if (block_end && m_output > m_points.back().output && m_output - m_points.back().output >= restart_span)
+        {
+            RestartPoint point;
+            point.output = m_output;
+            point.input = m_source.tell() - z->avail_in;
+            point.bits = z->data_type & 7;
+            size_t const dictionary_size = (size_t)std::min<uint64_t>(m_output - m_valid, window_size);
+            point.dictionary.resize(dictionary_size);
+            copyFromWindow(m_output, dictionary_size, point.dictionary.data());
+            m_points.emplace_back(std::move(point));
+        }
+        return true;
+    }
+    bool FileStream_Deflate::locate()
+    {
+        // 从不超过 m_cursor 的最近的重启点开始解压；当前位置更近时直接向前解压，跳过的数据不复制
+        auto const it = std::prev(std::upper_bound(m_points.begin(), m_points.end(), m_cursor,
+            [](uint64_t value, RestartPoint const& point) { return value < point.output; }));
+        if (m_cursor < getWindowBegin() || it->output > m_output)
+        {
+            if (!restart(*it))
+            {
+                return false;
+            }
+        }
+        while (m_output <= m_cursor)
+        {
+            if (!inflateStep())
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    bool FileStream_Deflate::seek(uint64_t position)
+    {
+        if (position > m_size)
+        {
+            return false;
+        }
+        m_cursor = position;
+        return true;
+    }
+    bool FileStream_Deflate::read(void* buffer, size_t size, size_t* read_size)
+    {
+        *read_size = 0;
+        if (m_error)
+        {
+            return false;
+        }
+        auto* ptr = static_cast<uint8_t*>(buffer);
+        size_t done = 0;
+        while (done < size && m_cursor < m_size)
+        {
+            if (m_cursor >= m_output || m_cursor < getWindowBegin())
+            {
+                if (!locate())
+                {
+                    // 解压状态已经不可信，之后的读取全部失败
+                    spdlog::error("[core] FileStream_Deflate: inflate failed at {}", m_cursor);
+                    m_error = true;
+                    *read_size = done;
+                    return false;
+                }
+                continue;
+            }
+            size_t const offset = (size_t)(m_cursor % window_size);
+            size_t const n = (size_t)std::min<uint64_t>({ m_output - m_cursor, window_size - offset, size - done });
+            std::memcpy(ptr + done, m_window.get() + offset, n);
+            m_cursor += n;
+            done += n;
+        }
+        *read_size = done;
+        return true;
+    }
+    size_t FileStream_Deflate::getMemoryUsage()
+    {
+        size_t usage = sizeof(FileStream_Deflate) + BUFSIZ + sizeof(zlib_stream) + m_inflate_memory + window_size + input_size;
+        for (auto const& point : m_points)
+        {
+            usage += sizeof(RestartPoint) + point.dictionary.capacity();
+        }
+        return usage;
+    }
+    bool FileStream_Deflate::open(std::string_view const& path, uint64_t offset, uint64_t compressed_size, uint64_t size)
+    {
+        if (!m_source.open(path, offset, compressed_size))
+        {
+            return false;
+        }
+        auto* z = new zlib_stream{};
+        z->zalloc = &allocate;
+        z->zfree = &deallocate;
+        z->opaque = this;
+        // zip 中的 deflate 数据没有 zlib 头
+        if (Z_OK != LUASTG_ZLIB(inflateInit2)(z, -MAX_WBITS))
+        {
+            delete z;
+            return false;
+        }
+        m_inflate = z;
+        m_window = std::make_unique<uint8_t[]>(window_size);
+        m_input = std::make_unique<uint8_t[]>(input_size);
+        m_size = size;
+        m_points.emplace_back(); // 数据开头也是重启点
+        return true;
+    }
+    FileStream_Deflate::~FileStream_Deflate()
+    {
+        if (m_inflate)
+        {
+            auto* z = static_cast<zlib_stream*>(m_inflate);
+            LUASTG_ZLIB(inflateEnd)(z);
+            delete z;
+        }
+    }
+}
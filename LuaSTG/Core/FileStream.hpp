@@ -0,0 +1,78 @@
+#pragma once
+#include "Core/Object.hpp"
+#include "Core/FileManager.hpp"
+#include <fstream>
+#include <memory>
+
+namespace Core
+{
+    // 文件中的一段连续数据：普通文件，或者 zip 中不压缩（stored）的条目
+    class FileStream : public Object<IFileStream>
+    {
+    private:
+        std::ifstream m_file;
+        uint64_t m_offset = 0;
+        uint64_t m_size = 0;
+        uint64_t m_cursor = 0;
+        bool m_file_seek = true; // m_file 的读取位置和 m_cursor 不一致
+    public:
+        uint64_t size() { return m_size; }
+        uint64_t tell() { return m_cursor; }
+        bool seek(uint64_t position);
+        bool read(void* buffer, size_t size, size_t* read_size);
+        size_t getMemoryUsage();
+    public:
+        // size 为 UINT64_MAX 时读到文件末尾
+        bool open(std::string_view const& path, uint64_t offset, uint64_t size);
+    };
+
+    // zip 中 deflate 压缩的条目
+    // deflate 只能从头顺序解压，解压过程中每隔 restart_span 字节在块边界上记录一个重启点（压缩数据位置、未读取的位、32KB 字典），
+    // 向后跳转或者向前跳过很远时从最近的重启点继续解压，不用从头开始
+    class FileStream_Deflate : public Object<IFileStream>
+    {
+    public:
+        static constexpr size_t window_size = 32768; // deflate 的最大回溯距离
+        static constexpr size_t input_size = 16384;
+        static constexpr uint64_t restart_span = 1048576;
+    private:
+        struct RestartPoint
+        {
+            uint64_t output = 0; // 解压后的位置
+            uint64_t input = 0;  // 压缩数据中已经读取的字节数
+            int bits = 0;        // input 的最后一个字节中还没有读取的位数
+            std::vector<uint8_t> dictionary;
+        };
+        FileStream m_source;
+        void* m_inflate = nullptr;
+        size_t m_inflate_memory = 0;
+        std::vector<RestartPoint> m_points;
+        // 解压出的第 p 个字节位于 m_window[p % window_size]
+        std::unique_ptr<uint8_t[]> m_window;
+        std::unique_ptr<uint8_t[]> m_input;
+        uint64_t m_size = 0;
+        uint64_t m_output = 0; // 已经解压到的位置
+        uint64_t m_valid = 0;  // m_window 中的数据从这个位置开始有效
+        uint64_t m_cursor = 0;
+        bool m_error = false;
+    private:
+        static void* allocate(void* opaque, unsigned int items, unsigned int size);
+        static void deallocate(void* opaque, void* address);
+        uint64_t getWindowBegin() const noexcept;
+        void copyFromWindow(uint64_t end, size_t size, uint8_t* buffer) const;
+        bool restart(RestartPoint const& point);
+        bool inflateStep();
+        bool locate();
+    public:
+        uint64_t size() { return m_size; }
+        uint64_t tell() { return m_cursor; }
+        bool seek(uint64_t position);
+        bool read(void* buffer, size_t size, size_t* read_size);
+        size_t getMemoryUsage();
+    public:
+        bool open(std::string_view const& path, uint64_t offset, uint64_t compressed_size, uint64_t size);
+    public:
+        FileStream_Deflate() = default;
+        ~FileStream_Deflate();
+    };
+}
@@ -0,0 +1,286 @@
+#include "Core/FrameProfiler.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+namespace Core
+{
+    static void appendJsonString(std::string& out, std::string_view const& str)
+    {
+        out.push_back('"');
+        for (char const c : str)
+        {
+            switch (c)
+            {
+            case '"': out.append("\\\""); break;
+            case '\\': out.append("\\\\"); break;
+            case '\n': out.append("\\n"); break;
+            case '\r': out.append("\\r"); break;
+            case '\t': out.append("\\t"); break;
+            default:
+                if ((unsigned char)c < 0x20)
+                {
+                    char buffer[8]{};
+                    std::snprintf(buffer, sizeof(buffer), "\\u%04x", (unsigned)c);
+                    out.append(buffer);
+                }
+                else
+                {
+                    out.push_back(c);
+                }
+                break;
+            }
+        }
+        out.push_back('"');
+    }
+    template<typename... Args>
+    static void appendFormat(std::string& out, char const* format, Args... args)
+    {
+        char buffer[128]{};
+        int const n = std::snprintf(buffer, sizeof(buffer), format, args...);
+        if (n > 0)
+        {
+            out.append(buffer, (size_t)std::min<int>(n, (int)sizeof(buffer) - 1));
+        }
+    }
+
+    void FrameProfiler::beginFrame()
+    {
+        if (m_InFrame)
+        {
+            endFrame();
+        }
+        if (!m_Enable)
+        {
+            return;
+        }
+        Frame& frame = currentFrame();
+        frame.index = m_FrameSerial;
+        frame.begin = now();
+        frame.end = frame.begin;
+        frame.first_event = m_EventSerial;
+        frame.event_count = 0;
+        frame.dropped_event_count = 0;
+        frame.counters.clear();
+        frame.samples.clear();
+        m_Stack.clear();
+        m_InFrame = true;
+    }
+    void FrameProfiler::endFrame()
+    {
+        if (!m_InFrame)
+        {
+            return;
+        }
+        uint64_t const t = now();
+        // 关闭未结束的计时区间
+        for (uint64_t const serial : m_Stack)
+        {
+            m_Events[serial % EventCapacity].end = t;
+        }
+        m_Stack.clear();
+        Frame& frame = currentFrame();
+        frame.end = t;
+        m_FrameSerial += 1;
+        m_InFrame = false;
+    }
+
+    uint64_t FrameProfiler::beginScope(char const* name) noexcept
+    {
+        if (!m_Enable || !m_InFrame)
+        {
+            return InvalidEvent;
+        }
+        Frame& frame = currentFrame();
+        if (frame.event_count >= FrameEventLimit)
+        {
+            frame.dropped_event_count += 1;
+            return InvalidEvent;
+        }
+        uint64_t const serial = m_EventSerial;
+        m_EventSerial += 1;
+        frame.event_count += 1;
+        Event& e = m_Events[serial % EventCapacity];
+        e.name = name;
+        e.depth = (uint32_t)m_Stack.size();
+        e.begin = now();
+        e.end = e.begin;
+        if (m_Stack.size() < m_Stack.capacity())
+        {
+            m_Stack.push_back(serial);
+        }
+        return serial;
+    }
+    void FrameProfiler::endScope(uint64_t serial) noexcept
+    {
+        if (serial == InvalidEvent || !m_InFrame)
+        {
+            return;
+        }
+        m_Events[serial % EventCapacity].end = now();
+        // 计时区间按后进先出的顺序结束，嵌套过深时没有入栈
+        if (!m_Stack.empty() && m_Stack.back() == serial)
+        {
+            m_Stack.pop_back();
+        }
+    }
+
+    void FrameProfiler::addCounter(char const* name, int64_t value)
+    {
+        if (!m_Enable || !m_InFrame)
+        {
+            return;
+        }
+        Frame& frame = currentFrame();
+        std::string_view const key(name);
+        for (auto& v : frame.counters)
+        {
+            if (v.name == name || key == v.name)
+            {
+                v.value += value;
+                return;
+            }
+        }
+        frame.counters.push_back(Counter{ name, value });
+    }
+    void FrameProfiler::addSample(char const* name, void const* key, uint64_t time)
+    {
+        if (!m_Enable || !m_InFrame)
+        {
+            return;
+        }
+        Frame& frame = currentFrame();
+        // 连续的回调通常属于同一个类，从后往前找
+        for (size_t i = frame.samples.size(); i > 0; i -= 1)
+        {
+            Sample& v = frame.samples[i - 1];
+            if (v.name == name && v.key == key)
+            {
+                v.count += 1;
+                v.time += time;
+                return;
+            }
+        }
+        frame.samples.push_back(Sample{ name, key, 1, time });
+    }
+
+    char const* FrameProfiler::intern(std::string_view const& name)
+    {
+        auto it = m_Strings.find(std::string(name));
+        if (it == m_Strings.end())
+        {
+            it = m_Strings.emplace(name).first;
+        }
+        return it->c_str();
+    }
+
+    size_t FrameProfiler::getFrameCount() const noexcept
+    {
+        size_t n = (size_t)std::min<uint64_t>(m_FrameSerial, FrameCapacity - 1);
+        // 计时区间已经被覆盖的帧不再完整
+        while (n > 0 && getFrame(n - 1) == nullptr)
+        {
+            n -= 1;
+        }
+        return n;
+    }
+    FrameProfiler::Frame const* FrameProfiler::getFrame(size_t age) const noexcept
+    {
+        if (age >= FrameCapacity - 1 || age >= m_FrameSerial)
+        {
+            return nullptr;
+        }
+        Frame const& frame = m_Frames[(m_FrameSerial - 1 - age) % FrameCapacity];
+        if (m_EventSerial > EventCapacity && frame.first_event < m_EventSerial - EventCapacity)
+        {
+            return nullptr;
+        }
+        return &frame;
+    }
+
+    bool FrameProfiler::dumpChromeTrace(std::string_view const& path, size_t frame_count)
+    {
+        frame_count = std::min(frame_count, getFrameCount());
+        std::string out;
+        out.reserve(1024 * 1024);
+        out.append("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+        bool first = true;
+        auto const separator = [&]()
+        {
+            if (!first)
+                out.append(",\n");
+            first = false;
+        };
+        for (size_t age = frame_count; age > 0; age -= 1)
+        {
+            Frame const& frame = *getFrame(age - 1);
+            // 帧
+            separator();
+            out.append("{\"name\":\"Frame\",\"ph\":\"X\",\"pid\":0,\"tid\":0,");
+            appendFormat(out, "\"ts\":%.3f,\"dur\":%.3f,", (double)frame.begin * 1e-3, (double)(frame.end - frame.begin) * 1e-3);
+            out.append("\"args\":{\"frame\":").append(std::to_string(frame.index));
+            out.append(",\"dropped\":").append(std::to_string(frame.dropped_event_count));
+            out.append(",\"samples\":[");
+            for (size_t i = 0; i < frame.samples.size(); i += 1)
+            {
+                Sample const& v = frame.samples[i];
+                char key[32]{};
+                std::snprintf(key, sizeof(key), "%p", v.key);
+                if (i > 0)
+                    out.push_back(',');
+                out.append("{\"name\":");
+                appendJsonString(out, v.name);
+                out.append(",\"key\":");
+                appendJsonString(out, key);
+                out.append(",\"count\":").append(std::to_string(v.count));
+                appendFormat(out, ",\"time\":%.3f", (double)v.time * 1e-3);
+                out.push_back('}');
+            }
+            out.append("]}}");
+            // 计时区间
+            for (uint64_t i = 0; i < frame.event_count; i += 1)
+            {
+                Event const& e = getEvent(frame.first_event + i);
+                separator();
+                out.append("{\"name\":");
+                appendJsonString(out, e.name);
+                out.append(",\"ph\":\"X\",\"pid\":0,\"tid\":0,");
+                appendFormat(out, "\"ts\":%.3f,\"dur\":%.3f}", (double)e.begin * 1e-3, (double)(e.end - e.begin) * 1e-3);
+            }
+            // 计数器
+            for (Counter const& v : frame.counters)
+            {
+                separator();
+                out.append("{\"name\":");
+                appendJsonString(out, v.name);
+                out.append(",\"ph\":\"C\",\"pid\":0,");
+                appendFormat(out, "\"ts\":%.3f,", (double)frame.begin * 1e-3);
+                out.append("\"args\":{\"value\":").append(std::to_string(v.value)).append("}}");
+            }
+        }
+        out.append("\n]}\n");
+
+        std::ofstream file{ std::string(path), std::ios::out | std::ios::binary | std::ios::trunc };
+        if (!file.is_open())
+        {
+            return false;
+        }
+        file.write(out.data(), (std::streamsize)out.size());
+        file.close();
+        return true;
+    }
+
+    FrameProfiler::FrameProfiler()
+        : m_Epoch(Clock::now())
+    {
+        m_Events.resize(EventCapacity);
+        m_Stack.reserve(256);
+        m_Frames.resize(FrameCapacity);
+    }
+
+    FrameProfiler& FrameProfiler::get()
+    {
+        static FrameProfiler instance;
+        return instance;
+    }
+}
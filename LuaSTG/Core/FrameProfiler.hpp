@@ -0,0 +1,142 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <chrono>
+
+namespace Core
+{
+    // 内置的逐帧性能分析器，只在主线程使用
+    // 嵌套的计时区间保存在环形缓冲区中，计数器和回调统计按帧保存，可以读取最近若干帧的数据或者导出为 Chrome trace 格式
+    class FrameProfiler
+    {
+    public:
+        static constexpr size_t EventCapacity = 65536;         // 环形缓冲区中的计时区间数
+        static constexpr size_t FrameCapacity = 120;           // 保存的帧数
+        static constexpr size_t FrameEventLimit = EventCapacity / 4; // 单帧最多记录的计时区间数，超出部分丢弃
+        static constexpr uint64_t InvalidEvent = UINT64_MAX;
+
+        struct Event
+        {
+            char const* name;   // 静态字符串或者 intern 返回的字符串
+            uint64_t begin;     // 纳秒
+            uint64_t end;       // 纳秒
+            uint32_t depth;     // 嵌套深度，0 为最外层
+        };
+
+        struct Counter
+        {
+            char const* name;
+            int64_t value;
+        };
+
+        // 按 (name, key) 汇总的计时，例如按对象的类汇总 lua 回调
+        struct Sample
+        {
+            char const* name;
+            void const* key;
+            uint64_t count;
+            uint64_t time;      // 纳秒
+        };
+
+        struct Frame
+        {
+            uint64_t index{ 0 };        // 帧序号
+            uint64_t begin{ 0 };        // 纳秒
+            uint64_t end{ 0 };          // 纳秒
+            uint64_t first_event{ 0 };  // 第一个计时区间的序号
+            uint64_t event_count{ 0 };
+            uint64_t dropped_event_count{ 0 };
+            std::vector<Counter> counters;
+            std::vector<Sample> samples;
+        };
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        Clock::time_point m_Epoch;
+        bool m_Enable{ true };
+        bool m_EnableSample{ false };
+
+        std::vector<Event> m_Events;
+        uint64_t m_EventSerial{ 0 };    // 下一个计时区间的序号
+        std::vector<uint64_t> m_Stack;  // 未结束的计时区间序号
+
+        std::vector<Frame> m_Frames;
+        uint64_t m_FrameSerial{ 0 };    // 下一帧的序号
+        bool m_InFrame{ false };
+
+        std::unordered_set<std::string> m_Strings;
+
+    private:
+        Frame& currentFrame() noexcept { return m_Frames[m_FrameSerial % FrameCapacity]; }
+
+    public:
+        uint64_t now() const noexcept
+        {
+            return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - m_Epoch).count();
+        }
+
+        // 启用或关闭，关闭时不记录任何数据
+        void setEnable(bool enable) noexcept { m_Enable = enable; }
+        bool isEnable() const noexcept { return m_Enable; }
+
+        // 启用或关闭汇总计时（开销比计时区间大，默认关闭）
+        void setSampleEnable(bool enable) noexcept { m_EnableSample = enable; }
+        bool isSampleEnable() const noexcept { return m_Enable && m_EnableSample && m_InFrame; }
+
+        void beginFrame();
+        void endFrame();
+
+        // 返回计时区间的序号，没有记录时返回 InvalidEvent
+        uint64_t beginScope(char const* name) noexcept;
+        void endScope(uint64_t serial) noexcept;
+
+        // 累加当前帧的计数器
+        void addCounter(char const* name, int64_t value);
+
+        // 累加当前帧的汇总计时
+        void addSample(char const* name, void const* key, uint64_t time);
+
+        // 保存动态生成的名称，返回的指针一直有效
+        char const* intern(std::string_view const& name);
+
+        // 已经结束并且数据完整的帧数
+        size_t getFrameCount() const noexcept;
+
+        // 获取已经结束的帧，0 为最近一帧
+        Frame const* getFrame(size_t age) const noexcept;
+
+        // 获取计时区间
+        Event const& getEvent(uint64_t serial) const noexcept { return m_Events[serial % EventCapacity]; }
+
+        // 导出最近若干帧为 Chrome trace 格式（chrome://tracing 或 Perfetto）
+        bool dumpChromeTrace(std::string_view const& path, size_t frame_count);
+
+    public:
+        FrameProfiler();
+        FrameProfiler(FrameProfiler const&) = delete;
+        FrameProfiler& operator=(FrameProfiler const&) = delete;
+
+    public:
+        static FrameProfiler& get();
+    };
+
+    // 离开作用域时结束计时区间
+    class FrameProfilerScope
+    {
+    private:
+        uint64_t m_Serial;
+    public:
+        explicit FrameProfilerScope(char const* name) noexcept : m_Serial(FrameProfiler::get().beginScope(name)) {}
+        ~FrameProfilerScope() { FrameProfiler::get().endScope(m_Serial); }
+        FrameProfilerScope(FrameProfilerScope const&) = delete;
+        FrameProfilerScope& operator=(FrameProfilerScope const&) = delete;
+    };
+}
+
+#define CORE_FRAME_PROFILE_CONCAT_(A, B) A##B
+#define CORE_FRAME_PROFILE_CONCAT(A, B) CORE_FRAME_PROFILE_CONCAT_(A, B)
+#define FrameProfileScopeN(NAME) ::Core::FrameProfilerScope CORE_FRAME_PROFILE_CONCAT(_frame_profile_scope_, __LINE__)(NAME)
@@ -130,10 +130,19 @@ namespace Core::Graphics
         virtual bool createTextureFromFile(StringView path, bool mipmap, ITexture2D** pp_texutre) = 0;
         virtual bool createTextureFromMemory(void const* data, size_t size, bool mipmap, ITexture2D** pp_texutre) = 0;
         virtual bool createTexture(Vector2U size, ITexture2D** pp_texutre) = 0;
+        // 使用已解码的 RGBA8 像素数据创建纹理，path 用于设备重建时重新加载
+        virtual bool createTextureFromPixelData(StringView path, Vector2U size, IData* p_pixel, bool mipmap, ITexture2D** pp_texutre) = 0;
 
         virtual bool createRenderTarget(Vector2U size, IRenderTarget** pp_rt) = 0;
         virtual bool createDepthStencilBuffer(Vector2U size, IDepthStencilBuffer** pp_ds) = 0;
 
+        // 开启后，之后从文件或内存加载的纹理在上传前预乘透明度，并标记为预乘透明度纹理
+        virtual void setPremultiplyTextureOnLoad(bool enable) = 0;
+        virtual bool getPremultiplyTextureOnLoad() = 0;
+
         static bool create(IDevice** p_device);
     };
+
+    // 将图片文件数据（PNG、JPG、QOI 等）解码为 RGBA8 像素数据，不访问图形设备，可以在工作线程调用
+    bool decodeImageFromMemory(void const* data, size_t size, Vector2U* p_size, IData** pp_pixel);
 }
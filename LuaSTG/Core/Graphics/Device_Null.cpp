@@ -0,0 +1,223 @@
+#include "Core/Graphics/Device_Null.hpp"
+#include "Core/FileManager.hpp"
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include "spdlog/spdlog.h"
+#include "stb_image_write.h"
+
+namespace Core::Graphics
+{
+	Device_Null::Device_Null(bool keep_pixels)
+		: m_keep_pixels(keep_pixels)
+	{
+		spdlog::info("[core] created headless Device (software rasterizer: {})", keep_pixels ? "enabled" : "disabled");
+	}
+	Device_Null::~Device_Null()
+	{
+		assert(m_eventobj.size() == 0);
+	}
+
+	void Device_Null::addEventListener(IDeviceEventListener* e)
+	{
+		// The device is never lost, listeners are kept only so that removeEventListener matches
+		removeEventListener(e);
+		m_eventobj.emplace_back(e);
+	}
+	void Device_Null::removeEventListener(IDeviceEventListener* e)
+	{
+		m_eventobj.erase(std::remove(m_eventobj.begin(), m_eventobj.end(), e), m_eventobj.end());
+	}
+
+	bool Device_Null::createTextureFromFile(StringView path, bool mipmap, ITexture2D** pp_texture)
+	{
+		std::vector<uint8_t> src;
+		if (!GFileManager().loadEx(path, src))
+		{
+			spdlog::error("[core] Unable to load file '{}'", path);
+			*pp_texture = nullptr;
+			return false;
+		}
+		return createTextureFromMemory(src.data(), src.size(), mipmap, pp_texture);
+	}
+	bool Device_Null::createTextureFromMemory(void const* data, size_t size, bool mipmap, ITexture2D** pp_texture)
+	{
+		Vector2U image_size;
+		ScopeObject<IData> pixel;
+		if (!decodeImageFromMemory(data, size, &image_size, ~pixel))
+		{
+			spdlog::error("[core] Unable to parse binary data");
+			*pp_texture = nullptr;
+			return false;
+		}
+		return createTextureFromPixelData("", image_size, *pixel, mipmap, pp_texture);
+	}
+	bool Device_Null::createTextureFromPixelData(StringView path, Vector2U size, IData* p_pixel, bool mipmap, ITexture2D** pp_texture)
+	{
+		(void)path;
+		(void)mipmap;
+		if (p_pixel == nullptr || p_pixel->size() < (size_t)size.x * (size_t)size.y * 4)
+		{
+			*pp_texture = nullptr;
+			return false;
+		}
+		try
+		{
+			auto* p = new Texture2D_Null(this, size, static_cast<uint8_t const*>(p_pixel->data()), false, false);
+			p->setPremultipliedAlpha(m_premul_on_load);
+			uint8_t* pixel = p->getPixels();
+			if (m_premul_on_load && pixel)
+			{
+				for (size_t i = 0; i < (size_t)size.x * (size_t)size.y; i += 1, pixel += 4)
+				{
+					uint32_t const a = pixel[3];
+					pixel[0] = (uint8_t)((pixel[0] * a + 127u) / 255u);
+					pixel[1] = (uint8_t)((pixel[1] * a + 127u) / 255u);
+					pixel[2] = (uint8_t)((pixel[2] * a + 127u) / 255u);
+				}
+			}
+			*pp_texture = p;
+			return true;
+		}
+		catch (...)
+		{
+			*pp_texture = nullptr;
+			return false;
+		}
+	}
+	bool Device_Null::createTexture(Vector2U size, ITexture2D** pp_texture)
+	{
+		try
+		{
+			*pp_texture = new Texture2D_Null(this, size, nullptr, true, false);
+			return true;
+		}
+		catch (...)
+		{
+			*pp_texture = nullptr;
+			return false;
+		}
+	}
+
+	bool Device_Null::createRenderTarget(Vector2U size, IRenderTarget** pp_rt)
+	{
+		try
+		{
+			*pp_rt = new RenderTarget_Null(this, size);
+			return true;
+		}
+		catch (...)
+		{
+			*pp_rt = nullptr;
+			return false;
+		}
+	}
+	bool Device_Null::createDepthStencilBuffer(Vector2U size, IDepthStencilBuffer** pp_ds)
+	{
+		try
+		{
+			*pp_ds = new DepthStencilBuffer_Null(size);
+			return true;
+		}
+		catch (...)
+		{
+			*pp_ds = nullptr;
+			return false;
+		}
+	}
+
+	bool Device_Null::create(bool keep_pixels, Device_Null** pp_device)
+	{
+		try
+		{
+			*pp_device = new Device_Null(keep_pixels);
+			return true;
+		}
+		catch (...)
+		{
+			*pp_device = nullptr;
+			return false;
+		}
+	}
+}
+
+namespace Core::Graphics
+{
+	// Texture2D
+
+	bool Texture2D_Null::setSize(Vector2U size)
+	{
+		if (!(m_dynamic || m_isrt))
+		{
+			spdlog::error("[core] Cannot modify size of static texture");
+			return false;
+		}
+		m_size = size;
+		if (m_device->isKeepPixels())
+		{
+			m_pixel.assign((size_t)size.x * (size_t)size.y * 4, 0);
+		}
+		return true;
+	}
+
+	bool Texture2D_Null::uploadPixelData(RectU rc, void const* data, uint32_t pitch)
+	{
+		if (!m_dynamic)
+		{
+			return false;
+		}
+		if (rc.b.x > m_size.x || rc.b.y > m_size.y || rc.a.x > rc.b.x || rc.a.y > rc.b.y)
+		{
+			return false;
+		}
+		if (m_pixel.empty())
+		{
+			return true;
+		}
+		uint8_t const* src = static_cast<uint8_t const*>(data);
+		size_t const row_size = (size_t)rc.width() * 4;
+		for (uint32_t y = rc.a.y; y < rc.b.y; y += 1, src += pitch)
+		{
+			std::memcpy(m_pixel.data() + ((size_t)y * m_size.x + rc.a.x) * 4, src, row_size);
+		}
+		return true;
+	}
+
+	bool Texture2D_Null::saveToFile(StringView path)
+	{
+		if (m_pixel.empty())
+		{
+			spdlog::error("[core] Texture has no pixel data, enable the headless software rasterizer to save it");
+			return false;
+		}
+		std::string spath(path);
+		return (bool)stbi_write_png(spath.c_str(), m_size.x, m_size.y, 4, m_pixel.data(), m_size.x * 4);
+	}
+
+	Texture2D_Null::Texture2D_Null(Device_Null* device, Vector2U size, uint8_t const* pixel, bool dynamic, bool rendertarget)
+		: m_device(device)
+		, m_size(size)
+		, m_id(device->nextTextureId())
+		, m_dynamic(dynamic)
+		, m_premul(rendertarget)
+		, m_isrt(rendertarget)
+	{
+		if (m_device->isKeepPixels())
+		{
+			size_t const n = (size_t)size.x * (size_t)size.y * 4;
+			if (pixel)
+				m_pixel.assign(pixel, pixel + n);
+			else
+				m_pixel.assign(n, 0);
+		}
+	}
+	Texture2D_Null::~Texture2D_Null() = default;
+
+	// RenderTarget
+
+	RenderTarget_Null::RenderTarget_Null(Device_Null* device, Vector2U size)
+	{
+		m_texture.attach(new Texture2D_Null(device, size, nullptr, true, true));
+	}
+	RenderTarget_Null::~RenderTarget_Null() = default;
+}
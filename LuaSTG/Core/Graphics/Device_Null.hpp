@@ -0,0 +1,130 @@
+#pragma once
+#include "Core/Object.hpp"
+#include "Core/Graphics/Device.hpp"
+#include "Core/Type.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace Core::Graphics
+{
+	class RenderTarget_Null;
+
+	// Device of the headless backend. Textures keep their size, and their RGBA8 pixels
+	// (GL memory layout, first row at v = 0) only when the software rasterizer is enabled.
+	class Device_Null : public Object<IDevice>
+	{
+	private:
+		std::vector<IDeviceEventListener*> m_eventobj;
+		RenderTarget_Null* m_bound_target{ nullptr }; // Like the framebuffer binding of a GL context
+		uint64_t m_texture_serial{ 0 };
+		bool m_premul_on_load{ false };
+		bool m_keep_pixels{ false };
+	public:
+		uint64_t nextTextureId() { return ++m_texture_serial; }
+		bool isKeepPixels() { return m_keep_pixels; }
+		void setBoundRenderTarget(RenderTarget_Null* p_rt) { m_bound_target = p_rt; }
+		RenderTarget_Null* getBoundRenderTarget() { return m_bound_target; }
+	public:
+		void addEventListener(IDeviceEventListener* e);
+		void removeEventListener(IDeviceEventListener* e);
+
+		bool recreate() { return true; }
+
+		void* getNativeHandle() { return nullptr; }
+		void* getNativeRendererHandle() { return nullptr; }
+
+		bool createTextureFromFile(StringView path, bool mipmap, ITexture2D** pp_texutre);
+		bool createTextureFromMemory(void const* data, size_t size, bool mipmap, ITexture2D** pp_texutre);
+		bool createTexture(Vector2U size, ITexture2D** pp_texutre);
+		bool createTextureFromPixelData(StringView path, Vector2U size, IData* p_pixel, bool mipmap, ITexture2D** pp_texutre);
+
+		bool createRenderTarget(Vector2U size, IRenderTarget** pp_rt);
+		bool createDepthStencilBuffer(Vector2U size, IDepthStencilBuffer** pp_ds);
+
+		void setPremultiplyTextureOnLoad(bool enable) { m_premul_on_load = enable; }
+		bool getPremultiplyTextureOnLoad() { return m_premul_on_load; }
+
+	public:
+		Device_Null(bool keep_pixels);
+		~Device_Null();
+
+	public:
+		static bool create(bool keep_pixels, Device_Null** pp_device);
+	};
+
+	class Texture2D_Null : public Object<ITexture2D>
+	{
+	private:
+		ScopeObject<Device_Null> m_device;
+		std::optional<SamplerState> m_sampler;
+		std::vector<uint8_t> m_pixel; // Empty without the software rasterizer
+		Vector2U m_size{};
+		uint64_t m_id{ 0 };
+		bool m_dynamic{ false };
+		bool m_premul{ false };
+		bool m_isrt{ false };
+
+	public:
+		uint64_t getId() const noexcept { return m_id; }
+		uint8_t* getPixels() { return m_pixel.empty() ? nullptr : m_pixel.data(); }
+
+	public:
+		void* getNativeHandle() { return nullptr; }
+
+		bool isDynamic() { return m_dynamic; }
+		bool isPremultipliedAlpha() { return m_premul; }
+		void setPremultipliedAlpha(bool v) { m_premul = v; }
+		Vector2U getSize() { return m_size; }
+		bool setSize(Vector2U size);
+
+		bool uploadPixelData(RectU rc, void const* data, uint32_t pitch);
+		void setPixelData(IData* p_data) { (void)p_data; }
+
+		bool saveToFile(StringView path);
+
+		void setSamplerState(SamplerState sampler) { m_sampler = sampler; }
+		std::optional<SamplerState> getSamplerState() { return m_sampler; }
+
+	public:
+		Texture2D_Null(Device_Null* device, Vector2U size, uint8_t const* pixel, bool dynamic, bool rendertarget);
+		~Texture2D_Null();
+	};
+
+	class DepthStencilBuffer_Null : public Object<IDepthStencilBuffer>
+	{
+	private:
+		Vector2U m_size{};
+
+	public:
+		void* getNativeHandle() { return nullptr; }
+
+		bool setSize(Vector2U size) { m_size = size; return true; }
+		Vector2U getSize() { return m_size; }
+
+	public:
+		DepthStencilBuffer_Null(Vector2U size) : m_size(size) {}
+	};
+
+	class RenderTarget_Null : public Object<IRenderTarget>
+	{
+	private:
+		ScopeObject<Texture2D_Null> m_texture;
+
+	public:
+		Texture2D_Null* getTextureNull() { return *m_texture; }
+
+	public:
+		bool DepthStencilBufferEnabled() { return false; }
+
+		void* getNativeHandle() { return nullptr; }
+
+		bool setSize(Vector2U size) { return m_texture->setSize(size); }
+		ITexture2D* getTexture() { return *m_texture; }
+
+	public:
+		RenderTarget_Null(Device_Null* device, Vector2U size);
+		~RenderTarget_Null();
+	};
+}
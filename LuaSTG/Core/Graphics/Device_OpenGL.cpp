@@ -132,6 +132,19 @@ namespace Core::Graphics
 			return false;
 		}
 	}
+	bool Device_OpenGL::createTextureFromPixelData(StringView path, Vector2U size, IData* p_pixel, bool mipmap, ITexture2D** pp_texture)
+	{
+		try
+		{
+			*pp_texture = new Texture2D_OpenGL(this, path, size, p_pixel, mipmap);
+			return true;
+		}
+		catch (...)
+		{
+			*pp_texture = nullptr;
+			return false;
+		}
+	}
 	bool Device_OpenGL::createTexture(Vector2U size, ITexture2D** pp_texture)
 	{
 		try
@@ -204,6 +217,62 @@ namespace Core::Graphics
 
 namespace Core::Graphics
 {
+	// Image
+
+	static void premultiplyAlpha(uint8_t* pixel, size_t count)
+	{
+		for (size_t i = 0; i < count; i += 1, pixel += 4)
+		{
+			uint32_t const a = pixel[3];
+			pixel[0] = (uint8_t)((pixel[0] * a + 127u) / 255u);
+			pixel[1] = (uint8_t)((pixel[1] * a + 127u) / 255u);
+			pixel[2] = (uint8_t)((pixel[2] * a + 127u) / 255u);
+		}
+	}
+
+	bool decodeImageFromMemory(void const* data, size_t size, Vector2U* p_size, IData** pp_pixel)
+	{
+		uint8_t const* src = static_cast<uint8_t const*>(data);
+		if (src == nullptr || size < 4 || size > INT32_MAX)
+		{
+			return false;
+		}
+		Vector2I image_size;
+		uint8_t* pixel = nullptr;
+		bool is_qoi = (src[0] == 'q' && src[1] == 'o' && src[2] == 'i' && src[3] == 'f');
+		if (is_qoi)
+		{
+			qoi_desc desc;
+			pixel = (uint8_t*)qoi_decode(src, (int)size, &desc, 4);
+			image_size.x = (int32_t)desc.width;
+			image_size.y = (int32_t)desc.height;
+		}
+		else
+		{
+			pixel = stbi_load_from_memory(src, (int)size, &image_size.x, &image_size.y, NULL, 4);
+		}
+		if (pixel == nullptr)
+		{
+			return false;
+		}
+		// image size will never be negative
+		size_t const pixel_size = (size_t)image_size.x * (size_t)image_size.y * 4;
+		ScopeObject<IData> p_pixel;
+		bool const result = IData::create(pixel_size, ~p_pixel);
+		if (result)
+		{
+			std::memcpy(p_pixel->data(), pixel, pixel_size);
+			p_size->x = (uint32_t)image_size.x;
+			p_size->y = (uint32_t)image_size.y;
+			*pp_pixel = p_pixel.detach();
+		}
+		if (is_qoi)
+			QOI_FREE(pixel);
+		else
+			stbi_image_free(pixel);
+		return result;
+	}
+
 	// Texture2D
 
 	bool Texture2D_OpenGL::setSize(Vector2U size)
@@ -225,7 +294,7 @@ namespace Core::Graphics
 			return false;
 		}
 
-		glBindTexture(GL_TEXTURE_2D, opengl_texture2d);
+		bindTexture2DOutsideRenderer(opengl_texture2d);
 		glPixelStorei(GL_UNPACK_ROW_LENGTH, pitch / 4);
 		glTexSubImage2D(GL_TEXTURE_2D, 0, rc.a.x, rc.a.y, rc.width(), rc.height(), GL_RGBA, GL_UNSIGNED_BYTE, data);
 		glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
@@ -238,7 +307,7 @@ namespace Core::Graphics
 
 		std::unique_ptr<uint8_t> data(new uint8_t[m_size.x * m_size.y * 4]);
 
-		glBindTexture(GL_TEXTURE_2D, opengl_texture2d);
+		bindTexture2DOutsideRenderer(opengl_texture2d);
 		glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, data.get());
 
 		return (bool)stbi_write_png(spath.c_str(), m_size.x, m_size.y, 4, data.get(), m_size.x * 4);
@@ -268,13 +337,17 @@ namespace Core::Graphics
 			// image size will never be negative
 			m_size.x = size.x;
 			m_size.y = size.y;
+			if (m_premul)
+			{
+				premultiplyAlpha(data, (size_t)m_size.x * (size_t)m_size.y);
+			}
 
 			glGenTextures(1, &opengl_texture2d);
 			if (opengl_texture2d == 0) {
 				i18n_core_system_call_report_error("glGenTextures");
 				return false;
 			}
-			glBindTexture(GL_TEXTURE_2D, opengl_texture2d);
+			bindTexture2DOutsideRenderer(opengl_texture2d);
 			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, m_size.x, m_size.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
 			glGenerateMipmap(GL_TEXTURE_2D);
 
@@ -282,50 +355,44 @@ namespace Core::Graphics
 		}
 		else if (!source_path.empty())
 		{
-			std::vector<uint8_t> src;
-			if (!GFileManager().loadEx(source_path, src))
-			{
-				spdlog::error("[core] Unable to load file '{}'", source_path);
-				return false;
-			}
-
 			// Load pictures
-			Vector2I size;
-			uint8_t* data;
-			if(src[0] ==  'q' && src[1] == 'o' && src[2] == 'i' && src[3] == 'f')
+			ScopeObject<IData> pixel;
+			if (m_pixel)
 			{
-				qoi_desc desc;
-				data = (uint8_t*)qoi_decode(src.data(), src.size(), &desc, 4);
-				size.x = desc.width;
-				size.y = desc.height;
-				spdlog::info("[core] Loaded QOI file '{}'", source_path);
+				// already decoded by the caller (e.g. on a worker thread), only upload here
+				pixel = m_pixel;
+				m_pixel.reset();
 			}
 			else
 			{
-				data = stbi_load_from_memory(src.data(), src.size(), &size.x, &size.y, NULL, 4);
+				std::vector<uint8_t> src;
+				if (!GFileManager().loadEx(source_path, src))
+				{
+					spdlog::error("[core] Unable to load file '{}'", source_path);
+					return false;
+				}
+				if (!decodeImageFromMemory(src.data(), src.size(), &m_size, ~pixel))
+				{
+					spdlog::error("[core] Unable to parse file '{}'", source_path);
+					return false;
+				}
 			}
-
-			if (data == NULL)
+			if (m_premul)
 			{
-				spdlog::error("[core] Unable to parse file '{}'", source_path);
-				return false;
+				premultiplyAlpha(static_cast<uint8_t*>(pixel->data()), (size_t)m_size.x * (size_t)m_size.y);
 			}
-			// image size will never be negative
-			m_size.x = size.x;
-			m_size.y = size.y;
 
 			glGenTextures(1, &opengl_texture2d);
 			if (opengl_texture2d == 0) {
 				i18n_core_system_call_report_error("glGenTextures");
 				return false;
 			}
-			glBindTexture(GL_TEXTURE_2D, opengl_texture2d);
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, m_size.x, m_size.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+			bindTexture2DOutsideRenderer(opengl_texture2d);
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, m_size.x, m_size.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixel->data());
 			glGenerateMipmap(GL_TEXTURE_2D);
 			// glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 			// glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST_MIPMAP_LINEAR);
 			// glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, 4.0f);
-			stbi_image_free(data);
 		}
 		else
 		{
@@ -334,7 +401,7 @@ namespace Core::Graphics
 				i18n_core_system_call_report_error("glGenTextures");
 				return false;
 			}
-			glBindTexture(GL_TEXTURE_2D, opengl_texture2d);
+			bindTexture2DOutsideRenderer(opengl_texture2d);
 			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, m_size.x, m_size.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, 0);
 			glGenerateMipmap(GL_TEXTURE_2D);
 			// glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
@@ -349,7 +416,7 @@ namespace Core::Graphics
 		: m_device(device)
 		, source_path(path)
 		, m_dynamic(false)
-		, m_premul(false)
+		, m_premul(device->getPremultiplyTextureOnLoad())
 		, m_mipmap(mipmap)
 		, m_isrt(false)
 	{
@@ -362,7 +429,7 @@ namespace Core::Graphics
 	Texture2D_OpenGL::Texture2D_OpenGL(Device_OpenGL* device, void const* data, size_t size, bool mipmap)
 		: m_device(device)
 		, m_dynamic(false)
-		, m_premul(false)
+		, m_premul(device->getPremultiplyTextureOnLoad())
 		, m_mipmap(mipmap)
 		, m_isrt(false)
 	{
@@ -375,6 +442,22 @@ namespace Core::Graphics
 			throw std::runtime_error("Texture2D::Texture2D(2)");
 		m_device->addEventListener(this);
 	}
+	Texture2D_OpenGL::Texture2D_OpenGL(Device_OpenGL* device, StringView path, Vector2U size, IData* p_pixel, bool mipmap)
+		: m_device(device)
+		, m_pixel(p_pixel)
+		, source_path(path)
+		, m_size(size)
+		, m_dynamic(false)
+		, m_premul(device->getPremultiplyTextureOnLoad())
+		, m_mipmap(mipmap)
+		, m_isrt(false)
+	{
+		if (path.empty() || p_pixel == nullptr || p_pixel->size() < (size_t)size.x * (size_t)size.y * 4)
+			throw std::runtime_error("Texture2D::Texture2D(1)");
+		if (!createResource())
+			throw std::runtime_error("Texture2D::Texture2D(2)");
+		m_device->addEventListener(this);
+	}
 	Texture2D_OpenGL::Texture2D_OpenGL(Device_OpenGL* device, Vector2U size, bool rendertarget)
 		: m_device(device)
 		, m_size(size)
@@ -14,6 +14,17 @@
 
 namespace Core::Graphics
 {
+	// Changes whenever a texture is bound outside of the renderer, the renderer then drops its texture binding shadow
+	inline uint32_t g_texture_binding_generation = 0;
+
+	// Textures may be created or updated in the middle of a batch. Bind on the active unit without querying
+	// and restoring the previous binding, the renderer binds its texture again before the next draw
+	inline void bindTexture2DOutsideRenderer(GLuint texture)
+	{
+		glBindTexture(GL_TEXTURE_2D, texture);
+		g_texture_binding_generation += 1;
+	}
+
 	class Device_OpenGL : public Object<IDevice>
 	{
 	private:
@@ -23,6 +34,7 @@ namespace Core::Graphics
 			DeviceDestroy,
 		};
 		bool m_is_dispatch_event{ false };
+		bool m_premul_on_load{ false };
 		std::vector<IDeviceEventListener*> m_eventobj;
 		std::vector<IDeviceEventListener*> m_eventobj_late;
 	private:
@@ -39,10 +51,14 @@ namespace Core::Graphics
 		bool createTextureFromFile(StringView path, bool mipmap, ITexture2D** pp_texutre);
 		bool createTextureFromMemory(void const* data, size_t size, bool mipmap, ITexture2D** pp_texutre);
 		bool createTexture(Vector2U size, ITexture2D** pp_texutre);
+		bool createTextureFromPixelData(StringView path, Vector2U size, IData* p_pixel, bool mipmap, ITexture2D** pp_texutre);
 
 		bool createRenderTarget(Vector2U size, IRenderTarget** pp_rt);
 		bool createDepthStencilBuffer(Vector2U size, IDepthStencilBuffer** pp_ds);
 
+		void setPremultiplyTextureOnLoad(bool enable) { m_premul_on_load = enable; }
+		bool getPremultiplyTextureOnLoad() { return m_premul_on_load; }
+
 	public:
 		Device_OpenGL();
 		~Device_OpenGL();
@@ -59,6 +75,7 @@ namespace Core::Graphics
 		ScopeObject<Device_OpenGL> m_device;
 		std::optional<SamplerState> m_sampler;
 		ScopeObject<IData> m_data;
+		ScopeObject<IData> m_pixel; // 已解码的像素数据，仅用于第一次创建，之后从 source_path 重新加载
 		std::string source_path;
 		GLuint opengl_texture2d = 0;
 		Vector2U m_size{};
@@ -97,6 +114,7 @@ namespace Core::Graphics
 	public:
 		Texture2D_OpenGL(Device_OpenGL* device, StringView path, bool mipmap);
 		Texture2D_OpenGL(Device_OpenGL* device, void const* data, size_t size, bool mipmap);
+		Texture2D_OpenGL(Device_OpenGL* device, StringView path, Vector2U size, IData* p_pixel, bool mipmap);
 		Texture2D_OpenGL(Device_OpenGL* device, Vector2U size, bool rendertarget); // if rendertarget, then hand over control to RenderTarget_OpenGL
 		~Texture2D_OpenGL();
 	};
@@ -81,7 +81,7 @@ namespace Core::Graphics
             assert(false);
             return false;
         }
-        glBindTexture(GL_TEXTURE_2D, default_image);
+        bindTexture2DOutsideRenderer(default_image);
         glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 64, 64, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
         glGenerateMipmap(GL_TEXTURE_2D);
 
@@ -206,7 +206,7 @@ namespace Core::Graphics
 {
     void map_sampler_to_opengl(tinygltf::Sampler& samp, GLuint tex)
     {
-        glBindTexture(GL_TEXTURE_2D, tex);
+        bindTexture2DOutsideRenderer(tex);
     #define MAKE_FILTER(MIN_MIP, MAG) ((MAG << 16) | (MIN_MIP))
         switch (MAKE_FILTER(samp.minFilter, samp.magFilter))
         {
@@ -431,7 +431,7 @@ namespace Core::Graphics
                 continue;
             }
 
-            glBindTexture(GL_TEXTURE_2D, image[idx]);
+            bindTexture2DOutsideRenderer(image[idx]);
             glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, img.width, img.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, img.image.data());
             // glGenerateMipmap(GL_TEXTURE_2D);
         }
@@ -1,6 +1,7 @@
 ﻿#pragma once
 #include "Core/Type.hpp"
 #include "Core/Graphics/Device.hpp"
+#include <cmath>
 
 namespace Core::Graphics
 {
@@ -27,6 +28,14 @@ namespace Core::Graphics
 		virtual void setRotationQuaternion(Vector4F const& quat) = 0;
 	};
 
+	// Draws recorded by IRenderer::beginBundle and IRenderer::endBundle, kept on the GPU
+	struct IRenderBundle : public IObject
+	{
+		virtual uint32_t getVertexCount() = 0;
+		virtual uint32_t getIndexCount() = 0;
+		virtual uint32_t getCommandCount() = 0;
+	};
+
 	struct IRenderer : public IObject
 	{
 		enum class VertexColorBlendState : uint8_t
@@ -126,6 +135,42 @@ namespace Core::Graphics
 				: x(x_), y(y_), z(0.f), u(u_), v(v_), color(0xFFFFFFFFu) {} // TODO: z = 0.0f or z = 0.5f ?
 		};
 		using DrawIndex = uint16_t;
+		using DrawIndex32 = uint32_t;
+
+		// Size of the draw list (per buffer section) and its index width.
+		// Draws that do not fit grow the draw list after a flush, draws with 32-bit indices that need them switch it to 32-bit indices.
+		struct DrawListConfig
+		{
+			uint32_t vertex_count = 65536;
+			uint32_t index_count = 98304;
+			uint32_t command_count = 4096;
+			bool index32 = false;
+		};
+
+		// Instanced sprites: one compact record per sprite, expanded to a quad by the vertex shader
+
+		struct SpriteInstanceRect
+		{
+			RectF pos; // Quad corners relative to the sprite center, y-axis-up, in world units
+			RectF uv;  // Normalized texture coordinates
+		};
+		struct SpriteInstance
+		{
+			float x, y, z;
+			float rotation;
+			float hscale, vscale;
+			uint32_t rect;  // Index into the rect table passed along with the instances
+			uint32_t color; // Same packing as DrawVertex::color
+		};
+		static constexpr size_t SpriteInstanceMaxRectCount = 256;
+
+		// Model transform of a replayed render bundle: scale, then rotate around the z-axis, then translate
+		struct RenderBundleTransform
+		{
+			Vector3F position;
+			Vector3F scale{ 1.0f, 1.0f, 1.0f };
+			float rotation = 0.0f; // Radians
+		};
 
 		virtual bool beginBatch() = 0;
 		virtual bool endBatch() = 0;
@@ -149,6 +194,12 @@ namespace Core::Graphics
 		virtual void setDepthState(DepthState state) = 0;
 		virtual void setBlendState(BlendState state) = 0;
 		virtual void setTexture(ITexture2D* texture) = 0;
+		// Premultiplied alpha batching: with Mul vertex color blending, the Alpha and Add blend states share one batch.
+		// Vertex colors are premultiplied, additive vertices get alpha 0 and everything uses the Alpha blend function.
+		// The only visible difference is the alpha channel of the render target, which additive sprites leave unchanged.
+		// Fog needs the real alpha of additive vertices to add the fog color, so while fog is enabled the blend states are not merged.
+		virtual void setPremultipliedBatching(bool enable) = 0;
+		virtual bool getPremultipliedBatching() = 0;
 
 		virtual bool drawTriangle(DrawVertex const& v1, DrawVertex const& v2, DrawVertex const& v3) = 0;
 		virtual bool drawTriangle(DrawVertex const* pvert) = 0;
@@ -156,6 +207,20 @@ namespace Core::Graphics
 		virtual bool drawQuad(DrawVertex const* pvert) = 0;
 		virtual bool drawRaw(DrawVertex const* pvert, uint16_t nvert, DrawIndex const* pidx, uint16_t nidx) = 0;
 		virtual bool drawRequest(uint16_t nvert, uint16_t nidx, DrawVertex** ppvert, DrawIndex** ppidx, uint16_t* idxoffset) = 0;
+		// 32-bit counts and indices, for meshes with more than 65535 vertices or indices
+		virtual bool drawRaw(DrawVertex const* pvert, uint32_t nvert, DrawIndex32 const* pidx, uint32_t nidx) = 0;
+		virtual bool drawRequest(uint32_t nvert, uint32_t nidx, DrawVertex** ppvert, DrawIndex32** ppidx, uint32_t* idxoffset) = 0;
+		virtual void setDrawListConfig(DrawListConfig const& config) = 0;
+		virtual DrawListConfig getDrawListConfig() = 0;
+		// Flushes the current batch, then draws all instances with a single draw call using the current render states
+		virtual bool drawSpriteInstances(ITexture2D* texture, SpriteInstanceRect const* rects, size_t rect_count, SpriteInstance const* instances, size_t count) = 0;
+		// Render bundles: batched draws between beginBundle and endBundle are recorded instead of drawn,
+		// together with their textures and vertex color blend, fog, depth and blend states, and uploaded once.
+		// The camera is not recorded, drawBundle uses the current one. Instanced sprites are recorded as quads, models and post effects cannot be recorded.
+		virtual bool beginBundle() = 0;
+		virtual bool endBundle(IRenderBundle** pp_bundle) = 0;
+		virtual bool isBundleScope() = 0;
+		virtual bool drawBundle(IRenderBundle* p_bundle, RenderBundleTransform const& transform) = 0;
 
 		virtual bool createPostEffectShader(StringView path, IPostEffectShader** pp_effect) = 0;
 		virtual bool drawPostEffect(
@@ -173,4 +238,51 @@ namespace Core::Graphics
 
 		static bool create(IDevice* p_device, IRenderer** pp_renderer);
 	};
+
+	// Expands instanced sprites into quads of the current batch, the same way the instance vertex shader does.
+	// Render bundles only hold batched draws, so drawSpriteInstances takes this path while a bundle is recorded
+	inline bool drawSpriteInstancesAsQuads(IRenderer* renderer, ITexture2D* texture, IRenderer::SpriteInstanceRect const* rects, size_t rect_count, IRenderer::SpriteInstance const* instances, size_t count)
+	{
+		renderer->setTexture(texture);
+		for (size_t i = 0; i < count; i += 1)
+		{
+			IRenderer::SpriteInstance const& s = instances[i];
+			if (s.rect >= rect_count)
+			{
+				continue;
+			}
+			IRenderer::SpriteInstanceRect const& r = rects[s.rect];
+			IRenderer::DrawVertex* vert = nullptr;
+			IRenderer::DrawIndex* idx = nullptr;
+			uint16_t offset = 0;
+			if (!renderer->drawRequest((uint16_t)4, (uint16_t)6, &vert, &idx, &offset))
+			{
+				return false;
+			}
+			float const sinv = std::sin(s.rotation);
+			float const cosv = std::cos(s.rotation);
+			for (uint32_t k = 0; k < 4; k += 1)
+			{
+				// Corner order of the triangle strip: (a.x, a.y), (b.x, a.y), (a.x, b.y), (b.x, b.y)
+				bool const cx = (k & 1) != 0;
+				bool const cy = (k >> 1) != 0;
+				float const ox = (cx ? r.pos.b.x : r.pos.a.x) * s.hscale;
+				float const oy = (cy ? r.pos.b.y : r.pos.a.y) * s.vscale;
+				vert[k] = IRenderer::DrawVertex(
+					s.x + ox * cosv - oy * sinv,
+					s.y + ox * sinv + oy * cosv,
+					s.z,
+					cx ? r.uv.b.x : r.uv.a.x,
+					cy ? r.uv.b.y : r.uv.a.y,
+					s.color);
+			}
+			idx[0] = (IRenderer::DrawIndex)(offset + 0);
+			idx[1] = (IRenderer::DrawIndex)(offset + 1);
+			idx[2] = (IRenderer::DrawIndex)(offset + 2);
+			idx[3] = (IRenderer::DrawIndex)(offset + 2);
+			idx[4] = (IRenderer::DrawIndex)(offset + 1);
+			idx[5] = (IRenderer::DrawIndex)(offset + 3);
+		}
+		return true;
+	}
 }
@@ -0,0 +1,899 @@
+#include "Core/Graphics/Renderer_Null.hpp"
+#include "Core/FrameProfiler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <fstream>
+#include <string>
+#include "spdlog/spdlog.h"
+
+namespace Core::Graphics
+{
+    static char const* const record_type_name[] = {
+        "Clear",
+        "ClearDepth",
+        "RenderTarget",
+        "Camera",
+        "Viewport",
+        "ScissorRect",
+        "VertexColorBlend",
+        "Fog",
+        "Depth",
+        "Blend",
+        "Draw",
+        "SpriteInstances",
+        "PostEffect",
+        "Model",
+        "Bundle",
+        "EndBatch",
+    };
+
+    struct RasterColor
+    {
+        float r, g, b, a;
+    };
+
+    static RasterColor unpackColor(uint32_t c)
+    {
+        return RasterColor{
+            (float)(c & 0xFFu) / 255.0f,
+            (float)((c >> 8) & 0xFFu) / 255.0f,
+            (float)((c >> 16) & 0xFFu) / 255.0f,
+            (float)((c >> 24) & 0xFFu) / 255.0f,
+        };
+    }
+    static uint8_t packChannel(float v)
+    {
+        return (uint8_t)(std::clamp(v, 0.0f, 1.0f) * 255.0f + 0.5f);
+    }
+    static uint32_t addressTexel(float t, uint32_t size, TextureAddressMode mode)
+    {
+        int64_t i = (int64_t)std::floor(t * (float)size);
+        if (mode == TextureAddressMode::Wrap)
+        {
+            i %= (int64_t)size;
+            return (uint32_t)(i < 0 ? i + size : i);
+        }
+        return (uint32_t)std::clamp<int64_t>(i, 0, (int64_t)size - 1);
+    }
+}
+
+namespace Core::Graphics
+{
+    void Renderer_Null::pushRecord(Record const& record)
+    {
+        m_record[m_record_count % record_capacity] = record;
+        m_record_count += 1;
+        m_frame_record_count += 1;
+    }
+    void Renderer_Null::pushStateRecord(RecordType type, uint32_t value)
+    {
+        m_draw_open = false;
+        Record record;
+        record.type = type;
+        record.frame = m_frame;
+        record.texture_id = m_texture_id;
+        record.value = value;
+        pushRecord(record);
+    }
+    void Renderer_Null::recordDraw(uint32_t nvert, uint32_t nidx)
+    {
+        if (m_draw_open)
+        {
+            Record& last = m_record[(m_record_count - 1) % record_capacity];
+            if (last.texture_id == m_texture_id)
+            {
+                last.vertex_count += nvert;
+                last.index_count += nidx;
+                return;
+            }
+        }
+        Record record;
+        record.type = RecordType::Draw;
+        record.frame = m_frame;
+        record.vertex_count = nvert;
+        record.index_count = nidx;
+        record.texture_id = m_texture_id;
+        pushRecord(record);
+        m_draw_open = true;
+        m_draw_call_count += 1;
+    }
+    void Renderer_Null::commitDrawRequest()
+    {
+        if (!m_request_pending)
+        {
+            return;
+        }
+        m_request_pending = false;
+        if (m_bundle_capture)
+        {
+            if (m_request_index32_pending)
+                captureDraw(m_request_vertex.data(), (uint32_t)m_request_vertex.size(), m_request_index32.data(), (uint32_t)m_request_index32.size());
+            else
+                captureDraw(m_request_vertex.data(), (uint32_t)m_request_vertex.size(), m_request_index.data(), (uint32_t)m_request_index.size());
+            return;
+        }
+        if (m_request_index32_pending)
+        {
+            rasterize(m_request_vertex.data(), (uint32_t)m_request_vertex.size(), m_request_index32.data(), (uint32_t)m_request_index32.size());
+        }
+        else
+        {
+            rasterize(m_request_vertex.data(), (uint32_t)m_request_vertex.size(), m_request_index.data(), (uint32_t)m_request_index.size());
+        }
+    }
+    template<typename T>
+    void Renderer_Null::captureDraw(DrawVertex const* pvert, uint32_t nvert, T const* pidx, uint32_t nidx)
+    {
+        auto& bundle = *m_bundle_capture.get();
+        uint32_t const base = (uint32_t)bundle.vertex.size();
+        uint32_t offset = 0;
+        if (!bundle.command.empty()
+            && bundle.command.back().texture.get() == m_texture.get()
+            && bundle.command.back().vertex_color_blend_state == m_vertex_color_blend_state
+            && bundle.command.back().blend_state == m_blend_state)
+        {
+            offset = base - bundle.command.back().vertex_offset;
+        }
+        else
+        {
+            RenderBundle_Null::Command cmd;
+            cmd.texture = m_texture;
+            cmd.vertex_offset = base;
+            cmd.index_offset = (uint32_t)bundle.index.size();
+            cmd.vertex_color_blend_state = m_vertex_color_blend_state;
+            cmd.blend_state = m_blend_state;
+            bundle.command.emplace_back(std::move(cmd));
+        }
+        bundle.vertex.insert(bundle.vertex.end(), pvert, pvert + nvert);
+        for (uint32_t i = 0; i < nidx; i += 1)
+        {
+            bundle.index.push_back(offset + pidx[i]);
+        }
+        bundle.command.back().index_count += nidx;
+    }
+    bool Renderer_Null::isPremulBatch(BlendState state) const noexcept
+    {
+        return m_premul_batching
+            && m_vertex_color_blend_state == VertexColorBlendState::Mul
+            && (state == BlendState::Alpha || state == BlendState::Add);
+    }
+
+    template<typename T>
+    void Renderer_Null::rasterize(DrawVertex const* pvert, uint32_t nvert, T const* pidx, uint32_t nidx)
+    {
+        if (!m_device->isKeepPixels() || m_is_3D)
+        {
+            return;
+        }
+        for (uint32_t i = 0; i + 2 < nidx; i += 3)
+        {
+            if (pidx[i] >= nvert || pidx[i + 1] >= nvert || pidx[i + 2] >= nvert)
+            {
+                continue;
+            }
+            rasterizeTriangle(pvert[pidx[i]], pvert[pidx[i + 1]], pvert[pidx[i + 2]]);
+        }
+    }
+    void Renderer_Null::rasterizeTriangle(DrawVertex const& v0, DrawVertex const& v1, DrawVertex const& v2)
+    {
+        RenderTarget_Null* p_rt = m_device->getBoundRenderTarget();
+        if (!p_rt || !p_rt->getTextureNull()->getPixels())
+        {
+            return;
+        }
+        Texture2D_Null* p_target = p_rt->getTextureNull();
+        uint8_t* target = p_target->getPixels();
+        Vector2U const target_size = p_target->getSize();
+
+        // Ortho camera and viewport, window coordinates are in GL convention like the pixel rows
+        float const ow = m_ortho.b.x - m_ortho.a.x;
+        float const oh = m_ortho.b.y - m_ortho.a.y;
+        if (ow == 0.0f || oh == 0.0f)
+        {
+            return;
+        }
+        float const vw = m_viewport.b.x - m_viewport.a.x;
+        float const vh = m_viewport.b.y - m_viewport.a.y;
+        auto const to_window = [&](DrawVertex const& v) -> Vector2F
+        {
+            return Vector2F(
+                m_viewport.a.x + (v.x - m_ortho.a.x) / ow * vw,
+                m_viewport.a.y + (v.y - m_ortho.a.y) / oh * vh);
+        };
+        Vector2F const p0 = to_window(v0);
+        Vector2F const p1 = to_window(v1);
+        Vector2F const p2 = to_window(v2);
+        float const area = (p1.x - p0.x) * (p2.y - p0.y) - (p1.y - p0.y) * (p2.x - p0.x);
+        if (std::abs(area) < 1e-6f)
+        {
+            return;
+        }
+
+        float const min_x = std::max({ std::min({ p0.x, p1.x, p2.x }), m_viewport.a.x, 0.0f });
+        float const max_x = std::min({ std::max({ p0.x, p1.x, p2.x }), m_viewport.b.x, (float)target_size.x });
+        float const min_y = std::max({ std::min({ p0.y, p1.y, p2.y }), m_viewport.a.y, 0.0f });
+        float const max_y = std::min({ std::max({ p0.y, p1.y, p2.y }), m_viewport.b.y, (float)target_size.y });
+        if (min_x >= max_x || min_y >= max_y)
+        {
+            return;
+        }
+
+        Texture2D_Null* p_texture = static_cast<Texture2D_Null*>(m_texture.get());
+        uint8_t const* texture = p_texture ? p_texture->getPixels() : nullptr;
+        Vector2U const texture_size = p_texture ? p_texture->getSize() : Vector2U();
+        bool const texture_premul = p_texture ? p_texture->isPremultipliedAlpha() : false;
+        Graphics::SamplerState const sampler = p_texture
+            ? p_texture->getSamplerState().value_or(m_sampler_state[IDX(SamplerState::LinearClamp)])
+            : m_sampler_state[IDX(SamplerState::LinearClamp)];
+
+        RasterColor const c0 = unpackColor(v0.color);
+        RasterColor const c1 = unpackColor(v1.color);
+        RasterColor const c2 = unpackColor(v2.color);
+
+        int const x_begin = (int)std::floor(min_x);
+        int const x_end = (int)std::ceil(max_x);
+        int const y_begin = (int)std::floor(min_y);
+        int const y_end = (int)std::ceil(max_y);
+        for (int py = y_begin; py < y_end; py += 1)
+        {
+            for (int px = x_begin; px < x_end; px += 1)
+            {
+                float const cx = (float)px + 0.5f;
+                float const cy = (float)py + 0.5f;
+                if (cx < m_viewport.a.x || cx >= m_viewport.b.x || cy < m_viewport.a.y || cy >= m_viewport.b.y)
+                {
+                    continue;
+                }
+                float const w0 = ((p2.x - p1.x) * (cy - p1.y) - (p2.y - p1.y) * (cx - p1.x)) / area;
+                float const w1 = ((p0.x - p2.x) * (cy - p2.y) - (p0.y - p2.y) * (cx - p2.x)) / area;
+                float const w2 = 1.0f - w0 - w1;
+                if (w0 < 0.0f || w1 < 0.0f || w2 < 0.0f)
+                {
+                    continue;
+                }
+
+                // Fragment shader
+
+                RasterColor const col{
+                    w0 * c0.r + w1 * c1.r + w2 * c2.r,
+                    w0 * c0.g + w1 * c1.g + w2 * c2.g,
+                    w0 * c0.b + w1 * c1.b + w2 * c2.b,
+                    w0 * c0.a + w1 * c1.a + w2 * c2.a,
+                };
+                RasterColor tex{ 0.0f, 0.0f, 0.0f, 0.0f };
+                if (texture && texture_size.x > 0 && texture_size.y > 0)
+                {
+                    float const u = w0 * v0.u + w1 * v1.u + w2 * v2.u;
+                    float const v = w0 * v0.v + w1 * v1.v + w2 * v2.v;
+                    uint32_t const tx = addressTexel(u, texture_size.x, sampler.address_u);
+                    uint32_t const ty = addressTexel(v, texture_size.y, sampler.address_v);
+                    uint8_t const* texel = texture + ((size_t)ty * texture_size.x + tx) * 4;
+                    tex = RasterColor{ texel[0] / 255.0f, texel[1] / 255.0f, texel[2] / 255.0f, texel[3] / 255.0f };
+                }
+                RasterColor src{};
+                switch (m_vertex_color_blend_state)
+                {
+                case VertexColorBlendState::Zero:
+                    src = tex;
+                    if (!texture_premul)
+                    {
+                        src.r *= src.a; src.g *= src.a; src.b *= src.a;
+                    }
+                    break;
+                case VertexColorBlendState::One:
+                    src = col;
+                    if (!texture_premul)
+                    {
+                        src.r *= src.a; src.g *= src.a; src.b *= src.a;
+                    }
+                    break;
+                case VertexColorBlendState::Add:
+                    src = tex;
+                    if (texture_premul)
+                    {
+                        if (src.a < (1.0f / 255.0f))
+                        {
+                            continue; // discard
+                        }
+                        src.r /= src.a; src.g /= src.a; src.b /= src.a;
+                    }
+                    src.r = std::min(src.r + col.r, 1.0f);
+                    src.g = std::min(src.g + col.g, 1.0f);
+                    src.b = std::min(src.b + col.b, 1.0f);
+                    src.a *= col.a;
+                    src.r *= src.a; src.g *= src.a; src.b *= src.a;
+                    break;
+                default: // Mul, Hue is treated as Mul
+                    src = RasterColor{ tex.r * col.r, tex.g * col.g, tex.b * col.b, tex.a * col.a };
+                    {
+                        float const k = texture_premul ? col.a : src.a;
+                        src.r *= k; src.g *= k; src.b *= k;
+                    }
+                    break;
+                }
+
+                // Output merger
+
+                uint8_t* pixel = target + ((size_t)py * target_size.x + (size_t)px) * 4;
+                RasterColor const dst{ pixel[0] / 255.0f, pixel[1] / 255.0f, pixel[2] / 255.0f, pixel[3] / 255.0f };
+                RasterColor out{};
+                switch (m_blend_state)
+                {
+                case BlendState::Disable:
+                case BlendState::One:
+                    out = src;
+                    break;
+                case BlendState::Min:
+                    out = RasterColor{ std::min(src.r, dst.r), std::min(src.g, dst.g), std::min(src.b, dst.b), std::min(src.a, dst.a) };
+                    break;
+                case BlendState::Max:
+                    out = RasterColor{ std::max(src.r, dst.r), std::max(src.g, dst.g), std::max(src.b, dst.b), std::max(src.a, dst.a) };
+                    break;
+                case BlendState::Add:
+                    out = RasterColor{ src.r + dst.r, src.g + dst.g, src.b + dst.b, src.a + dst.a * (1.0f - src.a) };
+                    break;
+                default: // Alpha
+                    {
+                        float const k = 1.0f - src.a;
+                        out = RasterColor{ src.r + dst.r * k, src.g + dst.g * k, src.b + dst.b * k, src.a + dst.a * k };
+                    }
+                    break;
+                }
+                pixel[0] = packChannel(out.r);
+                pixel[1] = packChannel(out.g);
+                pixel[2] = packChannel(out.b);
+                pixel[3] = packChannel(out.a);
+            }
+        }
+    }
+
+    bool Renderer_Null::saveRecordToFile(StringView path)
+    {
+        commitDrawRequest();
+        std::ofstream file{ std::string(path), std::ios::out | std::ios::trunc };
+        if (!file.is_open())
+        {
+            spdlog::error("[core] Unable to open file '{}'", path);
+            return false;
+        }
+        uint64_t const first = m_record_count > record_capacity ? m_record_count - record_capacity : 0;
+        file << std::format("# records: {}, dropped: {}\n", m_record_count - first, first);
+        file << "# frame type vertex_count index_count texture_id value\n";
+        for (uint64_t i = first; i < m_record_count; i += 1)
+        {
+            Record const& r = m_record[i % record_capacity];
+            file << std::format("{} {} {} {} {} {}\n", r.frame, record_type_name[IDX(r.type)], r.vertex_count, r.index_count, r.texture_id, r.value);
+        }
+        return file.good();
+    }
+
+    bool Renderer_Null::beginBatch()
+    {
+        m_batch_scope = true;
+        m_draw_open = false;
+        return true;
+    }
+    bool Renderer_Null::endBatch()
+    {
+        commitDrawRequest();
+        m_batch_scope = false;
+        pushStateRecord(RecordType::EndBatch, m_draw_call_count);
+        FrameProfiler::get().addCounter("Renderer.DrawCalls", m_draw_call_count);
+        FrameProfiler::get().addCounter("Renderer.RecordedCommands", m_frame_record_count);
+        m_draw_call_count = 0;
+        m_frame_record_count = 0;
+        m_frame += 1;
+        return true;
+    }
+    bool Renderer_Null::flush()
+    {
+        commitDrawRequest();
+        m_draw_open = false;
+        return true;
+    }
+
+    void Renderer_Null::clearRenderTarget(Color4B const& color)
+    {
+        commitDrawRequest();
+        pushStateRecord(RecordType::Clear, (uint32_t)color.r | ((uint32_t)color.g << 8) | ((uint32_t)color.b << 16) | ((uint32_t)color.a << 24));
+        RenderTarget_Null* p_rt = m_device->getBoundRenderTarget();
+        if (p_rt && p_rt->getTextureNull()->getPixels())
+        {
+            Texture2D_Null* p_texture = p_rt->getTextureNull();
+            uint8_t* pixel = p_texture->getPixels();
+            size_t const count = (size_t)p_texture->getSize().x * (size_t)p_texture->getSize().y;
+            for (size_t i = 0; i < count; i += 1, pixel += 4)
+            {
+                pixel[0] = color.r;
+                pixel[1] = color.g;
+                pixel[2] = color.b;
+                pixel[3] = color.a;
+            }
+        }
+    }
+    void Renderer_Null::clearDepthBuffer(float zvalue)
+    {
+        commitDrawRequest();
+        pushStateRecord(RecordType::ClearDepth, (uint32_t)(zvalue * 255.0f));
+    }
+    void Renderer_Null::setRenderAttachment(IRenderTarget* p_rt)
+    {
+        commitDrawRequest();
+        RenderTarget_Null* p_rt_null = static_cast<RenderTarget_Null*>(p_rt);
+        m_device->setBoundRenderTarget(p_rt_null);
+        m_draw_open = false;
+        Record record;
+        record.type = RecordType::RenderTarget;
+        record.frame = m_frame;
+        record.texture_id = p_rt_null ? p_rt_null->getTextureNull()->getId() : 0;
+        pushRecord(record);
+    }
+
+    void Renderer_Null::setOrtho(BoxF const& box)
+    {
+        if (m_is_3D || m_ortho != box)
+        {
+            commitDrawRequest();
+            m_ortho = box;
+            m_is_3D = false;
+            pushStateRecord(RecordType::Camera, 0);
+        }
+    }
+    void Renderer_Null::setPerspective(Vector3F const& eye, Vector3F const& lookat, Vector3F const& headup, float fov, float aspect, float znear, float zfar)
+    {
+        if (!m_is_3D || m_eye != eye || m_lookat != lookat || m_headup != headup || m_fov != fov || m_aspect != aspect || m_znear != znear || m_zfar != zfar)
+        {
+            commitDrawRequest();
+            m_eye = eye;
+            m_lookat = lookat;
+            m_headup = headup;
+            m_fov = fov;
+            m_aspect = aspect;
+            m_znear = znear;
+            m_zfar = zfar;
+            m_is_3D = true;
+            pushStateRecord(RecordType::Camera, 1);
+        }
+    }
+
+    void Renderer_Null::setViewport(BoxF const& box)
+    {
+        if (m_viewport != box)
+        {
+            commitDrawRequest();
+            m_viewport = box;
+            pushStateRecord(RecordType::Viewport, 0);
+        }
+    }
+    void Renderer_Null::setScissorRect(RectF const& rect)
+    {
+        if (m_scissor_rect != rect)
+        {
+            commitDrawRequest();
+            m_scissor_rect = rect;
+            pushStateRecord(RecordType::ScissorRect, 0);
+        }
+    }
+
+    void Renderer_Null::setVertexColorBlendState(VertexColorBlendState state)
+    {
+        if (m_vertex_color_blend_state != state)
+        {
+            commitDrawRequest();
+            m_vertex_color_blend_state = state;
+            pushStateRecord(RecordType::VertexColorBlend, (uint32_t)state);
+        }
+    }
+    void Renderer_Null::setFogState(FogState state, Color4B const& color, float density_or_znear, float zfar)
+    {
+        (void)color;
+        (void)density_or_znear;
+        (void)zfar;
+        if (m_fog_state != state)
+        {
+            commitDrawRequest();
+            m_fog_state = state;
+            pushStateRecord(RecordType::Fog, (uint32_t)state);
+        }
+    }
+    void Renderer_Null::setDepthState(DepthState state)
+    {
+        if (m_depth_state != state)
+        {
+            commitDrawRequest();
+            m_depth_state = state;
+            pushStateRecord(RecordType::Depth, (uint32_t)state);
+        }
+    }
+    void Renderer_Null::setBlendState(BlendState state)
+    {
+        if (m_blend_state != state)
+        {
+            commitDrawRequest();
+            // Alpha and Add share one batch with premultiplied batching, same as the OpenGL renderer
+            bool const shared = isPremulBatch(m_blend_state) && isPremulBatch(state);
+            m_blend_state = state;
+            if (!shared)
+            {
+                pushStateRecord(RecordType::Blend, (uint32_t)state);
+            }
+        }
+    }
+    void Renderer_Null::setTexture(ITexture2D* texture)
+    {
+        if (m_texture.get() != texture)
+        {
+            commitDrawRequest();
+            m_texture = texture;
+            m_texture_id = texture ? static_cast<Texture2D_Null*>(texture)->getId() : 0;
+        }
+    }
+
+    bool Renderer_Null::drawTriangle(DrawVertex const& v1, DrawVertex const& v2, DrawVertex const& v3)
+    {
+        DrawVertex const vert[3] = { v1, v2, v3 };
+        return drawTriangle(vert);
+    }
+    bool Renderer_Null::drawTriangle(DrawVertex const* pvert)
+    {
+        static DrawIndex const idx[3] = { 0, 1, 2 };
+        return drawRaw(pvert, (uint16_t)3, idx, (uint16_t)3);
+    }
+    bool Renderer_Null::drawQuad(DrawVertex const& v1, DrawVertex const& v2, DrawVertex const& v3, DrawVertex const& v4)
+    {
+        DrawVertex const vert[4] = { v1, v2, v3, v4 };
+        return drawQuad(vert);
+    }
+    bool Renderer_Null::drawQuad(DrawVertex const* pvert)
+    {
+        static DrawIndex const idx[6] = { 0, 1, 2, 0, 2, 3 };
+        return drawRaw(pvert, (uint16_t)4, idx, (uint16_t)6);
+    }
+    bool Renderer_Null::drawRaw(DrawVertex const* pvert, uint16_t nvert, DrawIndex const* pidx, uint16_t nidx)
+    {
+        commitDrawRequest();
+        if (m_bundle_capture)
+        {
+            captureDraw(pvert, nvert, pidx, nidx);
+            return true;
+        }
+        recordDraw(nvert, nidx);
+        rasterize(pvert, nvert, pidx, nidx);
+        return true;
+    }
+    bool Renderer_Null::drawRequest(uint16_t nvert, uint16_t nidx, DrawVertex** ppvert, DrawIndex** ppidx, uint16_t* idxoffset)
+    {
+        commitDrawRequest();
+        if (!m_bundle_capture)
+        {
+            recordDraw(nvert, nidx);
+        }
+        m_request_vertex.resize(nvert);
+        m_request_index.resize(nidx);
+        *ppvert = m_request_vertex.data();
+        *ppidx = m_request_index.data();
+        *idxoffset = 0;
+        m_request_pending = m_bundle_capture || m_device->isKeepPixels();
+        m_request_index32_pending = false;
+        return true;
+    }
+    bool Renderer_Null::drawRaw(DrawVertex const* pvert, uint32_t nvert, DrawIndex32 const* pidx, uint32_t nidx)
+    {
+        commitDrawRequest();
+        if (m_bundle_capture)
+        {
+            captureDraw(pvert, nvert, pidx, nidx);
+            return true;
+        }
+        recordDraw(nvert, nidx);
+        rasterize(pvert, nvert, pidx, nidx);
+        return true;
+    }
+    bool Renderer_Null::drawRequest(uint32_t nvert, uint32_t nidx, DrawVertex** ppvert, DrawIndex32** ppidx, uint32_t* idxoffset)
+    {
+        commitDrawRequest();
+        if (!m_bundle_capture)
+        {
+            recordDraw(nvert, nidx);
+        }
+        m_request_vertex.resize(nvert);
+        m_request_index32.resize(nidx);
+        *ppvert = m_request_vertex.data();
+        *ppidx = m_request_index32.data();
+        *idxoffset = 0;
+        m_request_pending = m_bundle_capture || m_device->isKeepPixels();
+        m_request_index32_pending = true;
+        return true;
+    }
+    bool Renderer_Null::drawSpriteInstances(ITexture2D* texture, SpriteInstanceRect const* rects, size_t rect_count, SpriteInstance const* instances, size_t count)
+    {
+        if (!texture || !rects || rect_count == 0 || rect_count > SpriteInstanceMaxRectCount || (count > 0 && !instances))
+        {
+            assert(false); return false;
+        }
+        if (count == 0)
+        {
+            return true;
+        }
+        if (m_bundle_capture)
+        {
+            return drawSpriteInstancesAsQuads(this, texture, rects, rect_count, instances, count);
+        }
+        commitDrawRequest();
+        FrameProfiler::get().addCounter("Renderer.SpriteInstances", (int64_t)count);
+        m_draw_open = false;
+        Record record;
+        record.type = RecordType::SpriteInstances;
+        record.frame = m_frame;
+        record.vertex_count = (uint32_t)(count * 4);
+        record.index_count = (uint32_t)(count * 6);
+        record.texture_id = static_cast<Texture2D_Null*>(texture)->getId();
+        record.value = (uint32_t)count;
+        pushRecord(record);
+        m_draw_call_count += 1;
+
+        if (m_device->isKeepPixels() && !m_is_3D)
+        {
+            // Expand instances to quads the same way as the instancing vertex shader
+            ScopeObject<ITexture2D> last_texture(m_texture);
+            m_texture = texture;
+            static DrawIndex const idx[6] = { 0, 1, 2, 0, 2, 3 };
+            static float const corner[4][2] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } };
+            for (size_t i = 0; i < count; i += 1)
+            {
+                SpriteInstance const& s = instances[i];
+                if (s.rect >= rect_count)
+                {
+                    continue;
+                }
+                SpriteInstanceRect const& rc = rects[s.rect];
+                float const sinv = std::sin(s.rotation);
+                float const cosv = std::cos(s.rotation);
+                DrawVertex vert[4];
+                for (size_t j = 0; j < 4; j += 1)
+                {
+                    float const ox = (rc.pos.a.x + (rc.pos.b.x - rc.pos.a.x) * corner[j][0]) * s.hscale;
+                    float const oy = (rc.pos.a.y + (rc.pos.b.y - rc.pos.a.y) * corner[j][1]) * s.vscale;
+                    vert[j] = DrawVertex(
+                        s.x + ox * cosv - oy * sinv,
+                        s.y + ox * sinv + oy * cosv,
+                        s.z,
+                        rc.uv.a.x + (rc.uv.b.x - rc.uv.a.x) * corner[j][0],
+                        rc.uv.a.y + (rc.uv.b.y - rc.uv.a.y) * corner[j][1],
+                        s.color);
+                }
+                rasterize(vert, 4u, idx, 6u);
+            }
+            m_texture = last_texture;
+        }
+        return true;
+    }
+
+    bool Renderer_Null::beginBundle()
+    {
+        if (m_bundle_capture)
+        {
+            spdlog::error("[core] A render bundle is already being recorded");
+            return false;
+        }
+        commitDrawRequest();
+        try
+        {
+            m_bundle_capture.attach(new RenderBundle_Null());
+        }
+        catch (...)
+        {
+            return false;
+        }
+        m_draw_open = false;
+        return true;
+    }
+    bool Renderer_Null::endBundle(IRenderBundle** pp_bundle)
+    {
+        *pp_bundle = nullptr;
+        if (!m_bundle_capture)
+        {
+            spdlog::error("[core] No render bundle is being recorded");
+            return false;
+        }
+        commitDrawRequest();
+        *pp_bundle = m_bundle_capture.detach();
+        return true;
+    }
+    bool Renderer_Null::drawBundle(IRenderBundle* p_bundle, RenderBundleTransform const& transform)
+    {
+        if (!p_bundle)
+        {
+            assert(false); return false;
+        }
+        if (m_bundle_capture)
+        {
+            spdlog::error("[core] Render bundles cannot be recorded into another render bundle");
+            return false;
+        }
+        auto* bundle = static_cast<RenderBundle_Null*>(p_bundle);
+        if (bundle->command.empty())
+        {
+            return true;
+        }
+        commitDrawRequest();
+        FrameProfiler::get().addCounter("Renderer.BundleDraws", 1);
+        m_draw_open = false;
+        Record record;
+        record.type = RecordType::Bundle;
+        record.frame = m_frame;
+        record.vertex_count = bundle->getVertexCount();
+        record.index_count = bundle->getIndexCount();
+        record.texture_id = bundle->command[0].texture ? static_cast<Texture2D_Null*>(bundle->command[0].texture.get())->getId() : 0;
+        record.value = bundle->getCommandCount();
+        pushRecord(record);
+        m_draw_call_count += bundle->getCommandCount();
+
+        if (m_device->isKeepPixels() && !m_is_3D)
+        {
+            // Scale, rotate around the z-axis, then translate, same as the OpenGL renderer
+            float const sinv = std::sin(transform.rotation);
+            float const cosv = std::cos(transform.rotation);
+            std::vector<DrawVertex> vert(bundle->vertex);
+            for (auto& v : vert)
+            {
+                float const x = v.x * transform.scale.x;
+                float const y = v.y * transform.scale.y;
+                v.x = transform.position.x + x * cosv - y * sinv;
+                v.y = transform.position.y + x * sinv + y * cosv;
+                v.z = transform.position.z + v.z * transform.scale.z;
+            }
+            ScopeObject<ITexture2D> const last_texture(m_texture);
+            VertexColorBlendState const last_vertex_color_blend_state = m_vertex_color_blend_state;
+            BlendState const last_blend_state = m_blend_state;
+            for (auto const& cmd : bundle->command)
+            {
+                m_texture = cmd.texture;
+                m_vertex_color_blend_state = cmd.vertex_color_blend_state;
+                m_blend_state = cmd.blend_state;
+                rasterize(vert.data() + cmd.vertex_offset, (uint32_t)(vert.size() - cmd.vertex_offset),
+                    bundle->index.data() + cmd.index_offset, cmd.index_count);
+            }
+            m_texture = last_texture;
+            m_vertex_color_blend_state = last_vertex_color_blend_state;
+            m_blend_state = last_blend_state;
+        }
+        return true;
+    }
+
+    bool Renderer_Null::createPostEffectShader(StringView path, IPostEffectShader** pp_effect)
+    {
+        (void)path;
+        try
+        {
+            *pp_effect = new PostEffectShader_Null();
+            return true;
+        }
+        catch (...)
+        {
+            *pp_effect = nullptr;
+            return false;
+        }
+    }
+    bool Renderer_Null::drawPostEffect(
+        IPostEffectShader* p_effect,
+        BlendState blend,
+        ITexture2D* p_tex, SamplerState rtsv,
+        Vector4F const* cv, size_t cv_n,
+        ITexture2D* const* p_tex_arr, SamplerState const* sv, size_t tv_sv_n)
+    {
+        (void)p_effect;
+        (void)rtsv;
+        (void)cv;
+        (void)cv_n;
+        (void)p_tex_arr;
+        (void)sv;
+        (void)tv_sv_n;
+        commitDrawRequest();
+        m_draw_open = false;
+        Record record;
+        record.type = RecordType::PostEffect;
+        record.frame = m_frame;
+        record.vertex_count = 4;
+        record.index_count = 6;
+        record.texture_id = p_tex ? static_cast<Texture2D_Null*>(p_tex)->getId() : 0;
+        record.value = (uint32_t)blend;
+        pushRecord(record);
+        m_draw_call_count += 1;
+        return true;
+    }
+    bool Renderer_Null::drawPostEffect(IPostEffectShader* p_effect, BlendState blend)
+    {
+        return drawPostEffect(p_effect, blend, nullptr, SamplerState::LinearClamp, nullptr, 0, nullptr, nullptr, 0);
+    }
+
+    bool Renderer_Null::createModel(StringView path, IModel** pp_model)
+    {
+        (void)path;
+        try
+        {
+            *pp_model = new Model_Null();
+            return true;
+        }
+        catch (...)
+        {
+            *pp_model = nullptr;
+            return false;
+        }
+    }
+    bool Renderer_Null::drawModel(IModel* p_model)
+    {
+        if (!p_model)
+        {
+            assert(false); return false;
+        }
+        commitDrawRequest();
+        pushStateRecord(RecordType::Model, 0);
+        m_draw_call_count += 1;
+        return true;
+    }
+
+    Graphics::SamplerState Renderer_Null::getKnownSamplerState(SamplerState state)
+    {
+        return m_sampler_state[IDX(state)];
+    }
+
+    Renderer_Null::Renderer_Null(Device_Null* p_device)
+        : m_device(p_device)
+        , m_record(record_capacity)
+    {
+        // Same table as the OpenGL renderer
+
+        m_sampler_state[IDX(SamplerState::PointWrap)].filter = Filter(FilterMode::Nearest, FilterMode::Nearest);
+        m_sampler_state[IDX(SamplerState::PointWrap)].address_u = TextureAddressMode::Wrap;
+        m_sampler_state[IDX(SamplerState::PointWrap)].address_v = TextureAddressMode::Wrap;
+
+        m_sampler_state[IDX(SamplerState::PointClamp)].filter = Filter(FilterMode::Nearest, FilterMode::Nearest);
+        m_sampler_state[IDX(SamplerState::PointClamp)].address_u = TextureAddressMode::Clamp;
+        m_sampler_state[IDX(SamplerState::PointClamp)].address_v = TextureAddressMode::Clamp;
+
+        m_sampler_state[IDX(SamplerState::PointBorderBlack)].filter = Filter(FilterMode::Nearest, FilterMode::Nearest);
+        m_sampler_state[IDX(SamplerState::PointBorderBlack)].address_u = TextureAddressMode::Border;
+        m_sampler_state[IDX(SamplerState::PointBorderBlack)].address_v = TextureAddressMode::Border;
+        m_sampler_state[IDX(SamplerState::PointBorderBlack)].border_color = BorderColor::Black;
+
+        m_sampler_state[IDX(SamplerState::PointBorderWhite)].filter = Filter(FilterMode::Nearest, FilterMode::Nearest);
+        m_sampler_state[IDX(SamplerState::PointBorderWhite)].address_u = TextureAddressMode::Border;
+        m_sampler_state[IDX(SamplerState::PointBorderWhite)].address_v = TextureAddressMode::Border;
+        m_sampler_state[IDX(SamplerState::PointBorderWhite)].border_color = BorderColor::White;
+
+        m_sampler_state[IDX(SamplerState::LinearWrap)].filter = Filter(FilterMode::Linear, FilterMode::Linear);
+        m_sampler_state[IDX(SamplerState::LinearWrap)].address_u = TextureAddressMode::Wrap;
+        m_sampler_state[IDX(SamplerState::LinearWrap)].address_v = TextureAddressMode::Wrap;
+
+        m_sampler_state[IDX(SamplerState::LinearClamp)].filter = Filter(FilterMode::Linear, FilterMode::Linear);
+        m_sampler_state[IDX(SamplerState::LinearClamp)].address_u = TextureAddressMode::Clamp;
+        m_sampler_state[IDX(SamplerState::LinearClamp)].address_v = TextureAddressMode::Clamp;
+
+        m_sampler_state[IDX(SamplerState::LinearBorderBlack)].filter = Filter(FilterMode::Linear, FilterMode::Linear);
+        m_sampler_state[IDX(SamplerState::LinearBorderBlack)].address_u = TextureAddressMode::Border;
+        m_sampler_state[IDX(SamplerState::LinearBorderBlack)].address_v = TextureAddressMode::Border;
+        m_sampler_state[IDX(SamplerState::LinearBorderBlack)].border_color = BorderColor::Black;
+
+        m_sampler_state[IDX(SamplerState::LinearBorderWhite)].filter = Filter(FilterMode::Linear, FilterMode::Linear);
+        m_sampler_state[IDX(SamplerState::LinearBorderWhite)].address_u = TextureAddressMode::Border;
+        m_sampler_state[IDX(SamplerState::LinearBorderWhite)].address_v = TextureAddressMode::Border;
+        m_sampler_state[IDX(SamplerState::LinearBorderWhite)].border_color = BorderColor::White;
+    }
+    Renderer_Null::~Renderer_Null() = default;
+
+    bool Renderer_Null::create(Device_Null* p_device, Renderer_Null** pp_renderer)
+    {
+        try
+        {
+            *pp_renderer = new Renderer_Null(p_device);
+            return true;
+        }
+        catch (...)
+        {
+            *pp_renderer = nullptr;
+            return false;
+        }
+    }
+}
@@ -0,0 +1,219 @@
+#pragma once
+#include "Core/Object.hpp"
+#include "Core/Graphics/Renderer.hpp"
+#include "Core/Graphics/Device_Null.hpp"
+#include <vector>
+
+#define IDX(x) (size_t)static_cast<uint8_t>(x)
+
+namespace Core::Graphics
+{
+	class PostEffectShader_Null : public Object<IPostEffectShader>
+	{
+	public:
+		bool setFloat(StringView, float) { return true; }
+		bool setFloat2(StringView, Vector2F) { return true; }
+		bool setFloat3(StringView, Vector3F) { return true; }
+		bool setFloat4(StringView, Vector4F) { return true; }
+		bool setTexture2D(StringView, ITexture2D*) { return true; }
+		bool apply(IRenderer*) { return true; }
+	};
+
+	class Model_Null : public Object<IModel>
+	{
+	public:
+		void setAmbient(Vector3F const&, float) {}
+		void setDirectionalLight(Vector3F const&, Vector3F const&, float) {}
+
+		void setScaling(Vector3F const&) {}
+		void setPosition(Vector3F const&) {}
+		void setRotationRollPitchYaw(float, float, float) {}
+		void setRotationQuaternion(Vector4F const&) {}
+	};
+
+	// Draws recorded between IRenderer::beginBundle and IRenderer::endBundle, replayed as one Bundle record
+	class RenderBundle_Null : public Object<IRenderBundle>
+	{
+	public:
+		struct Command
+		{
+			ScopeObject<ITexture2D> texture;
+			uint32_t vertex_offset{ 0 }; // Base vertex
+			uint32_t index_offset{ 0 };
+			uint32_t index_count{ 0 };
+			IRenderer::VertexColorBlendState vertex_color_blend_state{ IRenderer::VertexColorBlendState::Mul };
+			IRenderer::BlendState blend_state{ IRenderer::BlendState::Alpha };
+		};
+
+		std::vector<IRenderer::DrawVertex> vertex;
+		std::vector<IRenderer::DrawIndex32> index;
+		std::vector<Command> command;
+
+	public:
+		uint32_t getVertexCount() { return (uint32_t)vertex.size(); }
+		uint32_t getIndexCount() { return (uint32_t)index.size(); }
+		uint32_t getCommandCount() { return (uint32_t)command.size(); }
+	};
+
+	// Renderer of the headless backend. Instead of drawing, it records commands into a ring buffer:
+	// consecutive draws with the same texture and render states are merged into one Draw record,
+	// which is what the OpenGL renderer would submit as one draw call, and state changes are recorded
+	// only when the value changes.
+	// With the software rasterizer enabled, 2D draws (ortho camera) are also rasterized into the bound
+	// render target, nearest sampling only, fog and depth test are ignored, and blend states other than
+	// Disable, Alpha, One, Min, Max and Add fall back to Alpha.
+	class Renderer_Null : public Object<IRenderer>
+	{
+	public:
+		enum class RecordType : uint8_t
+		{
+			Clear,
+			ClearDepth,
+			RenderTarget,
+			Camera,
+			Viewport,
+			ScissorRect,
+			VertexColorBlend,
+			Fog,
+			Depth,
+			Blend,
+			Draw,
+			SpriteInstances,
+			PostEffect,
+			Model,
+			Bundle,
+			EndBatch,
+		};
+		struct Record
+		{
+			RecordType type{ RecordType::Draw };
+			uint32_t frame{ 0 };
+			uint32_t vertex_count{ 0 };
+			uint32_t index_count{ 0 };
+			uint64_t texture_id{ 0 };
+			uint32_t value{ 0 }; // New state value, clear color, instance count or bundle command count
+		};
+		static constexpr size_t record_capacity = 65536;
+
+	private:
+		ScopeObject<Device_Null> m_device;
+
+		std::vector<Record> m_record;
+		uint64_t m_record_count{ 0 };
+		uint32_t m_frame{ 0 };
+		uint32_t m_draw_call_count{ 0 };
+		uint32_t m_frame_record_count{ 0 };
+		bool m_draw_open{ false };
+		bool m_batch_scope{ false };
+
+		BoxF m_ortho = { 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f };
+		Vector3F m_eye = { 0.0f, 0.0f, 0.0f };
+		Vector3F m_lookat = { 0.0f, 0.0f, 1.0f };
+		Vector3F m_headup = { 0.0f, 1.0f, 0.0f };
+		float m_fov = 0.0f;
+		float m_aspect = 0.0f;
+		float m_znear = 0.0f;
+		float m_zfar = 0.0f;
+		bool m_is_3D = false;
+		BoxF m_viewport = { 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f };
+		RectF m_scissor_rect = { 0.0f, 0.0f, 1.0f, 1.0f };
+		VertexColorBlendState m_vertex_color_blend_state{ VertexColorBlendState::Mul };
+		FogState m_fog_state{ FogState::Disable };
+		DepthState m_depth_state{ DepthState::Disable };
+		BlendState m_blend_state{ BlendState::Alpha };
+		ScopeObject<ITexture2D> m_texture;
+		uint64_t m_texture_id{ 0 };
+		bool m_premul_batching{ false };
+		DrawListConfig m_draw_list_config;
+		Graphics::SamplerState m_sampler_state[IDX(SamplerState::MAX_COUNT)];
+
+		// Storage handed out by drawRequest, committed on the next call into the renderer
+		std::vector<DrawVertex> m_request_vertex;
+		std::vector<DrawIndex> m_request_index;
+		std::vector<DrawIndex32> m_request_index32;
+		bool m_request_pending{ false };
+		bool m_request_index32_pending{ false };
+
+		ScopeObject<RenderBundle_Null> m_bundle_capture;
+
+	private:
+		void pushRecord(Record const& record);
+		void pushStateRecord(RecordType type, uint32_t value);
+		void recordDraw(uint32_t nvert, uint32_t nidx);
+		void commitDrawRequest();
+		template<typename T>
+		void captureDraw(DrawVertex const* pvert, uint32_t nvert, T const* pidx, uint32_t nidx);
+		template<typename T>
+		void rasterize(DrawVertex const* pvert, uint32_t nvert, T const* pidx, uint32_t nidx);
+		void rasterizeTriangle(DrawVertex const& v0, DrawVertex const& v1, DrawVertex const& v2);
+		bool isPremulBatch(BlendState state) const noexcept;
+
+	public:
+		uint64_t getRecordCount() const noexcept { return m_record_count; }
+		// Writes the commands still in the ring buffer as text, one record per line
+		bool saveRecordToFile(StringView path);
+
+	public:
+		bool beginBatch();
+		bool endBatch();
+		bool isBatchScope() { return m_batch_scope; }
+		bool flush();
+
+		void clearRenderTarget(Color4B const& color);
+		void clearDepthBuffer(float zvalue);
+		void setRenderAttachment(IRenderTarget* p_rt);
+
+		void setOrtho(BoxF const& box);
+		void setPerspective(Vector3F const& eye, Vector3F const& lookat, Vector3F const& headup, float fov, float aspect, float znear, float zfar);
+
+		BoxF getViewport() { return m_viewport; }
+		void setViewport(BoxF const& box);
+		void setScissorRect(RectF const& rect);
+		void setViewportAndScissorRect() {}
+
+		void setVertexColorBlendState(VertexColorBlendState state);
+		void setFogState(FogState state, Color4B const& color, float density_or_znear, float zfar);
+		void setDepthState(DepthState state);
+		void setBlendState(BlendState state);
+		void setTexture(ITexture2D* texture);
+		void setPremultipliedBatching(bool enable) { m_premul_batching = enable; }
+		bool getPremultipliedBatching() { return m_premul_batching; }
+
+		bool drawTriangle(DrawVertex const& v1, DrawVertex const& v2, DrawVertex const& v3);
+		bool drawTriangle(DrawVertex const* pvert);
+		bool drawQuad(DrawVertex const& v1, DrawVertex const& v2, DrawVertex const& v3, DrawVertex const& v4);
+		bool drawQuad(DrawVertex const* pvert);
+		bool drawRaw(DrawVertex const* pvert, uint16_t nvert, DrawIndex const* pidx, uint16_t nidx);
+		bool drawRequest(uint16_t nvert, uint16_t nidx, DrawVertex** ppvert, DrawIndex** ppidx, uint16_t* idxoffset);
+		bool drawRaw(DrawVertex const* pvert, uint32_t nvert, DrawIndex32 const* pidx, uint32_t nidx);
+		bool drawRequest(uint32_t nvert, uint32_t nidx, DrawVertex** ppvert, DrawIndex32** ppidx, uint32_t* idxoffset);
+		void setDrawListConfig(DrawListConfig const& config) { m_draw_list_config = config; }
+		DrawListConfig getDrawListConfig() { return m_draw_list_config; }
+		bool drawSpriteInstances(ITexture2D* texture, SpriteInstanceRect const* rects, size_t rect_count, SpriteInstance const* instances, size_t count);
+		bool beginBundle();
+		bool endBundle(IRenderBundle** pp_bundle);
+		bool isBundleScope() { return m_bundle_capture.get() != nullptr; }
+		bool drawBundle(IRenderBundle* p_bundle, RenderBundleTransform const& transform);
+
+		bool createPostEffectShader(StringView path, IPostEffectShader** pp_effect);
+		bool drawPostEffect(
+			IPostEffectShader* p_effect,
+			BlendState blend,
+			ITexture2D* p_tex, SamplerState rtsv,
+			Vector4F const* cv, size_t cv_n,
+			ITexture2D* const* p_tex_arr, SamplerState const* sv, size_t tv_sv_n);
+		bool drawPostEffect(IPostEffectShader* p_effect, BlendState blend);
+
+		bool createModel(StringView path, IModel** pp_model);
+		bool drawModel(IModel* p_model);
+
+		Graphics::SamplerState getKnownSamplerState(SamplerState state);
+
+	public:
+		Renderer_Null(Device_Null* p_device);
+		~Renderer_Null();
+
+	public:
+		static bool create(Device_Null* p_device, Renderer_Null** pp_renderer);
+	};
+}
@@ -4,6 +4,7 @@
 #include "Core/Graphics/Model_OpenGL.hpp"
 #include "Core/Graphics/Renderer.hpp"
 #include "Core/Type.hpp"
+#include "Core/FrameProfiler.hpp"
 #include "TracyOpenGL.hpp"
 #include "glad/gl.h"
 #include "glm/glm.hpp"
@@ -12,9 +13,11 @@
 #include "spdlog/spdlog.h"
 #include <cstdint>
 #include <optional>
+#include <algorithm>
 
 #define IDX(x) (size_t)static_cast<uint8_t>(x)
 using DrawIndex = uint16_t;
+using DrawIndex32 = uint32_t;
 
 
 namespace Core::Graphics
@@ -36,6 +39,137 @@ namespace Core::Graphics
         return get_view(static_cast<Texture2D_OpenGL*>(p.get()));
     }
 
+    inline glm::mat4 makeViewProjection(CameraStateSet const& camera)
+    {
+        if (!camera.is_3D)
+        {
+            BoxF const& box = camera.ortho;
+            return glm::orthoLH_ZO(box.a.x, box.b.x, box.a.y, box.b.y, box.a.z, box.b.z);
+        }
+        glm::vec3 const eyef3(camera.eye.x, -camera.eye.y, camera.eye.z);
+        glm::vec3 const lookatf3(camera.lookat.x, -camera.lookat.y, camera.lookat.z);
+        glm::vec3 const headupf3(camera.headup.x, camera.headup.y, camera.headup.z);
+        return glm::scale(glm::perspectiveLH_ZO(camera.fov, camera.aspect, camera.znear, camera.zfar) * glm::lookAtLH(eyef3, lookatf3, headupf3), glm::vec3(1, -1, 1));
+    }
+
+    inline bool isSameSamplerState(Graphics::SamplerState const& a, Graphics::SamplerState const& b)
+    {
+        return a.filter.min == b.filter.min
+            && a.filter.mag == b.filter.mag
+            && a.address_u == b.address_u
+            && a.address_v == b.address_v
+            && a.mip_lod_bias == b.mip_lod_bias
+            && a.max_anisotropy == b.max_anisotropy
+            && a.min_lod == b.min_lod
+            && a.max_lod == b.max_lod
+            && a.border_color == b.border_color;
+    }
+    GLuint createSamplerObject(Graphics::SamplerState const& state)
+    {
+        GLuint sampler = 0;
+        glGenSamplers(1, &sampler);
+        glSamplerParameterf(sampler, GL_TEXTURE_MAX_ANISOTROPY_EXT, (float)state.max_anisotropy);
+        switch (state.filter.min)
+        {
+        case FilterMode::Nearest:
+            glSamplerParameteri(sampler, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            break;
+        case FilterMode::NearestMipNearest:
+            glSamplerParameteri(sampler, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+            break;
+        case FilterMode::NearestMipLinear:
+            glSamplerParameteri(sampler, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_LINEAR);
+            break;
+        case FilterMode::Linear:
+            glSamplerParameteri(sampler, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            break;
+        case FilterMode::LinearMipNearest:
+            glSamplerParameteri(sampler, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_NEAREST);
+            break;
+        case FilterMode::LinearMipLinear:
+            glSamplerParameteri(sampler, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+            break;
+        }
+        switch (state.filter.mag)
+        {
+        default:
+            assert(false);
+            break;
+        case FilterMode::Nearest:
+            glSamplerParameteri(sampler, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            break;
+        case FilterMode::Linear:
+            glSamplerParameteri(sampler, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            break;
+        }
+
+        switch (state.address_u)
+        {
+        case TextureAddressMode::Wrap:
+            glSamplerParameteri(sampler, GL_TEXTURE_WRAP_S, GL_REPEAT);
+            break;
+        case TextureAddressMode::Mirror:
+            glSamplerParameteri(sampler, GL_TEXTURE_WRAP_S, GL_MIRRORED_REPEAT);
+            break;
+        case TextureAddressMode::Clamp:
+            glSamplerParameteri(sampler, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            break;
+        case TextureAddressMode::Border:
+            glSamplerParameteri(sampler, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+            break;
+        }
+        switch (state.address_v)
+        {
+        case TextureAddressMode::Wrap:
+            glSamplerParameteri(sampler, GL_TEXTURE_WRAP_T, GL_REPEAT);
+            break;
+        case TextureAddressMode::Mirror:
+            glSamplerParameteri(sampler, GL_TEXTURE_WRAP_T, GL_MIRRORED_REPEAT);
+            break;
+        case TextureAddressMode::Clamp:
+            glSamplerParameteri(sampler, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            break;
+        case TextureAddressMode::Border:
+            glSamplerParameteri(sampler, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+            break;
+        }
+
+        if (state.address_u == TextureAddressMode::Border || state.address_v == TextureAddressMode::Border)
+        {
+            float borderColor[4];
+        #define makeColor(r, g, b, a) \
+            borderColor[0] = r;\
+            borderColor[1] = g;\
+            borderColor[2] = b;\
+            borderColor[3] = a;
+
+            switch (state.border_color)
+            {
+            case BorderColor::Black:
+                makeColor(0.0f, 0.0f, 0.0f, 0.0f);
+                break;
+            case BorderColor::OpaqueBlack:
+                makeColor(0.0f, 0.0f, 0.0f, 1.0f);
+                break;
+            case BorderColor::TransparentWhite:
+                makeColor(1.0f, 1.0f, 1.0f, 0.0f);
+                break;
+            case BorderColor::White:
+                makeColor(1.0f, 1.0f, 1.0f, 1.0f);
+                break;
+            }
+
+        #undef makeColor
+            glSamplerParameterfv(sampler, GL_TEXTURE_BORDER_COLOR, &borderColor[0]);
+        }
+
+        glSamplerParameterf(sampler, GL_TEXTURE_LOD_BIAS, state.mip_lod_bias);
+        glSamplerParameteri(sampler, GL_TEXTURE_COMPARE_FUNC, GL_NEVER);
+        glSamplerParameterf(sampler, GL_TEXTURE_MIN_LOD, state.min_lod);
+        glSamplerParameterf(sampler, GL_TEXTURE_MAX_LOD, state.max_lod);
+        return sampler;
+    }
+
     // inline GLuint get_sampler(ISamplerState* p_sampler)
     // {
     // 	return static_cast<SamplerState_OpenGL*>(p_sampler)->GetState();
@@ -137,8 +271,7 @@ namespace Core::Graphics
         for (auto& v : m_texture2d_map)
         {
             auto p_custom = v.second.texture->getSamplerState();
-            glActiveTexture(GL_TEXTURE0 + v.second.index);
-            glBindTexture(GL_TEXTURE_2D, v.second.texture->GetResource());
+            static_cast<Renderer_OpenGL*>(p_renderer)->bindTexture(v.second.index, v.second.texture->GetResource());
             static_cast<Renderer_OpenGL*>(p_renderer)->setSamplerState(p_custom.value_or(p_sampler), v.second.index);
         }
 
@@ -166,6 +299,116 @@ namespace Core::Graphics
     }
 }
 
+namespace Core::Graphics
+{
+    bool RenderBundle_OpenGL::isSameState(RendererStateSet const& a, RendererStateSet const& b)
+    {
+        return a.vertex_color_blend_state == b.vertex_color_blend_state
+            && a.fog_state == b.fog_state
+            && a.fog_color == b.fog_color
+            && a.fog_near_or_density == b.fog_near_or_density
+            && a.fog_far == b.fog_far
+            && a.depth_state == b.depth_state
+            && a.blend_state == b.blend_state;
+    }
+    void RenderBundle_OpenGL::append(Texture2D_OpenGL* texture, RendererStateSet const& state,
+        IRenderer::DrawVertex const* vertex, size_t vertex_count, void const* index, bool index32, size_t index_count)
+    {
+        uint32_t const base = (uint32_t)m_vertex.size();
+        uint32_t offset = 0;
+        if (!m_command.empty() && m_command.back().texture.get() == texture && isSameState(m_command.back().state, state))
+        {
+            // Same texture and states, continue the last command with 32-bit indices
+            offset = base - m_command.back().vertex_offset;
+        }
+        else
+        {
+            Command cmd_;
+            cmd_.texture = texture;
+            cmd_.vertex_offset = base;
+            cmd_.index_offset = (uint32_t)m_index.size();
+            cmd_.state = state;
+            m_command.emplace_back(std::move(cmd_));
+        }
+        m_vertex.insert(m_vertex.end(), vertex, vertex + vertex_count);
+        m_index.reserve(m_index.size() + index_count);
+        if (index32)
+        {
+            auto const* p = static_cast<IRenderer::DrawIndex32 const*>(index);
+            for (size_t i = 0; i < index_count; i += 1)
+                m_index.push_back(offset + p[i]);
+        }
+        else
+        {
+            auto const* p = static_cast<IRenderer::DrawIndex const*>(index);
+            for (size_t i = 0; i < index_count; i += 1)
+                m_index.push_back(offset + p[i]);
+        }
+        m_command.back().index_count += (uint32_t)index_count;
+    }
+    bool RenderBundle_OpenGL::createResources()
+    {
+        using DrawVertex = IRenderer::DrawVertex;
+        destroyResources();
+        if (m_command.empty())
+        {
+            return true;
+        }
+        glGenVertexArrays(1, &m_vao);
+        glGenBuffers(1, &m_vertex_buffer);
+        glGenBuffers(1, &m_index_buffer);
+        if (m_vao == 0 || m_vertex_buffer == 0 || m_index_buffer == 0)
+        {
+            destroyResources();
+            return false;
+        }
+        // Same layout as the renderer's vertex array
+        glBindVertexArray(m_vao);
+        glBindBuffer(GL_ARRAY_BUFFER, m_vertex_buffer);
+        glBufferData(GL_ARRAY_BUFFER, m_vertex.size() * sizeof(DrawVertex), m_vertex.data(), GL_STATIC_DRAW);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_index_buffer);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_index.size() * sizeof(IRenderer::DrawIndex32), m_index.data(), GL_STATIC_DRAW);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(DrawVertex), (const GLvoid *)0);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(DrawVertex), (const GLvoid *)offsetof(DrawVertex, u));
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(DrawVertex), (const GLvoid *)offsetof(DrawVertex, color));
+        glEnableVertexAttribArray(2);
+        return true;
+    }
+    void RenderBundle_OpenGL::destroyResources()
+    {
+        glDeleteVertexArrays(1, &m_vao);
+        glDeleteBuffers(1, &m_vertex_buffer);
+        glDeleteBuffers(1, &m_index_buffer);
+        m_vao = 0;
+        m_vertex_buffer = 0;
+        m_index_buffer = 0;
+    }
+    void RenderBundle_OpenGL::onDeviceCreate()
+    {
+        if (!createResources())
+        {
+            spdlog::error("[core] Unable to recreate render bundle buffers");
+        }
+    }
+    void RenderBundle_OpenGL::onDeviceDestroy()
+    {
+        destroyResources();
+    }
+
+    RenderBundle_OpenGL::RenderBundle_OpenGL(Device_OpenGL* p_device)
+        : m_device(p_device)
+    {
+        m_device->addEventListener(this);
+    }
+    RenderBundle_OpenGL::~RenderBundle_OpenGL()
+    {
+        m_device->removeEventListener(this);
+        destroyResources();
+    }
+}
+
 namespace Core::Graphics
 {
     void Renderer_OpenGL::setVertexIndexBuffer(size_t index)
@@ -189,6 +432,7 @@ namespace Core::Graphics
         ZoneScoped;
         TracyGpuZone("UploadVertexIndexBuffer");
         glBindVertexArray(_vao);
+        _gl_call_count += 1;
         auto& vi_ = _vi_buffer[_vi_buffer_index];
         GLuint inv = discard ? GL_MAP_INVALIDATE_BUFFER_BIT : 0;
         // copy vertex data
@@ -205,6 +449,7 @@ namespace Core::Graphics
             // std::memcpy((DrawVertex*)map, _draw_list.vertex.data, _draw_list.vertex.size * sizeof(DrawVertex));
             // glUnmapBuffer(GL_ARRAY_BUFFER);
             glBufferSubData(GL_ARRAY_BUFFER, vi_.vertex_offset * sizeof(DrawVertex), _draw_list.vertex.size * sizeof(DrawVertex), _draw_list.vertex.data);
+            _gl_call_count += 2;
         }
         // copy index data
         if (_draw_list.index.size > 0)
@@ -218,7 +463,9 @@ namespace Core::Graphics
             // );
             // std::memcpy((DrawIndex*)map, _draw_list.index.data, _draw_list.index.size * sizeof(DrawIndex));
             // glUnmapBuffer(GL_ELEMENT_ARRAY_BUFFER);
-            glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, vi_.index_offset * sizeof(DrawIndex), _draw_list.index.size * sizeof(DrawIndex), _draw_list.index.data);
+            size_t const stride = getDrawIndexStride();
+            glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, vi_.index_offset * stride, _draw_list.index.size * stride, _draw_list.index.data);
+            _gl_call_count += 2;
         }
         
         return true;
@@ -232,6 +479,278 @@ namespace Core::Graphics
         _draw_list.vertex.size = 0;
         _draw_list.index.size = 0;
         _draw_list.command.size = 0;
+        bindDrawListStorage();
+    }
+    void Renderer_OpenGL::bindDrawListStorage()
+    {
+        if (_vi_ring_enable && !_bundle_capture)
+        {
+            // Write straight into the mapped memory after the data already drawn
+            VertexIndexBuffer const& vi_ = _vi_buffer[_vi_buffer_index];
+            _draw_list.vertex.data = static_cast<DrawVertex*>(_vertex_ring.pointer(vi_.vertex_offset));
+            _draw_list.vertex.capacity = _vertex_ring.available(vi_.vertex_offset);
+            _draw_list.index.data = _index_ring.pointer(vi_.index_offset);
+            _draw_list.index.capacity = _index_ring.available(vi_.index_offset);
+        }
+        else
+        {
+            if (_draw_list_vertex_staging.empty())
+            {
+                // The mapped ring buffer is write-only, bundles are recorded through the staging arrays
+                _draw_list_vertex_staging.resize(_draw_list_config.vertex_count);
+                _draw_list_index_staging.resize((_draw_list_config.index_count * getDrawIndexStride() + sizeof(DrawIndex32) - 1) / sizeof(DrawIndex32));
+            }
+            _draw_list.vertex.data = _draw_list_vertex_staging.data();
+            _draw_list.vertex.capacity = _draw_list_vertex_staging.size();
+            _draw_list.index.data = _draw_list_index_staging.data();
+            _draw_list.index.capacity = _draw_list_index_staging.size() * sizeof(DrawIndex32) / getDrawIndexStride();
+        }
+    }
+    bool Renderer_OpenGL::reserveDrawList(size_t nvert, size_t nidx, bool index32)
+    {
+        commitDrawRequest();
+        auto const fit = [&]() -> bool
+        {
+            return (_draw_list.vertex.capacity - _draw_list.vertex.size) >= nvert
+                && (_draw_list.index.capacity - _draw_list.index.size) >= nidx;
+        };
+        if (!fit())
+        {
+            if (!batchFlush(false, FlushCause::Capacity)) return false;
+            if (!fit())
+            {
+                if (!_vi_ring_enable || _bundle_capture)
+                {
+                    return false;
+                }
+                // The rest of the current section is too small, move on to the next one
+                VertexIndexBuffer& vi_ = _vi_buffer[_vi_buffer_index];
+                if (_draw_list.vertex.capacity < nvert)
+                {
+                    vi_.vertex_offset = (GLint)_vertex_ring.nextSection();
+                }
+                if (_draw_list.index.capacity < nidx)
+                {
+                    vi_.index_offset = (GLuint)_index_ring.nextSection();
+                }
+                bindDrawListStorage();
+                if (!fit())
+                {
+                    return false;
+                }
+            }
+        }
+        // Indices relative to the command must stay within 16 bits, continue with a new command for the same texture
+        if ((!index32 || !_draw_list.index.index32) && _draw_list.command.size > 0)
+        {
+            DrawCommand& last_ = _draw_list.command.data[_draw_list.command.size - 1];
+            if (last_.vertex_count + nvert > DrawList::max_command_vertex_count_16)
+            {
+                if (_draw_list.command.size >= _draw_list.command.data.size())
+                {
+                    return batchFlush(false, FlushCause::Capacity) && fit();
+                }
+                DrawCommand& cmd_ = _draw_list.command.data[_draw_list.command.size];
+                cmd_.texture = last_.texture;
+                cmd_.vertex_count = 0;
+                cmd_.index_count = 0;
+                _draw_list.command.size += 1;
+            }
+        }
+        return true;
+    }
+    bool Renderer_OpenGL::requireDrawList(size_t nvert, size_t nidx, bool index32)
+    {
+        if ((!index32 || _draw_list.index.index32)
+            && nvert <= _draw_list_config.vertex_count
+            && nidx <= _draw_list_config.index_count)
+        {
+            return true;
+        }
+        constexpr size_t max_count = size_t(1) << 24;
+        if (nvert > max_count || nidx > max_count)
+        {
+            spdlog::error("[core] Draw with {} vertices and {} indices exceeds the draw list limit", nvert, nidx);
+            return false;
+        }
+        // Round up to a power of two, so a series of slightly larger meshes does not rebuild the buffers every time
+        auto const round_up = [](size_t v, uint32_t current) -> uint32_t
+        {
+            size_t n = current;
+            while (n < v) n *= 2;
+            return (uint32_t)n;
+        };
+        DrawListConfig config = _draw_list_config;
+        config.vertex_count = round_up(nvert, config.vertex_count);
+        config.index_count = round_up(nidx, config.index_count);
+        config.index32 = config.index32 || index32;
+        FrameProfiler::get().addCounter("Renderer.DrawListGrow", 1);
+        if (!batchFlush(false, FlushCause::Capacity)) return false;
+        return rebuildDrawList(config);
+    }
+    bool Renderer_OpenGL::rebuildDrawList(DrawListConfig const& config)
+    {
+        _draw_list_config = config;
+        if (_vao == 0)
+        {
+            return true; // Applied when the device is created
+        }
+        ScopeObject<Texture2D_OpenGL> texture(_state_texture);
+        clearDrawList();
+        destroyDrawListBuffers();
+        if (!createDrawListBuffers())
+        {
+            spdlog::error("[core] Unable to create draw list buffers ({} vertices, {} indices)", config.vertex_count, config.index_count);
+            return false;
+        }
+        if (_batch_scope)
+        {
+            setVertexIndexBuffer();
+        }
+        setTexture(texture.get());
+        return true;
+    }
+    void Renderer_OpenGL::setDrawListConfig(DrawListConfig const& config)
+    {
+        DrawListConfig value = config;
+        value.vertex_count = std::max<uint32_t>(value.vertex_count, 1024);
+        value.index_count = std::max<uint32_t>(value.index_count, 1536);
+        value.command_count = std::max<uint32_t>(value.command_count, 16);
+        batchFlush();
+        rebuildDrawList(value);
+    }
+    bool Renderer_OpenGL::createDrawListBuffers()
+    {
+        size_t const vertex_count = _draw_list_config.vertex_count;
+        size_t const index_count = _draw_list_config.index_count;
+        size_t const index_stride = _draw_list_config.index32 ? sizeof(DrawIndex32) : sizeof(DrawIndex);
+        _draw_list.index.index32 = _draw_list_config.index32;
+        _draw_list.command.size = 0;
+        _draw_list.command.data.resize(_draw_list_config.command_count);
+
+        _vi_ring_enable = false;
+        if (GLAD_GL_ARB_buffer_storage)
+        {
+            // Each section holds a full draw list, so a draw request always fits after moving to the next section
+            auto& vi_ = _vi_buffer[0];
+            glGenBuffers(1, &vi_.vertex_buffer);
+            glGenBuffers(1, &vi_.index_buffer);
+            if (vi_.vertex_buffer == 0 || vi_.index_buffer == 0) return false;
+            glBindVertexArray(_vao);
+            if (_vertex_ring.create(vi_.vertex_buffer, GL_ARRAY_BUFFER, sizeof(DrawVertex), vertex_count)
+                && _index_ring.create(vi_.index_buffer, GL_ELEMENT_ARRAY_BUFFER, index_stride, index_count))
+            {
+                _vi_ring_enable = true;
+                _draw_list_vertex_staging = std::vector<DrawVertex>();
+                _draw_list_index_staging = std::vector<DrawIndex32>();
+                spdlog::info("[core] Renderer uses persistent mapped vertex and index buffers ({} vertices, {} indices, {}-bit)",
+                    vertex_count, index_count, index_stride * 8);
+            }
+            else
+            {
+                spdlog::warn("[core] Unable to map vertex and index buffers persistently, fall back to glBufferSubData");
+                _vertex_ring.destroy();
+                _index_ring.destroy();
+                glDeleteBuffers(1, &vi_.vertex_buffer);
+                glDeleteBuffers(1, &vi_.index_buffer);
+                vi_.vertex_buffer = 0;
+                vi_.index_buffer = 0;
+            }
+        }
+        if (!_vi_ring_enable)
+        {
+            _draw_list_vertex_staging.resize(vertex_count);
+            _draw_list_index_staging.resize((index_count * index_stride + sizeof(DrawIndex32) - 1) / sizeof(DrawIndex32));
+            for (auto& vi_ : _vi_buffer)
+            {
+                glGenBuffers(1, &vi_.vertex_buffer);
+                if (vi_.vertex_buffer == 0) return false;
+                glBindBuffer(GL_ARRAY_BUFFER, vi_.vertex_buffer);
+                glBufferData(GL_ARRAY_BUFFER, vertex_count * sizeof(DrawVertex), 0, GL_DYNAMIC_DRAW);
+
+                glGenBuffers(1, &vi_.index_buffer);
+                if (vi_.index_buffer == 0) return false;
+                glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, vi_.index_buffer);
+                glBufferData(GL_ELEMENT_ARRAY_BUFFER, index_count * index_stride, 0, GL_DYNAMIC_DRAW);
+            }
+        }
+        for (auto& vi_ : _vi_buffer)
+        {
+            vi_.vertex_offset = 0;
+            vi_.index_offset = 0;
+        }
+        _vi_buffer_index = 0;
+        bindDrawListStorage();
+        return true;
+    }
+    void Renderer_OpenGL::destroyDrawListBuffers()
+    {
+        _vertex_ring.destroy();
+        _index_ring.destroy();
+        _vi_ring_enable = false;
+        for (auto& v : _vi_buffer)
+        {
+            glDeleteBuffers(1, &v.vertex_buffer);
+            glDeleteBuffers(1, &v.index_buffer);
+            v.vertex_buffer = 0;
+            v.index_buffer = 0;
+            v.vertex_offset = 0;
+            v.index_offset = 0;
+        }
+        _vi_buffer_index = 0;
+        _draw_list_vertex_staging = std::vector<DrawVertex>();
+        _draw_list_index_staging = std::vector<DrawIndex32>();
+        bindDrawListStorage();
+    }
+
+    bool PersistentRingBuffer::create(GLuint buffer_, GLenum target, size_t stride_, size_t section_size_)
+    {
+        buffer = buffer_;
+        stride = stride_;
+        section_size = section_size_;
+        section = 0;
+        GLbitfield const flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        GLsizeiptr const size = (GLsizeiptr)(section_count * section_size * stride);
+        glBindBuffer(target, buffer);
+        glBufferStorage(target, size, 0, flags);
+        mapped = static_cast<uint8_t*>(glMapBufferRange(target, 0, size, flags));
+        return mapped != nullptr;
+    }
+    void PersistentRingBuffer::destroy()
+    {
+        for (auto& v : fence)
+        {
+            if (v)
+            {
+                glDeleteSync(v);
+                v = nullptr;
+            }
+        }
+        // Deleting the buffer also unmaps it
+        mapped = nullptr;
+        buffer = 0;
+        section = 0;
+    }
+    size_t PersistentRingBuffer::nextSection()
+    {
+        fence[section] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        section = (section + 1) % section_count;
+        if (GLsync const sync = fence[section])
+        {
+            GLenum result = glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+            if (result == GL_TIMEOUT_EXPIRED)
+            {
+                // The GPU is still reading this section
+                FrameProfiler::get().addCounter("Renderer.RingBufferStall", 1);
+                while (result == GL_TIMEOUT_EXPIRED)
+                {
+                    result = glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000); // 1ms
+                }
+            }
+            glDeleteSync(sync);
+            fence[section] = nullptr;
+        }
+        return section * section_size;
     }
 
     bool Renderer_OpenGL::createBuffers()
@@ -248,20 +767,7 @@ namespace Core::Graphics
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _fx_ibuffer);
         glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(idx_), &idx_, GL_STATIC_DRAW);
 
-        for (auto& vi_ : _vi_buffer)
-        {
-            glGenBuffers(1, &vi_.vertex_buffer);
-            if (vi_.vertex_buffer == 0) return false;
-            glBindBuffer(GL_ARRAY_BUFFER, vi_.vertex_buffer);
-            // glBufferStorage(GL_ARRAY_BUFFER, _draw_list.vertex.capacity * sizeof(DrawVertex), 0, GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT);
-            glBufferData(GL_ARRAY_BUFFER, _draw_list.vertex.capacity * sizeof(DrawVertex), 0, GL_DYNAMIC_DRAW);
-
-            glGenBuffers(1, &vi_.index_buffer);
-            if (vi_.index_buffer == 0) return false;
-            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, vi_.index_buffer);
-            // glBufferStorage(GL_ELEMENT_ARRAY_BUFFER, _draw_list.index.capacity * sizeof(DrawIndex), 0, GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT);
-            glBufferData(GL_ELEMENT_ARRAY_BUFFER, _draw_list.index.capacity * sizeof(DrawIndex), 0, GL_DYNAMIC_DRAW);
-        }
+        if (!createDrawListBuffers()) return false;
 
         glGenBuffers(1, &_vp_matrix_buffer);
         if (_vp_matrix_buffer == 0) return false;
@@ -278,6 +784,36 @@ namespace Core::Graphics
         glGenBuffers(1, &_user_float_buffer);
         if (_user_float_buffer == 0) return false;
 
+        // Sprite instances
+
+        static_assert(sizeof(SpriteInstanceRect) == 2 * 4 * sizeof(float)); // Two vec4 per rect in sprite_rect_buffer
+        static_assert(sizeof(SpriteInstance) == 8 * sizeof(float));
+
+        glGenBuffers(1, &_instance_rect_buffer);
+        if (_instance_rect_buffer == 0) return false;
+        glBindBuffer(GL_UNIFORM_BUFFER, _instance_rect_buffer);
+        glBufferData(GL_UNIFORM_BUFFER, SpriteInstanceMaxRectCount * sizeof(SpriteInstanceRect), 0, GL_STREAM_DRAW);
+
+        glGenBuffers(1, &_instance_buffer);
+        if (_instance_buffer == 0) return false;
+        glGenVertexArrays(1, &_instance_vao);
+        if (_instance_vao == 0) return false;
+        glBindVertexArray(_instance_vao);
+        glBindBuffer(GL_ARRAY_BUFFER, _instance_buffer);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(SpriteInstance), (const GLvoid*)offsetof(SpriteInstance, x));
+        glVertexAttribDivisor(0, 1);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(SpriteInstance), (const GLvoid*)offsetof(SpriteInstance, rotation));
+        glVertexAttribDivisor(1, 1);
+        glEnableVertexAttribArray(1);
+        glVertexAttribIPointer(2, 1, GL_UNSIGNED_INT, sizeof(SpriteInstance), (const GLvoid*)offsetof(SpriteInstance, rect));
+        glVertexAttribDivisor(2, 1);
+        glEnableVertexAttribArray(2);
+        glVertexAttribPointer(3, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(SpriteInstance), (const GLvoid*)offsetof(SpriteInstance, color));
+        glVertexAttribDivisor(3, 1);
+        glEnableVertexAttribArray(3);
+        glBindVertexArray(_vao);
+
         return true;
     }
     bool Renderer_OpenGL::createStates()
@@ -326,6 +862,12 @@ namespace Core::Graphics
             _sampler_state[IDX(SamplerState::LinearBorderWhite)].border_color = BorderColor::White;
         }
 
+        for (size_t i = 0; i < IDX(SamplerState::MAX_COUNT); i += 1)
+        {
+            _sampler_objects[i] = getSamplerObject(_sampler_state[i]);
+            if (_sampler_objects[i] == 0) return false;
+        }
+
         return true;
     }
     void Renderer_OpenGL::initState()
@@ -356,117 +898,100 @@ namespace Core::Graphics
     }
     void Renderer_OpenGL::setSamplerState(IRenderer::SamplerState state, GLuint index)
     {
-        // GLuint opengl_sampler = static_cast<SamplerState_OpenGL*>(_sampler_state[IDX(state)].get())->GetState();
-        // glBindSampler(GL_TEXTURE0 + index, opengl_sampler);
-        // glTexParameteri(GL_TEXTURE_2D, );
-        // 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        // 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        setSamplerState(_sampler_state[IDX(state)], index);
+        bindSampler(index, _sampler_objects[IDX(state)]);
     }
     void Renderer_OpenGL::setSamplerState(Graphics::SamplerState state, GLuint index)
     {
-        glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, state.max_anisotropy);
-        switch (state.filter.min)
+        bindSampler(index, getSamplerObject(state));
+    }
+    GLuint Renderer_OpenGL::getSamplerObject(Graphics::SamplerState const& state)
+    {
+        // Only a handful of distinct states exist, a linear search is enough
+        for (auto const& v : _sampler_object_cache)
         {
-        case FilterMode::Nearest:
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-            break;
-        case FilterMode::NearestMipNearest:
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
-            break;
-        case FilterMode::NearestMipLinear:
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_LINEAR);
-            break;
-        case FilterMode::Linear:
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-            break;
-        case FilterMode::LinearMipNearest:
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_NEAREST);
-            break;
-        case FilterMode::LinearMipLinear:
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-            break;
+            if (isSameSamplerState(v.first, state))
+            {
+                return v.second;
+            }
         }
-        switch (state.filter.mag)
+        GLuint const sampler = createSamplerObject(state);
+        _sampler_object_cache.emplace_back(state, sampler);
+        return sampler;
+    }
+    void Renderer_OpenGL::resetStateShadow()
+    {
+        // Other code still relies on texture parameters, do not leave sampler objects bound
+        for (GLuint i = 0; i < shadow_texture_unit_count; i += 1)
         {
-        default:
-            assert(false);
-            break;
-        case FilterMode::Nearest:
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-            break;
-        case FilterMode::Linear:
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-            break;
+            if (_bound_sampler[i] != 0)
+            {
+                glBindSampler(i, 0);
+                _gl_call_count += 1;
+            }
+            _bound_sampler[i] = 0;
+            _bound_texture[i] = unknown_binding;
         }
-
-        switch (state.address_u)
+        _bound_program = unknown_binding;
+        _bound_texture_unit = unknown_binding;
+        _texture_binding_generation = g_texture_binding_generation;
+    }
+    void Renderer_OpenGL::useProgram(GLuint program)
+    {
+        if (_bound_program == program)
         {
-        case TextureAddressMode::Wrap:
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-            break;
-        case TextureAddressMode::Mirror:
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_MIRRORED_REPEAT);
-            break;
-        case TextureAddressMode::Clamp:
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-            break;
-        case TextureAddressMode::Border:
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
-            break;
+            _gl_call_skip_count += 1;
+            return;
         }
-        switch (state.address_v)
+        glUseProgram(program);
+        _gl_call_count += 1;
+        _bound_program = program;
+    }
+    void Renderer_OpenGL::bindTexture(GLuint unit, GLuint texture)
+    {
+        if (_texture_binding_generation != g_texture_binding_generation)
         {
-        case TextureAddressMode::Wrap:
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-            break;
-        case TextureAddressMode::Mirror:
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_MIRRORED_REPEAT);
-            break;
-        case TextureAddressMode::Clamp:
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-            break;
-        case TextureAddressMode::Border:
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
-            break;
+            // A texture was created or updated since the last bind, the active unit no longer holds our texture
+            std::fill(std::begin(_bound_texture), std::end(_bound_texture), unknown_binding);
+            _texture_binding_generation = g_texture_binding_generation;
         }
-
-        if (state.address_u == TextureAddressMode::Border || state.address_v == TextureAddressMode::Border)
+        if (unit < shadow_texture_unit_count && _bound_texture[unit] == texture)
         {
-            float borderColor[4];
-        #define makeColor(r, g, b, a) \
-            borderColor[0] = r;\
-            borderColor[1] = g;\
-            borderColor[2] = b;\
-            borderColor[3] = a;
-
-            switch (state.border_color)
-            {
-            case BorderColor::Black:
-                makeColor(0.0f, 0.0f, 0.0f, 0.0f);
-                break;
-            case BorderColor::OpaqueBlack:
-                makeColor(0.0f, 0.0f, 0.0f, 1.0f);
-                break;
-            case BorderColor::TransparentWhite:
-                makeColor(1.0f, 1.0f, 1.0f, 0.0f);
-                break;
-            case BorderColor::White:
-                makeColor(1.0f, 1.0f, 1.0f, 1.0f);
-                break;
-            }
-
-        #undef makeColor
-            glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, &borderColor[0]);
+            _gl_call_skip_count += 1;
+            return;
+        }
+        if (_bound_texture_unit != unit)
+        {
+            glActiveTexture(GL_TEXTURE0 + unit);
+            _gl_call_count += 1;
+            _bound_texture_unit = unit;
+        }
+        glBindTexture(GL_TEXTURE_2D, texture);
+        _gl_call_count += 1;
+        if (unit < shadow_texture_unit_count)
+        {
+            _bound_texture[unit] = texture;
+        }
+    }
+    void Renderer_OpenGL::bindSampler(GLuint unit, GLuint sampler)
+    {
+        if (unit < shadow_texture_unit_count && _bound_sampler[unit] == sampler)
+        {
+            _gl_call_skip_count += 1;
+            return;
+        }
+        glBindSampler(unit, sampler);
+        _gl_call_count += 1;
+        if (unit < shadow_texture_unit_count)
+        {
+            _bound_sampler[unit] = sampler;
         }
-
-        glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_LOD_BIAS, state.mip_lod_bias);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_FUNC, GL_NEVER);
-        glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_LOD, state.min_lod);
-        glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_LOD, state.max_lod);
     }
     bool Renderer_OpenGL::uploadVertexIndexBufferFromDrawList()
     {
+        if (_vi_ring_enable)
+        {
+            return true; // Already written into the mapped memory
+        }
         // upload data
         if ((_draw_list.vertex.capacity - _vi_buffer[_vi_buffer_index].vertex_offset) < _draw_list.vertex.size
             || (_draw_list.index.capacity - _vi_buffer[_vi_buffer_index].index_offset) < _draw_list.index.size)
@@ -501,11 +1026,15 @@ namespace Core::Graphics
     void Renderer_OpenGL::bindTextureSamplerState(ITexture2D* texture)
     {
         std::optional<Graphics::SamplerState> sampler_from_texture = texture ? texture->getSamplerState() : std::optional<Graphics::SamplerState>();
-        Graphics::SamplerState sampler = sampler_from_texture.value_or(_sampler_state[IDX(_state_set.sampler_state)]);
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, static_cast<Texture2D_OpenGL*>(texture)->GetResource());
-        setSamplerState(sampler, 0);
-        // glBindSampler(0, static_cast<SamplerState_OpenGL*>(sampler)->GetState());
+        bindTexture(0, static_cast<Texture2D_OpenGL*>(texture)->GetResource());
+        if (sampler_from_texture)
+        {
+            setSamplerState(*sampler_from_texture, 0);
+        }
+        else
+        {
+            setSamplerState(_state_set.sampler_state, 0);
+        }
     }
     void Renderer_OpenGL::bindTextureAlphaType(ITexture2D* texture)
     {
@@ -525,18 +1054,44 @@ namespace Core::Graphics
 
         // glUniformSubroutinesuiv(GL_FRAGMENT_SHADER, 2, subroutines);
     }
-    bool Renderer_OpenGL::batchFlush(bool discard)
+    bool Renderer_OpenGL::batchFlush(bool discard, FlushCause cause)
     {
         ZoneScoped;
-        if (!discard)
+        if (discard)
+        {
+            _draw_request_target = nullptr;
+            _draw_request_count = 0;
+            _draw_request_index_target = nullptr;
+            _draw_request_index_count = 0;
+        }
+        else
         {
             TracyGpuZone("BatchFlush");
+            FrameProfiler::get().addCounter("Renderer.BatchFlush", 1);
+            if (_draw_list.vertex.size > 0)
+            {
+                if (cause == FlushCause::Capacity)
+                    FrameProfiler::get().addCounter("Renderer.BatchFlushCapacity", 1);
+                else if (cause == FlushCause::State)
+                    FrameProfiler::get().addCounter("Renderer.BatchFlushState", 1);
+            }
+            commitDrawRequest();
+            if (_bundle_capture)
+            {
+                // Recorded instead of drawn
+                captureDrawList();
+                clearDrawList();
+                setTexture(_state_texture.get());
+                return true;
+            }
             // upload data
             if (!uploadVertexIndexBufferFromDrawList()) return false;
             // draw
             if (_draw_list.command.size > 0)
             {
                 VertexIndexBuffer& vi_ = _vi_buffer[_vi_buffer_index];
+                GLenum const index_type = _draw_list.index.index32 ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT;
+                size_t const index_stride = getDrawIndexStride();
                 for (size_t j_ = 0; j_ < _draw_list.command.size; j_ += 1)
                 {
                     DrawCommand& cmd_ = _draw_list.command.data[j_];
@@ -544,9 +1099,18 @@ namespace Core::Graphics
                     {
                         bindTextureAlphaType(cmd_.texture.get());
                         bindTextureSamplerState(cmd_.texture.get());
-                        glUseProgram(_programs[IDX(_state_set.vertex_color_blend_state)][IDX(_state_set.fog_state)][IDX(_state_set.texture_alpha_type)]);
+                        if (_premul_vertex != PremulVertex::None)
+                        {
+                            useProgram(_premul_vertex_programs[IDX(_state_set.texture_alpha_type)]);
+                        }
+                        else
+                        {
+                            useProgram(_programs[IDX(_state_set.vertex_color_blend_state)][IDX(_state_set.fog_state)][IDX(_state_set.texture_alpha_type)]);
+                        }
                         // glDrawElementsBaseVertex(GL_TRIANGLES, cmd_.index_count, GL_UNSIGNED_SHORT, 0, vi_.index_offset);
-                        glDrawElementsBaseVertex(GL_TRIANGLES, cmd_.index_count, GL_UNSIGNED_SHORT, (void*)(vi_.index_offset * sizeof(DrawIndex)), vi_.vertex_offset);
+                        glDrawElementsBaseVertex(GL_TRIANGLES, cmd_.index_count, index_type, (void*)(vi_.index_offset * index_stride), vi_.vertex_offset);
+                        _gl_call_count += 1;
+                        _draw_call_count += 1;
                     }
                     vi_.vertex_offset += cmd_.vertex_count;
                     vi_.index_offset += cmd_.index_count;
@@ -559,9 +1123,30 @@ namespace Core::Graphics
         return true;
     }
 
+    void Renderer_OpenGL::captureDrawList()
+    {
+        size_t const index_stride = getDrawIndexStride();
+        size_t vertex_offset = 0;
+        size_t index_offset = 0;
+        for (size_t j_ = 0; j_ < _draw_list.command.size; j_ += 1)
+        {
+            DrawCommand& cmd_ = _draw_list.command.data[j_];
+            if (cmd_.vertex_count > 0 && cmd_.index_count > 0)
+            {
+                _bundle_capture->append(cmd_.texture.get(), _state_set,
+                    _draw_list.vertex.data + vertex_offset, cmd_.vertex_count,
+                    static_cast<uint8_t const*>(_draw_list.index.data) + index_offset * index_stride, _draw_list.index.index32, cmd_.index_count);
+            }
+            vertex_offset += cmd_.vertex_count;
+            index_offset += cmd_.index_count;
+        }
+    }
+
     bool Renderer_OpenGL::createResources()
     {
         spdlog::info("[core] Starting Renderer Initialization");
+
+        resetStateShadow();
         
         if (!createBuffers())
         {
@@ -595,14 +1180,7 @@ namespace Core::Graphics
 
         glDeleteBuffers(1, &_fx_vbuffer);
         glDeleteBuffers(1, &_fx_ibuffer);
-        for (auto& v : _vi_buffer)
-        {
-            glDeleteBuffers(1, &v.vertex_buffer);
-            glDeleteBuffers(1, &v.index_buffer);
-            v.vertex_offset = 0;
-            v.index_offset = 0;
-        }
-        _vi_buffer_index = 0;
+        destroyDrawListBuffers();
 
         glDeleteBuffers(1, &_vp_matrix_buffer);
         glDeleteBuffers(1, &_world_matrix_buffer);
@@ -610,11 +1188,31 @@ namespace Core::Graphics
         glDeleteBuffers(1, &_fog_data_buffer);
         glDeleteBuffers(1, &_user_float_buffer);
 
+        glDeleteVertexArrays(1, &_instance_vao);
+        glDeleteBuffers(1, &_instance_buffer);
+        glDeleteBuffers(1, &_instance_rect_buffer);
+        _instance_buffer_capacity = 0;
 
         for (int i = 0; i < IDX(VertexColorBlendState::MAX_COUNT); i++)
         for (int j = 0; j < IDX(FogState::MAX_COUNT); j++)
         for (int k = 0; k < IDX(TextureAlphaType::MAX_COUNT); k++)
+        {
             glDeleteProgram(_programs[i][j][k]);
+            glDeleteProgram(_instance_programs[i][j][k]);
+        }
+        for (int k = 0; k < IDX(TextureAlphaType::MAX_COUNT); k++)
+        {
+            glDeleteProgram(_premul_vertex_programs[k]);
+        }
+
+        for (auto const& v : _sampler_object_cache)
+        {
+            glDeleteSamplers(1, &v.second);
+        }
+        _sampler_object_cache.clear();
+        std::fill(std::begin(_sampler_objects), std::end(_sampler_objects), 0);
+        std::fill(std::begin(_bound_sampler), std::end(_bound_sampler), 0); // Deleting a bound sampler object also unbinds it
+        resetStateShadow();
 
         spdlog::info("[core] Renderer Destroyed");
     }
@@ -639,9 +1237,16 @@ namespace Core::Graphics
     bool Renderer_OpenGL::endBatch()
     {
         _batch_scope = false;
-        if (!batchFlush())
+        if (!batchFlush(false, FlushCause::BatchEnd))
             return false;
         _state_texture.reset();
+        resetStateShadow();
+        FrameProfiler::get().addCounter("Renderer.GLCalls", _gl_call_count);
+        FrameProfiler::get().addCounter("Renderer.GLCallsSkipped", _gl_call_skip_count);
+        FrameProfiler::get().addCounter("Renderer.DrawCalls", _draw_call_count);
+        _gl_call_count = 0;
+        _gl_call_skip_count = 0;
+        _draw_call_count = 0;
         return true;
     }
     bool Renderer_OpenGL::flush()
@@ -680,7 +1285,7 @@ namespace Core::Graphics
             batchFlush();
             _camera_state_set.ortho = box;
             _camera_state_set.is_3D = false;
-            glm::mat4 m4 = glm::orthoLH_ZO(box.a.x, box.b.x, box.a.y, box.b.y, box.a.z, box.b.z);
+            glm::mat4 m4 = makeViewProjection(_camera_state_set);
             // spdlog::info("[core] setOrtho: {} {} {} {}", box.a.x, box.b.x, box.b.y, box.a.y);
             /* upload vp matrix */ {
                 glBindBuffer(GL_UNIFORM_BUFFER, _vp_matrix_buffer);
@@ -703,8 +1308,7 @@ namespace Core::Graphics
             _camera_state_set.is_3D = true;
             glm::vec3 const eyef3(eye.x, -eye.y, eye.z);
             glm::vec3 const lookatf3(lookat.x, -lookat.y, lookat.z);
-            glm::vec3 const headupf3(headup.x, headup.y, headup.z);
-            glm::mat4 m4 = glm::scale(glm::perspectiveLH_ZO(fov, aspect, znear, zfar) * glm::lookAtLH(eyef3, lookatf3, headupf3), glm::vec3(1, -1, 1));
+            glm::mat4 m4 = makeViewProjection(_camera_state_set);
             float const camera_pos[8] = {
                 eye.x, eye.y, eye.z, 0.0f,
                 lookatf3.x - eyef3.x, lookatf3.y - eyef3.y, lookatf3.z - eyef3.z, 0.0f,
@@ -754,6 +1358,12 @@ namespace Core::Graphics
         {
             batchFlush();
             _state_set.vertex_color_blend_state = state;
+            PremulVertex const last_premul_vertex = _premul_vertex;
+            updatePremulVertex();
+            if (!_state_dirty && (last_premul_vertex == PremulVertex::None) != (_premul_vertex == PremulVertex::None))
+            {
+                applyBlendState(_premul_vertex != PremulVertex::None ? BlendState::Alpha : _state_set.blend_state);
+            }
             //GLuint subroutines[2] = { (GLuint)(IDX(state) * 2 + IDX(_state_set.texture_alpha_type)), (GLuint)(IDX(_state_set.fog_state) + 8) };
             //GLuint subroutines[2] = { (GLuint)(IDX(_state_set.fog_state) + 8), (GLuint)(IDX(state) * 2 + IDX(_state_set.texture_alpha_type)) };
             // GLuint subroutines[2];
@@ -772,6 +1382,12 @@ namespace Core::Graphics
             _state_set.fog_color = color;
             _state_set.fog_near_or_density = density_or_znear;
             _state_set.fog_far = zfar;
+            PremulVertex const last_premul_vertex = _premul_vertex;
+            updatePremulVertex();
+            if (!_state_dirty && (last_premul_vertex == PremulVertex::None) != (_premul_vertex == PremulVertex::None))
+            {
+                applyBlendState(_premul_vertex != PremulVertex::None ? BlendState::Alpha : _state_set.blend_state);
+            }
             float const fog_color_and_range[8] = {
                 (float)color.r / 255.0f,
                 (float)color.g / 255.0f,
@@ -810,65 +1426,176 @@ namespace Core::Graphics
     {
         if (_state_dirty || _state_set.blend_state != state)
         {
+            if (!_state_dirty && _premul_vertex != PremulVertex::None
+                && (state == BlendState::Alpha || state == BlendState::Add))
+            {
+                // Stay in the same batch, the difference goes into the vertex alpha
+                _state_set.blend_state = state;
+                updatePremulVertex();
+                return;
+            }
             batchFlush();
             _state_set.blend_state = state;
-            switch (state) {
-            default: assert(false); break;
-            case BlendState::Disable:
-                glDisable(GL_BLEND);
-                break;
+            updatePremulVertex();
+            applyBlendState(_premul_vertex != PremulVertex::None ? BlendState::Alpha : state);
+        }
+    }
+    void Renderer_OpenGL::applyBlendState(BlendState state)
+    {
+        switch (state) {
+        default: assert(false); break;
+        case BlendState::Disable:
+            glDisable(GL_BLEND);
+            break;
+        case BlendState::Alpha:
+            glEnable(GL_BLEND);
+            glBlendFuncSeparate(GL_ONE, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+            glBlendEquationSeparate(GL_FUNC_ADD, GL_FUNC_ADD);
+            break;
+        case BlendState::One:
+            glEnable(GL_BLEND);
+            glBlendFuncSeparate(GL_ONE, GL_ZERO, GL_ONE, GL_ZERO);
+            glBlendEquationSeparate(GL_FUNC_ADD, GL_FUNC_ADD);
+            break;
+        case BlendState::Min:
+            glEnable(GL_BLEND);
+            glBlendFuncSeparate(GL_ONE, GL_ONE, GL_ONE, GL_ONE);
+            glBlendEquationSeparate(GL_MIN, GL_MIN);
+            break;
+        case BlendState::Max:
+            glEnable(GL_BLEND);
+            glBlendFuncSeparate(GL_ONE, GL_ONE, GL_ONE, GL_ONE);
+            glBlendEquationSeparate(GL_MAX, GL_MAX);
+            break;
+        case BlendState::Mul:
+            glEnable(GL_BLEND);
+            glBlendFuncSeparate(GL_DST_COLOR, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+            glBlendEquationSeparate(GL_FUNC_ADD, GL_FUNC_ADD);
+            break;
+        case BlendState::Screen:
+            glEnable(GL_BLEND);
+            glBlendFuncSeparate(GL_ONE, GL_ONE_MINUS_SRC_COLOR, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+            glBlendEquationSeparate(GL_FUNC_ADD, GL_FUNC_ADD);
+            break;
+        case BlendState::Add:
+            glEnable(GL_BLEND);
+            glBlendFuncSeparate(GL_ONE, GL_ONE, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+            glBlendEquationSeparate(GL_FUNC_ADD, GL_FUNC_ADD);
+            break;
+        case BlendState::Sub:
+            glEnable(GL_BLEND);
+            glBlendFuncSeparate(GL_ONE, GL_ONE, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            glBlendEquationSeparate(GL_FUNC_SUBTRACT, GL_FUNC_ADD);
+            break;
+        case BlendState::RevSub:
+            glEnable(GL_BLEND);
+            glBlendFuncSeparate(GL_ONE, GL_ONE, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+            glBlendEquationSeparate(GL_FUNC_REVERSE_SUBTRACT, GL_FUNC_ADD);
+            break;
+        case BlendState::Inv:
+            glEnable(GL_BLEND);
+            glBlendFuncSeparate(GL_ONE_MINUS_DST_COLOR, GL_ONE_MINUS_SRC_COLOR, GL_ZERO, GL_ONE);
+            glBlendEquationSeparate(GL_FUNC_REVERSE_SUBTRACT, GL_FUNC_ADD);
+            break;
+        }
+    }
+    void Renderer_OpenGL::updatePremulVertex()
+    {
+        // Additive vertices carry alpha 0, fog would lose the fog color it adds to them
+        if (_premul_batching && _state_set.vertex_color_blend_state == VertexColorBlendState::Mul && _state_set.fog_state == FogState::Disable)
+        {
+            switch (_state_set.blend_state)
+            {
             case BlendState::Alpha:
-                glEnable(GL_BLEND);
-                glBlendFuncSeparate(GL_ONE, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
-                glBlendEquationSeparate(GL_FUNC_ADD, GL_FUNC_ADD);
-                break;
-            case BlendState::One:
-                glEnable(GL_BLEND);
-                glBlendFuncSeparate(GL_ONE, GL_ZERO, GL_ONE, GL_ZERO);
-                glBlendEquationSeparate(GL_FUNC_ADD, GL_FUNC_ADD);
-                break;
-            case BlendState::Min:
-                glEnable(GL_BLEND);
-                glBlendFuncSeparate(GL_ONE, GL_ONE, GL_ONE, GL_ONE);
-                glBlendEquationSeparate(GL_MIN, GL_MIN);
-                break;
-            case BlendState::Max:
-                glEnable(GL_BLEND);
-                glBlendFuncSeparate(GL_ONE, GL_ONE, GL_ONE, GL_ONE);
-                glBlendEquationSeparate(GL_MAX, GL_MAX);
-                break;
-            case BlendState::Mul:
-                glEnable(GL_BLEND);
-                glBlendFuncSeparate(GL_DST_COLOR, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
-                glBlendEquationSeparate(GL_FUNC_ADD, GL_FUNC_ADD);
-                break;
-            case BlendState::Screen:
-                glEnable(GL_BLEND);
-                glBlendFuncSeparate(GL_ONE, GL_ONE_MINUS_SRC_COLOR, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
-                glBlendEquationSeparate(GL_FUNC_ADD, GL_FUNC_ADD);
-                break;
+                _premul_vertex = PremulVertex::Alpha;
+                return;
             case BlendState::Add:
-                glEnable(GL_BLEND);
-                glBlendFuncSeparate(GL_ONE, GL_ONE, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
-                glBlendEquationSeparate(GL_FUNC_ADD, GL_FUNC_ADD);
-                break;
-            case BlendState::Sub:
-                glEnable(GL_BLEND);
-                glBlendFuncSeparate(GL_ONE, GL_ONE, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-                glBlendEquationSeparate(GL_FUNC_SUBTRACT, GL_FUNC_ADD);
-                break;
-            case BlendState::RevSub:
-                glEnable(GL_BLEND);
-                glBlendFuncSeparate(GL_ONE, GL_ONE, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
-                glBlendEquationSeparate(GL_FUNC_REVERSE_SUBTRACT, GL_FUNC_ADD);
-                break;
-            case BlendState::Inv:
-                glEnable(GL_BLEND);
-                glBlendFuncSeparate(GL_ONE_MINUS_DST_COLOR, GL_ONE_MINUS_SRC_COLOR, GL_ZERO, GL_ONE);
-                glBlendEquationSeparate(GL_FUNC_REVERSE_SUBTRACT, GL_FUNC_ADD);
+                _premul_vertex = PremulVertex::Add;
+                return;
+            default:
                 break;
             }
         }
+        _premul_vertex = PremulVertex::None;
+    }
+    void Renderer_OpenGL::setPremultipliedBatching(bool enable)
+    {
+        if (_premul_batching != enable)
+        {
+            batchFlush();
+            _premul_batching = enable;
+            updatePremulVertex();
+            applyBlendState(_premul_vertex != PremulVertex::None ? BlendState::Alpha : _state_set.blend_state);
+        }
+    }
+    uint32_t Renderer_OpenGL::premulVertexColor(uint32_t color, PremulVertex mode)
+    {
+        // Bytes are r, g, b, a in memory
+        uint32_t const a = color >> 24;
+        uint32_t const r = ((color & 0xFFu) * a + 127u) / 255u;
+        uint32_t const g = (((color >> 8) & 0xFFu) * a + 127u) / 255u;
+        uint32_t const b = (((color >> 16) & 0xFFu) * a + 127u) / 255u;
+        return r | (g << 8) | (b << 16) | ((mode == PremulVertex::Add ? 0u : a) << 24);
+    }
+    void Renderer_OpenGL::commitDrawRequest()
+    {
+        if (_draw_request_target)
+        {
+            DrawVertex const* src = _draw_request_staging.data();
+            for (size_t i = 0; i < _draw_request_count; i += 1)
+            {
+                _draw_request_target[i] = src[i];
+                _draw_request_target[i].color = premulVertexColor(src[i].color, _draw_request_premul);
+            }
+            _draw_request_target = nullptr;
+            _draw_request_count = 0;
+        }
+        if (_draw_request_index_target)
+        {
+            if (_draw_list.index.index32)
+            {
+                DrawIndex const* src = _draw_request_index_staging.data();
+                DrawIndex32* dst = static_cast<DrawIndex32*>(_draw_request_index_target);
+                for (size_t i = 0; i < _draw_request_index_count; i += 1)
+                    dst[i] = src[i];
+            }
+            else
+            {
+                DrawIndex32 const* src = _draw_request_index32_staging.data();
+                DrawIndex* dst = static_cast<DrawIndex*>(_draw_request_index_target);
+                for (size_t i = 0; i < _draw_request_index_count; i += 1)
+                    dst[i] = (DrawIndex)src[i];
+            }
+            _draw_request_index_target = nullptr;
+            _draw_request_index_count = 0;
+        }
+    }
+
+    template<typename T>
+    inline void write_triangle_index(void* p, size_t offset, uint32_t base)
+    {
+        T* ibuf_ = static_cast<T*>(p) + offset;
+        ibuf_[0] = (T)(base);
+        ibuf_[1] = (T)(base + 1);
+        ibuf_[2] = (T)(base + 2);
+    }
+    template<typename T>
+    inline void write_quad_index(void* p, size_t offset, uint32_t base)
+    {
+        T* ibuf_ = static_cast<T*>(p) + offset;
+        ibuf_[0] = (T)(base);
+        ibuf_[1] = (T)(base + 1);
+        ibuf_[2] = (T)(base + 2);
+        ibuf_[3] = (T)(base);
+        ibuf_[4] = (T)(base + 2);
+        ibuf_[5] = (T)(base + 3);
+    }
+    template<typename T, typename S>
+    inline void write_offset_index(void* p, size_t offset, S const* src, size_t n, uint32_t base)
+    {
+        T* ibuf_ = static_cast<T*>(p) + offset;
+        for (size_t i = 0; i < n; i += 1)
+            ibuf_[i] = (T)(base + src[i]);
     }
 
     inline bool is_same(Texture2D_OpenGL* a, ITexture2D* b)
@@ -895,9 +1622,9 @@ namespace Core::Graphics
         else
         {
             // New render command
-            if ((_draw_list.command.capacity - _draw_list.command.size) < 1)
+            if ((_draw_list.command.data.size() - _draw_list.command.size) < 1)
             {
-                batchFlush(); // Free up space
+                batchFlush(false, FlushCause::Capacity); // Free up space
             }
             _draw_list.command.size += 1;
             DrawCommand& cmd_ = _draw_list.command.data[_draw_list.command.size - 1];
@@ -910,27 +1637,29 @@ namespace Core::Graphics
         {
             _state_texture = static_cast<Texture2D_OpenGL*>(texture);
         }
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, static_cast<Texture2D_OpenGL*>(texture)->GetResource());
+        // The texture is bound by batchFlush when the command is drawn
     }
 
     bool Renderer_OpenGL::drawTriangle(DrawVertex const& v1, DrawVertex const& v2, DrawVertex const& v3)
     {
-        if ((_draw_list.vertex.capacity - _draw_list.vertex.size) < 3 || (_draw_list.index.capacity - _draw_list.index.size) < 3)
-        {
-            if (!batchFlush()) return false;
-        }
+        if (!reserveDrawList(3, 3, true)) return false;
         assert(_draw_list.command.size > 0);
         DrawCommand& cmd_ = _draw_list.command.data[_draw_list.command.size - 1];
         IRenderer::DrawVertex* vbuf_ = _draw_list.vertex.data + _draw_list.vertex.size;
         vbuf_[0] = v1;
         vbuf_[1] = v2;
         vbuf_[2] = v3;
+        if (_premul_vertex != PremulVertex::None)
+        {
+            vbuf_[0].color = premulVertexColor(v1.color, _premul_vertex);
+            vbuf_[1].color = premulVertexColor(v2.color, _premul_vertex);
+            vbuf_[2].color = premulVertexColor(v3.color, _premul_vertex);
+        }
         _draw_list.vertex.size += 3;
-        DrawIndex* ibuf_ = _draw_list.index.data + _draw_list.index.size;
-        ibuf_[0] = cmd_.vertex_count;
-        ibuf_[1] = cmd_.vertex_count + 1;
-        ibuf_[2] = cmd_.vertex_count + 2;
+        if (_draw_list.index.index32)
+            write_triangle_index<DrawIndex32>(_draw_list.index.data, _draw_list.index.size, cmd_.vertex_count);
+        else
+            write_triangle_index<DrawIndex>(_draw_list.index.data, _draw_list.index.size, cmd_.vertex_count);
         _draw_list.index.size += 3;
         cmd_.vertex_count += 3;
         cmd_.index_count += 3;
@@ -942,10 +1671,7 @@ namespace Core::Graphics
     }
     bool Renderer_OpenGL::drawQuad(IRenderer::DrawVertex const& v1, IRenderer::DrawVertex const& v2, IRenderer::DrawVertex const& v3, IRenderer::DrawVertex const& v4)
     {
-        if ((_draw_list.vertex.capacity - _draw_list.vertex.size) < 4 || (_draw_list.index.capacity - _draw_list.index.size) < 6)
-        {
-            if (!batchFlush()) return false;
-        }
+        if (!reserveDrawList(4, 6, true)) return false;
         assert(_draw_list.command.size > 0);
         DrawCommand& cmd_ = _draw_list.command.data[_draw_list.command.size - 1];
         IRenderer::DrawVertex* vbuf_ = _draw_list.vertex.data + _draw_list.vertex.size;
@@ -953,14 +1679,18 @@ namespace Core::Graphics
         vbuf_[1] = v2;
         vbuf_[2] = v3;
         vbuf_[3] = v4;
+        if (_premul_vertex != PremulVertex::None)
+        {
+            vbuf_[0].color = premulVertexColor(v1.color, _premul_vertex);
+            vbuf_[1].color = premulVertexColor(v2.color, _premul_vertex);
+            vbuf_[2].color = premulVertexColor(v3.color, _premul_vertex);
+            vbuf_[3].color = premulVertexColor(v4.color, _premul_vertex);
+        }
         _draw_list.vertex.size += 4;
-        DrawIndex* ibuf_ = _draw_list.index.data + _draw_list.index.size;
-        ibuf_[0] = cmd_.vertex_count;
-        ibuf_[1] = cmd_.vertex_count + 1;
-        ibuf_[2] = cmd_.vertex_count + 2;
-        ibuf_[3] = cmd_.vertex_count;
-        ibuf_[4] = cmd_.vertex_count + 2;
-        ibuf_[5] = cmd_.vertex_count + 3;
+        if (_draw_list.index.index32)
+            write_quad_index<DrawIndex32>(_draw_list.index.data, _draw_list.index.size, cmd_.vertex_count);
+        else
+            write_quad_index<DrawIndex>(_draw_list.index.data, _draw_list.index.size, cmd_.vertex_count);
         _draw_list.index.size += 6;
         cmd_.vertex_count += 4;
         cmd_.index_count += 6;
@@ -970,62 +1700,333 @@ namespace Core::Graphics
     {
         return drawQuad(pvert[0], pvert[1], pvert[2], pvert[3]);
     }
-    bool Renderer_OpenGL::drawRaw(IRenderer::DrawVertex const* pvert, uint16_t nvert, DrawIndex const* pidx, uint16_t nidx)
+    bool Renderer_OpenGL::drawRawImpl(IRenderer::DrawVertex const* pvert, size_t nvert, void const* pidx, bool pidx32, size_t nidx)
     {
-        if (nvert > _draw_list.vertex.capacity || nidx > _draw_list.index.capacity)
+        // 16-bit indices can always be written relative to a command, 32-bit ones only when they fit
+        bool const wide = pidx32 && nvert > DrawList::max_command_vertex_count_16;
+        if (!requireDrawList(nvert, nidx, wide)) return false;
+        if (!reserveDrawList(nvert, nidx, wide)) return false;
+
+        assert(_draw_list.command.size > 0);
+        DrawCommand& cmd_ = _draw_list.command.data[_draw_list.command.size - 1];
+
+        IRenderer::DrawVertex* vbuf_ = _draw_list.vertex.data + _draw_list.vertex.size;
+        if (_premul_vertex != PremulVertex::None)
         {
-            assert(false); return false;
+            for (size_t i = 0; i < nvert; i += 1)
+            {
+                vbuf_[i] = pvert[i];
+                vbuf_[i].color = premulVertexColor(pvert[i].color, _premul_vertex);
+            }
+        }
+        else
+        {
+            std::memcpy(vbuf_, pvert, nvert * sizeof(IRenderer::DrawVertex));
         }
+        _draw_list.vertex.size += nvert;
 
-        if ((_draw_list.vertex.capacity - _draw_list.vertex.size) < nvert || (_draw_list.index.capacity - _draw_list.index.size) < nidx)
+        if (_draw_list.index.index32)
+        {
+            if (pidx32)
+                write_offset_index<DrawIndex32>(_draw_list.index.data, _draw_list.index.size, static_cast<DrawIndex32 const*>(pidx), nidx, cmd_.vertex_count);
+            else
+                write_offset_index<DrawIndex32>(_draw_list.index.data, _draw_list.index.size, static_cast<DrawIndex const*>(pidx), nidx, cmd_.vertex_count);
+        }
+        else
         {
-            if (!batchFlush()) return false;
+            if (pidx32)
+                write_offset_index<DrawIndex>(_draw_list.index.data, _draw_list.index.size, static_cast<DrawIndex32 const*>(pidx), nidx, cmd_.vertex_count);
+            else
+                write_offset_index<DrawIndex>(_draw_list.index.data, _draw_list.index.size, static_cast<DrawIndex const*>(pidx), nidx, cmd_.vertex_count);
         }
+        _draw_list.index.size += nidx;
 
-        assert(_draw_list.command.size > 0);
+        cmd_.vertex_count += (uint32_t)nvert;
+        cmd_.index_count += (uint32_t)nidx;
+
+        return true;
+    }
+    bool Renderer_OpenGL::drawRequestImpl(size_t nvert, size_t nidx, IRenderer::DrawVertex** ppvert, void** ppidx, bool pidx32, uint32_t* idxoffset)
+    {
+        bool const wide = pidx32 && nvert > DrawList::max_command_vertex_count_16;
+        if (!requireDrawList(nvert, nidx, wide)) return false;
+        if (!reserveDrawList(nvert, nidx, wide)) return false;
+
+        // assert(_draw_list.command.size > 0);
         DrawCommand& cmd_ = _draw_list.command.data[_draw_list.command.size - 1];
 
-        IRenderer::DrawVertex* vbuf_ = _draw_list.vertex.data + _draw_list.vertex.size;
-        std::memcpy(vbuf_, pvert, nvert * sizeof(IRenderer::DrawVertex));
+        *ppvert = _draw_list.vertex.data + _draw_list.vertex.size;
+        if (_premul_vertex != PremulVertex::None)
+        {
+            // The caller writes plain colors, convert them on the next call (draw list memory may be mapped, do not read it back)
+            if (_draw_request_staging.size() < nvert)
+            {
+                _draw_request_staging.resize(nvert);
+            }
+            _draw_request_target = *ppvert;
+            _draw_request_count = nvert;
+            _draw_request_premul = _premul_vertex;
+            *ppvert = _draw_request_staging.data();
+        }
         _draw_list.vertex.size += nvert;
 
-        DrawIndex* ibuf_ = _draw_list.index.data + _draw_list.index.size;
-        for (size_t idx_ = 0; idx_ < nidx; idx_ += 1)
+        void* const ibuf_ = static_cast<uint8_t*>(_draw_list.index.data) + _draw_list.index.size * getDrawIndexStride();
+        *ppidx = ibuf_;
+        if (pidx32 != _draw_list.index.index32)
         {
-            ibuf_[idx_] = cmd_.vertex_count + pidx[idx_];
+            // The caller writes indices of the other width, convert them on the next call
+            if (pidx32)
+            {
+                if (_draw_request_index32_staging.size() < nidx)
+                    _draw_request_index32_staging.resize(nidx);
+                *ppidx = _draw_request_index32_staging.data();
+            }
+            else
+            {
+                if (_draw_request_index_staging.size() < nidx)
+                    _draw_request_index_staging.resize(nidx);
+                *ppidx = _draw_request_index_staging.data();
+            }
+            _draw_request_index_target = ibuf_;
+            _draw_request_index_count = nidx;
         }
         _draw_list.index.size += nidx;
 
-        cmd_.vertex_count += nvert;
-        cmd_.index_count += nidx;
+        *idxoffset = cmd_.vertex_count; // Output vertex offset
+        cmd_.vertex_count += (uint32_t)nvert;
+        cmd_.index_count += (uint32_t)nidx;
 
         return true;
     }
+    bool Renderer_OpenGL::drawRaw(IRenderer::DrawVertex const* pvert, uint16_t nvert, DrawIndex const* pidx, uint16_t nidx)
+    {
+        return drawRawImpl(pvert, nvert, pidx, false, nidx);
+    }
+    bool Renderer_OpenGL::drawRaw(IRenderer::DrawVertex const* pvert, uint32_t nvert, DrawIndex32 const* pidx, uint32_t nidx)
+    {
+        return drawRawImpl(pvert, nvert, pidx, true, nidx);
+    }
     bool Renderer_OpenGL::drawRequest(uint16_t nvert, uint16_t nidx, IRenderer::DrawVertex** ppvert, DrawIndex** ppidx, uint16_t* idxoffset)
     {
-        if (nvert > _draw_list.vertex.capacity || nidx > _draw_list.index.capacity)
+        void* pidx = nullptr;
+        uint32_t offset = 0;
+        if (!drawRequestImpl(nvert, nidx, ppvert, &pidx, false, &offset)) return false;
+        *ppidx = static_cast<DrawIndex*>(pidx);
+        *idxoffset = (uint16_t)offset; // Commands of 16-bit callers never exceed 65536 vertices
+        return true;
+    }
+    bool Renderer_OpenGL::drawRequest(uint32_t nvert, uint32_t nidx, IRenderer::DrawVertex** ppvert, DrawIndex32** ppidx, uint32_t* idxoffset)
+    {
+        void* pidx = nullptr;
+        if (!drawRequestImpl(nvert, nidx, ppvert, &pidx, true, idxoffset)) return false;
+        *ppidx = static_cast<DrawIndex32*>(pidx);
+        return true;
+    }
+    bool Renderer_OpenGL::drawSpriteInstances(ITexture2D* texture, SpriteInstanceRect const* rects, size_t rect_count, SpriteInstance const* instances, size_t count)
+    {
+        if (!texture || !rects || rect_count == 0 || rect_count > SpriteInstanceMaxRectCount || (count > 0 && !instances))
         {
             assert(false); return false;
         }
+        if (count == 0)
+        {
+            return true;
+        }
+        if (_bundle_capture)
+        {
+            return drawSpriteInstancesAsQuads(this, texture, rects, rect_count, instances, count);
+        }
+
+        // Everything queued before must be drawn first
+        if (!batchFlush()) return false;
+
+        ZoneScoped;
+        TracyGpuZone("DrawSpriteInstances");
+        FrameProfiler::get().addCounter("Renderer.SpriteInstances", (int64_t)count);
+
+        // Upload rect table and instances, orphaning the previous storage
 
-        if ((_draw_list.vertex.capacity - _draw_list.vertex.size) < nvert || (_draw_list.index.capacity - _draw_list.index.size) < nidx)
+        glBindBuffer(GL_UNIFORM_BUFFER, _instance_rect_buffer);
+        glBufferData(GL_UNIFORM_BUFFER, SpriteInstanceMaxRectCount * sizeof(SpriteInstanceRect), 0, GL_STREAM_DRAW);
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, rect_count * sizeof(SpriteInstanceRect), rects);
+        glBindBufferBase(GL_UNIFORM_BUFFER, 4, _instance_rect_buffer);
+
+        glBindVertexArray(_instance_vao);
+        glBindBuffer(GL_ARRAY_BUFFER, _instance_buffer);
+        if (count > _instance_buffer_capacity)
         {
-            if (!batchFlush()) return false;
+            _instance_buffer_capacity = std::max<size_t>({ count, _instance_buffer_capacity * 2, 4096 });
         }
+        glBufferData(GL_ARRAY_BUFFER, _instance_buffer_capacity * sizeof(SpriteInstance), 0, GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, count * sizeof(SpriteInstance), instances);
 
-        // assert(_draw_list.command.size > 0);
-        DrawCommand& cmd_ = _draw_list.command.data[_draw_list.command.size - 1];
+        // Draw
 
-        *ppvert = _draw_list.vertex.data + _draw_list.vertex.size;
-        _draw_list.vertex.size += nvert;
+        bindTextureAlphaType(texture);
+        bindTextureSamplerState(texture);
+        useProgram(_instance_programs[IDX(_state_set.vertex_color_blend_state)][IDX(_state_set.fog_state)][IDX(_state_set.texture_alpha_type)]);
+        if (_premul_vertex != PremulVertex::None)
+        {
+            // Instance colors are not premultiplied, use the real blend function for this draw
+            applyBlendState(_state_set.blend_state);
+        }
+        glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, (GLsizei)count);
+        _gl_call_count += 1;
+        _draw_call_count += 1;
+        if (_premul_vertex != PremulVertex::None)
+        {
+            applyBlendState(BlendState::Alpha);
+        }
 
-        *ppidx = _draw_list.index.data + _draw_list.index.size;
-        _draw_list.index.size += nidx;
+        // Back to the batch
 
-        *idxoffset = cmd_.vertex_count; // Output vertex offset
-        cmd_.vertex_count += nvert;
-        cmd_.index_count += nidx;
+        setVertexIndexBuffer();
+        setTexture(_state_texture.get());
+        return true;
+    }
+
+    bool Renderer_OpenGL::beginBundle()
+    {
+        if (_bundle_capture)
+        {
+            spdlog::error("[core] A render bundle is already being recorded");
+            return false;
+        }
+        if (!batchFlush()) return false;
+        // Bundles hold straight vertex colors, so they can be replayed with any premultiplied batching setting
+        _bundle_premul_batching = _premul_batching;
+        setPremultipliedBatching(false);
+        try
+        {
+            _bundle_capture.attach(new RenderBundle_OpenGL(m_device.get()));
+        }
+        catch (...)
+        {
+            setPremultipliedBatching(_bundle_premul_batching);
+            return false;
+        }
+        // Switch the draw list to the staging arrays
+        clearDrawList();
+        setTexture(_state_texture.get());
+        return true;
+    }
+    bool Renderer_OpenGL::endBundle(IRenderBundle** pp_bundle)
+    {
+        *pp_bundle = nullptr;
+        if (!_bundle_capture)
+        {
+            spdlog::error("[core] No render bundle is being recorded");
+            return false;
+        }
+        bool const result = batchFlush(false, FlushCause::BatchEnd);
+        ScopeObject<RenderBundle_OpenGL> bundle(_bundle_capture);
+        _bundle_capture.reset();
+        clearDrawList();
+        setTexture(_state_texture.get());
+        setPremultipliedBatching(_bundle_premul_batching);
+        if (!result)
+        {
+            return false;
+        }
+        bool const built = bundle->build();
+        if (_batch_scope)
+        {
+            setVertexIndexBuffer();
+        }
+        if (!built)
+        {
+            spdlog::error("[core] Unable to create render bundle buffers ({} vertices, {} indices)", bundle->getVertexCount(), bundle->getIndexCount());
+            return false;
+        }
+        *pp_bundle = bundle.get();
+        (*pp_bundle)->retain();
+        return true;
+    }
+    bool Renderer_OpenGL::drawBundle(IRenderBundle* p_bundle, RenderBundleTransform const& transform)
+    {
+        if (!p_bundle)
+        {
+            assert(false); return false;
+        }
+        if (_bundle_capture)
+        {
+            spdlog::error("[core] Render bundles cannot be recorded into another render bundle");
+            return false;
+        }
+        auto* bundle = static_cast<RenderBundle_OpenGL*>(p_bundle);
+        if (bundle->GetVertexArray() == 0)
+        {
+            return bundle->GetCommands().empty();
+        }
+
+        // Everything queued before must be drawn first
+        if (!batchFlush()) return false;
+
+        ZoneScoped;
+        TracyGpuZone("DrawBundle");
+        FrameProfiler::get().addCounter("Renderer.BundleDraws", 1);
+
+        // The transform goes into the view projection matrix, the camera position into bundle space for fog
+
+        glm::mat4 const world = glm::scale(
+            glm::rotate(
+                glm::translate(glm::mat4(1.0f), glm::vec3(transform.position.x, transform.position.y, transform.position.z)),
+                transform.rotation, glm::vec3(0.0f, 0.0f, 1.0f)),
+            glm::vec3(transform.scale.x, transform.scale.y, transform.scale.z));
+        glm::mat4 const view_proj = makeViewProjection(_camera_state_set);
+        auto const upload_camera = [&](glm::mat4 const& m4, glm::vec3 const& eye)
+        {
+            glBindBuffer(GL_UNIFORM_BUFFER, _vp_matrix_buffer);
+            glBufferData(GL_UNIFORM_BUFFER, sizeof(m4), &m4, GL_STATIC_DRAW);
+            _gl_call_count += 2;
+            if (_camera_state_set.is_3D)
+            {
+                Vector3F const& lookat = _camera_state_set.lookat;
+                Vector3F const& eye_ = _camera_state_set.eye;
+                float const camera_pos[8] = {
+                    eye.x, eye.y, eye.z, 0.0f,
+                    lookat.x - eye_.x, eye_.y - lookat.y, lookat.z - eye_.z, 0.0f,
+                };
+                glBindBuffer(GL_UNIFORM_BUFFER, _camera_pos_buffer);
+                glBufferData(GL_UNIFORM_BUFFER, sizeof(camera_pos), &camera_pos, GL_STATIC_DRAW);
+                _gl_call_count += 2;
+            }
+        };
+        glm::vec3 const eye(_camera_state_set.eye.x, _camera_state_set.eye.y, _camera_state_set.eye.z);
+        upload_camera(view_proj * world, glm::vec3(glm::inverse(world) * glm::vec4(eye, 1.0f)));
+
+        // Draw with the recorded states
 
+        RendererStateSet const state = _state_set;
+        bool const premul_batching = _premul_batching;
+        setPremultipliedBatching(false);
+        for (auto const& cmd_ : bundle->GetCommands())
+        {
+            setVertexColorBlendState(cmd_.state.vertex_color_blend_state);
+            setFogState(cmd_.state.fog_state, cmd_.state.fog_color, cmd_.state.fog_near_or_density, cmd_.state.fog_far);
+            setDepthState(cmd_.state.depth_state);
+            setBlendState(cmd_.state.blend_state);
+            bindTextureAlphaType(cmd_.texture.get());
+            bindTextureSamplerState(cmd_.texture.get());
+            useProgram(_programs[IDX(_state_set.vertex_color_blend_state)][IDX(_state_set.fog_state)][IDX(_state_set.texture_alpha_type)]);
+            // Flushing the empty draw list on a state change may bind the batch vertex array
+            glBindVertexArray(bundle->GetVertexArray());
+            glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)cmd_.index_count, GL_UNSIGNED_INT,
+                (void*)(cmd_.index_offset * sizeof(DrawIndex32)), (GLint)cmd_.vertex_offset);
+            _gl_call_count += 2;
+            _draw_call_count += 1;
+        }
+
+        // Back to the batch
+
+        setVertexColorBlendState(state.vertex_color_blend_state);
+        setFogState(state.fog_state, state.fog_color, state.fog_near_or_density, state.fog_far);
+        setDepthState(state.depth_state);
+        setBlendState(state.blend_state);
+        setPremultipliedBatching(premul_batching);
+        upload_camera(view_proj, eye);
+        setVertexIndexBuffer();
+        setTexture(_state_texture.get());
         return true;
     }
 
@@ -1053,6 +2054,11 @@ namespace Core::Graphics
         assert((cv_n == 0) || (cv_n > 0 && cv));
         assert((tv_sv_n == 0) || (tv_sv_n > 0 && p_tex_arr && sv));
 
+        if (_bundle_capture)
+        {
+            spdlog::error("[core] Post effects cannot be recorded into a render bundle");
+            return false;
+        }
         if (!endBatch()) return false;
         
         // PREPARE
@@ -1129,13 +2135,11 @@ namespace Core::Graphics
 
         for (int stage = 0; stage < std::min<int>((int)tv_sv_n, 4); stage++)
         {
-            glActiveTexture(GL_TEXTURE1 + stage);
-            glBindTexture(GL_TEXTURE_2D, static_cast<Texture2D_OpenGL*>(p_tex_arr[stage])->GetResource());
-            setSamplerState(sv[stage], stage);
+            bindTexture(1 + stage, static_cast<Texture2D_OpenGL*>(p_tex_arr[stage])->GetResource());
+            setSamplerState(sv[stage], 1 + stage);
         }
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, static_cast<Texture2D_OpenGL*>(p_tex)->GetResource());
-        setSamplerState(rtsv, 4);
+        bindTexture(0, static_cast<Texture2D_OpenGL*>(p_tex)->GetResource());
+        setSamplerState(rtsv, 0);
 
         glDisable(GL_DEPTH_TEST);
         switch (blend) {
@@ -1198,6 +2202,7 @@ namespace Core::Graphics
         // DRAW
 
         glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, NULL);
+        _draw_call_count += 1;
 
         return beginBatch();
     }
@@ -1205,6 +2210,11 @@ namespace Core::Graphics
     {
         assert(p_effect);
 
+        if (_bundle_capture)
+        {
+            spdlog::error("[core] Post effects cannot be recorded into a render bundle");
+            return false;
+        }
         if (!endBatch()) return false;
 
         // PREPARE
@@ -1342,6 +2352,7 @@ namespace Core::Graphics
         // DRAW
 
         glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, NULL);
+        _draw_call_count += 1;
 
         return beginBatch();
     }
@@ -1382,6 +2393,11 @@ namespace Core::Graphics
             assert(false);
             return false;
         }
+        if (_bundle_capture)
+        {
+            spdlog::error("[core] Models cannot be recorded into a render bundle");
+            return false;
+        }
 
         if (!endBatch())
         {
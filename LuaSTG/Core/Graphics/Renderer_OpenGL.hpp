@@ -5,6 +5,7 @@
 #include "Core/Graphics/Device_OpenGL.hpp"
 #include "Core/Graphics/Model_OpenGL.hpp"
 #include "glad/gl.h"
+#include <vector>
 
 #define IDX(x) (size_t)static_cast<uint8_t>(x)
 
@@ -66,30 +67,57 @@ namespace Core::Graphics
 	struct DrawCommand
 	{
 		ScopeObject<Texture2D_OpenGL> texture;
-		uint16_t vertex_count = 0;
-		uint16_t vertex_offset = 0;
-		uint16_t index_count = 0;
+		uint32_t vertex_count = 0;
+		uint32_t vertex_offset = 0;
+		uint32_t index_count = 0;
+	};
+
+	// Persistently mapped, coherent ring buffer (GL_ARB_buffer_storage), split into sections.
+	// A fence is inserted when the writer leaves a section and waited on before the writer enters it again.
+	struct PersistentRingBuffer
+	{
+		static constexpr size_t section_count = 3;
+
+		GLuint buffer = 0;
+		uint8_t* mapped = nullptr;
+		size_t stride = 0;
+		size_t section_size = 0; // In elements
+		size_t section = 0; // Section the writer is in
+		GLsync fence[section_count] = {};
+
+		bool create(GLuint buffer_, GLenum target, size_t stride_, size_t section_size_);
+		void destroy();
+		void* pointer(size_t offset) { return mapped + offset * stride; }
+		// Elements left in the current section after offset
+		size_t available(size_t offset) const { return (section + 1) * section_size - offset; }
+		// Fences the current section and waits until the GPU is done with the next one, returns its first element
+		size_t nextSection();
 	};
 
 	struct DrawList
 	{
+		// 16-bit indices are relative to the first vertex of their command, so a command holds at most this many vertices
+		static constexpr size_t max_command_vertex_count_16 = 65536;
+
+		// The storage is either a staging array uploaded with glBufferSubData,
+		// or the mapped ring buffer at the current write offset
 		struct VertexBuffer
 		{
-			const size_t capacity = 32768;
+			size_t capacity = 0;
 			size_t size = 0;
-			IRenderer::DrawVertex data[32768] = {};
+			IRenderer::DrawVertex* data = nullptr;
 		} vertex;
 		struct IndexBuffer
 		{
-			const size_t capacity = 32768;
+			size_t capacity = 0;
 			size_t size = 0;
-			IRenderer::DrawIndex data[32768] = {};
+			void* data = nullptr; // DrawIndex or DrawIndex32
+			bool index32 = false;
 		} index;
 		struct DrawCommandBuffer
 		{
-			const size_t capacity = 2048;
 			size_t size = 0;
-			DrawCommand data[2048] = {};
+			std::vector<DrawCommand> data;
 		} command;
 	};
 
@@ -146,6 +174,55 @@ namespace Core::Graphics
 		~PostEffectShader_OpenGL();
 	};
 
+	// Draws recorded between IRenderer::beginBundle and IRenderer::endBundle.
+	// The CPU copies are kept to recreate the static buffers with the device.
+	class RenderBundle_OpenGL
+		: public Object<IRenderBundle>
+		, IDeviceEventListener
+	{
+	public:
+		struct Command
+		{
+			ScopeObject<Texture2D_OpenGL> texture;
+			uint32_t vertex_offset = 0; // Base vertex
+			uint32_t index_offset = 0;
+			uint32_t index_count = 0;
+			RendererStateSet state; // Only the vertex color blend, fog, depth and blend states are replayed
+		};
+
+	private:
+		ScopeObject<Device_OpenGL> m_device;
+		std::vector<IRenderer::DrawVertex> m_vertex;
+		std::vector<IRenderer::DrawIndex32> m_index;
+		std::vector<Command> m_command;
+		GLuint m_vao = 0;
+		GLuint m_vertex_buffer = 0;
+		GLuint m_index_buffer = 0;
+
+		static bool isSameState(RendererStateSet const& a, RendererStateSet const& b);
+		bool createResources();
+		void destroyResources();
+		void onDeviceCreate();
+		void onDeviceDestroy();
+
+	public:
+		// Indices are relative to the first vertex, 16-bit or 32-bit
+		void append(Texture2D_OpenGL* texture, RendererStateSet const& state,
+			IRenderer::DrawVertex const* vertex, size_t vertex_count, void const* index, bool index32, size_t index_count);
+		bool build() { return createResources(); }
+		GLuint GetVertexArray() const noexcept { return m_vao; }
+		std::vector<Command> const& GetCommands() const noexcept { return m_command; }
+
+	public:
+		uint32_t getVertexCount() { return (uint32_t)m_vertex.size(); }
+		uint32_t getIndexCount() { return (uint32_t)m_index.size(); }
+		uint32_t getCommandCount() { return (uint32_t)m_command.size(); }
+
+	public:
+		RenderBundle_OpenGL(Device_OpenGL* p_device);
+		~RenderBundle_OpenGL();
+	};
+
 	class Renderer_OpenGL
 		: public Object<IRenderer>
 		, IDeviceEventListener
@@ -162,9 +239,46 @@ namespace Core::Graphics
 		const size_t _vi_buffer_count = 1;
 		DrawList _draw_list;
 
+		GLuint _instance_vao = 0;
+		GLuint _instance_buffer = 0;
+		size_t _instance_buffer_capacity = 0; // In instances
+		GLuint _instance_rect_buffer = 0; // Bound to uniform block 4 while drawing instances
+
+		std::vector<DrawVertex> _draw_list_vertex_staging; // Only used without the ring buffer or while recording a bundle
+		std::vector<DrawIndex32> _draw_list_index_staging; // Holds 16-bit indices too
+		bool _vi_ring_enable = false;
+		PersistentRingBuffer _vertex_ring;
+		PersistentRingBuffer _index_ring;
+		DrawListConfig _draw_list_config;
+
+		// Why the draw list is flushed, reported as Renderer.BatchFlushState and Renderer.BatchFlushCapacity
+		enum class FlushCause : uint8_t
+		{
+			State,    // Render state, texture or render target changes
+			Capacity, // The draw list is full
+			BatchEnd, // endBatch
+		};
+
 		void setVertexIndexBuffer(size_t index = 0xFFFFFFFFu);
 		bool uploadVertexIndexBuffer(bool discard);
 		void clearDrawList();
+		void bindDrawListStorage();
+		// index32: the caller can write 32-bit indices, otherwise a command never holds more than 65536 vertices
+		bool reserveDrawList(size_t nvert, size_t nidx, bool index32);
+		// Grows the draw list or switches it to 32-bit indices when a draw needs it
+		bool requireDrawList(size_t nvert, size_t nidx, bool index32);
+		bool rebuildDrawList(DrawListConfig const& config);
+		// pidx32: width of the caller's indices, converted when it differs from the draw list
+		bool drawRawImpl(DrawVertex const* pvert, size_t nvert, void const* pidx, bool pidx32, size_t nidx);
+		bool drawRequestImpl(size_t nvert, size_t nidx, DrawVertex** ppvert, void** ppidx, bool pidx32, uint32_t* idxoffset);
+		bool createDrawListBuffers();
+		void destroyDrawListBuffers();
+		size_t getDrawIndexStride() const { return _draw_list.index.index32 ? sizeof(DrawIndex32) : sizeof(DrawIndex); }
+
+		// Bundle being recorded, batchFlush appends the draw list to it instead of drawing
+		ScopeObject<RenderBundle_OpenGL> _bundle_capture;
+		bool _bundle_premul_batching = false; // Premultiplied batching is suspended while recording
+		void captureDrawList();
 
 		GLuint _vp_matrix_buffer = 0;
 		GLuint _world_matrix_buffer = 0;
@@ -176,11 +290,15 @@ namespace Core::Graphics
 		// GLuint _vertex_shader[IDX(FogState::MAX_COUNT)]; // FogState
 		// GLuint _pixel_shader[IDX(VertexColorBlendState::MAX_COUNT)][IDX(FogState::MAX_COUNT)][IDX(TextureAlphaType::MAX_COUNT)]; // VertexColorBlendState, FogState, TextureAlphaType
 		GLuint _programs[IDX(VertexColorBlendState::MAX_COUNT)][IDX(FogState::MAX_COUNT)][IDX(TextureAlphaType::MAX_COUNT)]; // VertexColorBlendState, FogState, TextureAlphaType
+		GLuint _instance_programs[IDX(VertexColorBlendState::MAX_COUNT)][IDX(FogState::MAX_COUNT)][IDX(TextureAlphaType::MAX_COUNT)]; // Same as above, with the sprite instance vertex shader
+		GLuint _premul_vertex_programs[IDX(TextureAlphaType::MAX_COUNT)]; // Mul with premultiplied vertex colors, used by premultiplied batching (never with fog)
 		// GLuint _program;
 		// GLint idx_blend_uniform;
 		// GLint idx_fog_uniform;
 		// Microsoft::WRL::ComPtr<ID3D11RasterizerState> _raster_state;
 		Graphics::SamplerState _sampler_state[IDX(SamplerState::MAX_COUNT)];
+		GLuint _sampler_objects[IDX(SamplerState::MAX_COUNT)] = {}; // Sampler objects of the known sampler states
+		std::vector<std::pair<Graphics::SamplerState, GLuint>> _sampler_object_cache; // All sampler objects, including those for texture-provided states
 		// Microsoft::WRL::ComPtr<ID3D11DepthStencilState> _depth_state[IDX(DepthState::MAX_COUNT)];
 		// Microsoft::WRL::ComPtr<ID3D11BlendState> _blend_state[IDX(BlendState::MAX_COUNT)];
 		
@@ -190,6 +308,48 @@ namespace Core::Graphics
 		bool _state_dirty = false;
 		bool _batch_scope = false;
 
+		// Premultiplied batching, see IRenderer::setPremultipliedBatching
+		enum class PremulVertex : uint8_t
+		{
+			None,  // Vertex colors are written as is
+			Alpha, // Premultiplied
+			Add,   // Premultiplied, alpha 0
+		};
+		bool _premul_batching = false;
+		PremulVertex _premul_vertex = PremulVertex::None;
+		std::vector<DrawVertex> _draw_request_staging; // drawRequest hands this out while vertex colors need to be converted
+		DrawVertex* _draw_request_target = nullptr;
+		size_t _draw_request_count = 0;
+		PremulVertex _draw_request_premul = PremulVertex::None;
+		// drawRequest also hands out staging indices when the caller's index width differs from the draw list
+		std::vector<DrawIndex> _draw_request_index_staging;
+		std::vector<DrawIndex32> _draw_request_index32_staging;
+		void* _draw_request_index_target = nullptr;
+		size_t _draw_request_index_count = 0;
+
+		void updatePremulVertex();
+		void applyBlendState(BlendState state);
+		void commitDrawRequest();
+		uint32_t premulVertexColor(uint32_t color, PremulVertex mode);
+
+		// Shadow of the GL bindings used by the batch, only changes reach the driver.
+		// Models, post effects, the swap chain and imgui bind freely, so the shadow is reset by endBatch.
+		static constexpr GLuint unknown_binding = ~GLuint(0);
+		static constexpr GLuint shadow_texture_unit_count = 8;
+		GLuint _bound_program = unknown_binding;
+		GLuint _bound_texture_unit = unknown_binding;
+		GLuint _bound_texture[shadow_texture_unit_count] = {};
+		GLuint _bound_sampler[shadow_texture_unit_count] = {};
+		uint32_t _texture_binding_generation = 0; // g_texture_binding_generation when _bound_texture was last valid
+		int64_t _gl_call_count = 0; // Reported to the frame profiler by endBatch
+		int64_t _gl_call_skip_count = 0;
+		int64_t _draw_call_count = 0;
+
+		GLuint getSamplerObject(Graphics::SamplerState const& state);
+		void resetStateShadow();
+		void useProgram(GLuint program);
+		void bindSampler(GLuint unit, GLuint sampler);
+
 		bool createBuffers();
 		bool createStates();
 		bool createShaders();
@@ -197,13 +357,14 @@ namespace Core::Graphics
 		bool uploadVertexIndexBufferFromDrawList();
 		void bindTextureSamplerState(ITexture2D* texture);
 		void bindTextureAlphaType(ITexture2D* texture);
-		bool batchFlush(bool discard = false);
+		bool batchFlush(bool discard = false, FlushCause cause = FlushCause::State);
 
 		bool createResources();
 		void onDeviceCreate();
 		void onDeviceDestroy();
 
 	public:
+		void bindTexture(GLuint unit, GLuint texture);
 		void setSamplerState(IRenderer::SamplerState state, GLuint index);
 		void setSamplerState(Graphics::SamplerState state, GLuint index);
 
@@ -230,6 +391,8 @@ namespace Core::Graphics
 		void setDepthState(DepthState state);
 		void setBlendState(BlendState state);
 		void setTexture(ITexture2D* texture);
+		void setPremultipliedBatching(bool enable);
+		bool getPremultipliedBatching() { return _premul_batching; }
 
 		bool drawTriangle(DrawVertex const& v1, DrawVertex const& v2, DrawVertex const& v3);
 		bool drawTriangle(DrawVertex const* pvert);
@@ -237,6 +400,15 @@ namespace Core::Graphics
 		bool drawQuad(DrawVertex const* pvert);
 		bool drawRaw(DrawVertex const* pvert, uint16_t nvert, DrawIndex const* pidx, uint16_t nidx);
 		bool drawRequest(uint16_t nvert, uint16_t nidx, DrawVertex** ppvert, DrawIndex** ppidx, uint16_t* idxoffset);
+		bool drawRaw(DrawVertex const* pvert, uint32_t nvert, DrawIndex32 const* pidx, uint32_t nidx);
+		bool drawRequest(uint32_t nvert, uint32_t nidx, DrawVertex** ppvert, DrawIndex32** ppidx, uint32_t* idxoffset);
+		void setDrawListConfig(DrawListConfig const& config);
+		DrawListConfig getDrawListConfig() { return _draw_list_config; }
+		bool drawSpriteInstances(ITexture2D* texture, SpriteInstanceRect const* rects, size_t rect_count, SpriteInstance const* instances, size_t count);
+		bool beginBundle();
+		bool endBundle(IRenderBundle** pp_bundle);
+		bool isBundleScope() { return _bundle_capture.get() != nullptr; }
+		bool drawBundle(IRenderBundle* p_bundle, RenderBundleTransform const& transform);
 
 		bool createPostEffectShader(StringView path, IPostEffectShader** pp_effect);
 		bool drawPostEffect(
@@ -113,6 +113,19 @@ vec4 vb_mul_pmul()
     return color;
 }}
 
+vec4 vb_mul_vpmul()
+{{
+    // vertex color is premultiplied, alpha is 0 for additive vertices
+    vec4 color = texture(sampler0, uv);
+    color.rgb *= color.a;
+    return color * col;
+}}
+
+vec4 vb_mul_vpmul_pmul()
+{{
+    return texture(sampler0, uv) * col; // both premultiplied
+}}
+
 #if defined(VERTEX_HUE)
 vec4 vb_hue()
 {{
@@ -194,6 +207,8 @@ void main()
         col_out = vb_zero_pmul();
     #elif defined(VERTEX_HUE)
         col_out = vb_hue_pmul();
+    #elif defined(VERTEX_MUL_VPMUL)
+        col_out = vb_mul_vpmul_pmul();
     #else // VERTEX_MUL
         col_out = vb_mul_pmul();
     #endif
@@ -206,6 +221,8 @@ void main()
         col_out = vb_zero();
     #elif defined(VERTEX_HUE)
         col_out = vb_hue();
+    #elif defined(VERTEX_MUL_VPMUL)
+        col_out = vb_mul_vpmul();
     #else // VERTEX_MUL
         col_out = vb_mul();
     #endif
@@ -276,6 +293,64 @@ void main()
 
 const constexpr std::string_view dvert_sv{default_vertex};
 
+// Sprite Instance Vertex Shader
+// Expands one instance into a quad drawn as a 4 vertices triangle strip
+const constexpr GLchar instance_vertex[]{R"(
+#version 410 core
+
+#define VVAL{}
+
+uniform view_proj_buffer
+{{
+    mat4 view_proj;
+}};
+layout(std140) uniform sprite_rect_buffer
+{{
+    vec4 sprite_rect[512]; // pos, uv
+}};
+
+layout(location = 0) in vec3 pos_in;
+layout(location = 1) in vec3 rot_scale_in;
+layout(location = 2) in uint rect_in;
+layout(location = 3) in vec4 col_in;
+
+layout(location = 0) out vec4 sxy;
+layout(location = 1) out vec4 pos;
+layout(location = 2) out vec2 uv;
+layout(location = 3) out vec4 col;
+
+#if defined(VVALVERTEX_HUE)
+layout(location = 4) out vec2 hue;
+#endif
+
+#define PI 3.1415926538
+
+void main()
+{{
+    vec2 corner = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1));
+    vec4 rect_pos = sprite_rect[rect_in * 2u];
+    vec4 rect_uv = sprite_rect[rect_in * 2u + 1u];
+
+    vec2 offset = mix(rect_pos.xy, rect_pos.zw, corner) * rot_scale_in.yz;
+    float sinv = sin(rot_scale_in.x);
+    float cosv = cos(rot_scale_in.x);
+    offset = vec2(offset.x * cosv - offset.y * sinv, offset.x * sinv + offset.y * cosv);
+    vec4 pos_world = vec4(pos_in.xy + offset, pos_in.z, 1.0);
+
+    gl_Position = view_proj * pos_world;
+    sxy = view_proj * pos_world;
+    pos = pos_world;
+    uv = mix(rect_uv.xy, rect_uv.zw, corner);
+    col = col_in;
+#if defined(VVALVERTEX_HUE)
+    float hue_angle = (col.r*2) * PI;
+    hue = vec2(sin(hue_angle), cos(hue_angle));
+#endif
+}}
+)"};
+
+const constexpr std::string_view ivert_sv{instance_vertex};
+
 #define IDX(x) (size_t)static_cast<uint8_t>(x)
 
 namespace Core::Graphics
@@ -495,6 +570,7 @@ namespace Core::Graphics
     bool Renderer_OpenGL::createShaders()
     {
         GLuint vert = 0;
+        GLuint ivert = 0;
 
         for (int i = 0; i < IDX(VertexColorBlendState::MAX_COUNT); i++)
         for (int j = 0; j < IDX(FogState::MAX_COUNT); j++)
@@ -505,13 +581,20 @@ namespace Core::Graphics
             compileFragmentShaderMacro(s_frag.c_str(), s_frag.length(), frag);
             std::string s_vert = std::format(dvert_sv, vertex_blend_state[i]);
             compileVertexShaderMacro(s_vert.c_str(), s_vert.length(), vert);
+            std::string s_ivert = std::format(ivert_sv, vertex_blend_state[i]);
+            compileVertexShaderMacro(s_ivert.c_str(), s_ivert.length(), ivert);
             _programs[i][j][k] = glCreateProgram();
             glAttachShader(_programs[i][j][k], vert);
             glAttachShader(_programs[i][j][k], frag);
             glLinkProgram(_programs[i][j][k]);
+            _instance_programs[i][j][k] = glCreateProgram();
+            glAttachShader(_instance_programs[i][j][k], ivert);
+            glAttachShader(_instance_programs[i][j][k], frag);
+            glLinkProgram(_instance_programs[i][j][k]);
 
             glDeleteShader(frag);
             glDeleteShader(vert);
+            glDeleteShader(ivert);
 
             GLuint idx_view_proj_buffer = glGetUniformBlockIndex(_programs[i][j][k], "view_proj_buffer");
             GLuint idx_camera_data = glGetUniformBlockIndex(_programs[i][j][k], "camera_data");
@@ -520,6 +603,34 @@ namespace Core::Graphics
             glUniformBlockBinding(_programs[i][j][k], idx_view_proj_buffer, 0);
             glUniformBlockBinding(_programs[i][j][k], idx_camera_data, 2);
             glUniformBlockBinding(_programs[i][j][k], idx_fog_data, 3);
+
+            GLuint const iprgm = _instance_programs[i][j][k];
+            glUniformBlockBinding(iprgm, glGetUniformBlockIndex(iprgm, "view_proj_buffer"), 0);
+            glUniformBlockBinding(iprgm, glGetUniformBlockIndex(iprgm, "camera_data"), 2);
+            glUniformBlockBinding(iprgm, glGetUniformBlockIndex(iprgm, "fog_data"), 3);
+            glUniformBlockBinding(iprgm, glGetUniformBlockIndex(iprgm, "sprite_rect_buffer"), 4);
+        }
+
+        // Premultiplied batching is off while fog is enabled
+        for (int k = 0; k < IDX(TextureAlphaType::MAX_COUNT); k++)
+        {
+            GLuint frag = 0;
+            std::string s_frag = std::format(dfrag_sv, "VERTEX_MUL_VPMUL", fog_state[IDX(FogState::Disable)], pmul_alpha_state[k]);
+            compileFragmentShaderMacro(s_frag.c_str(), s_frag.length(), frag);
+            std::string s_vert = std::format(dvert_sv, "VERTEX_MUL_VPMUL");
+            compileVertexShaderMacro(s_vert.c_str(), s_vert.length(), vert);
+            GLuint const prgm = glCreateProgram();
+            glAttachShader(prgm, vert);
+            glAttachShader(prgm, frag);
+            glLinkProgram(prgm);
+
+            glDeleteShader(frag);
+            glDeleteShader(vert);
+
+            glUniformBlockBinding(prgm, glGetUniformBlockIndex(prgm, "view_proj_buffer"), 0);
+            glUniformBlockBinding(prgm, glGetUniformBlockIndex(prgm, "camera_data"), 2);
+            glUniformBlockBinding(prgm, glGetUniformBlockIndex(prgm, "fog_data"), 3);
+            _premul_vertex_programs[k] = prgm;
         }
 
 
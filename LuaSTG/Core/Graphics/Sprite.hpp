@@ -24,6 +24,9 @@ namespace Core::Graphics
 		virtual void setColor(Color4B const* color) = 0;
 		virtual void getColor(Color4B* color) = 0;
 
+		// Quad and texture coordinates used by IRenderer::drawSpriteInstances
+		virtual IRenderer::SpriteInstanceRect getInstanceRect() = 0;
+
 		virtual void draw(RectF const& rc) = 0;
 		virtual void draw(Vector3F const& p1, Vector3F const& p2, Vector3F const& p3, Vector3F const& p4) = 0;
 		virtual void draw(Vector3F const& pos, Vector3F const& rot, Vector2F const& scale) = 0;
@@ -57,6 +57,8 @@ namespace Core::Graphics
 			color[3] = m_color[3];
 		}
 
+		IRenderer::SpriteInstanceRect getInstanceRect() { return { m_pos_rc, m_uv }; }
+
 		void draw(RectF const& rc);
 		void draw(Vector3F const& p1, Vector3F const& p2, Vector3F const& p3, Vector3F const& p4);
 		void draw(Vector3F const& pos, Vector3F const& rot, Vector2F const& scale);
@@ -0,0 +1,166 @@
+#include "Core/Graphics/SwapChain_Null.hpp"
+#include "spdlog/spdlog.h"
+
+namespace Core::Graphics
+{
+	void SwapChain_Null::dispatchEvent(EventType t)
+	{
+		// callback
+		m_is_dispatch_event = true;
+		switch (t)
+		{
+		case EventType::SwapChainCreate:
+			for (auto& v : m_eventobj)
+			{
+				if (v) v->onSwapChainCreate();
+			}
+			break;
+		case EventType::SwapChainDestroy:
+			for (auto& v : m_eventobj)
+			{
+				if (v) v->onSwapChainDestroy();
+			}
+			break;
+		}
+		m_is_dispatch_event = false;
+		// Dealing with delayed objects
+		removeEventListener(nullptr);
+		for (auto& v : m_eventobj_late)
+		{
+			m_eventobj.emplace_back(v);
+		}
+		m_eventobj_late.clear();
+	}
+	void SwapChain_Null::addEventListener(ISwapChainEventListener* e)
+	{
+		removeEventListener(e);
+		if (m_is_dispatch_event)
+		{
+			m_eventobj_late.emplace_back(e);
+		}
+		else
+		{
+			m_eventobj.emplace_back(e);
+		}
+	}
+	void SwapChain_Null::removeEventListener(ISwapChainEventListener* e)
+	{
+		if (m_is_dispatch_event)
+		{
+			for (auto& v : m_eventobj)
+			{
+				if (v == e)
+				{
+					v = nullptr; // doesn't break traversal
+				}
+			}
+		}
+		else
+		{
+			for (auto it = m_eventobj.begin(); it != m_eventobj.end();)
+			{
+				if (*it == e)
+					it = m_eventobj.erase(it);
+				else
+					it++;
+			}
+		}
+	}
+
+	bool SwapChain_Null::setWindowMode(Vector2U size)
+	{
+		if (size.x == 0 || size.y == 0)
+		{
+			assert(false); return false;
+		}
+		m_window->setSize(size);
+		if (!m_canvas)
+		{
+			// First call works like creating the swap chain of other backends
+			return setCanvasSize(m_canvas_size);
+		}
+		return true;
+	}
+
+	bool SwapChain_Null::setCanvasSize(Vector2U size)
+	{
+		if (size.x == 0 || size.y == 0)
+		{
+			spdlog::error("[core] Cannot resize canvas to {}x{}", size.x, size.y);
+			assert(false); return false;
+		}
+
+		m_canvas_size = size;
+
+		dispatchEvent(EventType::SwapChainDestroy);
+
+		if (m_device->getBoundRenderTarget() == *m_canvas)
+		{
+			m_device->setBoundRenderTarget(nullptr);
+		}
+		m_canvas.reset();
+		try
+		{
+			m_canvas.attach(new RenderTarget_Null(*m_device, size));
+		}
+		catch (...)
+		{
+			return false;
+		}
+
+		dispatchEvent(EventType::SwapChainCreate);
+
+		return true;
+	}
+
+	void SwapChain_Null::clearRenderAttachment()
+	{
+		m_device->setBoundRenderTarget(nullptr);
+	}
+	void SwapChain_Null::applyRenderAttachment()
+	{
+		m_device->setBoundRenderTarget(*m_canvas);
+	}
+
+	bool SwapChain_Null::present()
+	{
+		m_present_count += 1;
+		return true;
+	}
+
+	bool SwapChain_Null::saveSnapshotToFile(StringView path)
+	{
+		if (!m_canvas)
+		{
+			return false;
+		}
+		return m_canvas->getTextureNull()->saveToFile(path);
+	}
+
+	SwapChain_Null::SwapChain_Null(Window_Null* p_window, Device_Null* p_device)
+		: m_window(p_window)
+		, m_device(p_device)
+	{
+		assert(p_window);
+		assert(p_device);
+	}
+	SwapChain_Null::~SwapChain_Null()
+	{
+		assert(m_eventobj.size() == 0);
+		assert(m_eventobj_late.size() == 0);
+	}
+
+	bool SwapChain_Null::create(Window_Null* p_window, Device_Null* p_device, SwapChain_Null** pp_swapchain)
+	{
+		try
+		{
+			*pp_swapchain = new SwapChain_Null(p_window, p_device);
+			return true;
+		}
+		catch (...)
+		{
+			*pp_swapchain = nullptr;
+			return false;
+		}
+	}
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include "Core/Object.hpp"
+#include "Core/Graphics/SwapChain.hpp"
+#include "Core/Graphics/Window_Null.hpp"
+#include "Core/Graphics/Device_Null.hpp"
+#include <vector>
+
+namespace Core::Graphics
+{
+	// Swap chain of the headless backend, the canvas is an ordinary render target and present only counts frames
+	class SwapChain_Null : public Object<ISwapChain>
+	{
+	private:
+		ScopeObject<Window_Null> m_window;
+		ScopeObject<Device_Null> m_device;
+		ScopeObject<RenderTarget_Null> m_canvas;
+		Vector2U m_canvas_size{ 640,480 };
+		uint64_t m_present_count{ 0 };
+
+	private:
+		enum class EventType
+		{
+			SwapChainCreate,
+			SwapChainDestroy,
+		};
+		bool m_is_dispatch_event{ false };
+		std::vector<ISwapChainEventListener*> m_eventobj;
+		std::vector<ISwapChainEventListener*> m_eventobj_late;
+		void dispatchEvent(EventType t);
+	public:
+		RenderTarget_Null* getCanvas() { return *m_canvas; }
+		uint64_t getPresentCount() const noexcept { return m_present_count; }
+
+	public:
+		void addEventListener(ISwapChainEventListener* e);
+		void removeEventListener(ISwapChainEventListener* e);
+
+		bool setWindowMode(Vector2U size);
+
+		bool setCanvasSize(Vector2U size);
+		Vector2U getCanvasSize() { return m_canvas_size; }
+
+		void clearRenderAttachment();
+		void applyRenderAttachment();
+		void setVSync(bool enable) { (void)enable; }
+		bool present();
+
+		bool saveSnapshotToFile(StringView path);
+
+	public:
+		SwapChain_Null(Window_Null* p_window, Device_Null* p_device);
+		~SwapChain_Null();
+	public:
+		static bool create(Window_Null* p_window, Device_Null* p_device, SwapChain_Null** pp_swapchain);
+	};
+}
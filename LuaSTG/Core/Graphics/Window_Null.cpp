@@ -0,0 +1,106 @@
+#include "Core/Graphics/Window_Null.hpp"
+#include "SDL.h"
+#include <algorithm>
+
+namespace Core::Graphics
+{
+    void Window_Null::handleEvents()
+    {
+        // Keep the SDL event queue (keyboard and mouse state) empty
+        SDL_Event ev;
+        while (SDL_PollEvent(&ev))
+        {
+            for (auto& v : m_eventobj)
+            {
+                v->onNativeWindowMessage(&ev);
+            }
+        }
+    }
+
+    void Window_Null::addEventListener(IWindowEventListener* e)
+    {
+        removeEventListener(e);
+        m_eventobj.emplace_back(e);
+    }
+    void Window_Null::removeEventListener(IWindowEventListener* e)
+    {
+        m_eventobj.erase(std::remove(m_eventobj.begin(), m_eventobj.end(), e), m_eventobj.end());
+    }
+
+    RectI Window_Null::getMonitorRect(uint32_t index)
+    {
+        (void)index;
+        return RectI(0, 0, (int32_t)m_size.x, (int32_t)m_size.y);
+    }
+
+    void Window_Null::setTextInput(StringView text)
+    {
+        m_text_input = text;
+        m_text_cursor_pos = (uint32_t)m_text_input.length();
+    }
+    void Window_Null::clearTextInput()
+    {
+        m_text_input.clear();
+        m_text_cursor_pos = 0;
+    }
+    bool Window_Null::setTextCursorPos(uint32_t pos)
+    {
+        if (pos > m_text_input.length())
+            return false;
+        m_text_cursor_pos = pos;
+        return true;
+    }
+    void Window_Null::insertInputTextAtCursor(StringView text, bool move_cursor)
+    {
+        m_text_input.insert(m_text_cursor_pos, text);
+        if (move_cursor)
+            m_text_cursor_pos += (uint32_t)text.length();
+    }
+    bool Window_Null::insertInputText(StringView text, uint32_t pos)
+    {
+        if (pos > m_text_input.length())
+            return false;
+        m_text_input.insert(pos, text);
+        return true;
+    }
+    uint32_t Window_Null::removeInputTextAtCursor(uint32_t length, bool after)
+    {
+        if (after)
+        {
+            uint32_t const n = std::min<uint32_t>(length, (uint32_t)m_text_input.length() - m_text_cursor_pos);
+            m_text_input.erase(m_text_cursor_pos, n);
+            return n;
+        }
+        uint32_t const n = std::min(length, m_text_cursor_pos);
+        m_text_cursor_pos -= n;
+        m_text_input.erase(m_text_cursor_pos, n);
+        return n;
+    }
+    int32_t Window_Null::removeInputText(uint32_t length, uint32_t pos)
+    {
+        if (pos > m_text_input.length())
+            return -1;
+        uint32_t const n = std::min<uint32_t>(length, (uint32_t)m_text_input.length() - pos);
+        m_text_input.erase(pos, n);
+        if (m_text_cursor_pos > m_text_input.length())
+            m_text_cursor_pos = (uint32_t)m_text_input.length();
+        return (int32_t)n;
+    }
+
+    Window_Null::Window_Null() = default;
+    Window_Null::~Window_Null() = default;
+
+    bool Window_Null::create(Window_Null** pp_window)
+    {
+        try
+        {
+            *pp_window = new Window_Null();
+            return true;
+        }
+        catch (...)
+        {
+            *pp_window = nullptr;
+            return false;
+        }
+    }
+}
@@ -0,0 +1,89 @@
+#pragma once
+#include "Core/Object.hpp"
+#include "Core/Graphics/Window.hpp"
+#include "Core/Type.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Core::Graphics
+{
+    // Window of the headless backend, only keeps the state that scripts set and read back
+    class Window_Null : public Object<IWindow>
+    {
+    private:
+        Vector2U m_size{ 640, 480 };
+        std::string m_title{ "Window" };
+        WindowFrameStyle m_framestyle{ WindowFrameStyle::Fixed };
+        WindowLayer m_layer{ WindowLayer::Invisible };
+        WindowCursor m_cursor{ WindowCursor::Arrow };
+        std::string m_text_input;
+        std::string m_clipboard;
+        uint32_t m_text_cursor_pos{ 0 };
+
+        std::vector<IWindowEventListener*> m_eventobj;
+
+    public:
+        // Internal Method
+
+        void handleEvents();
+
+    public:
+        void addEventListener(IWindowEventListener* e);
+        void removeEventListener(IWindowEventListener* e);
+
+        void* getNativeHandle() { return nullptr; }
+
+        void setTitleText(StringView str) { m_title = str; }
+        StringView getTitleText() { return m_title; }
+
+        bool setFrameStyle(WindowFrameStyle style) { m_framestyle = style; return true; }
+        WindowFrameStyle getFrameStyle() { return m_framestyle; }
+
+        Vector2U getSize() { return m_size; }
+        bool setSize(Vector2U v) { m_size = v; return true; }
+
+        WindowLayer getLayer() { return m_layer; }
+        bool setLayer(WindowLayer layer) { m_layer = layer; return true; }
+
+        void setWindowMode(Vector2U size) { m_size = size; }
+        void setExclusiveFullScreenMode() {}
+        void setBorderlessFullScreenMode() {}
+
+        uint32_t getMonitorCount() { return 1; }
+        RectI getMonitorRect(uint32_t index);
+        void setMonitorCentered(uint32_t index) { (void)index; }
+        void setMonitorFullScreen(uint32_t index) { (void)index; }
+
+        bool setCursor(WindowCursor type) { m_cursor = type; return true; }
+        WindowCursor getCursor() { return m_cursor; }
+
+        // Text input works on bytes, there is no keyboard to type with anyway
+        void setTextInputEnable(bool enable) { (void)enable; }
+        std::string getTextInput() { return m_text_input; }
+        std::string getIMEComp() { return ""; }
+        void setTextInput(StringView text);
+        void clearTextInput();
+        uint32_t getTextInputLength() { return (uint32_t)m_text_input.length(); }
+        uint32_t getTextCursorPos() { return m_text_cursor_pos; }
+        uint32_t getTextCursorPosRaw() { return m_text_cursor_pos; }
+        int32_t getIMECursorPos() { return -1; }
+        bool setTextCursorPos(uint32_t pos);
+        void insertInputTextAtCursor(StringView text, bool move_cursor = true);
+        bool insertInputText(StringView text, uint32_t pos);
+        uint32_t removeInputTextAtCursor(uint32_t length, bool after);
+        int32_t removeInputText(uint32_t length, uint32_t pos);
+        void setTextInputReturnEnable(bool enable) { (void)enable; }
+        void setTextInputRect(RectI rect) { (void)rect; }
+
+        std::string getClipboardText() { return m_clipboard; }
+        bool setClipboardText(StringView text) { m_clipboard = text; return true; }
+
+    public:
+        Window_Null();
+        ~Window_Null();
+
+    public:
+        static bool create(Window_Null** pp_window);
+    };
+}
@@ -41,6 +41,11 @@ namespace Core
 
         SET(debug_track_window_focus);
 
+        SET(headless_enable);
+        SET(headless_frame_count);
+        SET(headless_rasterizer_enable);
+        SET(headless_record_path);
+
     #undef SET
     }
     inline void from_json(nlohmann::json const& j, InitializeConfigure& p)
@@ -76,6 +81,11 @@ namespace Core
 
         GET(debug_track_window_focus);
 
+        GET(headless_enable);
+        GET(headless_frame_count);
+        GET(headless_rasterizer_enable);
+        GET(headless_record_path);
+
     #undef GET
     }
 
@@ -139,6 +149,11 @@ namespace Core
         application_instance_id.clear();
 
         debug_track_window_focus = false;
+
+        headless_enable = false;
+        headless_frame_count = 0;
+        headless_rasterizer_enable = false;
+        headless_record_path.clear();
     }
     bool InitializeConfigure::load(std::string_view const source) noexcept
     {
@@ -35,6 +35,12 @@ namespace Core
 
         bool debug_track_window_focus = false;
 
+        // Headless mode: no window or GPU, graphics calls are recorded. Also enabled by the --headless option
+        bool headless_enable = false;
+        int headless_frame_count = 0; // Exit after this many frames, 0 runs until the script exits
+        bool headless_rasterizer_enable = false; // Software rasterizer for small golden image tests
+        std::string headless_record_path; // Write the recorded commands here on exit
+
         void reset();
         bool load(std::string_view const source) noexcept;
         bool save(std::string_view const source, std::string& buffer) noexcept;
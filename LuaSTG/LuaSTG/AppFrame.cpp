@@ -2,6 +2,7 @@
 #include "Core/FileManager.hpp"
 #include "Debugger/ImGuiExtension.h"
 #include "LuaBinding/LuaAppFrame.hpp"
+#include <chrono>
 
 using namespace LuaSTGPlus;
 
@@ -308,6 +309,8 @@ bool AppFrame::onUpdate()
         // Run frame function
         imgui::cancelSetCursor();
         m_GameObjectPool->DebugNextFrame();
+        // 异步加载的纹理在帧开始时放入资源池，本帧的脚本就能使用
+        m_ResourceMgr.GetTextureLoader().Update();
         if (!SafeCallGlobalFunction(LuaSTG::LuaEngine::G_CALLBACK_EngineUpdate, 1))
         {
             result = false;
@@ -340,5 +343,50 @@ bool AppFrame::onRender()
     m_bRenderStarted = false;
     return result;
 }
+void AppFrame::onIdle()
+{
+    ZoneScopedN("OnIdle-LuaGC");
+
+    // Incremental step size in KB, small enough to check the clock often
+    constexpr int step_size = 16;
+    // Keep a margin for the frame rate controller's sleep
+    constexpr double margin = 0.0005;
+
+    auto const heap_size = [this]() -> size_t
+    {
+        return (size_t)lua_gc(L, LUA_GCCOUNT, 0) * 1024 + (size_t)lua_gc(L, LUA_GCCOUNTB, 0);
+    };
+
+    m_GCStatistics = {};
+    m_GCStatistics.heap_size = heap_size();
+    if (m_GCStepLimit <= 0.0)
+        return;
+    double const budget = std::min(m_pAppModel->getFrameRateController()->getRemainingTime() - margin, m_GCStepLimit);
+    if (budget <= 0.0)
+        return;
+    m_GCStatistics.budget = budget;
+    // After a finished cycle, wait until the heap has grown again instead of starting a new cycle right away,
+    // the threshold is below the collector's own (pause 200%) so the next cycle usually runs here
+    if (m_GCStatistics.heap_size < m_GCIdleThreshold)
+        return;
+
+    using Clock = std::chrono::steady_clock;
+    auto const begin = Clock::now();
+    double elapsed = 0.0;
+    do
+    {
+        m_GCStatistics.step_count += 1;
+        if (lua_gc(L, LUA_GCSTEP, step_size))
+        {
+            m_GCStatistics.cycle_finished = true;
+            size_t const live = heap_size();
+            m_GCIdleThreshold = live + live / 2;
+            break;
+        }
+        elapsed = std::chrono::duration<double>(Clock::now() - begin).count();
+    } while (elapsed < budget);
+    m_GCStatistics.step_time = std::chrono::duration<double>(Clock::now() - begin).count();
+    m_GCStatistics.heap_size = heap_size();
+}
 
 #pragma endregion
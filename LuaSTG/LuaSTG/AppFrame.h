@@ -41,6 +41,20 @@ namespace LuaSTGPlus
         float volume_music{ 1.0f };
     };
 
+    // Lua garbage collector work done in the slack of the last frame
+    struct GarbageCollectorStatistics
+    {
+        // Time spent in incremental steps (seconds)
+        double step_time{};
+        // Slack that was available for the steps (seconds)
+        double budget{};
+        // Lua heap size after the steps (bytes)
+        size_t heap_size{};
+        uint32_t step_count{};
+        // A collection cycle finished during the steps
+        bool cycle_finished{};
+    };
+
     struct IRenderTargetManager
     {
         // Render Target Stack
@@ -92,6 +106,13 @@ namespace LuaSTGPlus
 
         // Rendering state
         bool m_bRenderStarted = false;
+        bool m_bSpriteInstancing = true;
+        bool m_bParticleBatch = true;
+
+        // Lua garbage collector pacing
+        double m_GCStepLimit = 0.002;
+        size_t m_GCIdleThreshold = 0;
+        GarbageCollectorStatistics m_GCStatistics;
 
     public:
         /// Protected mode script execution
@@ -192,6 +213,11 @@ namespace LuaSTGPlus
         // Get current average FPS
         double GetFPS() const noexcept { return m_fAvgFPS; }
 
+        // Upper bound (seconds) of the incremental Lua GC steps run in the slack after present, 0 disables them
+        void SetGCStepLimit(double v) noexcept { m_GCStepLimit = v > 0.0 ? v : 0.0; }
+        double GetGCStepLimit() const noexcept { return m_GCStepLimit; }
+        GarbageCollectorStatistics const& GetGCStatistics() const noexcept { return m_GCStatistics; }
+
         // Read a text file from a resource package.  
         // It is possible to read other files, but you may get meaningless results.
         int LoadTextFile(lua_State* L, const char* path, const char *packname) noexcept;
@@ -204,6 +230,18 @@ namespace LuaSTGPlus
         // Apply blend modes
         void updateGraph2DBlendMode(BlendMode m);
 
+        // Draw default-rendered sprite objects and particles with IRenderer::drawSpriteInstances
+        void SetSpriteInstancing(bool v) noexcept { m_bSpriteInstancing = v; }
+        bool GetSpriteInstancing() const noexcept { return m_bSpriteInstancing; }
+
+        // Update HGE particle pools with the SIMD kernels instead of one particle at a time
+        void SetParticleBatch(bool v) noexcept { m_bParticleBatch = v; }
+        bool GetParticleBatch() const noexcept { return m_bParticleBatch; }
+
+        // Premultiplied alpha mode: textures loaded afterwards are premultiplied, and mul+alpha/mul+add share batches
+        void SetPremultipliedAlphaMode(bool v) noexcept;
+        bool GetPremultipliedAlphaMode() noexcept;
+
         /// Render particles
         bool Render(IParticlePool* p, float hscale = 1, float vscale = 1)noexcept;
         
@@ -307,6 +345,7 @@ namespace LuaSTGPlus
 
         bool onUpdate() override;
         bool onRender() override;
+        void onIdle() override;
     public:
         AppFrame()noexcept;
         ~AppFrame()noexcept;
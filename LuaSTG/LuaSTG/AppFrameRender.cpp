@@ -116,6 +116,16 @@ namespace LuaSTGPlus
         }
     }
     
+    void AppFrame::SetPremultipliedAlphaMode(bool v) noexcept
+    {
+        m_pAppModel->getDevice()->setPremultiplyTextureOnLoad(v);
+        m_pAppModel->getRenderer()->setPremultipliedBatching(v);
+    }
+    bool AppFrame::GetPremultipliedAlphaMode() noexcept
+    {
+        return m_pAppModel->getRenderer()->getPremultipliedBatching();
+    }
+    
     bool AppFrame::Render(IParticlePool* p, float hscale, float vscale) noexcept
     {
         assert(p);
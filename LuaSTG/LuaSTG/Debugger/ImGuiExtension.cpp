@@ -370,9 +370,12 @@ static int lib_ShowFrameStatistics(lua_State* L)
     static std::vector<double> arr_obj_alloc;
     static std::vector<double> arr_obj_free;
     static std::vector<double> arr_obj_alive;
+    static std::vector<double> arr_obj_colli_candidate;
     static std::vector<double> arr_obj_colli;
     static std::vector<double> arr_obj_colli_cb;
     static std::vector<double> arr_gpu_render_time;
+    static std::vector<double> arr_gc_time;
+    static std::vector<double> arr_gc_heap;
     static ImU64 arr_index = 0;
     static size_t record_range = 240;
     constexpr size_t record_range_min = 60;
@@ -380,9 +383,11 @@ static int lib_ShowFrameStatistics(lua_State* L)
     static float height = 384.0f;
     static float height_gpu = 384.0f;
     static float height_2 = 384.0f;
+    static float height_gc = 256.0f;
     static bool auto_fit = true;
     static bool auto_fit_gpu = true;
     static bool auto_fit_2 = true;
+    static bool auto_fit_gc = true;
     
     bool v = (lua_gettop(L) >= 1) ? lua_toboolean(L, 1) : true;
     if (v)
@@ -414,10 +419,14 @@ static int lib_ShowFrameStatistics(lua_State* L)
                 arr_obj_alloc.resize(arr_size);
                 arr_obj_free.resize(arr_size);
                 arr_obj_alive.resize(arr_size);
+                arr_obj_colli_candidate.resize(arr_size);
                 arr_obj_colli.resize(arr_size);
                 arr_obj_colli_cb.resize(arr_size);
 
                 arr_gpu_render_time.resize(arr_size);
+
+                arr_gc_time.resize(arr_size);
+                arr_gc_heap.resize(arr_size);
             }
 
             ImGui::SliderScalar("Record Range", sizeof(size_t) == 8 ? ImGuiDataType_U64 : ImGuiDataType_U32, &record_range, &record_range_min, &record_range_max);
@@ -542,6 +551,59 @@ static int lib_ShowFrameStatistics(lua_State* L)
                 }
             }
 
+            // lua gc
+
+            if (ImGui::CollapsingHeader("Lua GC"))
+            {
+                auto const& info = LAPP.GetGCStatistics();
+                constexpr double const byte_to_MiB = 1.0 / (1024.0 * 1024.0);
+
+                ImGui::Text("Step   : %.3fms (%u steps, budget %.3fms, limit %.3fms)", info.step_time * 1000.0, info.step_count, info.budget * 1000.0, LAPP.GetGCStepLimit() * 1000.0);
+                ImGui::Text("Heap   : %.3fMiB", (double)info.heap_size * byte_to_MiB);
+                ImGui::Text("Cycle  : %s", info.cycle_finished ? "finished" : "-");
+
+                ImGui::SliderFloat("Timeline Height##Lua GC", &height_gc, 128.0f, 512.0f);
+                ImGui::Checkbox("Auto-Fit Y Axis##Lua GC", &auto_fit_gc);
+
+                arr_gc_time[arr_index] = 1000.0 * info.step_time;
+                arr_gc_heap[arr_index] = (double)info.heap_size * byte_to_MiB;
+
+                if (ImPlot::BeginPlot("##Lua GC Step Time", ImVec2(-1, height_gc), 0))
+                {
+                    ImPlot::SetupAxisLimits(ImAxis_X1, 0.0, (double)(record_range - 1), ImGuiCond_Always);
+                    if (auto_fit_gc)
+                        ImPlot::SetupAxes(NULL, NULL, ImPlotAxisFlags_None, ImPlotAxisFlags_AutoFit | ImPlotAxisFlags_RangeFit);
+                    else
+                        ImPlot::SetupAxes(NULL, NULL);
+
+                    ImPlot::SetupLegend(ImPlotLocation_North, ImPlotLegendFlags_Horizontal | ImPlotLegendFlags_Outside);
+
+                    ImPlot::PlotLine("Step (ms)", arr_gc_time.data(), (int)record_range);
+
+                    ImPlot::SetNextLineStyle(ImVec4(0.2f, 0.2f, 0.2f, 1.0f));
+                    ImPlot::PlotInfLines("##Current Time", &arr_index, 1, ImPlotInfLinesFlags_None);
+
+                    ImPlot::EndPlot();
+                }
+                if (ImPlot::BeginPlot("##Lua GC Heap", ImVec2(-1, height_gc), 0))
+                {
+                    ImPlot::SetupAxisLimits(ImAxis_X1, 0.0, (double)(record_range - 1), ImGuiCond_Always);
+                    if (auto_fit_gc)
+                        ImPlot::SetupAxes(NULL, NULL, ImPlotAxisFlags_None, ImPlotAxisFlags_AutoFit | ImPlotAxisFlags_RangeFit);
+                    else
+                        ImPlot::SetupAxes(NULL, NULL);
+
+                    ImPlot::SetupLegend(ImPlotLocation_North, ImPlotLegendFlags_Horizontal | ImPlotLegendFlags_Outside);
+
+                    ImPlot::PlotLine("Heap (MiB)", arr_gc_heap.data(), (int)record_range);
+
+                    ImPlot::SetNextLineStyle(ImVec4(0.2f, 0.2f, 0.2f, 1.0f));
+                    ImPlot::PlotInfLines("##Current Time", &arr_index, 1, ImPlotInfLinesFlags_None);
+
+                    ImPlot::EndPlot();
+                }
+            }
+
             // memory
 
             // if (ImGui::CollapsingHeader("Memory Usage"))
@@ -602,6 +664,7 @@ static int lib_ShowFrameStatistics(lua_State* L)
                 ImGui::Text("Create : %llu", obj_info.object_alloc);
                 ImGui::Text("Return : %llu", obj_info.object_free);
                 ImGui::Text("Active : %llu", obj_info.object_alive);
+                ImGui::Text("Colli Candidate : %llu", obj_info.object_colli_candidate);
                 ImGui::Text("Colli Check : %llu", obj_info.object_colli_check);
                 ImGui::Text("Colli Callback : %llu", obj_info.object_colli_callback);
 
@@ -611,6 +674,7 @@ static int lib_ShowFrameStatistics(lua_State* L)
                 arr_obj_alloc[arr_index] = (double)obj_info.object_alloc;
                 arr_obj_free[arr_index] = (double)obj_info.object_free;
                 arr_obj_alive[arr_index] = (double)obj_info.object_alive;
+                arr_obj_colli_candidate[arr_index] = (double)obj_info.object_colli_candidate;
                 arr_obj_colli[arr_index] = (double)obj_info.object_colli_check;
                 arr_obj_colli_cb[arr_index] = (double)obj_info.object_colli_callback;
 
@@ -641,6 +705,7 @@ static int lib_ShowFrameStatistics(lua_State* L)
                     ImPlot::PlotLine("Create", arr_obj_alloc.data(), (int)record_range);
                     ImPlot::PlotLine("Return", arr_obj_free.data(), (int)record_range);
                     ImPlot::PlotLine("Active", arr_obj_alive.data(), (int)record_range);
+                    ImPlot::PlotLine("Colli Candidate", arr_obj_colli_candidate.data(), (int)record_range);
                     ImPlot::PlotLine("Colli Check", arr_obj_colli.data(), (int)record_range);
                     ImPlot::PlotLine("Colli Callback", arr_obj_colli_cb.data(), (int)record_range);
 
@@ -972,11 +1037,15 @@ namespace imgui
         setConfig();
         loadConfig();
         
-        g_ImGuiRenderDeviceEventListener.onWindowCreate();
-        window->addEventListener(&g_ImGuiRenderDeviceEventListener);
-        
-        g_ImGuiRenderDeviceEventListener.onDeviceCreate();
-        device->addEventListener(&g_ImGuiRenderDeviceEventListener);
+        // 无头模式下没有窗口和 OpenGL 上下文，只保留 ImGui 上下文，让脚本可以照常调用
+        if (!APP.GetAppModel()->isHeadless())
+        {
+            g_ImGuiRenderDeviceEventListener.onWindowCreate();
+            window->addEventListener(&g_ImGuiRenderDeviceEventListener);
+            
+            g_ImGuiRenderDeviceEventListener.onDeviceCreate();
+            device->addEventListener(&g_ImGuiRenderDeviceEventListener);
+        }
         
         luaopen_imgui(L);
         imgui_binding_lua_register_backend(L);
@@ -1002,11 +1071,14 @@ namespace imgui
         auto* window = APP.GetAppModel()->getWindow();
         auto* device = APP.GetAppModel()->getDevice();
         
-        device->removeEventListener(&g_ImGuiRenderDeviceEventListener);
-        g_ImGuiRenderDeviceEventListener.onDeviceDestroy();
-        
-        window->removeEventListener(&g_ImGuiRenderDeviceEventListener);
-        g_ImGuiRenderDeviceEventListener.onWindowDestroy();
+        if (!APP.GetAppModel()->isHeadless())
+        {
+            device->removeEventListener(&g_ImGuiRenderDeviceEventListener);
+            g_ImGuiRenderDeviceEventListener.onDeviceDestroy();
+            
+            window->removeEventListener(&g_ImGuiRenderDeviceEventListener);
+            g_ImGuiRenderDeviceEventListener.onWindowDestroy();
+        }
         
         ImPlot::DestroyContext();
         ImGui::DestroyContext();
@@ -1043,6 +1115,20 @@ namespace imgui
             auto& io = ImGui::GetIO();
             if (allow_set_cursor)
                 io.ConfigFlags &= mask;
+            if (LAPP.GetAppModel()->isHeadless())
+            {
+                // 没有渲染和平台后端，自己构建字体纹理数据并填写帧信息，固定帧时间保证结果可以复现
+                if (!io.Fonts->IsBuilt())
+                {
+                    unsigned char* pixels = nullptr;
+                    int width = 0, height = 0;
+                    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+                }
+                auto const ws = LAPP.GetAppModel()->getSwapChain()->getCanvasSize();
+                io.DisplaySize = ImVec2((float)ws.x, (float)ws.y);
+                io.DeltaTime = 1.0f / 60.0f;
+                return;
+            }
             {
                 ZoneScopedN("imgui.backend.NewFrame-OpenGL3");
                 ImGui_ImplOpenGL3_NewFrame();
@@ -103,25 +103,15 @@ namespace LuaSTGPlus
         luaclass.Reset();
 #endif // USING_ADVANCE_GAMEOBJECT_CLASS
 
-        x = y = 0.;
-        lastx = lasty = 0.;
-        dx = dy = 0.;
-        rot = omega = 0.;
-        vx = vy = 0.;
-        ax = ay = 0.;
+        // 运动学数据由对象池分配 id 时重置
+        kinematics = nullptr;
         layer = 0.;
         hscale = vscale = 1.;
-#ifdef USER_SYSTEM_OPERATION
-        maxv = std::numeric_limits<double>::max() * 0.5; // 平时应该不会有人弄那么大的速度吧，希望计算时不会溢出（
-        maxvx = maxvy = std::numeric_limits<double>::max();
-        ag = 0.;
-#endif
 
         colli = bound = true;
-        hide = navi = false;
+        hide = false;
 
         group = 0;
-        timer = ani_timer = 0;
 
         res = nullptr;
         ps = nullptr;
@@ -131,7 +121,6 @@ namespace LuaSTGPlus
         pause = 0;
     #endif
         ignore_superpause = false;
-        touch_lastx_lasty = false;
 
         world = 15;
 
@@ -148,25 +137,14 @@ namespace LuaSTGPlus
     {
         status = GameObjectStatus::Active;
 
-        x = y = 0.;
-        lastx = lasty = 0.;
-        dx = dy = 0.;
-        rot = omega = 0.;
-        vx = vy = 0.;
-        ax = ay = 0.;
+        kinematics->Reset(id);
         layer = 0.;
         hscale = vscale = 1.;
-#ifdef USER_SYSTEM_OPERATION
-        maxv = std::numeric_limits<double>::max() * 0.5; // 平时应该不会有人弄那么大的速度吧，希望计算时不会溢出（
-        maxvx = maxvy = std::numeric_limits<double>::max();
-        ag = 0.;
-#endif
 
         colli = bound = true;
-        hide = navi = false;
+        hide = false;
 
         group = 0;
-        timer = ani_timer = 0;
 
         ReleaseResource();
 
@@ -175,7 +153,6 @@ namespace LuaSTGPlus
         pause = 0;
     #endif
         ignore_superpause = false;
-        touch_lastx_lasty = false;
 
         world = 15;
 
@@ -252,8 +229,8 @@ namespace LuaSTGPlus
                 return false;
             }
             ps->SetActive(false);
-            ps->SetCenter(Core::Vector2F((float)x, (float)y));
-            ps->SetRotation((float)rot);
+            ps->SetCenter(Core::Vector2F((float)x(), (float)y()));
+            ps->SetRotation((float)rot());
             ps->SetActive(true);
             // 设置资源
             res = *tParticle;
@@ -314,6 +291,16 @@ namespace LuaSTGPlus
         lua_rawseti(L, idx, 4);
     }
     
+    bool GameObject::CanBatchUpdate() const noexcept
+    {
+    #ifdef	LUASTG_ENABLE_GAME_OBJECT_PROPERTY_PAUSE
+        if (pause > 0 || resolve_move)
+        {
+            return false;
+        }
+    #endif
+        return !(res && res->GetType() == ResourceType::Particle);
+    }
     void GameObject::Update()
     {
     #ifdef	LUASTG_ENABLE_GAME_OBJECT_PROPERTY_PAUSE
@@ -325,65 +312,39 @@ namespace LuaSTGPlus
         {
             if (resolve_move)
             {
-                if (touch_lastx_lasty)
+                if (kinematics->touch_lastx_lasty[id])
                 {
-                    vx = x - lastx;
-                    vy = y - lasty;
+                    vx() = x() - lastx();
+                    vy() = y() - lasty();
                 }
                 else
                 {
-                    vx = 0.0;
-                    vy = 0.0;
+                    vx() = 0.0;
+                    vy() = 0.0;
                 }
+                rot() += omega();
             }
             else
     #endif
             {
-                // 更新速度
-                vx += ax;
-                vy += ay;
-            #ifdef USER_SYSTEM_OPERATION
-                // 单独应用重力加速度
-                vy -= ag;
-                // 速度限制，来自lua层
-                if (maxv <= std::numeric_limits<double>::min())
-                {
-                    vx = 0.0;
-                    vy = 0.0;
-                }
-                else
-                {
-                    lua_Number const speed_ = std::sqrt(vx * vx + vy * vy);
-                    if (maxv < speed_ && speed_ > std::numeric_limits<double>::min())
-                    {
-                        lua_Number const scale_ = maxv / speed_;
-                        vx = scale_ * vx;
-                        vy = scale_ * vy;
-                    }
-                }
-                //针对x、y方向单独限制
-                vx = std::clamp(vx, -maxvx, maxvx);
-                vy = std::clamp(vy, -maxvy, maxvy);
-            #endif
-                x += vx;
-                y += vy;
+                // 更新速度、坐标和旋转角
+                uint32_t const index = static_cast<uint32_t>(id);
+                kinematics->Integrate(&index, 1);
             }
-            
-            rot += omega;
 
             // 更新粒子系统（若有）
             if (res && res->GetType() == ResourceType::Particle)
             {
-                ps->SetRotation((float)rot);
+                ps->SetRotation((float)rot());
                 if (ps->IsActived()) // 兼容性处理
                 {
                     ps->SetActive(false);
-                    ps->SetCenter(Core::Vector2F((float)x, (float)y));
+                    ps->SetCenter(Core::Vector2F((float)x(), (float)y()));
                     ps->SetActive(true);
                 }
                 else
                 {
-                    ps->SetCenter(Core::Vector2F((float)x, (float)y));
+                    ps->SetCenter(Core::Vector2F((float)x(), (float)y()));
                 }
                 ps->Update(1.0f / 60.f);
             }
@@ -393,28 +354,13 @@ namespace LuaSTGPlus
     }
     void GameObject::UpdateLast()
     {
-        if (touch_lastx_lasty)
-        {
-            dx = x - lastx;
-            dy = y - lasty;
-        }
-        else
-        {
-            dx = 0.0;
-            dy = 0.0;
-        }
-        lastx = x;
-        lasty = y;
-        touch_lastx_lasty = true;
-        if (navi && (std::abs(dx) > std::numeric_limits<double>::min() || std::abs(dy) > std::numeric_limits<double>::min()))
-        {
-            rot = std::atan2(dy, dx);
-        }
+        uint32_t const index = static_cast<uint32_t>(id);
+        kinematics->UpdateLast(&index, 1);
     }
     void GameObject::UpdateTimer()
     {
-        timer += 1;
-        ani_timer += 1;
+        timer() += 1;
+        ani_timer() += 1;
     }
 
     void GameObject::Render()
@@ -430,19 +376,19 @@ namespace LuaSTGPlus
                 {
                 case ResourceType::Sprite:
                     static_cast<IResourceSprite*>(res)->Render(
-                        static_cast<float>(x),
-                        static_cast<float>(y),
-                        static_cast<float>(rot),
+                        static_cast<float>(x()),
+                        static_cast<float>(y()),
+                        static_cast<float>(rot()),
                         static_cast<float>(hscale) * gscale,
                         static_cast<float>(vscale) * gscale
                     );
                     break;
                 case ResourceType::Animation:
                     static_cast<IResourceAnimation*>(res)->Render(
-                        static_cast<int>(ani_timer),
-                        static_cast<float>(x),
-                        static_cast<float>(y),
-                        static_cast<float>(rot),
+                        static_cast<int>(ani_timer()),
+                        static_cast<float>(x()),
+                        static_cast<float>(y()),
+                        static_cast<float>(rot()),
                         static_cast<float>(hscale) * gscale,
                         static_cast<float>(vscale) * gscale
                     );
@@ -466,9 +412,9 @@ namespace LuaSTGPlus
                 {
                 case ResourceType::Sprite:
                     static_cast<IResourceSprite*>(res)->Render(
-                            static_cast<float>(x),
-                            static_cast<float>(y),
-                            static_cast<float>(rot),
+                            static_cast<float>(x()),
+                            static_cast<float>(y()),
+                            static_cast<float>(rot()),
                             static_cast<float>(hscale) * gscale,
                         static_cast<float>(vscale) * gscale,
                         blendmode,
@@ -477,10 +423,10 @@ namespace LuaSTGPlus
                     break;
                 case ResourceType::Animation:
                     static_cast<IResourceAnimation*>(res)->Render(
-                        static_cast<int>(ani_timer),
-                        static_cast<float>(x),
-                        static_cast<float>(y),
-                        static_cast<float>(rot),
+                        static_cast<int>(ani_timer()),
+                        static_cast<float>(x()),
+                        static_cast<float>(y()),
+                        static_cast<float>(rot()),
                         static_cast<float>(hscale) * gscale,
                         static_cast<float>(vscale) * gscale,
                         blendmode,
@@ -544,63 +490,63 @@ namespace LuaSTGPlus
             // 位置
 
         case LuaSTG::GameObjectMember::X:
-            lua_pushnumber(L, x);
+            lua_pushnumber(L, x());
             return 1;
         case LuaSTG::GameObjectMember::Y:
-            lua_pushnumber(L, y);
+            lua_pushnumber(L, y());
             return 1;
         case LuaSTG::GameObjectMember::DX:
-            lua_pushnumber(L, dx);
+            lua_pushnumber(L, dx());
             return 1;
         case LuaSTG::GameObjectMember::DY:
-            lua_pushnumber(L, dy);
+            lua_pushnumber(L, dy());
             return 1;
 
             // 运动学
 
         case LuaSTG::GameObjectMember::VX:
-            lua_pushnumber(L, vx);
+            lua_pushnumber(L, vx());
             return 1;
         case LuaSTG::GameObjectMember::VY:
-            lua_pushnumber(L, vy);
+            lua_pushnumber(L, vy());
             return 1;
         case LuaSTG::GameObjectMember::AX:
-            lua_pushnumber(L, ax);
+            lua_pushnumber(L, ax());
             return 1;
         case LuaSTG::GameObjectMember::AY:
-            lua_pushnumber(L, ay);
+            lua_pushnumber(L, ay());
             return 1;
         #ifdef USER_SYSTEM_OPERATION
         case LuaSTG::GameObjectMember::MAXVX:
-            lua_pushnumber(L, maxvx);
+            lua_pushnumber(L, maxvx());
             return 1;
         case LuaSTG::GameObjectMember::MAXVY:
-            lua_pushnumber(L, maxvy);
+            lua_pushnumber(L, maxvy());
             return 1;
         case LuaSTG::GameObjectMember::MAXV:
-            lua_pushnumber(L, maxv);
+            lua_pushnumber(L, maxv());
             return 1;
         case LuaSTG::GameObjectMember::AG:
-            lua_pushnumber(L, ag);
+            lua_pushnumber(L, ag());
             return 1;
         #endif
         case LuaSTG::GameObjectMember::VSPEED:
-            lua_pushnumber(L, std::sqrt(vx * vx + vy * vy));
+            lua_pushnumber(L, std::sqrt(vx() * vx() + vy() * vy()));
             return 1;
         case LuaSTG::GameObjectMember::VANGLE:
-            if (std::abs(vx) > std::numeric_limits<double>::min() || std::abs(vy) > std::numeric_limits<double>::min())
-                lua_pushnumber(L, std::atan2(vy, vx) * L_RAD_TO_DEG);
+            if (std::abs(vx()) > std::numeric_limits<double>::min() || std::abs(vy()) > std::numeric_limits<double>::min())
+                lua_pushnumber(L, std::atan2(vy(), vx()) * L_RAD_TO_DEG);
             else
-                lua_pushnumber(L, rot * L_RAD_TO_DEG);
+                lua_pushnumber(L, rot() * L_RAD_TO_DEG);
             return 1;
         case LuaSTG::GameObjectMember::VPOS:
-            LuaWrapper::Vector2Wrapper::CreateAndPush(L, Core::Vector2(x, y));
+            LuaWrapper::Vector2Wrapper::CreateAndPush(L, Core::Vector2(x(), y()));
             return 1;
         case LuaSTG::GameObjectMember::VVEL:
-            LuaWrapper::Vector2Wrapper::CreateAndPush(L, Core::Vector2(vx, vy));
+            LuaWrapper::Vector2Wrapper::CreateAndPush(L, Core::Vector2(vx(), vy()));
             return 1;
         case LuaSTG::GameObjectMember::VACCEL:
-            LuaWrapper::Vector2Wrapper::CreateAndPush(L, Core::Vector2(ax, vy));
+            LuaWrapper::Vector2Wrapper::CreateAndPush(L, Core::Vector2(ax(), vy()));
             return 1;
         case LuaSTG::GameObjectMember::VVSCALE:
             LuaWrapper::Vector2Wrapper::CreateAndPush(L, Core::Vector2(hscale, vscale));
@@ -647,10 +593,10 @@ namespace LuaSTGPlus
             lua_pushnumber(L, vscale);
             return 1;
         case LuaSTG::GameObjectMember::ROT:
-            lua_pushnumber(L, rot * L_RAD_TO_DEG);
+            lua_pushnumber(L, rot() * L_RAD_TO_DEG);
             return 1;
         case LuaSTG::GameObjectMember::OMEGA:
-            lua_pushnumber(L, omega * L_RAD_TO_DEG);
+            lua_pushnumber(L, omega() * L_RAD_TO_DEG);
             return 1;
         #ifdef USING_ADVANCE_GAMEOBJECT_CLASS
         case LuaSTG::GameObjectMember::_BLEND:
@@ -691,13 +637,13 @@ namespace LuaSTGPlus
             return 1;
         #endif // USING_ADVANCE_GAMEOBJECT_CLASS
         case LuaSTG::GameObjectMember::ANI:
-            lua_pushinteger(L, ani_timer);
+            lua_pushinteger(L, ani_timer());
             return 1;
         case LuaSTG::GameObjectMember::HIDE:
             lua_pushboolean(L, hide);
             return 1;
         case LuaSTG::GameObjectMember::NAVI:
-            lua_pushboolean(L, navi);
+            lua_pushboolean(L, navi());
             return 1;
         case LuaSTG::GameObjectMember::IMG:
             if (res)
@@ -717,7 +663,7 @@ namespace LuaSTGPlus
             // 更新控制
 
         case LuaSTG::GameObjectMember::TIMER:
-            lua_pushinteger(L, timer);
+            lua_pushinteger(L, timer());
             return 1;
         #ifdef	LUASTG_ENABLE_GAME_OBJECT_PROPERTY_PAUSE
         case LuaSTG::GameObjectMember::PAUSE:
@@ -775,16 +721,16 @@ namespace LuaSTGPlus
 
         case LuaSTG::GameObjectMember::WORLD:
             world = luaL_checkinteger(L, 3);
-            return 0;
+            return 4;
 
             // 位置
 
         case LuaSTG::GameObjectMember::X:
-            x = luaL_checknumber(L, 3);
-            return 0;
+            x() = luaL_checknumber(L, 3);
+            return 3;
         case LuaSTG::GameObjectMember::Y:
-            y = luaL_checknumber(L, 3);
-            return 0;
+            y() = luaL_checknumber(L, 3);
+            return 3;
         case LuaSTG::GameObjectMember::DX:
             return luaL_error(L, "property 'dx' is readonly.");
         case LuaSTG::GameObjectMember::DY:
@@ -793,80 +739,80 @@ namespace LuaSTGPlus
             // 运动学
 
         case LuaSTG::GameObjectMember::VX:
-            vx = luaL_checknumber(L, 3);
+            vx() = luaL_checknumber(L, 3);
             return 0;
         case LuaSTG::GameObjectMember::VY:
-            vy = luaL_checknumber(L, 3);
+            vy() = luaL_checknumber(L, 3);
             return 0;
         case LuaSTG::GameObjectMember::AX:
-            ax = luaL_checknumber(L, 3);
+            ax() = luaL_checknumber(L, 3);
             return 0;
         case LuaSTG::GameObjectMember::AY:
-            ay = luaL_checknumber(L, 3);
+            ay() = luaL_checknumber(L, 3);
             return 0;
         #ifdef USER_SYSTEM_OPERATION
         case LuaSTG::GameObjectMember::MAXVX:
-            maxvx = std::abs(luaL_checknumber(L, 3));
+            maxvx() = std::abs(luaL_checknumber(L, 3));
             return 0;
         case LuaSTG::GameObjectMember::MAXVY:
-            maxvy = std::abs(luaL_checknumber(L, 3));
+            maxvy() = std::abs(luaL_checknumber(L, 3));
             return 0;
         case LuaSTG::GameObjectMember::MAXV:
-            maxv = luaL_checknumber(L, 3);
+            maxv() = luaL_checknumber(L, 3);
             return 0;
         case LuaSTG::GameObjectMember::AG:
-            ag = luaL_checknumber(L, 3);
+            ag() = luaL_checknumber(L, 3);
             return 0;
         #endif
         case LuaSTG::GameObjectMember::VSPEED:
             do {
-                lua_Number const cur_speed_ = std::sqrt(vx * vx + vy * vy);
+                lua_Number const cur_speed_ = std::sqrt(vx() * vx() + vy() * vy());
                 lua_Number const new_speed_ = luaL_checknumber(L, 3);
                 if (cur_speed_ <= std::numeric_limits<double>::min())
                 {
-                    vx = std::cos(rot) * new_speed_;
-                    vy = std::sin(rot) * new_speed_;
+                    vx() = std::cos(rot()) * new_speed_;
+                    vy() = std::sin(rot()) * new_speed_;
                 }
                 else
                 {
                     lua_Number const a3 = new_speed_ / cur_speed_;
-                    vx *= a3;
-                    vy *= a3;
+                    vx() *= a3;
+                    vy() *= a3;
                 }
             } while (false);
             return 0;
         case LuaSTG::GameObjectMember::VANGLE:
             do {
-                lua_Number const cur_speed_ = std::sqrt(vx * vx + vy * vy);
+                lua_Number const cur_speed_ = std::sqrt(vx() * vx() + vy() * vy());
                 lua_Number const new_angle_ = luaL_checknumber(L, 3) * L_DEG_TO_RAD;
                 if (cur_speed_ <= std::numeric_limits<double>::min())
                 {
-                    rot = new_angle_;
+                    rot() = new_angle_;
                 }
                 else
                 {
-                    vx = cur_speed_ * std::cos(new_angle_);
-                    vy = cur_speed_ * std::sin(new_angle_);
+                    vx() = cur_speed_ * std::cos(new_angle_);
+                    vy() = cur_speed_ * std::sin(new_angle_);
                 }
             } while (false);
-            return 0;  
+            return 4;
         case LuaSTG::GameObjectMember::VPOS:
             {
                 Core::Vector2F* const pos = LuaWrapper::Vector2Wrapper::Cast(L, 3);
-                x = pos->x;
-                y = pos->y;
-            } return 0;
+                x() = pos->x;
+                y() = pos->y;
+            } return 3;
         case LuaSTG::GameObjectMember::VVEL:
             {
                 Core::Vector2F* const vel = LuaWrapper::Vector2Wrapper::Cast(L, 3);
-                vx = vel->x;
-                vy = vel->y;
+                vx() = vel->x;
+                vy() = vel->y;
             } return 0;
         case LuaSTG::GameObjectMember::VACCEL:
             {
                 Core::Vector2F* const accel = LuaWrapper::Vector2Wrapper::Cast(L, 3);
-                ax = accel->x;
-                ay = accel->y;
+                ax() = accel->x;
+                ay() = accel->y;
             } return 0;
         case LuaSTG::GameObjectMember::VVSCALE:
             {
@@ -891,11 +837,11 @@ namespace LuaSTGPlus
             return 0;
         case LuaSTG::GameObjectMember::COLLI:
             colli = lua_to_uint8_boolean(L, 3);
-            return 0;
+            return 4;
         case LuaSTG::GameObjectMember::RECT:
             rect = lua_to_uint8_boolean(L, 3);
             UpdateCollisionCircleRadius();
-            return 0;
+            return 3;
         case LuaSTG::GameObjectMember::A:
         #ifdef GLOBAL_SCALE_COLLI_SHAPE
             a = luaL_checknumber(L, 3) * LRES.GetGlobalImageScaleFactor();
@@ -903,7 +849,7 @@ namespace LuaSTGPlus
             a = luaL_checknumber(L, 3);
         #endif // GLOBAL_SCALE_COLLI_SHAPE
             UpdateCollisionCircleRadius();
-            return 0;
+            return 3;
         case LuaSTG::GameObjectMember::B:
         #ifdef GLOBAL_SCALE_COLLI_SHAPE
             b = luaL_checknumber(L, 3) * LRES.GetGlobalImageScaleFactor();
@@ -911,7 +857,7 @@ namespace LuaSTGPlus
             b = luaL_checknumber(L, 3);
         #endif // GLOBAL_SCALE_COLLI_SHAPE
             UpdateCollisionCircleRadius();
-            return 0;
+            return 3;
 
             // 渲染
 
@@ -931,10 +877,10 @@ namespace LuaSTGPlus
             vscale = luaL_checknumber(L, 3);
             return 0;
         case LuaSTG::GameObjectMember::ROT:
-            rot = luaL_checknumber(L, 3) * L_DEG_TO_RAD;
-            return 0;
+            rot() = luaL_checknumber(L, 3) * L_DEG_TO_RAD;
+            return 4;
         case LuaSTG::GameObjectMember::OMEGA:
-            omega = luaL_checknumber(L, 3) * L_DEG_TO_RAD;
+            omega() = luaL_checknumber(L, 3) * L_DEG_TO_RAD;
             return 0;
         #ifdef USING_ADVANCE_GAMEOBJECT_CLASS
         case LuaSTG::GameObjectMember::_BLEND:
@@ -983,7 +929,7 @@ namespace LuaSTGPlus
             hide = lua_to_uint8_boolean(L, 3);
             return 0;
         case LuaSTG::GameObjectMember::NAVI:
-            navi = lua_to_uint8_boolean(L, 3);
+            navi() = lua_to_uint8_boolean(L, 3);
             return 0;
         case LuaSTG::GameObjectMember::IMG:
             do {
@@ -1005,7 +951,7 @@ namespace LuaSTGPlus
                     ReleaseResource();
                 }
             } while (false);
-            return 0;
+            return 3;
         #ifdef USING_ADVANCE_GAMEOBJECT_CLASS
         case LuaSTG::GameObjectMember::RES_RC:
             if (luaclass.IsRenderClass)
@@ -1018,7 +964,7 @@ namespace LuaSTGPlus
             // 更新控制
 
         case LuaSTG::GameObjectMember::TIMER:
-            timer = luaL_checkinteger(L, 3);
+            timer() = luaL_checkinteger(L, 3);
             return 0;
         #ifdef	LUASTG_ENABLE_GAME_OBJECT_PROPERTY_PAUSE
         case LuaSTG::GameObjectMember::PAUSE:
@@ -1040,12 +986,37 @@ namespace LuaSTGPlus
         }
     }
 
+    void GameObjectColliderShape::UpdateCollisionCircleRadius() noexcept
+    {
+        if (rect) {
+            //矩形
+            col_r = std::sqrt(a * a + b * b);
+        }
+        else if (!rect && (a != b)) {
+            //椭圆
+            col_r = a > b ? a : b;
+        }
+        else {
+            //严格的正圆
+            col_r = (a + b) / 2;
+        }
+    }
+
     bool CollisionCheck(GameObject* p1, GameObject* p2) noexcept
     {
         //忽略不碰撞对象
         if (!p1->colli || !p2->colli)
             return false;//返回点0
-        
+
+        return CollisionCheck(
+            GameObjectColliderShape{ p1->x(), p1->y(), p1->a, p1->b, p1->rot(), p1->col_r, (bool)p1->rect },
+            GameObjectColliderShape{ p2->x(), p2->y(), p2->a, p2->b, p2->rot(), p2->col_r, (bool)p2->rect });
+    }
+    bool CollisionCheck(GameObjectColliderShape const& s1, GameObjectColliderShape const& s2) noexcept
+    {
+        GameObjectColliderShape const* p1 = &s1;
+        GameObjectColliderShape const* p2 = &s2;
+
         //快速AABB检测
         if ((p1->x - p1->col_r >= p2->x + p2->col_r) ||
             (p1->x + p1->col_r <= p2->x - p2->col_r) ||
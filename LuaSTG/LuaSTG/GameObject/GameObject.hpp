@@ -2,6 +2,7 @@
 #include "GameResource/ResourceBase.hpp"
 #include "GameResource/ResourceParticle.hpp"
 #include "GameObject/GameObjectClass.hpp"
+#include "GameObject/GameObjectKinematics.hpp"
 #include "lua.hpp"
 
 namespace LuaSTGPlus
@@ -41,28 +42,9 @@ namespace LuaSTGPlus
 
 		lua_Integer world;				// [P] 世界标记位，用于对一个对象进行分组，影响更新、渲染、碰撞检测等
 
-		// 位置
+		// 位置、运动学、旋转角和计数器存放在对象池的 GameObjectKinematics 中，通过同名成员函数访问
 
-		float lastx;				// [4] [不可见] 对象上一帧坐标 x
-		float lasty;				// [4] [不可见] 对象上一帧坐标 y
-		float x;					// [4] 对象坐标 x
-		float y;					// [4] 对象坐标 y
-		float dx;					// [4] [只读] 对象坐标增量 x
-		float dy;					// [4] [只读] 对象坐标增量 y
-
-		// 运动学
-
-		float vx;					// [4] 对象速度 x 分量
-		float vy;					// [4] 对象速度 y 分量
-		float ax;					// [4] 对象加速度 x 分量
-		float ay;					// [4] 对象加速度 x 分量
-	#ifdef USER_SYSTEM_OPERATION
-		float maxvx;				// [4] 对象速度 x 分量最大值
-		float maxvy;				// [4] 对象速度 y 分量最大值
-		float maxv;				// [4] 对象速度最大值
-		float ag;					// [4] 重力加速度
-	#endif
-		//lua_Number va, speed; // 速度方向 速度值
+		GameObjectKinematics* kinematics;	// [P] [不可见] 运动学数据
 
 		// 碰撞体
 
@@ -80,13 +62,10 @@ namespace LuaSTGPlus
 		lua_Number nextlayer;			// [8] [不可见] 对象要切换到的图层
 		float hscale;				// [4] 横向渲染缩放
 		float vscale;				// [4] 纵向渲染缩放
-		float rot;					// [4] 平面渲染旋转角
-		float omega;				// [4] 平面渲染旋转角加速度
 	#ifdef USING_ADVANCE_GAMEOBJECT_CLASS
 		BlendMode blendmode;			// [4] 混合模式
 		uint32_t vertexcolor;			// [4] 顶点颜色
 	#endif // USING_ADVANCE_GAMEOBJECT_CLASS
-		lua_Integer ani_timer;			// [P] [只读] 动画自增计数器
 		// uint8_t hide;					// [1] 不渲染
 		// uint8_t navi;					// [1] 根据坐标增量自动设置渲染旋转角
 		IResourceBase* res;					// [P] 渲染资源
@@ -94,7 +73,6 @@ namespace LuaSTGPlus
 
 		// 更新控制
 
-		lua_Integer timer;				// [P] 自增计数器
 	#ifdef LUASTG_ENABLE_GAME_OBJECT_PROPERTY_PAUSE
 		lua_Integer pause;				// [P] 对象被暂停的时间(帧) 对象被暂停时，将跳过速度计算，但是timer会增加，frame仍会调用
 		// uint8_t resolve_move;			// [1] 是否为计算速度而非计算位置
@@ -110,9 +88,7 @@ namespace LuaSTGPlus
 				uint8_t colli : 1;
 				uint8_t rect : 1;
 				uint8_t hide : 1;
-				uint8_t navi : 1;
 				uint8_t ignore_superpause : 1;
-				uint8_t touch_lastx_lasty : 1;
 #ifdef LUASTG_ENABLE_GAME_OBJECT_PROPERTY_PAUSE
 				uint8_t resolve_move : 1;
 #endif
@@ -121,6 +97,30 @@ namespace LuaSTGPlus
 		};
 	
 
+		// 运动学数据
+
+		float& lastx() const noexcept { return kinematics->lastx[id]; }
+		float& lasty() const noexcept { return kinematics->lasty[id]; }
+		float& x() const noexcept { return kinematics->x[id]; }
+		float& y() const noexcept { return kinematics->y[id]; }
+		float& dx() const noexcept { return kinematics->dx[id]; }
+		float& dy() const noexcept { return kinematics->dy[id]; }
+		float& vx() const noexcept { return kinematics->vx[id]; }
+		float& vy() const noexcept { return kinematics->vy[id]; }
+		float& ax() const noexcept { return kinematics->ax[id]; }
+		float& ay() const noexcept { return kinematics->ay[id]; }
+	#ifdef USER_SYSTEM_OPERATION
+		float& maxvx() const noexcept { return kinematics->maxvx[id]; }
+		float& maxvy() const noexcept { return kinematics->maxvy[id]; }
+		float& maxv() const noexcept { return kinematics->maxv[id]; }
+		float& ag() const noexcept { return kinematics->ag[id]; }
+	#endif
+		float& rot() const noexcept { return kinematics->rot[id]; }
+		float& omega() const noexcept { return kinematics->omega[id]; }
+		lua_Integer& timer() const noexcept { return kinematics->timer[id]; }
+		lua_Integer& ani_timer() const noexcept { return kinematics->ani_timer[id]; }
+		uint8_t& navi() const noexcept { return kinematics->navi[id]; }
+
 		// 成员方法
 
 		void Reset();
@@ -131,23 +131,41 @@ namespace LuaSTGPlus
 		void ReleaseResource();
 		void ReleaseLuaRC(lua_State* L, int idx);
 
+		// Update 是否只包含运动学部分，可以由对象池批量计算
+		bool CanBatchUpdate() const noexcept;
 		void Update();
 		void UpdateLast();
 		void UpdateTimer();
 		void Render();
 
 		int GetAttr(lua_State* L);
+		// 返回值：0 无需额外处理，1 碰撞组发生变化，2 图层发生变化，3 坐标或碰撞体发生变化，4 影响碰撞检测结果的其他属性发生变化
 		int SetAttr(lua_State* L);
 
 		inline bool IsInRect(lua_Number l, lua_Number r, lua_Number b_, lua_Number t) const noexcept
 		{
 			assert(r >= l && t >= b_);
-			return x >= l && x <= r && y >= b_ && y <= t;
+			return x() >= l && x() <= r && y() >= b_ && y() <= t;
 		}
 	};
 
+	// 碰撞体形状，用于不属于对象池的临时碰撞体
+	struct GameObjectColliderShape
+	{
+		float x;
+		float y;
+		float a;
+		float b;
+		float rot;
+		float col_r;
+		bool rect;
+
+		void UpdateCollisionCircleRadius() noexcept;
+	};
+
 #pragma warning(pop)
 	
 	// 对两个游戏对象进行碰撞检测
 	bool CollisionCheck(GameObject* p1, GameObject* p2) noexcept;
+	bool CollisionCheck(GameObjectColliderShape const& s1, GameObjectColliderShape const& s2) noexcept;
 }
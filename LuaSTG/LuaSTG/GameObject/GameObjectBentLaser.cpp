@@ -312,7 +312,7 @@ bool GameObjectBentLaser::Update(size_t id, int length, float width, bool active
 		spdlog::error("[luastg] [GameObjectBentLaser::Update] 无效的lstg.GameObject");
 		return false;
 	}
-	return Update((float)p->x, (float)p->y, (float)p->rot, length, width, active);
+	return Update((float)p->x(), (float)p->y(), (float)p->rot(), length, width, active);
 }
 
 bool GameObjectBentLaser::Update(float x, float y, float rot, int length, float width, bool active) noexcept
@@ -578,8 +578,7 @@ void GameObjectBentLaser::RenderCollider(Core::Color4B fillColor) noexcept
 
 	LAPP.DebugSetGeometryRenderState();
 
-	GameObject testObjA;
-	testObjA.Reset();
+	GameObjectColliderShape testObjA{};
 	testObjA.rot = 0.0f;
 	testObjA.rect = false;
 
@@ -602,7 +601,7 @@ void GameObjectBentLaser::RenderCollider(Core::Color4B fillColor) noexcept
 					testObjA.a = df / 2;
 					testObjA.b = n.half_width;
 					testObjA.UpdateCollisionCircleRadius();
-					if (LuaSTGPlus::CollisionCheck(&testObjA, &testObjB))
+					if (LuaSTGPlus::CollisionCheck(testObjA, testObjB))
 						return true;
 
 				}
@@ -623,13 +622,11 @@ bool GameObjectBentLaser::CollisionCheck(float x, float y, float rot, float a, f
 	if (m_Queue.Size() <= 1)
 		return false;
 
-	GameObject testObjA;
-	testObjA.Reset();
+	GameObjectColliderShape testObjA{};
 	testObjA.rot = 0.;
 	testObjA.rect = false;
 
-	GameObject testObjB;
-	testObjB.Reset();
+	GameObjectColliderShape testObjB{};
 	testObjB.x = x;
 	testObjB.y = y;
 	testObjB.rot = rot;
@@ -656,7 +653,7 @@ bool GameObjectBentLaser::CollisionCheck(float x, float y, float rot, float a, f
 					testObjA.a = df / 2;
 					testObjA.b = n.half_width;
 					testObjA.UpdateCollisionCircleRadius();
-					if (LuaSTGPlus::CollisionCheck(&testObjA, &testObjB))
+					if (LuaSTGPlus::CollisionCheck(testObjA, testObjB))
 						return true;
 
 				}
@@ -668,7 +665,7 @@ bool GameObjectBentLaser::CollisionCheck(float x, float y, float rot, float a, f
 		testObjA.a = testObjA.b = n.half_width * _GetEnvelope((float)i / (float)(sn - 1u)); //n.half_width;
 		testObjA.rect = false;
 		testObjA.UpdateCollisionCircleRadius();
-		if (LuaSTGPlus::CollisionCheck(&testObjA, &testObjB))
+		if (LuaSTGPlus::CollisionCheck(testObjA, testObjB))
 			return true;
 	}
 	return false;
@@ -681,13 +678,11 @@ bool GameObjectBentLaser::CollisionCheckW(float x, float y, float rot, float a,
 		return false;
 	
 	width = width / 2;
-	GameObject testObjA;
-	testObjA.Reset();
+	GameObjectColliderShape testObjA{};
 	testObjA.rot = 0.;
 	testObjA.rect = false;
 
-	GameObject testObjB;
-	testObjB.Reset();
+	GameObjectColliderShape testObjB{};
 	testObjB.x = x;
 	testObjB.y = y;
 	testObjB.rot = rot;
@@ -714,7 +709,7 @@ bool GameObjectBentLaser::CollisionCheckW(float x, float y, float rot, float a,
 					testObjA.a = df / 2;
 					testObjA.b = width;
 					testObjA.UpdateCollisionCircleRadius();
-					if (LuaSTGPlus::CollisionCheck(&testObjA, &testObjB))
+					if (LuaSTGPlus::CollisionCheck(testObjA, testObjB))
 						return true;
 
 				}
@@ -726,7 +721,7 @@ bool GameObjectBentLaser::CollisionCheckW(float x, float y, float rot, float a,
 		testObjA.a = testObjA.b = width;
 		testObjA.rect = false;
 		testObjA.UpdateCollisionCircleRadius();
-		if (LuaSTGPlus::CollisionCheck(&testObjA, &testObjB))
+		if (LuaSTGPlus::CollisionCheck(testObjA, testObjB))
 			return true;
 	}
 	return false;
@@ -0,0 +1,233 @@
+#include "GameObject/GameObjectBroadPhase.hpp"
+
+namespace LuaSTGPlus
+{
+    // 网格尺寸为碰撞组平均外接圆半径的倍数
+    constexpr float BROADPHASE_CELL_SCALE = 4.0f;
+    constexpr float BROADPHASE_CELL_MIN = 8.0f;
+    constexpr float BROADPHASE_CELL_MAX = 1024.0f;
+    constexpr float BROADPHASE_CELL_LIMIT = 1073741823.0f;
+
+    GameObjectBroadPhase::GameObjectBroadPhase(size_t max_object_count)
+    {
+        m_ObjectOrder.assign(max_object_count, InvalidOrder);
+    }
+
+    int32_t GameObjectBroadPhase::_ToCell(float v) const noexcept
+    {
+        float const c = std::floor(v * m_InvCellSize);
+        return static_cast<int32_t>(std::clamp(c, -BROADPHASE_CELL_LIMIT, BROADPHASE_CELL_LIMIT));
+    }
+    void GameObjectBroadPhase::_MakeDynamic(uint32_t order)
+    {
+        if (!m_IsDynamic[order])
+        {
+            m_IsDynamic[order] = 1;
+            m_Dynamic.push_back(order);
+            m_Dirty = true;
+        }
+    }
+    void GameObjectBroadPhase::_Gather(GameObject const* object, std::vector<uint32_t>& output, uint32_t first)
+    {
+        uint32_t const stamp = m_StampValue;
+        uint32_t const count = static_cast<uint32_t>(m_Objects.size());
+
+        float const r = object->col_r + m_CellSize * 0.5f;
+        bool use_grid = std::isfinite(object->x()) && std::isfinite(object->y()) && std::isfinite(r);
+        int32_t x0 = 0, x1 = 0, y0 = 0, y1 = 0;
+        if (use_grid)
+        {
+            x0 = _ToCell(object->x() - r);
+            x1 = _ToCell(object->x() + r);
+            y0 = _ToCell(object->y() - r);
+            y1 = _ToCell(object->y() + r);
+            int64_t const cells = (int64_t(x1) - int64_t(x0) + 1) * (int64_t(y1) - int64_t(y0) + 1);
+            use_grid = cells <= int64_t(m_BucketMask) + 1;
+        }
+
+        if (!use_grid)
+        {
+            // 覆盖范围太大，退化为全部对象
+            for (uint32_t order = first; order < count; order += 1)
+            {
+                if (m_Stamp[order] != stamp)
+                {
+                    m_Stamp[order] = stamp;
+                    output.push_back(order);
+                }
+            }
+            return;
+        }
+
+        for (int32_t cy = y0; cy <= y1; cy += 1)
+        {
+            for (int32_t cx = x0; cx <= x1; cx += 1)
+            {
+                uint32_t const bucket = _HashCell(cx, cy) & m_BucketMask;
+                for (uint32_t k = m_BucketStart[bucket]; k < m_BucketStart[bucket + 1]; k += 1)
+                {
+                    uint32_t const order = m_BucketEntry[k];
+                    if (order >= first && m_Stamp[order] != stamp)
+                    {
+                        m_Stamp[order] = stamp;
+                        output.push_back(order);
+                    }
+                }
+            }
+        }
+        for (uint32_t const order : m_Dynamic)
+        {
+            if (order >= first && m_Stamp[order] != stamp)
+            {
+                m_Stamp[order] = stamp;
+                output.push_back(order);
+            }
+        }
+    }
+
+    void GameObjectBroadPhase::Build(GameObject* first, GameObject* last)
+    {
+        Clear();
+
+        // 按链表顺序编号，统计外接圆半径
+        double sum_r = 0.0;
+        size_t sum_n = 0;
+        for (GameObject* p = first; p != last; p = p->pColliNext)
+        {
+            uint32_t const order = static_cast<uint32_t>(m_Objects.size());
+            m_Objects.push_back(p);
+            m_ObjectId.push_back(static_cast<uint32_t>(p->id));
+            m_ObjectOrder[p->id] = order;
+            if (std::isfinite(p->col_r))
+            {
+                sum_r += p->col_r;
+                sum_n += 1;
+            }
+        }
+        size_t const count = m_Objects.size();
+        m_IsDynamic.assign(count, 0);
+        m_Stamp.assign(count, 0);
+        m_StampValue = 0;
+
+        float const avg_r = (sum_n > 0) ? static_cast<float>(sum_r / static_cast<double>(sum_n)) : 0.0f;
+        m_CellSize = std::clamp(avg_r * BROADPHASE_CELL_SCALE, BROADPHASE_CELL_MIN, BROADPHASE_CELL_MAX);
+        m_InvCellSize = 1.0f / m_CellSize;
+        float const max_r = m_CellSize * 0.5f;
+
+        uint32_t bucket_count = 16;
+        while (bucket_count < count)
+            bucket_count <<= 1;
+        m_BucketMask = bucket_count - 1;
+        m_BucketStart.assign(bucket_count + 1, 0);
+        m_EntryBucket.resize(count);
+
+        // 以中心点所在格子入桶，外接圆大于半个格子的对象放入动态列表
+        for (uint32_t order = 0; order < count; order += 1)
+        {
+            GameObject const* p = m_Objects[order];
+            if (!(p->col_r <= max_r) || !std::isfinite(p->x()) || !std::isfinite(p->y()))
+            {
+                m_EntryBucket[order] = InvalidOrder;
+                _MakeDynamic(order);
+                continue;
+            }
+            uint32_t const bucket = _HashCell(_ToCell(p->x()), _ToCell(p->y())) & m_BucketMask;
+            m_EntryBucket[order] = bucket;
+            m_BucketStart[bucket + 1] += 1;
+        }
+        for (uint32_t i = 0; i < bucket_count; i += 1)
+            m_BucketStart[i + 1] += m_BucketStart[i];
+        m_BucketCursor.assign(m_BucketStart.begin(), m_BucketStart.end() - 1);
+        m_BucketEntry.resize(m_BucketStart[bucket_count]);
+        for (uint32_t order = 0; order < count; order += 1)
+        {
+            uint32_t const bucket = m_EntryBucket[order];
+            if (bucket != InvalidOrder)
+                m_BucketEntry[m_BucketCursor[bucket]++] = order;
+        }
+
+        m_Dirty = false;
+    }
+    void GameObjectBroadPhase::Clear() noexcept
+    {
+        for (size_t order = 0; order < m_Objects.size(); order += 1)
+        {
+            uint32_t& v = m_ObjectOrder[m_ObjectId[order]];
+            if (v == order)
+                v = InvalidOrder;
+        }
+        m_Objects.clear();
+        m_ObjectId.clear();
+        m_Dynamic.clear();
+        m_Dirty = false;
+        m_QueryObject = nullptr;
+        m_QueryObjectDirty = false;
+    }
+    void GameObjectBroadPhase::Query(GameObject const* object, std::vector<uint32_t>& output)
+    {
+        output.clear();
+        m_StampValue += 1;
+        if (m_StampValue == 0)
+        {
+            std::fill(m_Stamp.begin(), m_Stamp.end(), 0);
+            m_StampValue = 1;
+        }
+        m_QueryObject = object;
+        m_QueryObjectDirty = false;
+        m_Dirty = false;
+        _Gather(object, output, 0);
+        std::sort(output.begin(), output.end());
+    }
+    void GameObjectBroadPhase::Requery(std::vector<uint32_t>& output, size_t position)
+    {
+        uint32_t const first = output[position] + 1;
+        size_t const tail = position + 1;
+        if (m_QueryObjectDirty)
+        {
+            // 查询对象自身移动了，按新的坐标重新查找
+            _Gather(m_QueryObject, output, first);
+        }
+        else
+        {
+            uint32_t const stamp = m_StampValue;
+            for (uint32_t const order : m_Dynamic)
+            {
+                if (order >= first && m_Stamp[order] != stamp)
+                {
+                    m_Stamp[order] = stamp;
+                    output.push_back(order);
+                }
+            }
+        }
+        std::sort(output.begin() + static_cast<ptrdiff_t>(tail), output.end());
+        m_Dirty = false;
+        m_QueryObjectDirty = false;
+    }
+    void GameObjectBroadPhase::Append(GameObject* object)
+    {
+        uint32_t const order = static_cast<uint32_t>(m_Objects.size());
+        m_Objects.push_back(object);
+        m_ObjectId.push_back(static_cast<uint32_t>(object->id));
+        m_ObjectOrder[object->id] = order;
+        m_IsDynamic.push_back(0);
+        m_Stamp.push_back(0);
+        m_EntryBucket.push_back(InvalidOrder);
+        _MakeDynamic(order);
+    }
+    void GameObjectBroadPhase::Remove(GameObject* object) noexcept
+    {
+        m_ObjectOrder[object->id] = InvalidOrder;
+    }
+    void GameObjectBroadPhase::Touch(GameObject* object)
+    {
+        if (object == m_QueryObject)
+        {
+            m_QueryObjectDirty = true;
+        }
+        uint32_t const order = m_ObjectOrder[object->id];
+        if (order != InvalidOrder)
+        {
+            _MakeDynamic(order);
+        }
+    }
+}
@@ -0,0 +1,90 @@
+#pragma once
+#include "GameObject/GameObject.hpp"
+
+namespace LuaSTGPlus
+{
+    // 碰撞检测粗筛阶段（均匀网格）
+    // 每次 CollisionCheck 调用时按碰撞组 B 的链表顺序给对象编号并建立网格，候选对象总是按编号（即链表顺序）返回
+    // 回调中被修改了坐标、碰撞体或者重新加入碰撞组 B 的对象会被移入动态列表，每次查询都会返回，
+    // 因此回调顺序和逐个遍历链表的结果完全一致，不影响录像
+    class GameObjectBroadPhase
+    {
+    public:
+        static constexpr uint32_t InvalidOrder = UINT32_MAX;
+
+    private:
+        // 按链表顺序编号的对象
+        std::vector<GameObject*> m_Objects;
+        std::vector<uint32_t> m_ObjectId;
+        // 对象 id 到编号的映射，不在碰撞组内时为 InvalidOrder
+        std::vector<uint32_t> m_ObjectOrder;
+        // 编号是否已经在动态列表中
+        std::vector<uint8_t> m_IsDynamic;
+        // 查询去重标记
+        std::vector<uint32_t> m_Stamp;
+        uint32_t m_StampValue{ 0 };
+
+        // 网格，对象按所在格子的哈希桶连续存放
+        std::vector<uint32_t> m_BucketStart;
+        std::vector<uint32_t> m_BucketCursor;
+        std::vector<uint32_t> m_BucketEntry;
+        std::vector<uint32_t> m_EntryBucket;
+        uint32_t m_BucketMask{ 0 };
+        float m_CellSize{ 1.0f };
+        float m_InvCellSize{ 1.0f };
+
+        // 动态列表：过大的碰撞体、调用期间被修改或者新加入的对象
+        std::vector<uint32_t> m_Dynamic;
+        bool m_Dirty{ false };
+
+        // 当前正在查询的对象
+        GameObject const* m_QueryObject{ nullptr };
+        bool m_QueryObjectDirty{ false };
+
+    private:
+        static uint32_t _HashCell(int32_t cx, int32_t cy) noexcept
+        {
+            return (static_cast<uint32_t>(cx) * 73856093u) ^ (static_cast<uint32_t>(cy) * 19349663u);
+        }
+        int32_t _ToCell(float v) const noexcept;
+        void _MakeDynamic(uint32_t order);
+        void _Gather(GameObject const* object, std::vector<uint32_t>& output, uint32_t first);
+
+    public:
+        // 以链表 [first, last) 建立网格
+        void Build(GameObject* first, GameObject* last);
+
+        // 清空网格，结束本次碰撞检测
+        void Clear() noexcept;
+
+        // 查询可能与对象相交的候选对象编号，按链表顺序排列
+        void Query(GameObject const* object, std::vector<uint32_t>& output);
+
+        // 回调修改了网格或者查询对象后，补充剩余的候选对象，position 为当前正在处理的候选对象下标
+        void Requery(std::vector<uint32_t>& output, size_t position);
+
+        // 获取编号对应的对象，对象已离开碰撞组时返回 nullptr
+        GameObject* GetObject(uint32_t order) const noexcept
+        {
+            return (m_ObjectOrder[m_ObjectId[order]] == order) ? m_Objects[order] : nullptr;
+        }
+
+        // 对象加入了碰撞组链表末尾
+        void Append(GameObject* object);
+
+        // 对象离开了碰撞组链表
+        void Remove(GameObject* object) noexcept;
+
+        // 对象的坐标或碰撞体发生了变化
+        void Touch(GameObject* object);
+
+        // 是否有需要补充的候选对象
+        bool IsDirty() const noexcept { return m_Dirty || m_QueryObjectDirty; }
+
+        // 已编号的对象数量
+        size_t GetObjectCount() const noexcept { return m_Objects.size(); }
+
+    public:
+        explicit GameObjectBroadPhase(size_t max_object_count);
+    };
+}
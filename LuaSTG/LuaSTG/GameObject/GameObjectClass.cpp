@@ -5,6 +5,7 @@ namespace LuaSTGPlus
 {
 	constexpr char const IS_CLASS[] = "is_class";
 	constexpr char const IS_RENDER_CLASS[] = ".render";
+	constexpr char const IS_OBJECT_VIEW_CLASS[] = ".object_view";
 	constexpr char const DEFAULT_FUNCTION[] = "default_function";
 	
 	bool GameObjectClass::CheckClassClass(lua_State* L, int index)
@@ -49,6 +50,11 @@ namespace LuaSTGPlus
 		IsRenderClass = lua_to_uint8_boolean(L, -1);		// ??? class ??? b 
 		lua_pop(L, 1);										// ??? class ??? 
 		
+		// 使用 FFI 数据视图的元表
+		lua_getfield(L, index, IS_OBJECT_VIEW_CLASS);		// ??? class ??? ? 
+		IsObjectView = lua_to_uint8_boolean(L, -1);			// ??? class ??? b 
+		lua_pop(L, 1);										// ??? class ??? 
+		
 		return true;
 	}
 	
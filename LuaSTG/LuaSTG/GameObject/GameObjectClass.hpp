@@ -26,6 +26,7 @@ namespace LuaSTGPlus
 				uint32_t IsDefaultTrigger : 1;
 				uint32_t IsDefaultLegacyKill : 1;
 				uint32_t IsRenderClass : 1;
+				uint32_t IsObjectView : 1;
 			};
 			uint32_t __Value{};
 		};
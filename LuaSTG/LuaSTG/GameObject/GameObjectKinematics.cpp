@@ -0,0 +1,429 @@
+#include "GameObject/GameObjectKinematics.hpp"
+
+#if defined(_M_X64) || defined(__x86_64__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#include <emmintrin.h>
+#define LUASTG_KINEMATICS_SSE2
+#elif defined(_M_ARM64) || defined(__aarch64__)
+#include <arm_neon.h>
+#define LUASTG_KINEMATICS_NEON
+#endif
+
+namespace LuaSTGPlus
+{
+    namespace
+    {
+        constexpr size_t storage_alignment = 64;
+
+        // 逐个对象的计算，也用于批量计算中无法向量化的对象
+
+        inline void integrate_one(GameObjectKinematics& k, size_t i) noexcept
+        {
+            // 更新速度
+            float vx = k.vx[i] + k.ax[i];
+            float vy = k.vy[i] + k.ay[i];
+        #ifdef USER_SYSTEM_OPERATION
+            // 单独应用重力加速度
+            vy -= k.ag[i];
+            // 速度限制，来自lua层
+            float const maxv = k.maxv[i];
+            if (maxv <= std::numeric_limits<double>::min())
+            {
+                vx = 0.0;
+                vy = 0.0;
+            }
+            else
+            {
+                // 和批量计算的运算顺序相同；GCC/Clang 下本文件以 -ffp-contract=off 编译，不会合并为 FMA，结果逐位一致
+                float const vx2 = vx * vx;
+                float const vy2 = vy * vy;
+                lua_Number const speed_ = std::sqrt(vx2 + vy2);
+                if (maxv < speed_ && speed_ > std::numeric_limits<double>::min())
+                {
+                    lua_Number const scale_ = maxv / speed_;
+                    vx = (float)(scale_ * vx);
+                    vy = (float)(scale_ * vy);
+                }
+            }
+            //针对x、y方向单独限制
+            vx = std::clamp(vx, -k.maxvx[i], k.maxvx[i]);
+            vy = std::clamp(vy, -k.maxvy[i], k.maxvy[i]);
+        #endif
+            k.vx[i] = vx;
+            k.vy[i] = vy;
+            k.x[i] += vx;
+            k.y[i] += vy;
+            k.rot[i] += k.omega[i];
+        }
+        inline void update_last_one(GameObjectKinematics& k, size_t i) noexcept
+        {
+            if (k.touch_lastx_lasty[i])
+            {
+                k.dx[i] = k.x[i] - k.lastx[i];
+                k.dy[i] = k.y[i] - k.lasty[i];
+            }
+            else
+            {
+                k.dx[i] = 0.0;
+                k.dy[i] = 0.0;
+            }
+            k.lastx[i] = k.x[i];
+            k.lasty[i] = k.y[i];
+            k.touch_lastx_lasty[i] = 1;
+        }
+        inline void update_navi_one(GameObjectKinematics& k, size_t i) noexcept
+        {
+            float const dx = k.dx[i];
+            float const dy = k.dy[i];
+            if (k.navi[i] && (std::abs(dx) > std::numeric_limits<double>::min() || std::abs(dy) > std::numeric_limits<double>::min()))
+            {
+                k.rot[i] = std::atan2(dy, dx);
+            }
+        }
+
+        // 与 lua_Number 比较等价的 float 边界：对任意 float x，x >= l 当且仅当 x >= lower_bound(l)
+        float lower_bound(lua_Number v) noexcept
+        {
+            if (std::isnan(v))
+                return std::numeric_limits<float>::quiet_NaN();
+            if (v > std::numeric_limits<float>::max())
+                return std::numeric_limits<float>::infinity();
+            if (v < -std::numeric_limits<float>::max())
+                return std::isinf(v) ? -std::numeric_limits<float>::infinity() : -std::numeric_limits<float>::max();
+            float f = static_cast<float>(v);
+            if (static_cast<lua_Number>(f) < v)
+                f = std::nextafter(f, std::numeric_limits<float>::infinity());
+            return f;
+        }
+        // 对任意 float x，x <= r 当且仅当 x <= upper_bound(r)
+        float upper_bound(lua_Number v) noexcept
+        {
+            return -lower_bound(-v);
+        }
+
+        // 4 个连续的 id 才能直接读写数组
+        inline bool is_contiguous(uint32_t const* index) noexcept
+        {
+            uint32_t const i0 = index[0];
+            return index[1] == i0 + 1 && index[2] == i0 + 2 && index[3] == i0 + 3;
+        }
+
+    #if defined(LUASTG_KINEMATICS_SSE2)
+        using f4 = __m128;
+        using m4 = __m128;
+        inline f4 f4_load(float const* p) noexcept { return _mm_loadu_ps(p); }
+        inline void f4_store(float* p, f4 v) noexcept { _mm_storeu_ps(p, v); }
+        inline f4 f4_zero() noexcept { return _mm_setzero_ps(); }
+        inline f4 f4_set(float v) noexcept { return _mm_set1_ps(v); }
+        inline f4 f4_add(f4 a, f4 b) noexcept { return _mm_add_ps(a, b); }
+        inline f4 f4_sub(f4 a, f4 b) noexcept { return _mm_sub_ps(a, b); }
+        inline f4 f4_mul(f4 a, f4 b) noexcept { return _mm_mul_ps(a, b); }
+        inline f4 f4_sqrt(f4 a) noexcept { return _mm_sqrt_ps(a); }
+        inline f4 f4_neg(f4 a) noexcept { return _mm_xor_ps(a, _mm_set1_ps(-0.0f)); }
+        inline m4 f4_lt(f4 a, f4 b) noexcept { return _mm_cmplt_ps(a, b); }
+        inline m4 f4_le(f4 a, f4 b) noexcept { return _mm_cmple_ps(a, b); }
+        inline m4 f4_gt(f4 a, f4 b) noexcept { return _mm_cmpgt_ps(a, b); }
+        inline m4 f4_ge(f4 a, f4 b) noexcept { return _mm_cmpge_ps(a, b); }
+        inline m4 m4_and(m4 a, m4 b) noexcept { return _mm_and_ps(a, b); }
+        inline m4 m4_or(m4 a, m4 b) noexcept { return _mm_or_ps(a, b); }
+        inline f4 f4_select(m4 m, f4 a, f4 b) noexcept { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+        inline int m4_bits(m4 m) noexcept { return _mm_movemask_ps(m); }
+        inline m4 m4_from_bytes(uint8_t const* p) noexcept
+        {
+            return _mm_castsi128_ps(_mm_set_epi32(-int(p[3] != 0), -int(p[2] != 0), -int(p[1] != 0), -int(p[0] != 0)));
+        }
+    #elif defined(LUASTG_KINEMATICS_NEON)
+        using f4 = float32x4_t;
+        using m4 = uint32x4_t;
+        inline f4 f4_load(float const* p) noexcept { return vld1q_f32(p); }
+        inline void f4_store(float* p, f4 v) noexcept { vst1q_f32(p, v); }
+        inline f4 f4_zero() noexcept { return vdupq_n_f32(0.0f); }
+        inline f4 f4_set(float v) noexcept { return vdupq_n_f32(v); }
+        inline f4 f4_add(f4 a, f4 b) noexcept { return vaddq_f32(a, b); }
+        inline f4 f4_sub(f4 a, f4 b) noexcept { return vsubq_f32(a, b); }
+        inline f4 f4_mul(f4 a, f4 b) noexcept { return vmulq_f32(a, b); }
+        inline f4 f4_sqrt(f4 a) noexcept { return vsqrtq_f32(a); }
+        inline f4 f4_neg(f4 a) noexcept { return vnegq_f32(a); }
+        inline m4 f4_lt(f4 a, f4 b) noexcept { return vcltq_f32(a, b); }
+        inline m4 f4_le(f4 a, f4 b) noexcept { return vcleq_f32(a, b); }
+        inline m4 f4_gt(f4 a, f4 b) noexcept { return vcgtq_f32(a, b); }
+        inline m4 f4_ge(f4 a, f4 b) noexcept { return vcgeq_f32(a, b); }
+        inline m4 m4_and(m4 a, m4 b) noexcept { return vandq_u32(a, b); }
+        inline m4 m4_or(m4 a, m4 b) noexcept { return vorrq_u32(a, b); }
+        inline f4 f4_select(m4 m, f4 a, f4 b) noexcept { return vbslq_f32(m, a, b); }
+        inline int m4_bits(m4 m) noexcept
+        {
+            return int(vgetq_lane_u32(m, 0) & 1u)
+                | int(vgetq_lane_u32(m, 1) & 2u)
+                | int(vgetq_lane_u32(m, 2) & 4u)
+                | int(vgetq_lane_u32(m, 3) & 8u);
+        }
+        inline m4 m4_from_bytes(uint8_t const* p) noexcept
+        {
+            uint32_t const v[4] = { p[0] ? ~0u : 0u, p[1] ? ~0u : 0u, p[2] ? ~0u : 0u, p[3] ? ~0u : 0u };
+            return vld1q_u32(v);
+        }
+    #endif
+
+    #if defined(LUASTG_KINEMATICS_SSE2) || defined(LUASTG_KINEMATICS_NEON)
+        #define LUASTG_KINEMATICS_SIMD
+        constexpr size_t simd_width = 4;
+
+        inline void integrate_simd(GameObjectKinematics& k, size_t i) noexcept
+        {
+            f4 vx = f4_add(f4_load(k.vx + i), f4_load(k.ax + i));
+            f4 vy = f4_add(f4_load(k.vy + i), f4_load(k.ay + i));
+        #ifdef USER_SYSTEM_OPERATION
+            vy = f4_sub(vy, f4_load(k.ag + i));
+            // 触发速度限制的对象很少，且需要双精度计算，交给逐个对象的计算
+            f4 const zero = f4_zero();
+            f4 const maxv = f4_load(k.maxv + i);
+            f4 const speed = f4_sqrt(f4_add(f4_mul(vx, vx), f4_mul(vy, vy)));
+            m4 const slow = m4_or(f4_le(maxv, zero), m4_and(f4_lt(maxv, speed), f4_gt(speed, zero)));
+            if (m4_bits(slow) != 0)
+            {
+                for (size_t j = 0; j < simd_width; j += 1)
+                    integrate_one(k, i + j);
+                return;
+            }
+            // 与 std::clamp 一致：v < lo ? lo : (hi < v ? hi : v)
+            f4 const maxvx = f4_load(k.maxvx + i);
+            f4 const minvx = f4_neg(maxvx);
+            vx = f4_select(f4_lt(vx, minvx), minvx, f4_select(f4_lt(maxvx, vx), maxvx, vx));
+            f4 const maxvy = f4_load(k.maxvy + i);
+            f4 const minvy = f4_neg(maxvy);
+            vy = f4_select(f4_lt(vy, minvy), minvy, f4_select(f4_lt(maxvy, vy), maxvy, vy));
+        #endif
+            f4_store(k.vx + i, vx);
+            f4_store(k.vy + i, vy);
+            f4_store(k.x + i, f4_add(f4_load(k.x + i), vx));
+            f4_store(k.y + i, f4_add(f4_load(k.y + i), vy));
+            f4_store(k.rot + i, f4_add(f4_load(k.rot + i), f4_load(k.omega + i)));
+        }
+        inline void update_last_simd(GameObjectKinematics& k, size_t i) noexcept
+        {
+            f4 const zero = f4_zero();
+            m4 const touch = m4_from_bytes(k.touch_lastx_lasty + i);
+            f4 const x = f4_load(k.x + i);
+            f4 const y = f4_load(k.y + i);
+            f4_store(k.dx + i, f4_select(touch, f4_sub(x, f4_load(k.lastx + i)), zero));
+            f4_store(k.dy + i, f4_select(touch, f4_sub(y, f4_load(k.lasty + i)), zero));
+            f4_store(k.lastx + i, x);
+            f4_store(k.lasty + i, y);
+            std::memset(k.touch_lastx_lasty + i, 1, simd_width);
+            uint32_t navi = 0;
+            std::memcpy(&navi, k.navi + i, sizeof(navi));
+            if (navi != 0)
+            {
+                for (size_t j = 0; j < simd_width; j += 1)
+                    update_navi_one(k, i + j);
+            }
+        }
+    #endif
+    }
+
+    GameObjectKinematics::GameObjectKinematics(size_t max_object_count)
+        : m_Capacity(max_object_count)
+    {
+        size_t const stride = (m_Capacity * sizeof(lua_Integer) + storage_alignment - 1) / storage_alignment * storage_alignment;
+        constexpr size_t array_count = 16 + 2 + 3; // float + lua_Integer + uint8_t
+        m_Storage = std::make_unique<uint8_t[]>(stride * array_count + storage_alignment);
+        uint8_t* p = m_Storage.get();
+        p += (storage_alignment - reinterpret_cast<uintptr_t>(p) % storage_alignment) % storage_alignment;
+        auto const next = [&]() { uint8_t* r = p; p += stride; return r; };
+        lastx = reinterpret_cast<float*>(next());
+        lasty = reinterpret_cast<float*>(next());
+        x = reinterpret_cast<float*>(next());
+        y = reinterpret_cast<float*>(next());
+        dx = reinterpret_cast<float*>(next());
+        dy = reinterpret_cast<float*>(next());
+        vx = reinterpret_cast<float*>(next());
+        vy = reinterpret_cast<float*>(next());
+        ax = reinterpret_cast<float*>(next());
+        ay = reinterpret_cast<float*>(next());
+        maxvx = reinterpret_cast<float*>(next());
+        maxvy = reinterpret_cast<float*>(next());
+        maxv = reinterpret_cast<float*>(next());
+        ag = reinterpret_cast<float*>(next());
+        rot = reinterpret_cast<float*>(next());
+        omega = reinterpret_cast<float*>(next());
+        timer = reinterpret_cast<lua_Integer*>(next());
+        ani_timer = reinterpret_cast<lua_Integer*>(next());
+        navi = next();
+        touch_lastx_lasty = next();
+        active = next();
+        m_ActiveIndex.reserve(m_Capacity);
+        for (size_t i = 0; i < m_Capacity; i += 1)
+            Reset(i);
+        Clear();
+    }
+
+    void GameObjectKinematics::Alloc(size_t id) noexcept
+    {
+        assert(id < m_Capacity && !active[id]);
+        Reset(id);
+        active[id] = 1;
+        m_ActiveIndexDirty = true;
+    }
+    void GameObjectKinematics::Free(size_t id) noexcept
+    {
+        assert(id < m_Capacity && active[id]);
+        active[id] = 0;
+        m_ActiveIndexDirty = true;
+    }
+    void GameObjectKinematics::Reset(size_t id) noexcept
+    {
+        x[id] = y[id] = 0.;
+        lastx[id] = lasty[id] = 0.;
+        dx[id] = dy[id] = 0.;
+        rot[id] = omega[id] = 0.;
+        vx[id] = vy[id] = 0.;
+        ax[id] = ay[id] = 0.;
+        maxv[id] = std::numeric_limits<float>::infinity(); // 平时应该不会有人弄那么大的速度吧
+        maxvx[id] = maxvy[id] = std::numeric_limits<float>::infinity();
+        ag[id] = 0.;
+        timer[id] = ani_timer[id] = 0;
+        navi[id] = 0;
+        touch_lastx_lasty[id] = 0;
+    }
+    void GameObjectKinematics::Clear() noexcept
+    {
+        std::memset(active, 0, m_Capacity);
+        m_ActiveIndex.clear();
+        m_ActiveIndexDirty = false;
+    }
+    std::vector<uint32_t> const& GameObjectKinematics::GetActiveIndex()
+    {
+        if (m_ActiveIndexDirty)
+        {
+            m_ActiveIndex.clear();
+            size_t i = 0;
+            // 空闲的部分一次跳过 8 个
+            for (; i + 8 <= m_Capacity; i += 8)
+            {
+                uint64_t v = 0;
+                std::memcpy(&v, active + i, sizeof(v));
+                if (v == 0)
+                    continue;
+                for (size_t j = i; j < i + 8; j += 1)
+                {
+                    if (active[j])
+                        m_ActiveIndex.push_back(static_cast<uint32_t>(j));
+                }
+            }
+            for (; i < m_Capacity; i += 1)
+            {
+                if (active[i])
+                    m_ActiveIndex.push_back(static_cast<uint32_t>(i));
+            }
+            m_ActiveIndexDirty = false;
+        }
+        return m_ActiveIndex;
+    }
+
+    void GameObjectKinematics::Integrate(uint32_t const* index, size_t count) noexcept
+    {
+        size_t n = 0;
+    #ifdef LUASTG_KINEMATICS_SIMD
+        for (; n + simd_width <= count; n += simd_width)
+        {
+            if (is_contiguous(index + n))
+            {
+                integrate_simd(*this, index[n]);
+            }
+            else
+            {
+                for (size_t j = 0; j < simd_width; j += 1)
+                    integrate_one(*this, index[n + j]);
+            }
+        }
+    #endif
+        for (; n < count; n += 1)
+        {
+            integrate_one(*this, index[n]);
+        }
+    }
+    void GameObjectKinematics::UpdateLast(uint32_t const* index, size_t count) noexcept
+    {
+        size_t n = 0;
+    #ifdef LUASTG_KINEMATICS_SIMD
+        for (; n + simd_width <= count; n += simd_width)
+        {
+            if (is_contiguous(index + n))
+            {
+                update_last_simd(*this, index[n]);
+            }
+            else
+            {
+                for (size_t j = 0; j < simd_width; j += 1)
+                {
+                    update_last_one(*this, index[n + j]);
+                    update_navi_one(*this, index[n + j]);
+                }
+            }
+        }
+    #endif
+        for (; n < count; n += 1)
+        {
+            update_last_one(*this, index[n]);
+            update_navi_one(*this, index[n]);
+        }
+    }
+    void GameObjectKinematics::UpdateTimer(uint32_t const* index, size_t count) noexcept
+    {
+        for (size_t n = 0; n < count; n += 1)
+        {
+            timer[index[n]] += 1;
+            ani_timer[index[n]] += 1;
+        }
+    }
+    size_t GameObjectKinematics::BoundCheck(uint32_t const* index, size_t count, lua_Number l, lua_Number r, lua_Number b, lua_Number t, uint32_t* output) const noexcept
+    {
+        float const fl = lower_bound(l);
+        float const fr = upper_bound(r);
+        float const fb = lower_bound(b);
+        float const ft = upper_bound(t);
+        size_t out = 0;
+        size_t n = 0;
+    #ifdef LUASTG_KINEMATICS_SIMD
+        f4 const vl = f4_set(fl);
+        f4 const vr = f4_set(fr);
+        f4 const vb = f4_set(fb);
+        f4 const vt = f4_set(ft);
+        for (; n + simd_width <= count; n += simd_width)
+        {
+            int inside = 0;
+            if (is_contiguous(index + n))
+            {
+                size_t const i = index[n];
+                f4 const vx_ = f4_load(x + i);
+                f4 const vy_ = f4_load(y + i);
+                inside = m4_bits(m4_and(m4_and(f4_ge(vx_, vl), f4_le(vx_, vr)), m4_and(f4_ge(vy_, vb), f4_le(vy_, vt))));
+            }
+            else
+            {
+                for (size_t j = 0; j < simd_width; j += 1)
+                {
+                    size_t const i = index[n + j];
+                    if (x[i] >= fl && x[i] <= fr && y[i] >= fb && y[i] <= ft)
+                        inside |= (1 << j);
+                }
+            }
+            if (inside != 0xF)
+            {
+                for (size_t j = 0; j < simd_width; j += 1)
+                {
+                    if (!(inside & (1 << j)))
+                        output[out++] = index[n + j];
+                }
+            }
+        }
+    #endif
+        for (; n < count; n += 1)
+        {
+            size_t const i = index[n];
+            if (!(x[i] >= fl && x[i] <= fr && y[i] >= fb && y[i] <= ft))
+                output[out++] = index[n];
+        }
+        return out;
+    }
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include "lua.hpp"
+
+namespace LuaSTGPlus
+{
+    // 游戏对象运动学数据（SoA），按对象在对象池中的 id 索引
+    // 逐对象的计算和批量计算使用同一套浮点运算顺序，结果完全一致，不影响录像
+    class GameObjectKinematics
+    {
+    public:
+        // 位置
+        float* lastx{};     // 对象上一帧坐标 x
+        float* lasty{};     // 对象上一帧坐标 y
+        float* x{};         // 对象坐标 x
+        float* y{};         // 对象坐标 y
+        float* dx{};        // 对象坐标增量 x
+        float* dy{};        // 对象坐标增量 y
+
+        // 运动学
+        float* vx{};        // 对象速度 x 分量
+        float* vy{};        // 对象速度 y 分量
+        float* ax{};        // 对象加速度 x 分量
+        float* ay{};        // 对象加速度 y 分量
+        float* maxvx{};     // 对象速度 x 分量最大值
+        float* maxvy{};     // 对象速度 y 分量最大值
+        float* maxv{};      // 对象速度最大值
+        float* ag{};        // 重力加速度
+
+        // 旋转
+        float* rot{};       // 平面渲染旋转角
+        float* omega{};     // 平面渲染旋转角加速度
+
+        // 计数器
+        lua_Integer* timer{};       // 自增计数器
+        lua_Integer* ani_timer{};   // 动画自增计数器
+
+        // 标记
+        uint8_t* navi{};                // 根据坐标增量自动设置渲染旋转角
+        uint8_t* touch_lastx_lasty{};   // 是否已经更新过 lastx 和 lasty 值
+        uint8_t* active{};              // 是否已分配
+
+    private:
+        size_t m_Capacity{ 0 };
+        std::unique_ptr<uint8_t[]> m_Storage;
+        std::vector<uint32_t> m_ActiveIndex;
+        bool m_ActiveIndexDirty{ false };
+
+    public:
+        // 分配 id 并设置为默认值
+        void Alloc(size_t id) noexcept;
+
+        // 释放 id
+        void Free(size_t id) noexcept;
+
+        // 恢复默认值
+        void Reset(size_t id) noexcept;
+
+        // 释放全部 id
+        void Clear() noexcept;
+
+        // 已分配的 id，按升序排列
+        std::vector<uint32_t> const& GetActiveIndex();
+
+        // 更新速度、坐标和旋转角，等价于逐个对象执行 GameObject::Update 的运动学部分
+        void Integrate(uint32_t const* index, size_t count) noexcept;
+
+        // 更新坐标增量和上一帧坐标，等价于逐个对象执行 GameObject::UpdateLast
+        void UpdateLast(uint32_t const* index, size_t count) noexcept;
+
+        // 计数器自增
+        void UpdateTimer(uint32_t const* index, size_t count) noexcept;
+
+        // 找出坐标在矩形外的对象，结果保持输入顺序，返回数量
+        size_t BoundCheck(uint32_t const* index, size_t count, lua_Number l, lua_Number r, lua_Number b, lua_Number t, uint32_t* output) const noexcept;
+
+    public:
+        explicit GameObjectKinematics(size_t max_object_count);
+        GameObjectKinematics(GameObjectKinematics const&) = delete;
+        GameObjectKinematics& operator=(GameObjectKinematics const&) = delete;
+    };
+}
@@ -2,11 +2,16 @@
 #include "LuaBinding/LuaWrapper.hpp"
 #include "LuaBinding/lua_luastg_hash.hpp"
 #include "AppFrame.h"
+#include "Core/FrameProfiler.hpp"
 
 #include "SDL.h"
 
 #define LOBJPOOL_SIZE_INTERNAL (LOBJPOOL_SIZE + 1)
 #define LOBJPOOL_METATABLE_IDX (LOBJPOOL_SIZE_INTERNAL)
+#define LOBJPOOL_VIEW_METATABLE_IDX (LOBJPOOL_SIZE_INTERNAL + 1)
+#define LOBJPOOL_DISPATCH_LIST_IDX (LOBJPOOL_SIZE_INTERNAL + 2)
+#define LOBJPOOL_DISPATCH_FUNC_IDX (LOBJPOOL_SIZE_INTERNAL + 3)
+#define LOBJPOOL_RECYCLE_IDX (LOBJPOOL_SIZE_INTERNAL + 4)
 
 namespace LuaSTGPlus
 {
@@ -14,6 +19,35 @@ namespace LuaSTGPlus
 
     static GameObjectPool* g_GameObjectPool = nullptr;
 
+    // 批量回调在 Lua 侧的循环，list[0] 记录进度，用于获取当前对象
+    // 回调出错时在出错的位置记录调用栈，清空进度和剩余的对象后再抛出
+    static char const s_DispatchSource[] = R"(
+local rawget = rawget
+local xpcall = xpcall
+local error = error
+local traceback = debug.traceback
+local function dispatch(list, n, callback)
+    for i = 1, n do
+        local object = list[i]
+        if object then
+            list[i] = nil
+            list[0] = i
+            rawget(rawget(object, 1), callback)(object)
+        end
+    end
+end
+return function(list, n, callback)
+    local ok, message = xpcall(dispatch, traceback, list, n, callback)
+    list[0] = 0
+    if not ok then
+        for i = 1, n do
+            list[i] = nil
+        end
+        error(message, 0)
+    end
+end
+)";
+
     GameObjectPool::GameObjectPool(lua_State* pL)
     {
         assert(g_GameObjectPool == nullptr);
@@ -23,12 +57,15 @@ namespace LuaSTGPlus
         // 初始化对象链表
         _ClearLinkList();
         m_RenderList.clear();
+        m_RenderSortBuffer[0].resize(LOBJPOOL_SIZE);
+        m_RenderSortBuffer[1].resize(LOBJPOOL_SIZE);
         // ex+
         m_pCurrentObject = nullptr;
         m_superpause = 0;
         m_nextsuperpause = 0;
         // lua
         _PrepareLuaObjectTable();
+        _PrepareObjectView();
     }
     GameObjectPool::~GameObjectPool()
     {
@@ -88,10 +125,18 @@ namespace LuaSTGPlus
         p->pColliPrev = prev;
         p->pColliNext = next;
         next->pColliPrev = p;
+        if (group == m_BroadPhaseGroup)
+        {
+            m_BroadPhase.Append(p);
+        }
     }
     void GameObjectPool::_RemoveFromColliLinkList(GameObject* p)
     {
         assert(p != m_LockObjectA && p != m_LockObjectB);
+        if (m_BroadPhaseGroup != BroadPhaseInactive)
+        {
+            m_BroadPhase.Remove(p);
+        }
         GameObject* prev = p->pColliPrev;
         GameObject* next = p->pColliNext;
         prev->pColliNext = next;
@@ -107,18 +152,47 @@ namespace LuaSTGPlus
 
     void GameObjectPool::_InsertToRenderList(GameObject* p)
     {
-        m_RenderList.insert(p);
+        if (!m_SortRenderList)
+        {
+            m_RenderList.insert(p);
+        }
     }
     void GameObjectPool::_RemoveFromRenderList(GameObject* p)
     {
-        m_RenderList.erase(p);
+        if (!m_SortRenderList)
+        {
+            m_RenderList.erase(p);
+        }
     }
     void GameObjectPool::_SetObjectLayer(GameObject* object, lua_Number layer)
     {
+        if (m_SortRenderList)
+        {
+            object->layer = layer;
+            return;
+        }
         m_RenderList.erase(object);
         object->layer = layer;
         m_RenderList.insert(object);
     }
+    cpp::radix_sort_item<GameObject*>* GameObjectPool::_SortRenderList(size_t& count)
+    {
+        ZoneScopedN("LOBJMGR.SortRenderList");
+        FrameProfileScopeN("LOBJMGR.SortRenderList");
+
+        // 更新链表按 uid 递增排列，因此只需要对 layer 做稳定排序，结果与 _less_render 相同
+        cpp::radix_sort_item<GameObject*>* data = m_RenderSortBuffer[0].data();
+        size_t n = 0;
+        for (GameObject* p = m_UpdateLinkList.first.pUpdateNext; p != &m_UpdateLinkList.second; p = p->pUpdateNext)
+        {
+            assert(n == 0 || data[n - 1].value->uid < p->uid);
+            data[n].key = cpp::radix_sort_key(p->layer);
+            data[n].value = p;
+            n += 1;
+        }
+        count = n;
+        return cpp::radix_sort(data, m_RenderSortBuffer[1].data(), n);
+    }
 
     void GameObjectPool::_PrepareLuaObjectTable()
     {
@@ -137,9 +211,58 @@ namespace LuaSTGPlus
         luaL_register(G_L, NULL, mt);						// ??? p ot mt
         lua_rawseti(G_L, -2, LOBJPOOL_METATABLE_IDX);		// ??? p ot
 
+        // 批量回调使用的数组和循环
+        lua_createtable(G_L, LOBJPOOL_SIZE, 1);				// ??? p ot list
+        lua_rawseti(G_L, -2, LOBJPOOL_DISPATCH_LIST_IDX);	// ??? p ot
+
+        // 回收的对象表，键为类，值为空闲对象表的数组；关闭回收和重置对象池时整个丢弃
+        lua_newtable(G_L);									// ??? p ot recycle
+        lua_rawseti(G_L, -2, LOBJPOOL_RECYCLE_IDX);			// ??? p ot
+        if (0 == luaL_loadbuffer(G_L, s_DispatchSource, sizeof(s_DispatchSource) - 1, "internal.dispatch")
+            && 0 == lua_pcall(G_L, 0, 1, 0))				// ??? p ot f
+        {
+            lua_rawseti(G_L, -2, LOBJPOOL_DISPATCH_FUNC_IDX);	// ??? p ot
+            m_DispatchReady = true;
+        }
+        else
+        {
+            spdlog::error("[luastg] GameObjectPool: 无法加载批量回调函数：{}", lua_tostring(G_L, -1));
+            lua_pop(G_L, 1);								// ??? p ot
+        }
+
         // 保存对象表
         lua_settable(G_L, LUA_REGISTRYINDEX);				// ???
     }
+    void GameObjectPool::_PrepareObjectView()
+    {
+        m_View.x = m_Kinematics.x;
+        m_View.y = m_Kinematics.y;
+        m_View.vx = m_Kinematics.vx;
+        m_View.vy = m_Kinematics.vy;
+        m_View.ax = m_Kinematics.ax;
+        m_View.ay = m_Kinematics.ay;
+        m_View.rot = m_Kinematics.rot;
+        m_View.omega = m_Kinematics.omega;
+        m_View.timer = m_Kinematics.timer;
+        m_View.object = reinterpret_cast<uint8_t*>(m_ObjectPool.data());
+        m_View.object_stride = (uint32_t)sizeof(GameObject);
+        m_View.hscale_offset = (uint32_t)offsetof(GameObject, hscale);
+        m_View.vscale_offset = (uint32_t)offsetof(GameObject, vscale);
+        m_View.status_offset = (uint32_t)offsetof(GameObject, status);
+        m_View.position_version = &m_PositionVersion;
+        m_View.write_barrier = 0;
+        m_View.deg_to_rad = L_DEG_TO_RAD;
+        m_View.rad_to_deg = L_RAD_TO_DEG;
+    }
+    void GameObjectPool::SetObjectViewMetatable(lua_State* L, int index) noexcept
+    {
+        if (index < 0)
+            index = lua_gettop(L) + index + 1;
+        GetObjectTable(L);									// ??? ot
+        lua_pushvalue(L, index);							// ??? ot mt
+        lua_rawseti(L, -2, LOBJPOOL_VIEW_METATABLE_IDX);	// ??? ot
+        lua_pop(L, 1);										// ???
+    }
 
     GameObject* GameObjectPool::_AllocObject()
     {
@@ -154,6 +277,9 @@ namespace LuaSTGPlus
         p->id = id;
         p->uid = m_iUid;
         m_iUid++;
+        p->kinematics = &m_Kinematics;
+        m_Kinematics.Alloc(id);
+        m_PositionVersion += 1;
     #ifdef USING_MULTI_GAME_WORLD
         if (m_pCurrentObject)
         {
@@ -178,6 +304,8 @@ namespace LuaSTGPlus
             m_pCurrentObject = nullptr;
         }
         object->status = GameObjectStatus::Free;
+        m_Kinematics.Free(object->id);
+        m_PositionVersion += 1;
         m_ObjectPool.free(object->id);
         return ret;
     }
@@ -201,6 +329,10 @@ namespace LuaSTGPlus
         p->ReleaseLuaRC(G_L, lua_gettop(G_L));	// ot object				// 释放可能的粒子系统
         lua_pushlightuserdata(G_L, nullptr);	// ot object nullptr
         lua_rawseti(G_L, -2, 3);				// ot object
+        if (m_EnableTableRecycle && m_RecycleCount < LOBJPOOL_RECYCLE_MAX)
+        {
+            _RecycleObjectTable(G_L, ot_stk);	// ot object
+        }
         lua_pop(G_L, 1);						// ot
         lua_pushnil(G_L);						// ot nil
         lua_rawseti(G_L, ot_stk, index);		// ot
@@ -217,6 +349,135 @@ namespace LuaSTGPlus
         return pRet;
     }
 
+    void GameObjectPool::_RecycleObjectTable(lua_State* L, int ot_idx) noexcept
+    {
+        int const object = lua_gettop(L);				// ??? object
+        lua_rawgeti(L, object, 1);						// ??? object class
+        if (!lua_istable(L, -1))
+        {
+            lua_pop(L, 1);								// ??? object
+            return;
+        }
+        lua_rawgeti(L, ot_idx, LOBJPOOL_RECYCLE_IDX);	// ??? object class recycle
+        lua_pushvalue(L, -2);							// ??? object class recycle class
+        lua_rawget(L, -2);								// ??? object class recycle list?
+        if (!lua_istable(L, -1))
+        {
+            // 关闭回收时创建的对象没有空闲列表
+            lua_pop(L, 3);								// ??? object
+            return;
+        }
+        // list[0] 为数组部分的容量，放满时取负数，请求下一次 New 扩大容量；写入已有的键和数组部分不会分配内存
+        lua_rawgeti(L, -1, 0);							// ??? object class recycle list capacity
+        int const capacity = (int)lua_tointeger(L, -1);
+        lua_pop(L, 1);									// ??? object class recycle list
+        int const n = (int)lua_objlen(L, -1);
+        if (capacity <= 0 || n >= capacity)
+        {
+            if (capacity > 0)
+            {
+                lua_pushinteger(L, -capacity);			// ??? object class recycle list -capacity
+                lua_rawseti(L, -2, 0);					// ??? object class recycle list
+            }
+            lua_pop(L, 3);								// ??? object
+            return;
+        }
+        // 逐个清除字段，数组部分和哈希部分的容量保持不变，元表保留给同一类的对象使用
+        lua_pushnil(L);									// ??? object class recycle list nil
+        while (lua_next(L, object))						// ??? object class recycle list k v
+        {
+            lua_pop(L, 1);								// ??? object class recycle list k
+            lua_pushvalue(L, -1);						// ??? object class recycle list k k
+            lua_pushnil(L);								// ??? object class recycle list k k nil
+            lua_rawset(L, object);						// ??? object class recycle list k
+        }
+        lua_pushvalue(L, object);						// ??? object class recycle list object
+        lua_rawseti(L, -2, n + 1);						// ??? object class recycle list
+        lua_pop(L, 3);									// ??? object
+        m_RecycleCount += 1;
+    }
+    void GameObjectPool::_ReserveRecycleList(lua_State* L, int ot_idx, int class_idx)
+    {
+        lua_rawgeti(L, ot_idx, LOBJPOOL_RECYCLE_IDX);	// ??? recycle
+        lua_pushvalue(L, class_idx);					// ??? recycle class
+        lua_rawget(L, -2);								// ??? recycle list?
+        int capacity = 0;
+        if (lua_istable(L, -1))
+        {
+            lua_rawgeti(L, -1, 0);						// ??? recycle list capacity
+            capacity = (int)lua_tointeger(L, -1);
+            lua_pop(L, 1);								// ??? recycle list
+            if (capacity > 0 || -capacity >= LOBJPOOL_RECYCLE_MAX)
+            {
+                lua_pop(L, 2);							// ???
+                return;
+            }
+        }
+        // 新建或者加倍容量，复制已有的空闲对象表
+        int const new_capacity = capacity == 0 ? LOBJPOOL_RECYCLE_CLASS_MIN : std::min(-capacity * 2, LOBJPOOL_RECYCLE_MAX);
+        lua_createtable(L, new_capacity, 1);			// ??? recycle list? new
+        lua_pushinteger(L, new_capacity);				// ??? recycle list? new capacity
+        lua_rawseti(L, -2, 0);							// ??? recycle list? new
+        if (lua_istable(L, -2))
+        {
+            int const n = (int)lua_objlen(L, -2);
+            for (int i = 1; i <= n; i += 1)
+            {
+                lua_rawgeti(L, -2, i);					// ??? recycle list new object
+                lua_rawseti(L, -2, i);					// ??? recycle list new
+            }
+        }
+        lua_pushvalue(L, class_idx);					// ??? recycle list? new class
+        lua_insert(L, -2);								// ??? recycle list? class new
+        lua_rawset(L, -4);								// ??? recycle list?
+        lua_pop(L, 2);									// ???
+    }
+    bool GameObjectPool::_PopRecycledObjectTable(lua_State* L, int ot_idx, int class_idx) noexcept
+    {
+        if (m_RecycleCount == 0)
+            return false;
+        lua_rawgeti(L, ot_idx, LOBJPOOL_RECYCLE_IDX);	// ??? recycle
+        lua_pushvalue(L, class_idx);					// ??? recycle class
+        lua_rawget(L, -2);								// ??? recycle list?
+        int const n = lua_istable(L, -1) ? (int)lua_objlen(L, -1) : 0;
+        if (n == 0)
+        {
+            lua_pop(L, 2);								// ???
+            return false;
+        }
+        lua_rawgeti(L, -1, n);							// ??? recycle list object
+        lua_pushnil(L);									// ??? recycle list object nil
+        lua_rawseti(L, -3, n);							// ??? recycle list object
+        lua_replace(L, -3);								// ??? object list
+        lua_pop(L, 1);									// ??? object
+        m_RecycleCount -= 1;
+        return true;
+    }
+    void GameObjectPool::_ClearRecycledObjectTable(lua_State* L) noexcept
+    {
+        // 空闲列表强引用类，清空后类和空闲对象表才能被回收；只把已有的键置空，不分配内存
+        GetObjectTable(L);								// ??? ot
+        lua_rawgeti(L, -1, LOBJPOOL_RECYCLE_IDX);		// ??? ot recycle
+        lua_pushnil(L);									// ??? ot recycle nil
+        while (lua_next(L, -2))							// ??? ot recycle class list
+        {
+            lua_pop(L, 1);								// ??? ot recycle class
+            lua_pushvalue(L, -1);						// ??? ot recycle class class
+            lua_pushnil(L);								// ??? ot recycle class class nil
+            lua_rawset(L, -4);							// ??? ot recycle class
+        }
+        lua_pop(L, 2);									// ???
+        m_RecycleCount = 0;
+    }
+    void GameObjectPool::SetTableRecycle(bool enable) noexcept
+    {
+        m_EnableTableRecycle = enable;
+        if (!enable)
+        {
+            _ClearRecycledObjectTable(G_L);
+        }
+    }
+
     GameObject* GameObjectPool::_ToGameObject(lua_State* L, int idx)
     {
         if (!lua_istable(L, idx))
@@ -244,14 +505,119 @@ namespace LuaSTGPlus
 
     void GameObjectPool::_GameObjectCallback(lua_State* L, int otidx, GameObject* p, int cbidx)
     {
+        Core::FrameProfiler& profiler = Core::FrameProfiler::get();
+        bool const sample = profiler.isSampleEnable();
+        uint64_t const begin = sample ? profiler.now() : 0;
         lua_rawgeti(L, otidx, (int)p->id + 1);	// ??? ot object
         lua_rawgeti(L, -1, 1);					// ??? ot object class
         lua_rawgeti(L, -1, cbidx);				// ??? ot object class frame
         lua_pushvalue(L, -3);					// ??? ot object class frame object
         lua_call(L, 1, 0);						// ??? ot object class
+        if (sample)
+            _ProfileCallback(L, cbidx, profiler.now() - begin);
+        lua_pop(L, 2);							// ??? ot
+    }
+    bool GameObjectPool::_CanBatchDispatch() const noexcept
+    {
+        return m_EnableBatchDispatch && m_DispatchReady && !m_Dispatching && !Core::FrameProfiler::get().isSampleEnable();
+    }
+    void GameObjectPool::_DispatchCallbacks(lua_State* L, int otidx, int cbidx)
+    {
+        if (m_DispatchList.empty())
+            return;
+        lua_rawgeti(L, otidx, LOBJPOOL_DISPATCH_FUNC_IDX);	// ??? ot f
+        lua_rawgeti(L, otidx, LOBJPOOL_DISPATCH_LIST_IDX);	// ??? ot f list
+        int n = 0;
+        for (GameObject* p : m_DispatchList)
+        {
+            n += 1;
+            lua_rawgeti(L, otidx, (int)p->id + 1);			// ??? ot f list object
+            lua_rawseti(L, -2, n);							// ??? ot f list
+        }
+        lua_pushinteger(L, n);								// ??? ot f list n
+        lua_pushinteger(L, cbidx);							// ??? ot f list n cbidx
+        m_Dispatching = true;
+        // 出错时先恢复状态再把错误继续抛出，错误信息中已经带有回调中的调用栈
+        int const result = lua_pcall(L, 3, 0, 0);			// ??? ot (err)
+        m_Dispatching = false;
+        m_DispatchList.clear();
+        m_pCurrentObject = nullptr;
+        if (result != 0)
+            lua_error(L);
+    }
+    void GameObjectPool::_SyncDispatchCursor(lua_State* L)
+    {
+        if (!m_Dispatching)
+            return;
+        GetObjectTable(L);									// ??? ot
+        lua_rawgeti(L, -1, LOBJPOOL_DISPATCH_LIST_IDX);		// ??? ot list
+        lua_rawgeti(L, -1, 0);								// ??? ot list i
+        lua_Integer const i = lua_tointeger(L, -1);
+        lua_pop(L, 3);										// ???
+        if (i >= 1 && (size_t)i <= m_DispatchList.size())
+            m_pCurrentObject = m_DispatchList[(size_t)i - 1];
+    }
+    void GameObjectPool::_GameObjectColliCallback(lua_State* L, int otidx, GameObject* pA, GameObject* pB)
+    {
+        Core::FrameProfiler& profiler = Core::FrameProfiler::get();
+        bool const sample = profiler.isSampleEnable();
+        uint64_t const begin = sample ? profiler.now() : 0;
+        // 根据id获取对象的lua绑定table、拿到class再拿到collifunc
+        lua_rawgeti(L, otidx, (int)pA->id + 1);	// ??? ot object
+        lua_rawgeti(L, -1, 1);					// ??? ot object class
+        lua_rawgeti(L, -1, LGOBJ_CC_COLLI);		// ??? ot object class colli
+        lua_pushvalue(L, -3);					// ??? ot object class colli object
+        lua_rawgeti(L, otidx, (int)pB->id + 1);	// ??? ot object class colli object other
+        lua_call(L, 2, 0);						// ??? ot object class
+        if (sample)
+            _ProfileCallback(L, LGOBJ_CC_COLLI, profiler.now() - begin);
         lua_pop(L, 2);							// ??? ot
     }
 
+    // 性能分析时按类记录的回调，类表保存在注册表中，读取数据时用于找回类表
+    static char const PROFILE_CLASS_TABLE_KEY = 0;
+
+    void GameObjectPool::_ProfileCallback(lua_State* L, int cbidx, uint64_t time)
+    {
+        static char const* const callback_name[] = { "", "init", "del", "frame", "render", "colli", "kill" };
+        // ??? class
+        void const* key = lua_topointer(L, -1);
+        if (m_ProfileClass.insert(key).second)
+        {
+            lua_pushlightuserdata(L, (void*)&PROFILE_CLASS_TABLE_KEY);	// ??? class k
+            lua_rawget(L, LUA_REGISTRYINDEX);							// ??? class t?
+            if (!lua_istable(L, -1))
+            {
+                lua_pop(L, 1);											// ??? class
+                lua_newtable(L);										// ??? class t
+                lua_pushlightuserdata(L, (void*)&PROFILE_CLASS_TABLE_KEY);	// ??? class t k
+                lua_pushvalue(L, -2);									// ??? class t k t
+                lua_rawset(L, LUA_REGISTRYINDEX);						// ??? class t
+            }
+            lua_pushlightuserdata(L, (void*)key);						// ??? class t p
+            lua_pushvalue(L, -3);										// ??? class t p class
+            lua_rawset(L, -3);											// ??? class t
+            lua_pop(L, 1);												// ??? class
+        }
+        Core::FrameProfiler::get().addSample(callback_name[cbidx], key, time);
+    }
+    void GameObjectPool::PushProfileClass(lua_State* L, void const* key)
+    {
+        lua_pushlightuserdata(L, (void*)&PROFILE_CLASS_TABLE_KEY);	// k
+        lua_rawget(L, LUA_REGISTRYINDEX);							// t?
+        if (lua_istable(L, -1))
+        {
+            lua_pushlightuserdata(L, (void*)key);					// t p
+            lua_rawget(L, -2);										// t class?
+            lua_remove(L, -2);										// class?
+        }
+        else
+        {
+            lua_pop(L, 1);
+            lua_pushnil(L);											// nil
+        }
+    }
+
     // --------------------------------------------------------------------------------
 
     void GameObjectPool::DebugNextFrame()
@@ -260,6 +626,7 @@ namespace LuaSTGPlus
         m_DbgData[m_DbgIdx].object_alloc = 0;
         m_DbgData[m_DbgIdx].object_free = 0;
         m_DbgData[m_DbgIdx].object_alive = m_ObjectPool.size();
+        m_DbgData[m_DbgIdx].object_colli_candidate = 0;
         m_DbgData[m_DbgIdx].object_colli_check = 0;
         m_DbgData[m_DbgIdx].object_colli_callback = 0;
     }
@@ -278,6 +645,7 @@ namespace LuaSTGPlus
     }
     int GameObjectPool::PushCurrentObject(lua_State* L)  noexcept
     {
+        _SyncDispatchCursor(L);
         if (!m_pCurrentObject)
         {
             lua_pushnil(L);
@@ -294,13 +662,27 @@ namespace LuaSTGPlus
 
     void GameObjectPool::ResetPool() noexcept
     {
-        // 回收已分配的对象和更新链表
+        // 回收已分配的对象和更新链表，空闲对象表随后整个丢弃，不用逐个回收
+        bool const recycle = m_EnableTableRecycle;
+        m_EnableTableRecycle = false;
         GetObjectTable(G_L);
         int const ot_at = lua_gettop(G_L);
         for (GameObject* p = m_UpdateLinkList.first.pUpdateNext; p != &m_UpdateLinkList.second;)
         {
             p = _FreeObject(p, ot_at);
         }
+        m_EnableTableRecycle = recycle;
+        // 在回调中重置对象池时，正在进行的批量回调跳过剩余的对象
+        if (m_Dispatching)
+        {
+            lua_rawgeti(G_L, ot_at, LOBJPOOL_DISPATCH_LIST_IDX);
+            for (size_t i = 1; i <= m_DispatchList.size(); i += 1)
+            {
+                lua_pushnil(G_L);
+                lua_rawseti(G_L, -2, (int)i);
+            }
+            lua_pop(G_L, 1);
+        }
     #if (defined(_DEBUG) && defined(LuaSTG_enable_GameObjectManager_Debug))
         for (int i = 1; i <= LOBJPOOL_SIZE; i += 1)
         {
@@ -311,11 +693,20 @@ namespace LuaSTGPlus
         }
     #endif
         lua_pop(G_L, 1);
+        // 丢弃空闲对象表，释放上一个场景的类
+        _ClearRecycledObjectTable(G_L);
+        // 结束可能未完成的碰撞检测粗筛
+        m_BroadPhaseGroup = BroadPhaseInactive;
+        m_View.write_barrier = 0;
+        m_BroadPhase.Clear();
+        m_DispatchList.clear();
+        m_DispatchUpdate.clear();
         // 重置其他链表
         _ClearLinkList();
         m_RenderList.clear();
         // 重置整个对象池，恢复为线性状态
         m_ObjectPool.clear();
+        m_Kinematics.Clear();
         // 重置其他数据
         m_iWorld = 15;
         m_Worlds = { 15, 0, 0, 0 };
@@ -326,6 +717,7 @@ namespace LuaSTGPlus
     void GameObjectPool::DoFrame()
     {
         ZoneScopedN("LOBJMGR.ObjFrame");
+        FrameProfileScopeN("LOBJMGR.ObjFrame");
 
         //处理超级暂停
         GetObjectTable(G_L);  // ot
@@ -333,29 +725,127 @@ namespace LuaSTGPlus
 
         m_pCurrentObject = nullptr;
         int superpause = UpdateSuperPause();
+        m_KinematicsBatch.clear();
+        // uid 小于该值、使用默认 frame 回调的对象已经在第一遍更新
+        uint64_t native_uid_limit = 0;
+    #ifdef USING_ADVANCE_GAMEOBJECT_CLASS
+        if (m_EnableTwoPassFrame)
+        {
+            ZoneScopedN("LOBJMGR.ObjFrame.Native");
+            FrameProfileScopeN("LOBJMGR.ObjFrame.Native");
+            // 第一遍：不涉及 lua，全部推迟到最后批量计算
+            native_uid_limit = m_iUid;
+            for (GameObject* p = m_UpdateLinkList.first.pUpdateNext; p != &m_UpdateLinkList.second; p = p->pUpdateNext)
+            {
+                if ((superpause <= 0 || p->ignore_superpause) && p->luaclass.IsDefaultUpdate)
+                {
+                    _UpdateObject(p);
+                }
+            }
+            _FlushKinematicsBatch();
+        }
+    #endif // USING_ADVANCE_GAMEOBJECT_CLASS
+        if (_CanBatchDispatch())
+        {
+            _DoFrameBatch(ot_idx, superpause, native_uid_limit);
+            m_pCurrentObject = nullptr;
+            lua_pop(G_L, 1);
+            return;
+        }
         for (GameObject* p = m_UpdateLinkList.first.pUpdateNext; p != &m_UpdateLinkList.second; p = p->pUpdateNext)
         {
             // 根据id获取对象的lua绑定table、拿到class再拿到framefunc
             if (superpause <= 0 || p->ignore_superpause)
             {
+            #ifdef USING_ADVANCE_GAMEOBJECT_CLASS
+                // 第二遍：跳过已经更新的对象，回调中新创建的对象仍然按顺序更新
+                if (p->luaclass.IsDefaultUpdate && p->uid < native_uid_limit)
+                {
+                    continue;
+                }
+            #endif // USING_ADVANCE_GAMEOBJECT_CLASS
                 m_pCurrentObject = p;
             #ifdef USING_ADVANCE_GAMEOBJECT_CLASS
                 if (!p->luaclass.IsDefaultUpdate)
                 {
             #endif // USING_ADVANCE_GAMEOBJECT_CLASS
+                    // 回调可能读取前面的对象，先完成推迟的更新
+                    _FlushKinematicsBatch();
                     _GameObjectCallback(G_L, ot_idx, p, LGOBJ_CC_FRAME);
             #ifdef USING_ADVANCE_GAMEOBJECT_CLASS
                 }
             #endif // USING_ADVANCE_GAMEOBJECT_CLASS
-                p->Update();
+                _UpdateObject(p);
             }
         }
+        _FlushKinematicsBatch();
         m_pCurrentObject = nullptr;
 
         lua_pop(G_L, 1);
     }
+    void GameObjectPool::_DoFrameBatch(int ot_idx, int superpause, uint64_t native_uid_limit)
+    {
+        GameObject* first = m_UpdateLinkList.first.pUpdateNext;
+        while (first != &m_UpdateLinkList.second)
+        {
+            GameObject* last = first;
+            for (GameObject* p = first; p != &m_UpdateLinkList.second; p = p->pUpdateNext)
+            {
+                last = p;
+                if (superpause > 0 && !p->ignore_superpause)
+                {
+                    continue;
+                }
+            #ifdef USING_ADVANCE_GAMEOBJECT_CLASS
+                if (p->luaclass.IsDefaultUpdate && p->uid < native_uid_limit)
+                {
+                    continue;
+                }
+                if (!p->luaclass.IsDefaultUpdate)
+            #endif // USING_ADVANCE_GAMEOBJECT_CLASS
+                    m_DispatchList.push_back(p);
+                m_DispatchUpdate.push_back(p);
+            }
+            _DispatchCallbacks(G_L, ot_idx, LGOBJ_CC_FRAME);
+            for (GameObject* p : m_DispatchUpdate)
+            {
+                _UpdateObject(p);
+            }
+            m_DispatchUpdate.clear();
+            _FlushKinematicsBatch();
+            // 对象池在回调中被重置
+            if (last->status == GameObjectStatus::Free)
+            {
+                break;
+            }
+            first = last->pUpdateNext;
+        }
+    }
+    void GameObjectPool::_UpdateObject(GameObject* p)
+    {
+        // 只包含运动学部分的更新推迟到下一个回调之前批量计算，各个对象的更新互不影响
+        if (m_EnableBatchKinematics && p->CanBatchUpdate())
+        {
+            m_KinematicsBatch.push_back(static_cast<uint32_t>(p->id));
+        }
+        else
+        {
+            p->Update();
+        }
+    }
+    void GameObjectPool::_FlushKinematicsBatch() noexcept
+    {
+        if (!m_KinematicsBatch.empty())
+        {
+            m_Kinematics.Integrate(m_KinematicsBatch.data(), m_KinematicsBatch.size());
+            m_KinematicsBatch.clear();
+        }
+    }
     void GameObjectPool::DoRender()
     {
+        ZoneScopedN("LOBJMGR.ObjRender");
+        FrameProfileScopeN("LOBJMGR.ObjRender");
+
         GetObjectTable(G_L); // ot
         int const ot_idx = lua_gettop(G_L);
 
@@ -364,7 +854,18 @@ namespace LuaSTGPlus
     #ifdef USING_MULTI_GAME_WORLD
         lua_Integer world = GetWorldFlag();
     #endif // USING_MULTI_GAME_WORLD
-        for (auto& p : m_RenderList)
+        bool const instancing = LAPP.GetSpriteInstancing();
+        // 连续的脚本渲染对象合并为一次批量回调，遇到默认渲染的对象时先执行，绘制顺序不变
+        bool const batch = _CanBatchDispatch();
+        auto const flush_dispatch = [&]()
+        {
+            if (!m_DispatchList.empty())
+            {
+                _FlushSpriteInstances();
+                _DispatchCallbacks(G_L, ot_idx, LGOBJ_CC_RENDER);
+            }
+        };
+        auto const render_object = [&](GameObject* p)
         {
     #ifdef USING_MULTI_GAME_WORLD
             if (!p->hide && CheckWorld(p->world, world))  // 只渲染可见对象
@@ -377,39 +878,264 @@ namespace LuaSTGPlus
                 if (!p->luaclass.IsDefaultRender)
                 {
     #endif // USING_ADVANCE_GAMEOBJECT_CLASS
+                    if (batch)
+                    {
+                        m_DispatchList.push_back(p);
+                        return;
+                    }
+                    _FlushSpriteInstances();
                     _GameObjectCallback(G_L, ot_idx, p, LGOBJ_CC_RENDER);
     #ifdef USING_ADVANCE_GAMEOBJECT_CLASS
                 }
                 else
                 {
-                    p->Render();
+                    flush_dispatch();
+                    if (!instancing || !_PushSpriteInstance(p))
+                    {
+                        _FlushSpriteInstances();
+                        p->Render();
+                    }
                 }
     #endif // USING_ADVANCE_GAMEOBJECT_CLASS
             }
+        };
+        if (m_SortRenderList)
+        {
+            // 渲染过程中新建的对象不会在本帧渲染
+            size_t count = 0;
+            cpp::radix_sort_item<GameObject*>* const list = _SortRenderList(count);
+            for (size_t i = 0; i < count; i += 1)
+            {
+                render_object(list[i].value);
+            }
+        }
+        else
+        {
+            for (GameObject* p : m_RenderList)
+            {
+                render_object(p);
+            }
         }
+        flush_dispatch();
+        _FlushSpriteInstances();
         m_pCurrentObject = nullptr;
         m_IsRendering = false;
 
         lua_pop(G_L, 1);
     }
+    bool GameObjectPool::_PushSpriteInstance(GameObject* p)
+    {
+    #ifdef USING_ADVANCE_GAMEOBJECT_CLASS
+        using Core::Graphics::IRenderer;
+        if (!p->res)
+        {
+            return false;
+        }
+        IResourceSprite* res_sprite = nullptr;
+        BlendMode blend{};
+        Core::Color4B color[4]{};
+        switch (p->res->GetType())
+        {
+        case ResourceType::Sprite:
+            res_sprite = static_cast<IResourceSprite*>(p->res);
+            blend = res_sprite->GetBlendMode();
+            res_sprite->GetSprite()->getColor(color);
+            break;
+        case ResourceType::Animation:
+            {
+                IResourceAnimation* res_ani = static_cast<IResourceAnimation*>(p->res);
+                res_sprite = res_ani->GetSpriteByTimer(static_cast<int>(p->ani_timer()));
+                blend = res_ani->GetBlendMode();
+                res_ani->GetVertexColor(color);
+            }
+            break;
+        default:
+            return false; // 粒子特效在 GameObject::Render 里绘制
+        }
+        if (p->luaclass.IsRenderClass)
+        {
+            blend = p->blendmode;
+            color[0] = Core::Color4B(p->vertexcolor);
+        }
+        else if (color[0] != color[1] || color[0] != color[2] || color[0] != color[3])
+        {
+            return false; // 每个实例只有一个顶点颜色
+        }
+
+        Core::Graphics::ISprite* const sprite = res_sprite->GetSprite();
+        Core::Graphics::ITexture2D* const texture = sprite->getTexture();
+        SpriteInstanceBatch& batch = m_SpriteBatch;
+        if (!batch.objects.empty() && (batch.texture != texture || batch.blend != blend))
+        {
+            _FlushSpriteInstances();
+        }
+        uint32_t rect = 0;
+        if (auto const it = batch.rect_index.find(sprite); it != batch.rect_index.end())
+        {
+            rect = it->second;
+        }
+        else
+        {
+            if (batch.rects.size() >= IRenderer::SpriteInstanceMaxRectCount)
+            {
+                _FlushSpriteInstances();
+            }
+            rect = static_cast<uint32_t>(batch.rects.size());
+            batch.rects.emplace_back(sprite->getInstanceRect());
+            batch.rect_index.emplace(sprite, rect);
+        }
+
+        float const gscale = LRES.GetGlobalImageScaleFactor();
+        IRenderer::SpriteInstance& instance = batch.instances.emplace_back();
+        instance.x = static_cast<float>(p->x());
+        instance.y = static_cast<float>(p->y());
+        instance.z = sprite->getZ();
+        instance.rotation = static_cast<float>(p->rot());
+        instance.hscale = static_cast<float>(p->hscale) * gscale;
+        instance.vscale = static_cast<float>(p->vscale) * gscale;
+        instance.rect = rect;
+        instance.color = color[0].color();
+        batch.texture = texture;
+        batch.blend = blend;
+        batch.objects.push_back(p);
+        return true;
+    #else // USING_ADVANCE_GAMEOBJECT_CLASS
+        std::ignore = p;
+        return false;
+    #endif // USING_ADVANCE_GAMEOBJECT_CLASS
+    }
+    void GameObjectPool::_FlushSpriteInstances()
+    {
+        SpriteInstanceBatch& batch = m_SpriteBatch;
+        if (batch.objects.empty())
+        {
+            return;
+        }
+        if (batch.objects.size() < LOBJPOOL_SPRITE_INSTANCE_MIN)
+        {
+            // 实例化绘制会打断渲染器当前的批次，对象太少时不划算
+            for (GameObject* p : batch.objects)
+            {
+                p->Render();
+            }
+        }
+        else
+        {
+            LAPP.updateGraph2DBlendMode(batch.blend);
+            LAPP.GetRenderer2D()->drawSpriteInstances(batch.texture, batch.rects.data(), batch.rects.size(), batch.instances.data(), batch.instances.size());
+        }
+        batch.texture = nullptr;
+        batch.objects.clear();
+        batch.rect_index.clear();
+        batch.rects.clear();
+        batch.instances.clear();
+    }
+    bool GameObjectPool::SetRenderListSort(bool enable)
+    {
+        if (m_IsRendering)
+            return false;
+        if (m_SortRenderList == enable)
+            return true;
+        m_SortRenderList = enable;
+        m_RenderList.clear();
+        if (!m_SortRenderList)
+        {
+            for (GameObject* p = m_UpdateLinkList.first.pUpdateNext; p != &m_UpdateLinkList.second; p = p->pUpdateNext)
+            {
+                m_RenderList.insert(p);
+            }
+        }
+        return true;
+    }
     void GameObjectPool::BoundCheck()
     {
         ZoneScopedN("LOBJMGR.BoundCheck");
+        FrameProfileScopeN("LOBJMGR.BoundCheck");
 
         GetObjectTable(G_L); // ot
         int const ot_idx = lua_gettop(G_L);
         
         m_pCurrentObject = nullptr;
+        if (!m_EnableBatchKinematics)
+        {
+            _BoundCheckFrom(m_UpdateLinkList.first.pUpdateNext, ot_idx);
+        }
+        else
+        {
+            // 批量找出坐标在边界外的对象，再按更新链表的顺序（uid 升序）处理
+            std::vector<uint32_t> const& index = m_Kinematics.GetActiveIndex();
+            m_BoundCheckOutput.resize(index.size());
+            size_t const count = m_Kinematics.BoundCheck(index.data(), index.size(),
+                m_BoundLeft, m_BoundRight, m_BoundBottom, m_BoundTop, m_BoundCheckOutput.data());
+            std::sort(m_BoundCheckOutput.begin(), m_BoundCheckOutput.begin() + static_cast<ptrdiff_t>(count), [this](uint32_t a, uint32_t b)
+            {
+                return m_ObjectPool.object(a)->uid < m_ObjectPool.object(b)->uid;
+            });
+        #ifdef USING_MULTI_GAME_WORLD
+            lua_Integer world = GetWorldFlag();
+        #endif // USING_MULTI_GAME_WORLD
+            uint64_t const version = m_PositionVersion;
+            bool const batch = _CanBatchDispatch();
+            for (size_t i = 0; i < count; i += 1)
+            {
+                GameObject* p = m_ObjectPool.object(m_BoundCheckOutput[i]);
+            #ifdef USING_MULTI_GAME_WORLD
+                if (p->bound && CheckWorld(p->world, world))
+            #else // USING_MULTI_GAME_WORLD
+                if (p->bound)
+            #endif // USING_MULTI_GAME_WORLD
+                {
+                    m_pCurrentObject = p;
+                    // 越界设置为 del 状态
+                    p->status = GameObjectStatus::Dead;
+                    // 调用 del callback
+                #ifdef USING_ADVANCE_GAMEOBJECT_CLASS
+                    if (!p->luaclass.IsDefaultDestroy)
+                    {
+                #endif // USING_ADVANCE_GAMEOBJECT_CLASS
+                        if (batch)
+                        {
+                            m_DispatchList.push_back(p);
+                            continue;
+                        }
+                        _GameObjectCallback(G_L, ot_idx, p, LGOBJ_CC_DEL);
+                #ifdef USING_ADVANCE_GAMEOBJECT_CLASS
+                    }
+                #endif // USING_ADVANCE_GAMEOBJECT_CLASS
+                    if (m_PositionVersion != version)
+                    {
+                        // 回调修改了坐标、场景边界或者创建了对象，批量检查的结果已经失效，剩余部分逐个检查
+                        _BoundCheckFrom(p->pUpdateNext, ot_idx);
+                        break;
+                    }
+                }
+            }
+            if (batch && !m_DispatchList.empty())
+            {
+                // 全部出界对象已经设置为 del 状态，回调改变了坐标、场景边界或者创建了对象时，重新检查仍然正常的对象
+                _DispatchCallbacks(G_L, ot_idx, LGOBJ_CC_DEL);
+                if (m_PositionVersion != version)
+                {
+                    _BoundCheckFrom(m_UpdateLinkList.first.pUpdateNext, ot_idx, true);
+                }
+            }
+        }
+        m_pCurrentObject = nullptr;
+
+        lua_pop(G_L, 1);
+    }
+    void GameObjectPool::_BoundCheckFrom(GameObject* first, int ot_idx, bool active_only)
+    {
     #ifdef USING_MULTI_GAME_WORLD
         lua_Integer world = GetWorldFlag();
     #endif // USING_MULTI_GAME_WORLD
-        for (GameObject* p = m_UpdateLinkList.first.pUpdateNext; p != &m_UpdateLinkList.second; p = p->pUpdateNext)
+        for (GameObject* p = first; p != &m_UpdateLinkList.second; p = p->pUpdateNext)
         {
         #ifdef USING_MULTI_GAME_WORLD
             if (CheckWorld(p->world, world))
             {
         #endif // USING_MULTI_GAME_WORLD
-                if (!_ObjectBoundCheck(p))
+                if ((!active_only || p->status == GameObjectStatus::Active) && !_ObjectBoundCheck(p))
                 {
                     m_pCurrentObject = p;
                     // 越界设置为 del 状态
@@ -428,31 +1154,60 @@ namespace LuaSTGPlus
             }
         #endif // USING_MULTI_GAME_WORLD
         }
-        m_pCurrentObject = nullptr;
-
-        lua_pop(G_L, 1);
     }
     void GameObjectPool::CollisionCheck(size_t groupA, size_t groupB)
     {
         ZoneScopedN("LOBJMGR.CollisionCheck");
 
-        if (groupA < 0 || groupA >= LOBJPOOL_SIZE || groupB < 0 || groupB >= LOBJPOOL_SIZE)
+        if (groupA < 0 || groupA >= LOBJPOOL_GROUPN || groupB < 0 || groupB >= LOBJPOOL_GROUPN)
             luaL_error(G_L, "Invalid collision group.");
 
+        // 每个碰撞组对单独计时
+        char const*& profile_name = m_ColliProfileName[groupA * LOBJPOOL_GROUPN + groupB];
+        if (profile_name == nullptr)
+            profile_name = Core::FrameProfiler::get().intern(fmt::format("LOBJMGR.CollisionCheck({}, {})", groupA, groupB));
+        FrameProfileScopeN(profile_name);
+
+        if (m_EnableParallelCollision && _CountColliPairs(groupA, groupB) >= LOBJPOOL_PARALLEL_COLLI_MIN_PAIRS)
+        {
+            _CollisionCheckParallel(groupA, groupB);
+            return;
+        }
+
+        if (m_EnableBroadPhase && _ShouldUseBroadPhase(groupA, groupB))
+        {
+            _CollisionCheckBroadPhase(groupA, groupB);
+            return;
+        }
+
         GetObjectTable(G_L); // ot
 
         m_pCurrentObject = nullptr;
-        for (GameObject* ptrA = m_ColliLinkList[groupA].first.pColliNext; ptrA != &m_ColliLinkList[groupA].second;)
+        _CollisionCheckFrom(groupA, groupB, nullptr, m_ColliLinkList[groupA].first.pColliNext, nullptr);
+        m_pCurrentObject = nullptr;
+
+        lua_pop(G_L, 1);
+    }
+    void GameObjectPool::_CollisionCheckFrom(size_t groupA, size_t groupB, GameObject* pA, GameObject* ptrA, GameObject* ptrB)
+    {
+        while (true)
         {
-            GameObject* pA = ptrA;
-            ptrA = ptrA->pColliNext;
+            if (pA == nullptr)
+            {
+                if (ptrA == &m_ColliLinkList[groupA].second)
+                    break;
+                pA = ptrA;
+                ptrA = ptrA->pColliNext;
+                ptrB = m_ColliLinkList[groupB].first.pColliNext;
+            }
 
             m_LockObjectA = ptrA;
 
-            for (GameObject* ptrB = m_ColliLinkList[groupB].first.pColliNext; ptrB != &m_ColliLinkList[groupB].second;)
+            while (ptrB != &m_ColliLinkList[groupB].second)
             {
                 GameObject* pB = ptrB;
                 ptrB = ptrB->pColliNext;
+                m_DbgData[m_DbgIdx].object_colli_candidate += 1;
             #ifdef USING_MULTI_GAME_WORLD
                 if (CheckWorlds(pA->world, pB->world))
                 {
@@ -470,14 +1225,7 @@ namespace LuaSTGPlus
                         if (!pA->luaclass.IsDefaultTrigger)
                         {
                     #endif // USING_ADVANCE_GAMEOBJECT_CLASS
-                            // 根据id获取对象的lua绑定table、拿到class再拿到collifunc
-                            lua_rawgeti(G_L, -1, pA->id + 1);		// ot t(object)
-                            lua_rawgeti(G_L, -1, 1);				// ot t(object) t(class)
-                            lua_rawgeti(G_L, -1, LGOBJ_CC_COLLI);	// ot t(object) t(class) f(colli)
-                            lua_pushvalue(G_L, -3);					// ot t(object) t(class) f(colli) t(object)
-                            lua_rawgeti(G_L, -5, pB->id + 1);		// ot t(object) t(class) f(colli) t(object) t(object)
-                            lua_call(G_L, 2, 0);					// ot t(object) t(class)
-                            lua_pop(G_L, 2);						// ot
+                            _GameObjectColliCallback(G_L, lua_gettop(G_L), pA, pB);
                     #ifdef USING_ADVANCE_GAMEOBJECT_CLASS
                         }
                     #endif // USING_ADVANCE_GAMEOBJECT_CLASS
@@ -490,16 +1238,228 @@ namespace LuaSTGPlus
             }
 
             m_LockObjectA = nullptr;
+            pA = nullptr;
+        }
+    }
+    void GameObjectPool::_CollisionCheckParallel(size_t groupA, size_t groupB)
+    {
+        if (!m_JobPool)
+        {
+            size_t const hardware = std::thread::hardware_concurrency();
+            m_JobPool = std::make_unique<cpp::job_pool>(std::clamp<size_t>(hardware, 1, 8) - 1);
+            m_ColliPairs.resize(m_JobPool->concurrency());
+            m_ColliCheckCount.resize(m_JobPool->concurrency());
+        }
+
+        // 工作线程只读取快照，不访问对象和 lua
+        for (size_t i = 0; i < 2; i += 1)
+        {
+            size_t const group = (i == 0) ? groupA : groupB;
+            auto& snapshot = m_ColliSnapshot[i];
+            snapshot.clear();
+            for (GameObject* p = m_ColliLinkList[group].first.pColliNext; p != &m_ColliLinkList[group].second; p = p->pColliNext)
+            {
+                snapshot.push_back(ColliSnapshot{
+                    p,
+                    GameObjectColliderShape{ p->x(), p->y(), p->a, p->b, p->rot(), p->col_r, (bool)p->rect },
+                    p->world,
+                    (bool)p->colli,
+                });
+            }
+        }
+        auto const& snapshotA = m_ColliSnapshot[0];
+        auto const& snapshotB = m_ColliSnapshot[1];
+        size_t const countA = snapshotA.size();
+        size_t const countB = snapshotB.size();
+
+        // 窄检测阶段，任务按 (碰撞组 A 对象, 碰撞组 B 的一段) 划分，碰撞组 A 只有少量对象时也能分到多个线程
+        constexpr size_t block_size = 256;
+        size_t const blocks = (countB + block_size - 1) / block_size;
+        for (auto& pairs : m_ColliPairs)
+            pairs.clear();
+        for (auto& n : m_ColliCheckCount)
+            n = 0;
+        auto narrow_phase = [&](size_t begin, size_t end, size_t worker)
+        {
+            auto& pairs = m_ColliPairs[worker];
+            uint64_t check = 0;
+            for (size_t task = begin; task < end; task += 1)
+            {
+                size_t const ia = task / blocks;
+                size_t const first = (task % blocks) * block_size;
+                size_t const last = std::min(first + block_size, countB);
+                ColliSnapshot const& a = snapshotA[ia];
+                for (size_t ib = first; ib < last; ib += 1)
+                {
+                    ColliSnapshot const& b = snapshotB[ib];
+                #ifdef USING_MULTI_GAME_WORLD
+                    if (!CheckWorlds((int)a.world, (int)b.world))
+                        continue;
+                #endif // USING_MULTI_GAME_WORLD
+                    check += 1;
+                    if (a.colli && b.colli && LuaSTGPlus::CollisionCheck(a.shape, b.shape))
+                    {
+                        pairs.push_back({ (static_cast<uint64_t>(ia) << 32) | ib, static_cast<uint32_t>(ib) });
+                    }
+                }
+            }
+            m_ColliCheckCount[worker] += check;
+        };
+        {
+            ZoneScopedN("LOBJMGR.CollisionCheck.Narrow");
+            FrameProfileScopeN("LOBJMGR.CollisionCheck.Narrow");
+            m_JobPool->parallel_for(countA * blocks, 16, narrow_phase);
+        }
+
+        // 合并后排序成逐对检测的顺序
+        auto& buffer = m_ColliPairBuffer[0];
+        buffer.clear();
+        for (auto const& pairs : m_ColliPairs)
+            buffer.insert(buffer.end(), pairs.begin(), pairs.end());
+        m_ColliPairBuffer[1].resize(buffer.size());
+        cpp::radix_sort_item<uint32_t> const* sorted = cpp::radix_sort(buffer.data(), m_ColliPairBuffer[1].data(), buffer.size());
+
+        m_DbgData[m_DbgIdx].object_colli_candidate += static_cast<uint64_t>(countA) * countB;
+        for (auto const n : m_ColliCheckCount)
+            m_DbgData[m_DbgIdx].object_colli_check += n;
+
+        GetObjectTable(G_L); // ot
+
+        // 按顺序执行回调，回调修改了碰撞相关的状态后，剩余部分逐对检测
+        uint64_t const version = m_PositionVersion;
+        m_pCurrentObject = nullptr;
+        for (size_t i = 0; i < buffer.size(); i += 1)
+        {
+            size_t const ia = static_cast<size_t>(sorted[i].key >> 32);
+            size_t const ib = sorted[i].value;
+            GameObject* pA = snapshotA[ia].object;
+            GameObject* pB = snapshotB[ib].object;
+            GameObject* ptrA = (ia + 1 < countA) ? snapshotA[ia + 1].object : &m_ColliLinkList[groupA].second;
+            GameObject* ptrB = (ib + 1 < countB) ? snapshotB[ib + 1].object : &m_ColliLinkList[groupB].second;
+
+            m_DbgData[m_DbgIdx].object_colli_callback += 1;
+            m_pCurrentObject = pA;
+
+            m_LockObjectA = ptrA;
+            m_LockObjectB = ptrB;
+
+        #ifdef USING_ADVANCE_GAMEOBJECT_CLASS
+            if (!pA->luaclass.IsDefaultTrigger)
+            {
+        #endif // USING_ADVANCE_GAMEOBJECT_CLASS
+                _GameObjectColliCallback(G_L, lua_gettop(G_L), pA, pB);
+        #ifdef USING_ADVANCE_GAMEOBJECT_CLASS
+            }
+        #endif // USING_ADVANCE_GAMEOBJECT_CLASS
+
+            m_LockObjectB = nullptr;
+            m_LockObjectA = nullptr;
+
+            if (m_PositionVersion != version)
+            {
+                _CollisionCheckFrom(groupA, groupB, pA, ptrA, ptrB);
+                break;
+            }
         }
         m_pCurrentObject = nullptr;
 
         lua_pop(G_L, 1);
     }
+    uint64_t GameObjectPool::_CountColliPairs(size_t groupA, size_t groupB) const noexcept
+    {
+        uint64_t countA = 0;
+        for (GameObject* p = m_ColliLinkList[groupA].first.pColliNext; p != &m_ColliLinkList[groupA].second; p = p->pColliNext)
+            countA += 1;
+        uint64_t countB = 0;
+        for (GameObject* p = m_ColliLinkList[groupB].first.pColliNext; p != &m_ColliLinkList[groupB].second; p = p->pColliNext)
+            countB += 1;
+        return countA * countB;
+    }
+    bool GameObjectPool::_ShouldUseBroadPhase(size_t groupA, size_t groupB) const noexcept
+    {
+        return _CountColliPairs(groupA, groupB) >= LOBJPOOL_BROADPHASE_MIN_PAIRS;
+    }
+    void GameObjectPool::_CollisionCheckBroadPhase(size_t groupA, size_t groupB)
+    {
+        GetObjectTable(G_L); // ot
+
+        // 以碰撞组 B 建立网格，碰撞组 A 仍然按链表顺序遍历
+        m_BroadPhase.Build(m_ColliLinkList[groupB].first.pColliNext, &m_ColliLinkList[groupB].second);
+        m_BroadPhaseGroup = groupB;
+        m_View.write_barrier = 1;
+
+        m_pCurrentObject = nullptr;
+        for (GameObject* ptrA = m_ColliLinkList[groupA].first.pColliNext; ptrA != &m_ColliLinkList[groupA].second;)
+        {
+            GameObject* pA = ptrA;
+            ptrA = ptrA->pColliNext;
+
+            m_LockObjectA = ptrA;
+
+            // 候选对象按碰撞组 B 的链表顺序排列，回调顺序与逐对检测一致
+            m_BroadPhase.Query(pA, m_ColliCandidate);
+            for (size_t i = 0; i < m_ColliCandidate.size(); i += 1)
+            {
+                GameObject* pB = m_BroadPhase.GetObject(m_ColliCandidate[i]);
+                if (pB == nullptr)
+                    continue; // 已离开碰撞组 B
+                m_DbgData[m_DbgIdx].object_colli_candidate += 1;
+            #ifdef USING_MULTI_GAME_WORLD
+                if (CheckWorlds(pA->world, pB->world))
+                {
+            #endif // USING_MULTI_GAME_WORLD
+                    m_DbgData[m_DbgIdx].object_colli_check += 1;
+                    if (LuaSTGPlus::CollisionCheck(pA, pB))
+                    {
+                        m_DbgData[m_DbgIdx].object_colli_callback += 1;
+                        m_pCurrentObject = pA;
+
+                        // 与逐对检测相同，锁定碰撞组 B 链表中的下一个对象
+                        m_LockObjectB = pB->pColliNext;
+
+                    #ifdef USING_ADVANCE_GAMEOBJECT_CLASS
+                        if (!pA->luaclass.IsDefaultTrigger)
+                        {
+                    #endif // USING_ADVANCE_GAMEOBJECT_CLASS
+                            _GameObjectColliCallback(G_L, lua_gettop(G_L), pA, pB);
+                    #ifdef USING_ADVANCE_GAMEOBJECT_CLASS
+                        }
+                    #endif // USING_ADVANCE_GAMEOBJECT_CLASS
+
+                        m_LockObjectB = nullptr;
+                    }
+            #ifdef USING_MULTI_GAME_WORLD
+                }
+            #endif // USING_MULTI_GAME_WORLD
+                // 回调中移动了对象或者有对象加入了碰撞组 B，补充剩余的候选对象
+                if (m_BroadPhase.IsDirty())
+                {
+                    m_BroadPhase.Requery(m_ColliCandidate, i);
+                }
+            }
+
+            m_LockObjectA = nullptr;
+        }
+        m_pCurrentObject = nullptr;
+
+        m_BroadPhaseGroup = BroadPhaseInactive;
+        m_View.write_barrier = 0;
+        m_BroadPhase.Clear();
+
+        lua_pop(G_L, 1);
+    }
     void GameObjectPool::UpdateXY() noexcept
     {
         ZoneScopedN("LOBJMGR.UpdateXY");
+        FrameProfileScopeN("LOBJMGR.UpdateXY");
 
         int superpause = GetSuperPauseTime();
+        if (m_EnableBatchKinematics && superpause <= 0)
+        {
+            std::vector<uint32_t> const& index = m_Kinematics.GetActiveIndex();
+            m_Kinematics.UpdateLast(index.data(), index.size());
+            return;
+        }
         for (GameObject* p = m_UpdateLinkList.first.pUpdateNext; p != &m_UpdateLinkList.second; p = p->pUpdateNext)
         {
             if (superpause <= 0 || p->ignore_superpause)
@@ -511,11 +1471,30 @@ namespace LuaSTGPlus
     void GameObjectPool::AfterFrame() noexcept
     {
         ZoneScopedN("LOBJMGR.AfterFrame");
+        FrameProfileScopeN("LOBJMGR.AfterFrame");
 
         GetObjectTable(G_L);
         int const ot_at = lua_gettop(G_L);
 
         int superpause = GetSuperPauseTime();
+        if (m_EnableBatchKinematics && superpause <= 0)
+        {
+            std::vector<uint32_t> const& index = m_Kinematics.GetActiveIndex();
+            m_Kinematics.UpdateTimer(index.data(), index.size());
+            for (GameObject* p = m_UpdateLinkList.first.pUpdateNext; p != &m_UpdateLinkList.second;)
+            {
+                if (p->status != GameObjectStatus::Active)
+                {
+                    p = _FreeObject(p, ot_at); // 再下一个
+                }
+                else
+                {
+                    p = p->pUpdateNext;
+                }
+            }
+            lua_pop(G_L, 1);
+            return;
+        }
         for (GameObject* p = m_UpdateLinkList.first.pUpdateNext; p != &m_UpdateLinkList.second;)
         {
             if (superpause <= 0 || p->ignore_superpause)
@@ -548,6 +1527,7 @@ namespace LuaSTGPlus
         }
 
         // 分配一个对象
+        _SyncDispatchCursor(L);
         GameObject* p = _AllocObject();
         if (p == nullptr)
         {
@@ -560,9 +1540,12 @@ namespace LuaSTGPlus
 
         //											// class ...
 
-        // 创建对象 table
+        // 创建对象 table，启用对象表回收时优先复用同一类的空闲对象表
         GetObjectTable(L);							// class ... ot
-        lua_createtable(L, 3, 0);					// class ... ot object
+        if (m_EnableTableRecycle)
+            _ReserveRecycleList(L, lua_gettop(L), 1);
+        if (!m_EnableTableRecycle || !_PopRecycledObjectTable(L, lua_gettop(L), 1))
+            lua_createtable(L, 3, 0);				// class ... ot object
         lua_pushvalue(L, 1);						// class ... ot object class
         lua_rawseti(L, -2, 1);						// class ... ot object
         lua_pushinteger(L, (lua_Integer)p->id);		// class ... ot object id
@@ -570,8 +1553,16 @@ namespace LuaSTGPlus
         lua_pushlightuserdata(L, p);				// class ... ot object pGameObject
         lua_rawseti(L, -2, 3);						// class ... ot object
 
-        // 设置对象 metatable
-        lua_rawgeti(L, -2, LOBJPOOL_METATABLE_IDX);	// class ... ot object mt
+        // 设置对象 metatable，对象类启用了数据视图并且已经设置了对应的元表时，使用数据视图的元表
+        if (p->luaclass.IsObjectView)
+            lua_rawgeti(L, -2, LOBJPOOL_VIEW_METATABLE_IDX);	// class ... ot object mt/nil
+        else
+            lua_pushnil(L);								// class ... ot object nil
+        if (lua_isnil(L, -1))
+        {
+            lua_pop(L, 1);								// class ... ot object
+            lua_rawgeti(L, -2, LOBJPOOL_METATABLE_IDX);	// class ... ot object mt
+        }
         lua_setmetatable(L, -2);					// class ... ot object
 
         // 设置到全局表 ot[n]
@@ -615,6 +1606,7 @@ namespace LuaSTGPlus
         _RemoveFromColliLinkList(p);
         p->uid = m_iUid;
         m_iUid += 1;
+        m_PositionVersion += 1;
         _InsertToUpdateLinkList(p);
         _InsertToRenderList(p);
         _InsertToColliLinkList(p, (size_t)p->group);
@@ -789,15 +1781,15 @@ namespace LuaSTGPlus
             {
                 if (p->rect)
                 {
-                    LAPP.DebugDrawRect((float)p->x, (float)p->y, (float)p->a, (float)p->b, (float)p->rot, fillColor);
+                    LAPP.DebugDrawRect((float)p->x(), (float)p->y(), (float)p->a, (float)p->b, (float)p->rot(), fillColor);
                 }
                 else if (!p->rect && p->a == p->b)
                 {
-                    LAPP.DebugDrawCircle((float)p->x, (float)p->y, (float)p->a, fillColor);
+                    LAPP.DebugDrawCircle((float)p->x(), (float)p->y(), (float)p->a, fillColor);
                 }
                 else if (!p->rect && p->a != p->b)
                 {
-                    LAPP.DebugDrawEllipse((float)p->x, (float)p->y, (float)p->a, (float)p->b, (float)p->rot, fillColor);
+                    LAPP.DebugDrawEllipse((float)p->x(), (float)p->y(), (float)p->a, (float)p->b, (float)p->rot(), fillColor);
                 }
                 else {
                     //备份，为以后做准备
@@ -813,8 +1805,8 @@ namespace LuaSTGPlus
                             { -tHalfSize.x,         0.0f, 0.5f, fillColor.argb, 1.0f, 1.0f },
                             {         0.0f,  tHalfSize.y, 0.5f, fillColor.argb, 1.0f, 0.0f }
                         };
-                        float tCos = std::cosf((float)p->rot);
-                        float tSin = std::sinf((float)p->rot);
+                        float tCos = std::cosf((float)p->rot());
+                        float tSin = std::sinf((float)p->rot());
                         // 变换
                         for (int i = 0; i < 4; i++)
                         {
@@ -837,8 +1829,8 @@ namespace LuaSTGPlus
                             { -tHalfSize.x,  tHalfSize.y, 0.5f, fillColor.argb, 1.0f, 1.0f },
                             { -tHalfSize.x,  tHalfSize.y, 0.5f, fillColor.argb, 1.0f, 1.0f },//和第三个点相同
                         };
-                        float tCos = std::cosf((float)p->rot);
-                        float tSin = std::sinf((float)p->rot);
+                        float tCos = std::cosf((float)p->rot());
+                        float tSin = std::sinf((float)p->rot());
                         // 变换
                         for (int i = 0; i < 4; i++)
                         {
@@ -948,7 +1940,7 @@ namespace LuaSTGPlus
         {
             GameObject* p1 = g_GameObjectPool->_ToGameObject(L, 1);
             GameObject* p2 = g_GameObjectPool->_ToGameObject(L, 2);
-            lua_pushnumber(L, std::atan2(p2->y - p1->y, p2->x - p1->x) * L_RAD_TO_DEG);
+            lua_pushnumber(L, std::atan2(p2->y() - p1->y(), p2->x() - p1->x()) * L_RAD_TO_DEG);
             return 1;
         }
         else if (argc == 3)
@@ -958,7 +1950,7 @@ namespace LuaSTGPlus
                 GameObject* p = g_GameObjectPool->_TableToGameObject(L, 1);
                 lua_Number const x = luaL_checknumber(L, 2);
                 lua_Number const y = luaL_checknumber(L, 3);
-                lua_pushnumber(L, std::atan2(y - p->y, x - p->x) * L_RAD_TO_DEG);
+                lua_pushnumber(L, std::atan2(y - p->y(), x - p->x()) * L_RAD_TO_DEG);
                 return 1;
             }
             else
@@ -966,7 +1958,7 @@ namespace LuaSTGPlus
                 lua_Number const x = luaL_checknumber(L, 1);
                 lua_Number const y = luaL_checknumber(L, 2);
                 GameObject* p = g_GameObjectPool->_ToGameObject(L, 3);
-                lua_pushnumber(L, std::atan2(p->y - y, p->x - x) * L_RAD_TO_DEG);
+                lua_pushnumber(L, std::atan2(p->y() - y, p->x() - x) * L_RAD_TO_DEG);
                 return 1;
             }
         }
@@ -987,8 +1979,8 @@ namespace LuaSTGPlus
         {
             GameObject* p1 = g_GameObjectPool->_ToGameObject(L, 1);
             GameObject* p2 = g_GameObjectPool->_ToGameObject(L, 2);
-            lua_Number const dx = p2->x - p1->x;
-            lua_Number const dy = p2->y - p1->y;
+            lua_Number const dx = p2->x() - p1->x();
+            lua_Number const dy = p2->y() - p1->y();
             lua_pushnumber(L, std::sqrt(dx * dx + dy * dy));
             return 1;
         }
@@ -999,8 +1991,8 @@ namespace LuaSTGPlus
                 GameObject* p = g_GameObjectPool->_TableToGameObject(L, 1);
                 lua_Number const x = luaL_checknumber(L, 2);
                 lua_Number const y = luaL_checknumber(L, 3);
-                lua_Number const dx = x - p->x;
-                lua_Number const dy = y - p->y;
+                lua_Number const dx = x - p->x();
+                lua_Number const dy = y - p->y();
                 lua_pushnumber(L, std::sqrt(dx * dx + dy * dy));
                 return 1;
             }
@@ -1009,8 +2001,8 @@ namespace LuaSTGPlus
                 lua_Number const x = luaL_checknumber(L, 1);
                 lua_Number const y = luaL_checknumber(L, 2);
                 GameObject* p = g_GameObjectPool->_ToGameObject(L, 3);
-                lua_Number const dx = p->x - x;
-                lua_Number const dy = p->y - y;
+                lua_Number const dx = p->x() - x;
+                lua_Number const dy = p->y() - y;
                 lua_pushnumber(L, std::sqrt(dx * dx + dy * dy));
                 return 1;
             }
@@ -1030,8 +2022,8 @@ namespace LuaSTGPlus
     int GameObjectPool::api_GetV(lua_State* L)
     {
         GameObject* p = g_GameObjectPool->_ToGameObject(L, 1);
-        lua_pushnumber(L, std::sqrt(p->vx * p->vx + p->vy * p->vy));
-        lua_pushnumber(L, std::atan2(p->vy, p->vx) * L_RAD_TO_DEG);
+        lua_pushnumber(L, std::sqrt(p->vx() * p->vx() + p->vy() * p->vy()));
+        lua_pushnumber(L, std::atan2(p->vy(), p->vx()) * L_RAD_TO_DEG);
         return 2;
     }
     int GameObjectPool::api_SetV(lua_State* L)
@@ -1040,9 +2032,13 @@ namespace LuaSTGPlus
         lua_Number const v = luaL_checknumber(L, 2);
         lua_Number const a = luaL_checknumber(L, 3) * L_DEG_TO_RAD;
         bool const s = (lua_gettop(L) >= 4) ? lua_toboolean(L, 4) : false;
-        p->vx = v * std::cos(a);
-        p->vy = v * std::sin(a);
-        if (s) p->rot = a;
+        p->vx() = v * std::cos(a);
+        p->vy() = v * std::sin(a);
+        if (s)
+        {
+            p->rot() = a;
+            g_GameObjectPool->m_PositionVersion += 1;
+        }
         return 0;
     }
 
@@ -1087,12 +2083,21 @@ namespace LuaSTGPlus
             if (p == g_GameObjectPool->m_LockObjectA || p == g_GameObjectPool->m_LockObjectB)
                 return luaL_error(L, "illegal operation, lstg object 'group' property should not be modified in 'lstg.CollisionCheck'");
             g_GameObjectPool->_MoveToColliLinkList(p, (size_t)p->group);
+            g_GameObjectPool->m_PositionVersion += 1;
             break;
         case 2: // layer
             if (g_GameObjectPool->m_IsRendering)
                 return luaL_error(L, "illegal operation, lstg object 'layer' property should not be modified in 'lstg.ObjRender'");
             g_GameObjectPool->_SetObjectLayer(p, p->nextlayer);
             break;
+        case 3: // x, y, a, b, rect, img
+            if (g_GameObjectPool->m_BroadPhaseGroup != BroadPhaseInactive)
+                g_GameObjectPool->m_BroadPhase.Touch(p);
+            g_GameObjectPool->m_PositionVersion += 1;
+            break;
+        case 4: // colli, rot, world
+            g_GameObjectPool->m_PositionVersion += 1;
+            break;
         }
         return 0;
     }
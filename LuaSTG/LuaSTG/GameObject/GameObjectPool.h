@@ -1,10 +1,20 @@
 ﻿#pragma once
 #include "GameObject/GameObject.hpp"
+#include "GameObject/GameObjectBroadPhase.hpp"
+#include "GameObject/GameObjectView.hpp"
 #include "Utility/fixed_object_pool.hpp"
+#include "Utility/radix_sort.hpp"
+#include "Utility/job_pool.hpp"
+#include "Core/Graphics/Sprite.hpp"
 
 // 对象池信息
 #define LOBJPOOL_SIZE   32768 // 最大对象数 //32768(full) //16384(half)
 #define LOBJPOOL_GROUPN 24    // 碰撞组数
+#define LOBJPOOL_BROADPHASE_MIN_PAIRS 4096 // 碰撞检测对象对数达到该值时启用粗筛
+#define LOBJPOOL_PARALLEL_COLLI_MIN_PAIRS 16384 // 碰撞检测对象对数达到该值时启用多线程
+#define LOBJPOOL_SPRITE_INSTANCE_MIN 16 // 连续的默认渲染精灵对象达到该数量时使用实例化绘制
+#define LOBJPOOL_RECYCLE_MAX 8192 // 启用对象表回收时最多保留的空闲对象表数
+#define LOBJPOOL_RECYCLE_CLASS_MIN 64 // 每个类的空闲列表的初始容量，放满后在下一次 New 时加倍
 
 namespace LuaSTGPlus
 {
@@ -17,6 +27,7 @@ namespace LuaSTGPlus
             uint64_t object_alloc{ 0 };
             uint64_t object_free{ 0 };
             uint64_t object_alive{ 0 };
+            uint64_t object_colli_candidate{ 0 };
             uint64_t object_colli_check{ 0 };
             uint64_t object_colli_callback{ 0 };
         };
@@ -39,7 +50,21 @@ namespace LuaSTGPlus
             }
         };
         std::set<GameObject*, _less_render> m_RenderList;
+        // 每帧按 (layer, uid) 排序的渲染列表，启用时不再维护 m_RenderList
+        bool m_SortRenderList = false;
+        std::vector<cpp::radix_sort_item<GameObject*>> m_RenderSortBuffer[2];
         std::pair<GameObject, GameObject> m_UpdateLinkList;
+        // 连续的默认渲染精灵对象按纹理和混合模式合批，用实例化绘制
+        struct SpriteInstanceBatch
+        {
+            Core::Graphics::ITexture2D* texture{};
+            BlendMode blend{};
+            std::vector<GameObject*> objects;
+            std::unordered_map<Core::Graphics::ISprite*, uint32_t> rect_index;
+            std::vector<Core::Graphics::IRenderer::SpriteInstanceRect> rects;
+            std::vector<Core::Graphics::IRenderer::SpriteInstance> instances;
+        };
+        SpriteInstanceBatch m_SpriteBatch;
         std::array<std::pair<GameObject, GameObject>, LOBJPOOL_GROUPN> m_ColliLinkList = {};
 
         // 场景边界
@@ -57,6 +82,56 @@ namespace LuaSTGPlus
         GameObject* m_LockObjectA{};
         GameObject* m_LockObjectB{};
 
+        // 碰撞检测粗筛
+        static constexpr size_t BroadPhaseInactive = SIZE_MAX;
+        bool m_EnableBroadPhase = true;
+        size_t m_BroadPhaseGroup = BroadPhaseInactive;
+        GameObjectBroadPhase m_BroadPhase{ LOBJPOOL_SIZE };
+        std::vector<uint32_t> m_ColliCandidate;
+
+        // 多线程碰撞检测：并行计算全部碰撞对象对，排序后按逐对检测的顺序执行回调
+        struct ColliSnapshot
+        {
+            GameObject* object;
+            GameObjectColliderShape shape;
+            lua_Integer world;
+            bool colli;
+        };
+        bool m_EnableParallelCollision = false;
+        std::unique_ptr<cpp::job_pool> m_JobPool;
+        std::vector<ColliSnapshot> m_ColliSnapshot[2];
+        // 每个线程独占的输出，键值为 (碰撞组 A 下标 << 32) | 碰撞组 B 下标
+        std::vector<std::vector<cpp::radix_sort_item<uint32_t>>> m_ColliPairs;
+        std::vector<uint64_t> m_ColliCheckCount;
+        std::vector<cpp::radix_sort_item<uint32_t>> m_ColliPairBuffer[2];
+
+        // 性能分析
+        std::array<char const*, LOBJPOOL_GROUPN * LOBJPOOL_GROUPN> m_ColliProfileName{};
+        std::unordered_set<void const*> m_ProfileClass;
+
+        // 运动学数据（SoA）和批量计算
+        bool m_EnableBatchKinematics = true;
+        GameObjectKinematics m_Kinematics{ LOBJPOOL_SIZE };
+        std::vector<uint32_t> m_KinematicsBatch;
+        std::vector<uint32_t> m_BoundCheckOutput;
+        // 对象坐标、碰撞体、场景边界可能发生变化或者有对象创建、回收时递增
+        uint64_t m_PositionVersion = 0;
+        // 两遍更新：先更新全部使用默认 frame 回调的对象，再执行脚本 frame 回调
+        bool m_EnableTwoPassFrame = false;
+        // 供 LuaJIT FFI 使用的数据视图
+        GameObjectView m_View{};
+        // 批量回调：对象依次填入预先分配的 Lua 数组，由 Lua 侧的循环调用回调，减少 C 与 Lua 之间的切换
+        bool m_EnableBatchDispatch = false;
+        bool m_DispatchReady = false;
+        bool m_Dispatching = false;
+        std::vector<GameObject*> m_DispatchList;
+        std::vector<GameObject*> m_DispatchUpdate;
+        // 对象表回收：回收对象时清空对象表并按类保存，下次创建同一类的对象时复用，减少 GC 压力
+        bool m_EnableTableRecycle = false;
+        size_t m_RecycleCount = 0;
+
+        void _PrepareObjectView();
+
         void _ClearLinkList();
         void _InsertToUpdateLinkList(GameObject* p);
         void _RemoveFromUpdateLinkList(GameObject* p);
@@ -67,6 +142,12 @@ namespace LuaSTGPlus
         void _InsertToRenderList(GameObject* p);
         void _RemoveFromRenderList(GameObject* p);
         void _SetObjectLayer(GameObject* object, lua_Number layer);
+        // 收集所有对象并按 (layer, uid) 排序，返回排序结果
+        cpp::radix_sort_item<GameObject*>* _SortRenderList(size_t& count);
+        // 把默认渲染的对象加入实例化批次，纹理或混合模式变化时先绘制已有的批次，不能实例化绘制时返回 false
+        bool _PushSpriteInstance(GameObject* p);
+        // 绘制并清空实例化批次，对象太少时按原来的方式逐个绘制
+        void _FlushSpriteInstances();
 
         //准备lua表用于存放对象
         void _PrepareLuaObjectTable();
@@ -87,15 +168,53 @@ namespace LuaSTGPlus
         
         // 释放一个对象，完全释放，返回下一个可用的对象（可能为nullptr）
         GameObject* _FreeObject(GameObject* p, int ot_at = 0) noexcept;
+        // 清空栈顶的对象表并放入对应类的空闲列表，不弹出对象表；空闲列表已满时不回收，不分配内存
+        void _RecycleObjectTable(lua_State* L, int ot_idx) noexcept;
+        // 创建或扩大 class_idx 处的类的空闲列表，只在 New 中调用，这里可以分配内存
+        void _ReserveRecycleList(lua_State* L, int ot_idx, int class_idx);
+        // 取出 class_idx 处的类的空闲对象表压入栈顶，没有时返回 false，栈不变
+        bool _PopRecycledObjectTable(lua_State* L, int ot_idx, int class_idx) noexcept;
+        // 清空全部空闲对象表
+        void _ClearRecycledObjectTable(lua_State* L) noexcept;
 
         GameObject* _ToGameObject(lua_State* L, int idx);
         GameObject* _TableToGameObject(lua_State* L, int idx);
 
         void _GameObjectCallback(lua_State* L, int otidx, GameObject* p, int cbidx);
+        void _GameObjectColliCallback(lua_State* L, int otidx, GameObject* pA, GameObject* pB);
+        // 性能分析，按类汇总回调耗时，栈顶为类表
+        void _ProfileCallback(lua_State* L, int cbidx, uint64_t time);
+
+        // 统计碰撞组对象数，返回需要检测的对象对数
+        uint64_t _CountColliPairs(size_t groupA, size_t groupB) const noexcept;
+        // 判断是否值得启用粗筛
+        bool _ShouldUseBroadPhase(size_t groupA, size_t groupB) const noexcept;
+        void _CollisionCheckBroadPhase(size_t groupA, size_t groupB);
+        // 逐对检测，先检测对象 pA（可以为 nullptr）与碰撞组 B 中从 ptrB 开始的对象，然后从 ptrA 开始遍历碰撞组 A
+        void _CollisionCheckFrom(size_t groupA, size_t groupB, GameObject* pA, GameObject* ptrA, GameObject* ptrB);
+        void _CollisionCheckParallel(size_t groupA, size_t groupB);
+
+        // 批量执行已推迟的对象运动学更新
+        void _FlushKinematicsBatch() noexcept;
+        // 更新对象，可以批量计算时推迟到下一次 _FlushKinematicsBatch
+        void _UpdateObject(GameObject* p);
+        // 从指定对象开始逐个进行边界检查，active_only 为 true 时跳过已经不是 normal 状态的对象
+        void _BoundCheckFrom(GameObject* first, int ot_idx, bool active_only = false);
+
+        // 是否可以批量调用回调，性能分析按类统计回调耗时，需要逐个调用
+        bool _CanBatchDispatch() const noexcept;
+        // 一次调用 m_DispatchList 中全部对象的回调，然后清空
+        void _DispatchCallbacks(lua_State* L, int otidx, int cbidx);
+        // 批量回调期间，根据 Lua 侧循环的进度更新当前对象
+        void _SyncDispatchCursor(lua_State* L);
+        // 批量回调的 DoFrame：每一轮先执行全部脚本 frame 回调，再更新这些对象，回调中新建的对象在下一轮处理
+        void _DoFrameBatch(int ot_idx, int superpause, uint64_t native_uid_limit);
 
     public:
         void DebugNextFrame();
         FrameStatistics DebugGetFrameStatistics();
+        /// @brief 压入性能分析数据中的类标识对应的类表，找不到时压入 nil
+        void PushProfileClass(lua_State* L, void const* key);
 
     public:
         int PushCurrentObject(lua_State* L) noexcept;
@@ -111,11 +230,25 @@ namespace LuaSTGPlus
         /// @brief 获取对象
         GameObject* GetPooledObject(size_t i) noexcept { return m_ObjectPool.object(i); }
         
+        /// @brief 获取供 LuaJIT FFI 使用的数据视图，地址在对象池的生命周期内不变
+        GameObjectView* GetObjectView() noexcept { return &m_View; }
+        
+        /// @brief 设置使用数据视图的对象类的元表，元表位于栈上 index 处
+        /// @note 只影响之后创建的对象
+        void SetObjectViewMetatable(lua_State* L, int index) noexcept;
+        
         /// @brief 执行对象的Frame函数
         void DoFrame();
         
         /// @brief 执行对象的Render函数
         void DoRender();
+
+        /// @brief 切换渲染列表的排序方式：每帧基数排序或者红黑树，两者渲染顺序完全相同
+        /// @note 渲染过程中不能切换，返回 false
+        bool SetRenderListSort(bool enable);
+
+        /// @brief 是否每帧基数排序渲染列表
+        bool GetRenderListSort() const noexcept { return m_SortRenderList; }
         
         // TODO: double -> float ???
         /// @brief 获取舞台边界
@@ -131,6 +264,7 @@ namespace LuaSTGPlus
             m_BoundRight = r;
             m_BoundTop = t;
             m_BoundBottom = b;
+            m_PositionVersion += 1;
         }
         
         /// @brief 执行边界检查
@@ -140,6 +274,49 @@ namespace LuaSTGPlus
         /// @param[in] groupA 对象组A
         /// @param[in] groupB 对象组B
         void CollisionCheck(size_t groupA, size_t groupB);
+
+        /// @brief 启用或关闭碰撞检测粗筛（均匀网格），关闭时对两个碰撞组逐对检测
+        void SetCollisionBroadPhase(bool enable) noexcept { m_EnableBroadPhase = enable; }
+
+        /// @brief 是否启用了碰撞检测粗筛
+        bool GetCollisionBroadPhase() const noexcept { return m_EnableBroadPhase; }
+
+        /// @brief 启用或关闭多线程碰撞检测，启用时优先于粗筛，回调顺序与逐对检测完全相同
+        void SetCollisionParallel(bool enable) noexcept { m_EnableParallelCollision = enable; }
+
+        /// @brief 是否启用了多线程碰撞检测
+        bool GetCollisionParallel() const noexcept { return m_EnableParallelCollision; }
+        
+        /// @brief 启用或关闭运动学批量计算（SIMD），关闭时逐个对象计算，两者结果完全相同
+        void SetKinematicsBatch(bool enable) noexcept { m_EnableBatchKinematics = enable; }
+
+        /// @brief 是否启用了运动学批量计算
+        bool GetKinematicsBatch() const noexcept { return m_EnableBatchKinematics; }
+
+        /// @brief 启用或关闭两遍更新，启用时 DoFrame 先更新全部使用默认 frame 回调的对象，再按顺序执行脚本 frame 回调
+        /// @note 关闭时（默认）按对象顺序交替执行，frame 回调读取其他对象时，看到的是前面的对象已更新、后面的对象未更新的状态
+        void SetTwoPassFrame(bool enable) noexcept { m_EnableTwoPassFrame = enable; }
+
+        /// @brief 是否启用了两遍更新
+        bool GetTwoPassFrame() const noexcept { return m_EnableTwoPassFrame; }
+        
+        /// @brief 启用或关闭批量回调，启用时 frame、render、del（出界）回调由 Lua 侧的循环依次调用
+        /// @note DoFrame 中每一轮的对象先执行全部 frame 回调再更新坐标，frame 回调读取其他对象时看到的是未更新的状态
+        /// @note DoRender 只合并连续的脚本渲染对象，绘制顺序不变；BoundCheck 先找出全部出界对象再执行 del 回调
+        void SetBatchDispatch(bool enable) noexcept { m_EnableBatchDispatch = enable; }
+
+        /// @brief 是否启用了批量回调
+        bool GetBatchDispatch() const noexcept { return m_EnableBatchDispatch; }
+        
+        /// @brief 启用或关闭对象表回收，关闭时丢弃已保存的空闲对象表
+        /// @note 回收的对象表会被新对象复用，启用后脚本不能在对象回收后继续持有并使用对象表
+        void SetTableRecycle(bool enable) noexcept;
+
+        /// @brief 是否启用了对象表回收
+        bool GetTableRecycle() const noexcept { return m_EnableTableRecycle; }
+
+        /// @brief 获取当前保存的空闲对象表数
+        size_t GetRecycledTableCount() const noexcept { return m_RecycleCount; }
         
         /// @brief 更新对象的XY坐标偏移量
         void UpdateXY() noexcept;
@@ -201,6 +378,7 @@ namespace LuaSTGPlus
             m_Worlds[1] = b;
             m_Worlds[2] = c;
             m_Worlds[3] = d;
+            m_PositionVersion += 1;
         }
         // 检查两个world mask位与或的结果 //静态函数，不应该只用于类内
         static inline bool CheckWorld(lua_Integer gameworld, lua_Integer objworld) {
@@ -0,0 +1,46 @@
+#pragma once
+#include "lua.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace LuaSTGPlus
+{
+    // 游戏对象常用属性的数据视图，供 LuaJIT FFI 直接读写，脚本访问这些属性时不需要离开 JIT trace
+    // 布局与 LuaInternalSource.cpp 中的 lstg_GameObjectView 声明一致，修改时需要同时修改
+    struct GameObjectView
+    {
+        // 运动学数据，按对象 id 索引，角度为弧度
+        float* x;
+        float* y;
+        float* vx;
+        float* vy;
+        float* ax;
+        float* ay;
+        float* rot;
+        float* omega;
+        lua_Integer* timer;
+
+        // 对象数组，hscale、vscale、status 通过 id * object_stride + 偏移量访问
+        uint8_t* object;
+        uint32_t object_stride;
+        uint32_t hscale_offset;
+        uint32_t vscale_offset;
+        uint32_t status_offset;
+
+        // 修改坐标、旋转角后需要递增
+        uint64_t* position_version;
+        // 非零时正在进行碰撞检测粗筛，坐标只能通过 lstg.SetAttr 修改，以便通知网格
+        uint32_t write_barrier;
+        uint32_t reserved;
+
+        double deg_to_rad;
+        double rad_to_deg;
+    };
+
+    static_assert(std::is_standard_layout_v<GameObjectView>);
+    static_assert(sizeof(lua_Integer) == sizeof(ptrdiff_t));
+    static_assert(offsetof(GameObjectView, object) == sizeof(void*) * 9);
+    static_assert(offsetof(GameObjectView, position_version) == sizeof(void*) * 10 + sizeof(uint32_t) * 4);
+    static_assert(offsetof(GameObjectView, deg_to_rad) == sizeof(void*) * 11 + sizeof(uint32_t) * 4 + sizeof(uint32_t) * 2);
+}
@@ -16,6 +16,13 @@ namespace LuaSTGPlus
 		, m_bRectangle(rect)
 		, m_is_sprite_cloned(true)
 	{
+		if (tex->IsAtlasTexture())
+		{
+			// 纹理坐标换算到图集页上
+			auto const origin = tex->GetAtlasRect().a;
+			x += (float)origin.x;
+			y += (float)origin.y;
+		}
 		// 分割纹理
 		m_sprites.reserve(m * n);
 		for (int j = 0; j < m; ++j)  // 行
@@ -1,9 +1,206 @@
 #include "GameResource/Implement/ResourceParticleImpl.hpp"
+#include "AppFrame.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define LUASTG_PARTICLE_AVX2
+#elif defined(_M_X64) || defined(__x86_64__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#include <emmintrin.h>
+#define LUASTG_PARTICLE_SSE2
+#elif defined(_M_ARM64) || defined(__aarch64__)
+#include <arm_neon.h>
+#define LUASTG_PARTICLE_NEON
+#endif
 
 namespace LuaSTGPlus
 {
 	static std::pmr::unsynchronized_pool_resource s_particle_pool_res;
-	
+	static std::vector<Core::Graphics::IRenderer::SpriteInstance> s_particle_instances;
+
+	namespace
+	{
+		// 逐个粒子的计算，也用于批量计算中剩余的不足一组的粒子
+		// 运算顺序与 HGE 的实现一致，和批量计算逐位相同；GCC/Clang 默认会把乘加合并为 FMA，构建时对本文件关闭（-ffp-contract=off）
+		inline void integrate_one(hgeParticleArray& p, size_t i, Core::Vector2F center, float delta) noexcept
+		{
+			// 计算线加速度和切向加速度
+			Core::Vector2F const n = Core::Vector2F(p.x[i] - center.x, p.y[i] - center.y).normalized();
+			float const ax = n.x * p.radial_accel[i];
+			float const ay = n.y * p.radial_accel[i];
+			// 相当于旋转向量 n.Rotate(M_PI_2)
+			float const tx = -n.y * p.tangential_accel[i];
+			float const ty = n.x * p.tangential_accel[i];
+
+			// 计算速度
+			float const dvx = (ax + tx) * delta;
+			float const dvy = (ay + ty) * delta;
+			p.vx[i] += dvx;
+			p.vy[i] += dvy;
+			float const dg = p.gravity[i] * delta;
+			p.vy[i] += dg;
+
+			// 计算位置
+			float const dx = p.vx[i] * delta;
+			float const dy = p.vy[i] * delta;
+			p.x[i] += dx;
+			p.y[i] += dy;
+
+			// 计算自旋、大小和颜色
+			float const ds = p.spin_delta[i] * delta;
+			p.spin[i] += ds;
+			float const dz = p.size_delta[i] * delta;
+			p.size[i] += dz;
+			for (size_t c = 0; c < 4; c += 1)
+			{
+				float const dc = p.color_delta[c][i] * delta;
+				p.color[c][i] += dc;
+			}
+		}
+
+	#if defined(LUASTG_PARTICLE_AVX2)
+		using fv = __m256;
+		using mv = __m256;
+		constexpr size_t simd_width = 8;
+		inline fv fv_load(float const* p) noexcept { return _mm256_loadu_ps(p); }
+		inline void fv_store(float* p, fv v) noexcept { _mm256_storeu_ps(p, v); }
+		inline fv fv_zero() noexcept { return _mm256_setzero_ps(); }
+		inline fv fv_set(float v) noexcept { return _mm256_set1_ps(v); }
+		inline fv fv_add(fv a, fv b) noexcept { return _mm256_add_ps(a, b); }
+		inline fv fv_sub(fv a, fv b) noexcept { return _mm256_sub_ps(a, b); }
+		inline fv fv_mul(fv a, fv b) noexcept { return _mm256_mul_ps(a, b); }
+		inline fv fv_div(fv a, fv b) noexcept { return _mm256_div_ps(a, b); }
+		inline fv fv_sqrt(fv a) noexcept { return _mm256_sqrt_ps(a); }
+		inline fv fv_neg(fv a) noexcept { return _mm256_xor_ps(a, _mm256_set1_ps(-0.0f)); }
+		inline mv fv_ge(fv a, fv b) noexcept { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+		inline fv fv_select(mv m, fv a, fv b) noexcept { return _mm256_blendv_ps(b, a, m); }
+		inline int mv_bits(mv m) noexcept { return _mm256_movemask_ps(m); }
+	#elif defined(LUASTG_PARTICLE_SSE2)
+		using fv = __m128;
+		using mv = __m128;
+		constexpr size_t simd_width = 4;
+		inline fv fv_load(float const* p) noexcept { return _mm_loadu_ps(p); }
+		inline void fv_store(float* p, fv v) noexcept { _mm_storeu_ps(p, v); }
+		inline fv fv_zero() noexcept { return _mm_setzero_ps(); }
+		inline fv fv_set(float v) noexcept { return _mm_set1_ps(v); }
+		inline fv fv_add(fv a, fv b) noexcept { return _mm_add_ps(a, b); }
+		inline fv fv_sub(fv a, fv b) noexcept { return _mm_sub_ps(a, b); }
+		inline fv fv_mul(fv a, fv b) noexcept { return _mm_mul_ps(a, b); }
+		inline fv fv_div(fv a, fv b) noexcept { return _mm_div_ps(a, b); }
+		inline fv fv_sqrt(fv a) noexcept { return _mm_sqrt_ps(a); }
+		inline fv fv_neg(fv a) noexcept { return _mm_xor_ps(a, _mm_set1_ps(-0.0f)); }
+		inline mv fv_ge(fv a, fv b) noexcept { return _mm_cmpge_ps(a, b); }
+		inline fv fv_select(mv m, fv a, fv b) noexcept { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+		inline int mv_bits(mv m) noexcept { return _mm_movemask_ps(m); }
+	#elif defined(LUASTG_PARTICLE_NEON)
+		using fv = float32x4_t;
+		using mv = uint32x4_t;
+		constexpr size_t simd_width = 4;
+		inline fv fv_load(float const* p) noexcept { return vld1q_f32(p); }
+		inline void fv_store(float* p, fv v) noexcept { vst1q_f32(p, v); }
+		inline fv fv_zero() noexcept { return vdupq_n_f32(0.0f); }
+		inline fv fv_set(float v) noexcept { return vdupq_n_f32(v); }
+		inline fv fv_add(fv a, fv b) noexcept { return vaddq_f32(a, b); }
+		inline fv fv_sub(fv a, fv b) noexcept { return vsubq_f32(a, b); }
+		inline fv fv_mul(fv a, fv b) noexcept { return vmulq_f32(a, b); }
+		inline fv fv_div(fv a, fv b) noexcept { return vdivq_f32(a, b); }
+		inline fv fv_sqrt(fv a) noexcept { return vsqrtq_f32(a); }
+		inline fv fv_neg(fv a) noexcept { return vnegq_f32(a); }
+		inline mv fv_ge(fv a, fv b) noexcept { return vcgeq_f32(a, b); }
+		inline fv fv_select(mv m, fv a, fv b) noexcept { return vbslq_f32(m, a, b); }
+		inline int mv_bits(mv m) noexcept
+		{
+			return int(vgetq_lane_u32(m, 0) & 1u)
+				| int(vgetq_lane_u32(m, 1) & 2u)
+				| int(vgetq_lane_u32(m, 2) & 4u)
+				| int(vgetq_lane_u32(m, 3) & 8u);
+		}
+	#endif
+
+	#if defined(LUASTG_PARTICLE_AVX2) || defined(LUASTG_PARTICLE_SSE2) || defined(LUASTG_PARTICLE_NEON)
+		#define LUASTG_PARTICLE_SIMD
+
+		inline void integrate_simd(hgeParticleArray& p, size_t i, fv cx, fv cy, fv delta) noexcept
+		{
+			fv_store(p.age + i, fv_add(fv_load(p.age + i), delta));
+
+			// 与 Vector2F::normalized 一致：长度小于 FLT_MIN 时为零向量
+			fv const rx = fv_sub(fv_load(p.x + i), cx);
+			fv const ry = fv_sub(fv_load(p.y + i), cy);
+			fv const l = fv_sqrt(fv_add(fv_mul(rx, rx), fv_mul(ry, ry)));
+			mv const valid = fv_ge(l, fv_set(std::numeric_limits<float>::min()));
+			fv const nx = fv_select(valid, fv_div(rx, l), fv_zero());
+			fv const ny = fv_select(valid, fv_div(ry, l), fv_zero());
+
+			fv const radial = fv_load(p.radial_accel + i);
+			fv const tangential = fv_load(p.tangential_accel + i);
+			fv const ax = fv_add(fv_mul(nx, radial), fv_mul(fv_neg(ny), tangential));
+			fv const ay = fv_add(fv_mul(ny, radial), fv_mul(nx, tangential));
+
+			fv const vx = fv_add(fv_load(p.vx + i), fv_mul(ax, delta));
+			fv vy = fv_add(fv_load(p.vy + i), fv_mul(ay, delta));
+			vy = fv_add(vy, fv_mul(fv_load(p.gravity + i), delta));
+			fv_store(p.vx + i, vx);
+			fv_store(p.vy + i, vy);
+			fv_store(p.x + i, fv_add(fv_load(p.x + i), fv_mul(vx, delta)));
+			fv_store(p.y + i, fv_add(fv_load(p.y + i), fv_mul(vy, delta)));
+
+			fv_store(p.spin + i, fv_add(fv_load(p.spin + i), fv_mul(fv_load(p.spin_delta + i), delta)));
+			fv_store(p.size + i, fv_add(fv_load(p.size + i), fv_mul(fv_load(p.size_delta + i), delta)));
+			for (size_t c = 0; c < 4; c += 1)
+			{
+				fv_store(p.color[c] + i, fv_add(fv_load(p.color[c] + i), fv_mul(fv_load(p.color_delta[c] + i), delta)));
+			}
+		}
+		inline bool any_dead_simd(hgeParticleArray const& p, size_t i) noexcept
+		{
+			return mv_bits(fv_ge(fv_load(p.age + i), fv_load(p.terminal_age + i))) != 0;
+		}
+	#endif
+	}
+
+	void hgeParticleArray::Set(size_t i, hgeParticle const& p) noexcept
+	{
+		x[i] = p.vecLocation.x;
+		y[i] = p.vecLocation.y;
+		vx[i] = p.vecVelocity.x;
+		vy[i] = p.vecVelocity.y;
+		gravity[i] = p.fGravity;
+		radial_accel[i] = p.fRadialAccel;
+		tangential_accel[i] = p.fTangentialAccel;
+		spin[i] = p.fSpin;
+		spin_delta[i] = p.fSpinDelta;
+		size[i] = p.fSize;
+		size_delta[i] = p.fSizeDelta;
+		for (size_t c = 0; c < 4; c += 1)
+		{
+			color[c][i] = p.colColor[c];
+			color_delta[c][i] = p.colColorDelta[c];
+		}
+		age[i] = p.fAge;
+		terminal_age[i] = p.fTerminalAge;
+	}
+	void hgeParticleArray::Move(size_t dst, size_t src) noexcept
+	{
+		x[dst] = x[src];
+		y[dst] = y[src];
+		vx[dst] = vx[src];
+		vy[dst] = vy[src];
+		gravity[dst] = gravity[src];
+		radial_accel[dst] = radial_accel[src];
+		tangential_accel[dst] = tangential_accel[src];
+		spin[dst] = spin[src];
+		spin_delta[dst] = spin_delta[src];
+		size[dst] = size[src];
+		size_delta[dst] = size_delta[src];
+		for (size_t c = 0; c < 4; c += 1)
+		{
+			color[c][dst] = color[c][src];
+			color_delta[c][dst] = color_delta[c][src];
+		}
+		age[dst] = age[src];
+		terminal_age[dst] = terminal_age[src];
+	}
+
 	bool ParticleSystemResourceInfo::LoadFromMemory(void const* data, size_t size)
 	{
 		if (size != sizeof(hgeParticleSystemInfo))
@@ -74,6 +271,22 @@ namespace LuaSTGPlus
 		SetSeed(uint32_t(std::rand()));
 	}
 	size_t ParticlePoolImpl::GetAliveCount() { return m_iAlive; }
+	bool ParticlePoolImpl::GetParticleState(size_t index, ParticleState& state)
+	{
+		if (index >= m_iAlive)
+		{
+			return false;
+		}
+		hgeParticleArray const& p = m_ParticlePool;
+		state.position = Core::Vector2F(p.x[index], p.y[index]);
+		state.size = p.size[index];
+		state.spin = p.spin[index];
+		for (size_t c = 0; c < 4; c += 1)
+		{
+			state.color[c] = p.color[c][index];
+		}
+		return true;
+	}
 	BlendMode ParticlePoolImpl::GetBlendMode() { return m_Info.eBlendMode; }
 	void ParticlePoolImpl::SetBlendMode(BlendMode m) { m_Info.eBlendMode = m; }
 	Core::Color4B ParticlePoolImpl::GetVertexColor()
@@ -124,62 +337,93 @@ namespace LuaSTGPlus
 	Core::Vector2F ParticlePoolImpl::GetCenter() { return m_vCenter; }
 	void ParticlePoolImpl::SetRotation(float r) { m_fDirection = r; }
 	float ParticlePoolImpl::GetRotation() { return m_fDirection; }
-	void ParticlePoolImpl::Update(float delta)
+	void ParticlePoolImpl::UpdateParticles(float delta)
 	{
-		hgeParticleSystemInfo const& pInfo = m_Info.tParticleSystemInfo;
-
-		if (m_iStatus == Status::Alive)
-		{
-			m_fAge += delta;
-			if (m_fAge >= pInfo.fLifetime && pInfo.fLifetime >= 0.0f)
-			{
-				m_iStatus = Status::Sleep;
-			}
-		}
-
-		// 更新所有粒子
+		hgeParticleArray& p = m_ParticlePool;
 		for (size_t i = 0; i < m_iAlive; i += 1)
 		{
-			hgeParticle& tInst = m_ParticlePool[i];
-			tInst.fAge += delta;
-			if (tInst.fAge >= tInst.fTerminalAge)
+			p.age[i] += delta;
+			if (p.age[i] >= p.terminal_age[i])
 			{
 				m_iAlive -= 1;
 				if (i < m_iAlive)
 				{
 					// 需要拷贝最后一个粒子到当前位置
-					std::memcpy(&tInst, &m_ParticlePool[m_iAlive], sizeof(hgeParticle));
+					p.Move(i, m_iAlive);
 				}
 				// 回溯索引
 				i -= 1;
 				continue;
 			}
+			integrate_one(p, i, m_vCenter, delta);
+		}
+	}
+	void ParticlePoolImpl::UpdateParticlesBatch(float delta)
+	{
+		hgeParticleArray& p = m_ParticlePool;
+		size_t const count = m_iAlive;
 
-			// 计算线加速度和切向加速度
-			Core::Vector2F vecAccel = (tInst.vecLocation - m_vCenter).normalized();
-			Core::Vector2F vecAccel2 = vecAccel;
-			vecAccel *= tInst.fRadialAccel;
-			// 相当于旋转向量 vecAccel2.Rotate(M_PI_2);
-			std::swap(vecAccel2.x, vecAccel2.y);
-			vecAccel2.x = -vecAccel2.x;
-			vecAccel2 *= tInst.fTangentialAccel;
+		// 先更新所有粒子，死亡的粒子也参与计算，随后被移除
+		size_t i = 0;
+	#ifdef LUASTG_PARTICLE_SIMD
+		fv const cx = fv_set(m_vCenter.x);
+		fv const cy = fv_set(m_vCenter.y);
+		fv const dt = fv_set(delta);
+		for (; i + simd_width <= count; i += simd_width)
+		{
+			integrate_simd(p, i, cx, cy, dt);
+		}
+	#endif
+		for (; i < count; i += 1)
+		{
+			p.age[i] += delta;
+			integrate_one(p, i, m_vCenter, delta);
+		}
 
-			// 计算速度
-			tInst.vecVelocity += (vecAccel + vecAccel2) * delta;
-			tInst.vecVelocity.y += tInst.fGravity * delta;
+		// 再移除死亡的粒子，与逐个更新的顺序相同：由最后一个粒子填补空位
+		size_t alive = count;
+		i = 0;
+		while (i < alive)
+		{
+		#ifdef LUASTG_PARTICLE_SIMD
+			if (i + simd_width <= alive && !any_dead_simd(p, i))
+			{
+				i += simd_width;
+				continue;
+			}
+		#endif
+			if (p.age[i] >= p.terminal_age[i])
+			{
+				alive -= 1;
+				if (i < alive)
+				{
+					p.Move(i, alive);
+				}
+				continue;
+			}
+			i += 1;
+		}
+		m_iAlive = alive;
+	}
+	void ParticlePoolImpl::Update(float delta)
+	{
+		hgeParticleSystemInfo const& pInfo = m_Info.tParticleSystemInfo;
 
-			// 计算位置
-			tInst.vecLocation += tInst.vecVelocity * delta;
-
-			// 计算自旋和大小
-			tInst.fSpin += tInst.fSpinDelta * delta;
-			tInst.fSize += tInst.fSizeDelta * delta;
-			tInst.colColor[0] += tInst.colColorDelta[0] * delta;
-			tInst.colColor[1] += tInst.colColorDelta[1] * delta;
-			tInst.colColor[2] += tInst.colColorDelta[2] * delta;
-			tInst.colColor[3] += tInst.colColorDelta[3] * delta;
+		if (m_iStatus == Status::Alive)
+		{
+			m_fAge += delta;
+			if (m_fAge >= pInfo.fLifetime && pInfo.fLifetime >= 0.0f)
+			{
+				m_iStatus = Status::Sleep;
+			}
 		}
 
+		// 更新所有粒子
+		if (LAPP.GetParticleBatch())
+			UpdateParticlesBatch(delta);
+		else
+			UpdateParticles(delta);
+
 		// 产生新的粒子
 		if (m_iStatus == Status::Alive)
 		{
@@ -189,11 +433,10 @@ namespace LuaSTGPlus
 
 			for (uint32_t i = 0; i < nParticlesCreated; ++i)
 			{
-				if (m_iAlive >= m_ParticlePool.size())
+				if (m_iAlive >= LPARTICLE_MAXCNT)
 					break;
 
-				hgeParticle& tInst = m_ParticlePool[m_iAlive];
-				m_iAlive += 1;
+				hgeParticle tInst;
 
 				tInst.fAge = 0.0f;
 				tInst.fTerminalAge = RandomFloat(pInfo.fParticleLifeMin, pInfo.fParticleLifeMax);
@@ -249,6 +492,9 @@ namespace LuaSTGPlus
 				tInst.colColorDelta[1] = (pInfo.colColorEnd[1] - tInst.colColor[1]) / tInst.fTerminalAge;
 				tInst.colColorDelta[2] = (pInfo.colColorEnd[2] - tInst.colColor[2]) / tInst.fTerminalAge;
 				tInst.colColorDelta[3] = (pInfo.colColorEnd[3] - tInst.colColor[3]) / tInst.fTerminalAge;
+
+				m_ParticlePool.Set(m_iAlive, tInst);
+				m_iAlive += 1;
 			}
 		}
 
@@ -259,31 +505,56 @@ namespace LuaSTGPlus
 		Core::Graphics::ISprite* pSprite = m_Info.pSprite.get();
 		hgeParticleSystemInfo const& pInfo = m_Info.tParticleSystemInfo;
 		Core::Color4B const tVertexColor = GetVertexColor();
-		for (size_t i = 0; i < m_iAlive; i += 1)
+		hgeParticleArray const& p = m_ParticlePool;
+		auto const particle_color = [&](size_t i) -> Core::Color4B
 		{
-			hgeParticle const& pInst = m_ParticlePool[i];
 			if (pInfo.colColorStart[0] < 0) // r < 0
 			{
-				pSprite->setColor(Core::Color4B(
+				return Core::Color4B(
 					tVertexColor.r,
 					tVertexColor.g,
 					tVertexColor.b,
-					(uint8_t)std::clamp(pInst.colColor[3] * (float)tVertexColor.a, 0.0f, 255.0f)
-				));
+					(uint8_t)std::clamp(p.color[3][i] * (float)tVertexColor.a, 0.0f, 255.0f)
+				);
 			}
 			else
 			{
-				pSprite->setColor(Core::Color4B(
-					(uint8_t)std::clamp(pInst.colColor[0] * (float)tVertexColor.r, 0.0f, 255.0f),
-					(uint8_t)std::clamp(pInst.colColor[1] * (float)tVertexColor.g, 0.0f, 255.0f),
-					(uint8_t)std::clamp(pInst.colColor[2] * (float)tVertexColor.b, 0.0f, 255.0f),
-					(uint8_t)std::clamp(pInst.colColor[3] * (float)tVertexColor.a, 0.0f, 255.0f)
-				));
+				return Core::Color4B(
+					(uint8_t)std::clamp(p.color[0][i] * (float)tVertexColor.r, 0.0f, 255.0f),
+					(uint8_t)std::clamp(p.color[1][i] * (float)tVertexColor.g, 0.0f, 255.0f),
+					(uint8_t)std::clamp(p.color[2][i] * (float)tVertexColor.b, 0.0f, 255.0f),
+					(uint8_t)std::clamp(p.color[3][i] * (float)tVertexColor.a, 0.0f, 255.0f)
+				);
 			}
+		};
+		if (m_iAlive >= LPARTICLE_INSTANCE_MIN && LAPP.GetSpriteInstancing())
+		{
+			// 所有粒子共用一个精灵，一次绘制完
+			Core::Graphics::IRenderer::SpriteInstanceRect const rect = pSprite->getInstanceRect();
+			float const z = pSprite->getZ();
+			s_particle_instances.resize(m_iAlive);
+			for (size_t i = 0; i < m_iAlive; i += 1)
+			{
+				Core::Graphics::IRenderer::SpriteInstance& instance = s_particle_instances[i];
+				instance.x = p.x[i];
+				instance.y = p.y[i];
+				instance.z = z;
+				instance.rotation = p.spin[i];
+				instance.hscale = scaleX * p.size[i];
+				instance.vscale = scaleY * p.size[i];
+				instance.rect = 0;
+				instance.color = particle_color(i).color();
+			}
+			LAPP.GetRenderer2D()->drawSpriteInstances(pSprite->getTexture(), &rect, 1, s_particle_instances.data(), m_iAlive);
+			return;
+		}
+		for (size_t i = 0; i < m_iAlive; i += 1)
+		{
+			pSprite->setColor(particle_color(i));
 			pSprite->draw(
-				Core::Vector2F(pInst.vecLocation.x, pInst.vecLocation.y),
-				Core::Vector2F(scaleX * pInst.fSize, scaleY * pInst.fSize),
-				pInst.fSpin);
+				Core::Vector2F(p.x[i], p.y[i]),
+				Core::Vector2F(scaleX * p.size[i], scaleY * p.size[i]),
+				p.spin[i]);
 		}
 	}
 }
@@ -5,6 +5,7 @@
 #include "Utility/xorshift.hpp"
 
 #define LPARTICLE_MAXCNT 500  // 单个粒子池最多有500个粒子，这是HGE粒子特效的实现，不应该修改
+#define LPARTICLE_INSTANCE_MIN 16  // 存活粒子数达到该值时使用实例化绘制
 
 namespace LuaSTGPlus
 {
@@ -32,6 +33,32 @@ namespace LuaSTGPlus
 		float fTerminalAge; // 终止时间
 	};
 
+	// HGE 粒子池的存储，每个字段单独一个数组（SoA），便于批量计算
+	struct hgeParticleArray
+	{
+		// 向上取整到 8 的倍数，数组按 32 字节对齐
+		static constexpr size_t capacity = (LPARTICLE_MAXCNT + 7) / 8 * 8;
+
+		alignas(32) float x[capacity];
+		alignas(32) float y[capacity];
+		alignas(32) float vx[capacity];
+		alignas(32) float vy[capacity];
+		alignas(32) float gravity[capacity];
+		alignas(32) float radial_accel[capacity];
+		alignas(32) float tangential_accel[capacity];
+		alignas(32) float spin[capacity];
+		alignas(32) float spin_delta[capacity];
+		alignas(32) float size[capacity];
+		alignas(32) float size_delta[capacity];
+		alignas(32) float color[4][capacity];
+		alignas(32) float color_delta[4][capacity];
+		alignas(32) float age[capacity];
+		alignas(32) float terminal_age[capacity];
+
+		void Set(size_t i, hgeParticle const& p) noexcept;
+		void Move(size_t dst, size_t src) noexcept;
+	};
+
 	// 粒子效果资源定义
 	struct ParticleSystemResourceInfo
 	{
@@ -56,7 +83,7 @@ namespace LuaSTGPlus
 	private:
 		Core::ScopeObject<IResourceParticle> m_Res;
 		ParticleSystemResourceInfo m_Info;
-		std::array<hgeParticle, LPARTICLE_MAXCNT> m_ParticlePool;
+		hgeParticleArray m_ParticlePool;
 		UtilRandom::xoshiro128p m_Random;
 		uint32_t m_RandomSeed = 0;
 		Status m_iStatus = Status::Alive;  // 状态
@@ -69,9 +96,12 @@ namespace LuaSTGPlus
 		bool m_bOldBehavior = true; // 使用旧行为
 	private:
 		float RandomFloat(float a, float b);
+		void UpdateParticles(float delta);
+		void UpdateParticlesBatch(float delta);
 	public:
 		hgeParticleSystemInfo& GetParticleSystemInfo() { return m_Info.tParticleSystemInfo; };
 		size_t GetAliveCount();
+		bool GetParticleState(size_t index, ParticleState& state);
 		BlendMode GetBlendMode();
 		void SetBlendMode(BlendMode m);
 		Core::Color4B GetVertexColor();
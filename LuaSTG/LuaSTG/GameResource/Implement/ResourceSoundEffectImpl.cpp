@@ -2,69 +2,150 @@
 
 namespace LuaSTGPlus
 {
+	ResourceSoundEffectImpl::Voice* ResourceSoundEffectImpl::AcquireVoice()
+	{
+		// 空闲的声部
+		for (auto& v : m_voices)
+		{
+			if (!v.paused && !v.player->isPlaying())
+			{
+				return &v;
+			}
+		}
+		// 新的声部，和第一个声部共享解码后的数据
+		if (m_voices.size() < m_config.max_voices)
+		{
+			Core::ScopeObject<Core::Audio::IAudioPlayer> p_player;
+			if (m_device->createSharedAudioPlayer(m_voices[0].player.get(), ~p_player))
+			{
+				p_player->setSpeed(m_voices[0].player->getSpeed());
+				Voice& v = m_voices.emplace_back();
+				v.player = p_player;
+				return &v;
+			}
+		}
+		// 抢占
+		Voice* victim = &m_voices[0];
+		for (auto& v : m_voices)
+		{
+			if (m_config.steal == SoundEffectStealPolicy::Quietest && v.vol != victim->vol)
+			{
+				if (v.vol < victim->vol)
+				{
+					victim = &v;
+				}
+			}
+			else if (v.serial < victim->serial)
+			{
+				victim = &v;
+			}
+		}
+		return victim;
+	}
+	void ResourceSoundEffectImpl::PauseVoices()
+	{
+		for (auto& v : m_voices)
+		{
+			if (v.player->isPlaying())
+			{
+				v.player->stop();
+				v.paused = true;
+			}
+		}
+	}
+	void ResourceSoundEffectImpl::StartPlays(bool start)
+	{
+		for (auto const& request : m_plays)
+		{
+			Voice* v = AcquireVoice();
+			m_serial += 1;
+			v->serial = m_serial;
+			v->vol = request.vol;
+			v->player->reset();
+			v->player->setVolume(request.vol);
+			v->player->setBalance(request.pan);
+			if (start)
+			{
+				v->player->start();
+			}
+			v->paused = !start;
+		}
+	}
+
 	void ResourceSoundEffectImpl::FlushCommand()
 	{
 		// 根据最后的命令对音效进行操作
-		switch (m_last_command.type)
+		switch (m_last_command)
 		{
 		case CommandType::None:
 			break;
 		case CommandType::Play:
-			m_player->start();
+			for (auto& v : m_voices)
+			{
+				if (v.paused)
+				{
+					v.player->start();
+					v.paused = false;
+				}
+			}
 			break;
 		case CommandType::Stop:
-			m_player->stop();
+			PauseVoices();
 			break;
 		case CommandType::Reset:
-			m_player->reset();
-			m_player->setVolume(m_last_command.vol);
-			m_player->setBalance(m_last_command.pan);
-			m_player->start();
+			StartPlays(true);
 			break;
 		case CommandType::ResetAndStop:
-			m_player->reset();
-			m_player->setVolume(m_last_command.vol);
-			m_player->setBalance(m_last_command.pan);
+			PauseVoices();
+			StartPlays(false);
 			break;
 		default:
 			assert(false);
 			break;
 		}
 		// 重置为无命令
-		m_last_command.type = CommandType::None;
-		m_last_command.vol = 0.0f;
-		m_last_command.pan = 0.0f;
+		m_last_command = CommandType::None;
+		m_plays.clear();
 	}
 	void ResourceSoundEffectImpl::Play(float vol, float pan)
 	{
 		// 优先级最高的命令，覆盖其他一切命令
-		m_last_command.type = CommandType::Reset;
-		m_last_command.vol = std::max(m_last_command.vol, vol); // 取音量最高
-		m_last_command.pan = pan;
+		m_last_command = CommandType::Reset;
+		if (m_plays.size() < m_config.max_plays_per_frame)
+		{
+			m_plays.push_back(PlayRequest{ vol, pan });
+		}
+		else
+		{
+			// 超出每帧的播放次数，合并到最后一次
+			PlayRequest& last = m_plays.back();
+			last.vol = std::max(last.vol, vol); // 取音量最高
+			last.pan = pan;
+		}
 		m_status = 2; // playing
 	}
 	void ResourceSoundEffectImpl::Resume()
 	{
-		switch (m_last_command.type)
+		switch (m_last_command)
 		{
 		case CommandType::None:
 			// 初始化命令
-			m_last_command.type = CommandType::Play;
+			m_last_command = CommandType::Play;
 			break;
 		case CommandType::Play:
 			// 就是这个命令
-			m_last_command.type = CommandType::Play;
+			m_last_command = CommandType::Play;
 			break;
 		case CommandType::Stop:
 			// 覆盖暂停/停止命令
-			m_last_command.type = CommandType::Play;
+			m_last_command = CommandType::Play;
 			break;
 		case CommandType::Reset:
 			// 保持当前命令
 			break;
 		case CommandType::ResetAndStop:
 			// 修正为重新播放命令
-			m_last_command.type = CommandType::Reset;
+			m_last_command = CommandType::Reset;
 			break;
 		default:
 			assert(false);
@@ -74,23 +155,23 @@ namespace LuaSTGPlus
 	}
 	void ResourceSoundEffectImpl::Pause()
 	{
-		switch (m_last_command.type)
+		switch (m_last_command)
 		{
 		case CommandType::None:
 			// 初始化命令
-			m_last_command.type = CommandType::Stop;
+			m_last_command = CommandType::Stop;
 			break;
 		case CommandType::Play:
 			// 覆盖播放/恢复命令
-			m_last_command.type = CommandType::Stop;
+			m_last_command = CommandType::Stop;
 			break;
 		case CommandType::Stop:
 			// 就是这个命令
-			m_last_command.type = CommandType::Stop;
+			m_last_command = CommandType::Stop;
 			break;
 		case CommandType::Reset:
 			// 修正为回到起始命令
-			m_last_command.type = CommandType::ResetAndStop;
+			m_last_command = CommandType::ResetAndStop;
 			break;
 		case CommandType::ResetAndStop:
 			// 保持当前命令
@@ -103,23 +184,23 @@ namespace LuaSTGPlus
 	}
 	void ResourceSoundEffectImpl::Stop()
 	{
-		switch (m_last_command.type)
+		switch (m_last_command)
 		{
 		case CommandType::None:
 			// 初始化命令
-			m_last_command.type = CommandType::Stop;
+			m_last_command = CommandType::Stop;
 			break;
 		case CommandType::Play:
 			// 覆盖播放/恢复命令
-			m_last_command.type = CommandType::Stop;
+			m_last_command = CommandType::Stop;
 			break;
 		case CommandType::Stop:
 			// 就是这个命令
-			m_last_command.type = CommandType::Stop;
+			m_last_command = CommandType::Stop;
 			break;
 		case CommandType::Reset:
 			// 修正为回到起始命令
-			m_last_command.type = CommandType::ResetAndStop;
+			m_last_command = CommandType::ResetAndStop;
 			break;
 		case CommandType::ResetAndStop:
 			// 保持当前命令
@@ -130,14 +211,61 @@ namespace LuaSTGPlus
 		}
 		m_status = 0; // stop
 	}
-	bool ResourceSoundEffectImpl::IsPlaying() { return m_player->isPlaying() || m_status == 2; }
+	bool ResourceSoundEffectImpl::IsPlaying()
+	{
+		if (m_status == 2)
+		{
+			return true;
+		}
+		for (auto& v : m_voices)
+		{
+			if (v.player->isPlaying())
+			{
+				return true;
+			}
+		}
+		return false;
+	}
 	bool ResourceSoundEffectImpl::IsStopped() { return !IsPlaying() && m_status != 1; }
-	bool ResourceSoundEffectImpl::SetSpeed(float speed) { return m_player->setSpeed(speed); }
-	float ResourceSoundEffectImpl::GetSpeed() { return m_player->getSpeed(); }
+	bool ResourceSoundEffectImpl::SetSpeed(float speed)
+	{
+		bool result = true;
+		for (auto& v : m_voices)
+		{
+			result = v.player->setSpeed(speed) && result;
+		}
+		return result;
+	}
+	float ResourceSoundEffectImpl::GetSpeed() { return m_voices[0].player->getSpeed(); }
+	void ResourceSoundEffectImpl::SetVoiceConfig(SoundEffectVoiceConfig const& config)
+	{
+		m_config = config;
+		m_config.max_voices = std::max<uint32_t>(1, m_config.max_voices);
+		m_config.max_plays_per_frame = std::max<uint32_t>(1, m_config.max_plays_per_frame);
+		if (m_voices.size() > m_config.max_voices)
+		{
+			m_voices.resize(m_config.max_voices); // 多出来的声部直接释放
+		}
+	}
+	SoundEffectVoiceConfig ResourceSoundEffectImpl::GetVoiceConfig() { return m_config; }
+	uint32_t ResourceSoundEffectImpl::GetVoiceCount() { return (uint32_t)m_voices.size(); }
+	uint32_t ResourceSoundEffectImpl::GetActiveVoiceCount()
+	{
+		uint32_t count = 0;
+		for (auto& v : m_voices)
+		{
+			if (v.player->isPlaying())
+			{
+				count += 1;
+			}
+		}
+		return count;
+	}
 
-	ResourceSoundEffectImpl::ResourceSoundEffectImpl(const char* name, Core::Audio::IAudioPlayer* p_player)
+	ResourceSoundEffectImpl::ResourceSoundEffectImpl(const char* name, Core::Audio::IAudioDevice* p_device, Core::Audio::IAudioPlayer* p_player)
 		: ResourceBaseImpl(ResourceType::SoundEffect, name)
-		, m_player(p_player)
+		, m_device(p_device)
 	{
+		m_voices.emplace_back().player = p_player;
 	}
 }
@@ -16,16 +16,30 @@ namespace LuaSTGPlus
 			Reset,
 			ResetAndStop,
 		};
-		struct Command
+		struct PlayRequest
 		{
-			CommandType type = CommandType::None;
 			float vol = 0.0f;
 			float pan = 0.0f;
 		};
+		struct Voice
+		{
+			Core::ScopeObject<Core::Audio::IAudioPlayer> player;
+			uint64_t serial = 0; // 开始播放的序号，越小越早
+			float vol = 0.0f;
+			bool paused = false;
+		};
 	private:
-		Core::ScopeObject<Core::Audio::IAudioPlayer> m_player;
+		Core::ScopeObject<Core::Audio::IAudioDevice> m_device;
+		std::vector<Voice> m_voices; // 第一个是加载时创建的播放器，其他声部和它共享解码后的数据
+		std::vector<PlayRequest> m_plays; // 本帧的播放请求
+		SoundEffectVoiceConfig m_config;
+		uint64_t m_serial = 0;
 		int m_status = 0; // 0停止 1暂停 2播放
-		Command m_last_command;
+		CommandType m_last_command = CommandType::None;
+	private:
+		Voice* AcquireVoice();
+		void PauseVoices();
+		void StartPlays(bool start);
 	public:
 		void FlushCommand();
 		void Play(float vol, float pan);
@@ -36,8 +50,12 @@ namespace LuaSTGPlus
 		bool IsStopped();
 		bool SetSpeed(float speed);
 		float GetSpeed();
+		void SetVoiceConfig(SoundEffectVoiceConfig const& config);
+		SoundEffectVoiceConfig GetVoiceConfig();
+		uint32_t GetVoiceCount();
+		uint32_t GetActiveVoiceCount();
 
 	public:
-		ResourceSoundEffectImpl(const char* name, Core::Audio::IAudioPlayer* p_player);
+		ResourceSoundEffectImpl(const char* name, Core::Audio::IAudioDevice* p_device, Core::Audio::IAudioPlayer* p_player);
 	};
 }
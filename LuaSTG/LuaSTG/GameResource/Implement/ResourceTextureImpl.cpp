@@ -40,6 +40,16 @@ namespace LuaSTGPlus
 		// , m_enable_depthbuffer(false)
 	{
 	}
+	// 图集纹理容器
+	ResourceTextureImpl::ResourceTextureImpl(const char* name, Core::Graphics::ITexture2D* p_page, Core::RectU atlas_rect)
+		: ResourceBaseImpl(ResourceType::Texture, name)
+		, m_texture(p_page)
+		, m_is_rendertarget(false)
+		, m_is_auto_resize(false)
+		, m_is_atlas(true)
+		, m_atlas_rect(atlas_rect)
+	{
+	}
 	// 渲染附件容器
 	ResourceTextureImpl::ResourceTextureImpl(const char* name, int w, int h)
 		: ResourceBaseImpl(ResourceType::Texture, name)
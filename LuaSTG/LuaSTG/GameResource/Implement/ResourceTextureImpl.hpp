@@ -13,6 +13,8 @@ namespace LuaSTGPlus
 		bool m_is_rendertarget{ false };
 		bool m_is_auto_resize{ false };
 		bool m_enable_depthbuffer{ false };
+		bool m_is_atlas{ false };
+		Core::RectU m_atlas_rect;
 	public:
 		bool ResizeRenderTarget(Core::Vector2U size);
 	public:
@@ -21,9 +23,14 @@ namespace LuaSTGPlus
 		// Core::Graphics::IDepthStencilBuffer* GetDepthStencilBuffer() { return m_ds.get(); }
 		bool IsRenderTarget() { return m_is_rendertarget; }
 		bool HasDepthStencilBuffer() { return m_rt->DepthStencilBufferEnabled(); }
+		bool IsAtlasTexture() { return m_is_atlas; }
+		Core::RectU GetAtlasRect() { return m_atlas_rect; }
+		Core::Vector2U GetSize() { return m_is_atlas ? m_atlas_rect.dim() : m_texture->getSize(); }
 	public:
 		// 纹理容器
 		ResourceTextureImpl(const char* name, Core::Graphics::ITexture2D* p_texture);
+		// 图集纹理容器
+		ResourceTextureImpl(const char* name, Core::Graphics::ITexture2D* p_page, Core::RectU atlas_rect);
 		// 渲染附件容器
 		ResourceTextureImpl(const char* name, int w, int h);
 		// 自动调整大小的渲染附件容器
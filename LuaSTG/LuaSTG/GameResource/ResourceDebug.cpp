@@ -81,20 +81,33 @@ namespace LuaSTGPlus
 			};
 			auto draw_texture = [](IResourceTexture* p_res, bool show_info, float scale) -> void
 			{
-				auto const size = p_res->GetTexture()->getSize();
+				auto const size = p_res->GetSize();
+				auto const page_size = p_res->GetTexture()->getSize();
+				auto const rc = p_res->GetAtlasRect();
 				if (show_info)
 				{
 					ImGui::Text("Size: %u x %u", size.x, size.y);
 					ImGui::Text("RenderTarget: %s", p_res->IsRenderTarget() ? "Yes" : "Not");
 					ImGui::Text("Dynamic: %s", p_res->IsRenderTarget() ? "Yes" : "Not");
+					if (p_res->IsAtlasTexture())
+					{
+						ImGui::Text("Atlas: (%u, %u) - (%u, %u) on %u x %u page", rc.a.x, rc.a.y, rc.b.x, rc.b.y, page_size.x, page_size.y);
+					}
 					unsigned long long mem_usage = size.x * size.y * 4;
 					ImGui::Text("Adapter Memory Usage (Approximate): %s", bytes_count_to_string(mem_usage).c_str());
 				}
+				ImVec2 uv0(0.0f, 0.0f);
+				ImVec2 uv1(1.0f, 1.0f);
+				if (p_res->IsAtlasTexture())
+				{
+					uv0 = ImVec2((float)rc.a.x / (float)page_size.x, (float)rc.a.y / (float)page_size.y);
+					uv1 = ImVec2((float)rc.b.x / (float)page_size.x, (float)rc.b.y / (float)page_size.y);
+				}
 				ImGui::Image(
 					p_res->GetTexture()->getNativeHandle(),
 					ImVec2(scale * (float)size.x, scale * (float)size.y),
-					ImVec2(0.0f, 0.0f),
-					ImVec2(1.0f, 1.0f),
+					uv0,
+					uv1,
 					ImVec4(1.0f, 1.0f, 1.0f, 1.0f),
 					ImVec4(0.5f, 0.5f, 0.5f, 1.0f));
 			};
@@ -145,8 +158,7 @@ namespace LuaSTGPlus
 						{
 							if (filter.PassFilter(v.second->GetResName().data()))
 							{
-								auto* p_res = v.second->GetTexture();
-								auto const p_tex_size = p_res->getSize();
+								auto const p_tex_size = v.second->GetSize();
 								unsigned long long mem_usage = p_tex_size.x * p_tex_size.y * 4;
 								if (ImGui::TreeNode(*v.second,
 									"%d. %s",
@@ -167,6 +179,42 @@ namespace LuaSTGPlus
 						ImGui::EndTabItem();
 					}
 
+					if (ImGui::BeginTabItem("Texture Atlas"))
+					{
+						auto const& pages = p_pool->m_TextureAtlas.GetPages();
+						ImGui::Text("Atlas Mode: %s", p_pool->GetTextureAtlasEnable() ? "On" : "Off");
+						ImGui::Text("Total Pages: %u", (unsigned int)pages.size());
+						ImGui::Text("Adapter Memory Usage (Approximate): %s",
+							bytes_count_to_string((unsigned long long)pages.size() * ResourceTextureAtlas::page_size * ResourceTextureAtlas::page_size * 4).c_str());
+
+						static ImGuiTextFilter filter;
+						filter.Draw();
+
+						for (size_t page_i = 0; page_i < pages.size(); page_i += 1)
+						{
+							auto const& page = pages[page_i];
+							double const usage = (double)page.used_area / ((double)ResourceTextureAtlas::page_size * (double)ResourceTextureAtlas::page_size);
+							if (ImGui::TreeNode(&page, "Page %u (%u textures, %.1f%% used%s)",
+								(unsigned int)page_i, (unsigned int)page.alive_count, usage * 100.0, page.premul ? ", premultiplied" : ""))
+							{
+								for (auto const& entry : page.entries)
+								{
+									if (entry.alive && filter.PassFilter(entry.name.c_str()))
+									{
+										ImGui::Text("%s: (%u, %u) - (%u, %u) %s", entry.name.c_str(),
+											entry.rect.a.x, entry.rect.a.y, entry.rect.b.x, entry.rect.b.y, entry.path.c_str());
+									}
+								}
+								static float preview_scale = 0.25f;
+								draw_preview_scaling(preview_scale);
+								draw_texture0(page.texture.get(), preview_scale);
+								ImGui::TreePop();
+							}
+						}
+
+						ImGui::EndTabItem();
+					}
+
 					if (ImGui::BeginTabItem("Sprite"))
 					{
 						ImGui::Text("Total Resources: %u", p_pool->m_SpritePool.size());
@@ -5,6 +5,7 @@ namespace LuaSTGPlus
 	ResourceMgr::ResourceMgr()
 		: m_GlobalResourcePool(this, ResourcePoolType::Global)
 		, m_StageResourcePool(this, ResourcePoolType::Stage)
+		, m_TextureLoader(this)
 	{
 	}
 
@@ -120,7 +121,7 @@ namespace LuaSTGPlus
 		Core::ScopeObject<IResourceTexture> tRet = FindTexture(name);
 		if (!tRet)
 			return false;
-		out = tRet->GetTexture()->getSize();
+		out = tRet->GetSize();
 		return true;
 	}
 
@@ -8,6 +8,8 @@
 #include "GameResource/ResourceFont.hpp"
 #include "GameResource/ResourcePostEffectShader.hpp"
 #include "GameResource/ResourceModel.hpp"
+#include "GameResource/ResourceTextureLoader.hpp"
+#include "GameResource/ResourceTextureAtlas.hpp"
 #include "lua.hpp"
 #include "xxhash.h"
 
@@ -27,6 +29,7 @@ namespace LuaSTGPlus
     class ResourcePool
     {
         friend class ResourceMgr;
+        friend class ResourceTextureLoader;
     public:
         struct dictionary_key_t
         {
@@ -86,8 +89,14 @@ namespace LuaSTGPlus
         dictionary_t<Core::ScopeObject<IResourceFont>> m_TTFFontPool;
         dictionary_t<Core::ScopeObject<IResourcePostEffectShader>> m_FXPool;
         dictionary_t<Core::ScopeObject<IResourceModel>> m_ModelPool;
+        ResourceTextureAtlas m_TextureAtlas;
+        bool m_TextureAtlasEnable{ false };
+        bool m_MusicStreamEnable{ true };
     private:
         const char* getResourcePoolTypeName();
+        bool AddTexture(const char* name, const char* path, Core::Graphics::ITexture2D* p_texture) noexcept;
+        // 打包进图集，纹理太大时创建普通纹理
+        bool AddTexture(const char* name, const char* path, Core::Vector2U size, Core::IData* p_pixel, bool mipmaps, bool atlas) noexcept;
     public:
         void Clear() noexcept;
         void RemoveResource(ResourceType t, const char* name) noexcept;
@@ -97,7 +106,12 @@ namespace LuaSTGPlus
         // 纹理
         bool LoadTexture(const char* name, const char* path, bool mipmaps = true) noexcept;
         bool LoadTextureBin(const char* name, std::vector<uint8_t> data, bool mipmaps = true) noexcept;
+        // 在工作线程上读取和解码，之后若干帧内放入资源池，通过 ResourceTextureLoader::GetState 查询
+        bool LoadTextureAsync(const char* name, const char* path, bool mipmaps = true) noexcept;
         bool CreateTexture(const char* name, int width, int height) noexcept;
+        // 开启后，之后从文件加载的小纹理打包进图集，只适合用于创建精灵、动画精灵
+        void SetTextureAtlasEnable(bool enable) noexcept { m_TextureAtlasEnable = enable; }
+        bool GetTextureAtlasEnable() const noexcept { return m_TextureAtlasEnable; }
         // 渲染目标
         bool CreateRenderTarget(const char* name, int width = 0, int height = 0, bool depth_buffer = false) noexcept;
         // 图片精灵
@@ -114,6 +128,9 @@ namespace LuaSTGPlus
             double a, double b, bool rect = false) noexcept;
         // 音乐
         bool LoadMusic(const char* name, const char* path, double start, double end, bool once_decode) noexcept;
+        // 开启时（默认）流式播放的音乐从文件或文件包中按需读取，关闭后和一次性解码一样先把整个文件读入内存
+        void SetMusicStreamEnable(bool enable) noexcept { m_MusicStreamEnable = enable; }
+        bool GetMusicStreamEnable() const noexcept { return m_MusicStreamEnable; }
         // 音效
         bool LoadSoundEffect(const char* name, const char* path) noexcept;
         // 粒子特效(HGE)
@@ -156,6 +173,8 @@ namespace LuaSTGPlus
         ResourcePoolType m_ActivedPool = ResourcePoolType::Global;
         ResourcePool m_GlobalResourcePool;
         ResourcePool m_StageResourcePool;
+        ResourceTextureLoader m_TextureLoader;
+        uint64_t m_ResourceGeneration = 1;
     public:
         ResourcePoolType GetActivedPoolType() noexcept;
         void SetActivedPoolType(ResourcePoolType t) noexcept;
@@ -177,6 +196,10 @@ namespace LuaSTGPlus
         bool GetTextureSize(const char* name, Core::Vector2U& out) noexcept;
         void CacheTTFFontString(const char* name, const char* text, size_t len) noexcept;
         void UpdateSound();
+        ResourceTextureLoader& GetTextureLoader() noexcept { return m_TextureLoader; }
+        // 资源池发生变化（创建、移除、清空）时递增，用于作废按名字查找的缓存
+        uint64_t GetResourceGeneration() const noexcept { return m_ResourceGeneration; }
+        void IncreaseResourceGeneration() noexcept { m_ResourceGeneration += 1; }
     private:
         static bool g_ResourceLoadingLog;
         float m_GlobalImageScaleFactor = 1.0f;
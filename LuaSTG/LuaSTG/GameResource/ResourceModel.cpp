@@ -4,7 +4,8 @@ namespace LuaSTGPlus
 {
     bool Mesh::resize(uint32_t const vertex_count, uint32_t const index_count) noexcept
     {
-        if (vertex_count > 32768 || index_count > 32768)
+        // 超过 65536 个顶点时渲染器会切换到 32 位索引
+        if (vertex_count > 16777216 || index_count > 16777216)
             return false;
         try
         {
@@ -30,7 +31,7 @@ namespace LuaSTGPlus
         uint32_t const c = color.color();
         for (auto& v : vertex_) v.color = c;
     }
-    void Mesh::setIndex(uint32_t const index, Core::Graphics::IRenderer::DrawIndex const value) noexcept
+    void Mesh::setIndex(uint32_t const index, Core::Graphics::IRenderer::DrawIndex32 const value) noexcept
     {
         index_[index] = value;
     }
@@ -62,17 +63,17 @@ namespace LuaSTGPlus
     bool Mesh::draw(Core::Graphics::IRenderer* p_renderer)
     {
         return p_renderer->drawRaw(
-                vertex_.data(), (uint16_t)vertex_.size(),
-                index_.data(), (uint16_t)index_.size());
+                vertex_.data(), (uint32_t)vertex_.size(),
+                index_.data(), (uint32_t)index_.size());
     }
     bool Mesh::draw(Core::Graphics::IRenderer* p_renderer, Core::Graphics::ITexture2D* p_texture)
     {
         float const u_scale = 1.0f / (float)p_texture->getSize().x;
         float const v_scale = 1.0f / (float)p_texture->getSize().y;
         Core::Graphics::IRenderer::DrawVertex* p_vert = nullptr;
-        Core::Graphics::IRenderer::DrawIndex* p_idx = nullptr;
-        uint16_t vert_offset = 0;
-        if (!p_renderer->drawRequest((uint16_t)vertex_.size(), (uint16_t)index_.size(), &p_vert, &p_idx, &vert_offset))
+        Core::Graphics::IRenderer::DrawIndex32* p_idx = nullptr;
+        uint32_t vert_offset = 0;
+        if (!p_renderer->drawRequest((uint32_t)vertex_.size(), (uint32_t)index_.size(), &p_vert, &p_idx, &vert_offset))
             return false;
         for (size_t i = 0; i < vertex_.size(); i += 1)
         {
@@ -45,10 +45,21 @@ namespace LuaSTGPlus
 		float fAlphaVar;        // alpha抖动值
 	};
 
+	// 粒子的当前状态，用于测试逐个计算和批量计算的结果
+	struct ParticleState
+	{
+		Core::Vector2F position;
+		float size;
+		float spin;
+		float color[4]; // rgba
+	};
+
 	struct IParticlePool
 	{
 		virtual hgeParticleSystemInfo& GetParticleSystemInfo() = 0;
 		virtual size_t GetAliveCount() = 0;
+		// index 从 0 开始，超出存活粒子数时返回 false
+		virtual bool GetParticleState(size_t index, ParticleState& state) = 0;
 		virtual BlendMode GetBlendMode() = 0;
 		virtual void SetBlendMode(BlendMode m) = 0;
 		virtual Core::Color4B GetVertexColor() = 0;
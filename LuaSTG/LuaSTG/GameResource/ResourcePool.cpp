@@ -10,6 +10,7 @@
 #include "GameResource/Implement/ResourcePostEffectShaderImpl.hpp"
 #include "GameResource/Implement/ResourceModelImpl.hpp"
 #include "Core/FileManager.hpp"
+#include "Core/FrameProfiler.hpp"
 #include "AppFrame.h"
 #include "LuaBinding/lua_utility.hpp"
 #include <cstdint>
@@ -23,6 +24,8 @@ namespace LuaSTGPlus
 
     void ResourcePool::Clear() noexcept
     {
+        m_pMgr->GetTextureLoader().Cancel(m_iType);
+        m_pMgr->IncreaseResourceGeneration();
         m_TexturePool.clear();
         m_SpritePool.clear();
         m_AnimationPool.clear();
@@ -33,6 +36,7 @@ namespace LuaSTGPlus
         m_TTFFontPool.clear();
         m_FXPool.clear();
         m_ModelPool.clear();
+        m_TextureAtlas.Clear();
         spdlog::info("[luastg] '{}' pools cleared", getResourcePoolTypeName());
     }
 
@@ -66,10 +70,13 @@ namespace LuaSTGPlus
 
     void ResourcePool::RemoveResource(ResourceType t, const char* name) noexcept
     {
+        m_pMgr->IncreaseResourceGeneration();
         switch (t)
         {
         case ResourceType::Texture:
+            m_pMgr->GetTextureLoader().Cancel(m_iType, name);
             removeResource(m_TexturePool, name);
+            m_TextureAtlas.Remove(name);
             break;
         case ResourceType::Sprite:
             removeResource(m_SpritePool, name);
@@ -196,6 +203,7 @@ namespace LuaSTGPlus
 
     bool ResourcePool::LoadTexture(const char* name, const char* path, bool mipmaps) noexcept
     {
+        FrameProfileScopeN("Resource.LoadTexture");
         if (m_TexturePool.find(std::string_view(name)) != m_TexturePool.end())
         {
             if (ResourceMgr::GetResourceLoadingLog())
@@ -205,6 +213,19 @@ namespace LuaSTGPlus
             return true;
         }
     
+        if (m_TextureAtlasEnable)
+        {
+            std::vector<uint8_t> src;
+            Core::Vector2U size;
+            Core::ScopeObject<Core::IData> pixel;
+            if (!GFileManager().loadEx(path, src) || !Core::Graphics::decodeImageFromMemory(src.data(), src.size(), &size, ~pixel))
+            {
+                spdlog::error("[luastg] Failed to create texture '{}' from '{}'", name, path);
+                return false;
+            }
+            return AddTexture(name, path, size, pixel.get(), mipmaps, true);
+        }
+
         Core::ScopeObject<Core::Graphics::ITexture2D> p_texture;
         // spdlog::debug("tex_ptr: {}", (size_t)&p_texture); // 140737488345752 140737488345752
         if (!LAPP.GetAppModel()->getDevice()->createTextureFromFile(path, mipmaps, ~p_texture))
@@ -213,10 +234,24 @@ namespace LuaSTGPlus
             return false;
         }
 
+        return AddTexture(name, path, p_texture.get());
+    }
+
+    bool ResourcePool::AddTexture(const char* name, const char* path, Core::Graphics::ITexture2D* p_texture) noexcept
+    {
+        if (m_TexturePool.find(std::string_view(name)) != m_TexturePool.end())
+        {
+            if (ResourceMgr::GetResourceLoadingLog())
+            {
+                spdlog::warn("[luastg] LoadTexture: Texture '{}' already exists, loading cancelled.", name);
+            }
+            return true;
+        }
+
         try
         {
             Core::ScopeObject<IResourceTexture> tRes;
-            tRes.attach(new ResourceTextureImpl(name, p_texture.get()));
+            tRes.attach(new ResourceTextureImpl(name, p_texture));
             m_TexturePool.emplace(name, tRes);
         }
         catch (std::exception const& e)
@@ -233,8 +268,78 @@ namespace LuaSTGPlus
         return true;
     }
 
+    bool ResourcePool::AddTexture(const char* name, const char* path, Core::Vector2U size, Core::IData* p_pixel, bool mipmaps, bool atlas) noexcept
+    {
+        if (m_TexturePool.find(std::string_view(name)) != m_TexturePool.end())
+        {
+            if (ResourceMgr::GetResourceLoadingLog())
+            {
+                spdlog::warn("[luastg] LoadTexture: Texture '{}' already exists, loading cancelled.", name);
+            }
+            return true;
+        }
+
+        Core::ScopeObject<Core::Graphics::ITexture2D> p_texture;
+        Core::RectU atlas_rect;
+        if (atlas && ResourceTextureAtlas::IsPackable(size))
+        {
+            if (m_TextureAtlas.Add(name, path, size, p_pixel, ~p_texture, &atlas_rect))
+            {
+                try
+                {
+                    Core::ScopeObject<IResourceTexture> tRes;
+                    tRes.attach(new ResourceTextureImpl(name, p_texture.get(), atlas_rect));
+                    m_TexturePool.emplace(name, tRes);
+                }
+                catch (std::exception const& e)
+                {
+                    m_TextureAtlas.Remove(name);
+                    spdlog::error("[luastg] LoadTexture: Failed to load texture '{}' ({})", name, e.what());
+                    return false;
+                }
+                if (ResourceMgr::GetResourceLoadingLog())
+                {
+                    spdlog::info("[luastg] LoadTexture: path '{}', name '{}', packed into atlas at ({}, {}) ({})",
+                        path, name, atlas_rect.a.x, atlas_rect.a.y, getResourcePoolTypeName());
+                }
+                return true;
+            }
+            spdlog::warn("[luastg] LoadTexture: Unable to pack texture '{}' into atlas, creating standalone texture", name);
+        }
+
+        if (!LAPP.GetAppModel()->getDevice()->createTextureFromPixelData(path, size, p_pixel, mipmaps, ~p_texture))
+        {
+            spdlog::error("[luastg] Failed to create texture '{}' from '{}'", name, path);
+            return false;
+        }
+        return AddTexture(name, path, p_texture.get());
+    }
+
+    bool ResourcePool::LoadTextureAsync(const char* name, const char* path, bool mipmaps) noexcept
+    {
+        if (m_TexturePool.find(std::string_view(name)) != m_TexturePool.end())
+        {
+            if (ResourceMgr::GetResourceLoadingLog())
+            {
+                spdlog::warn("[luastg] LoadTextureAsync: Texture '{}' already exists, loading cancelled.", name);
+            }
+            return true;
+        }
+
+        try
+        {
+            return m_pMgr->GetTextureLoader().Push(m_iType, name, path, mipmaps, m_TextureAtlasEnable);
+        }
+        catch (std::exception const& e)
+        {
+            spdlog::error("[luastg] LoadTextureAsync: Failed to load texture '{}' ({})", name, e.what());
+            return false;
+        }
+    }
+
     bool ResourcePool::LoadTextureBin(const char* name, std::vector<uint8_t> data, bool mipmaps) noexcept
     {
+        FrameProfileScopeN("Resource.LoadTextureBin");
         if (m_TexturePool.find(std::string_view(name)) != m_TexturePool.end())
         {
             if (ResourceMgr::GetResourceLoadingLog())
@@ -390,6 +495,13 @@ namespace LuaSTGPlus
             spdlog::error("[luastg] Failed to create image sprite '{}' from texture '{}'", texname, name);
             return false;
         }
+        if (pTex->IsAtlasTexture())
+        {
+            // 纹理坐标换算到图集页上
+            auto const origin = pTex->GetAtlasRect().a;
+            x += (double)origin.x;
+            y += (double)origin.y;
+        }
         p_sprite->setTextureRect(Core::RectF((float)x, (float)y, (float)(x + w), (float)(y + h)));
         p_sprite->setTextureCenter(Core::Vector2F((float)(x + w * 0.5), (float)(y + h * 0.5)));
 
@@ -398,6 +510,7 @@ namespace LuaSTGPlus
             Core::ScopeObject<IResourceSprite> tRes;
             tRes.attach(new ResourceSpriteImpl(name, p_sprite.get(), a, b, rect));
             m_SpritePool.emplace(name, tRes);
+            m_pMgr->IncreaseResourceGeneration();
         }
         catch (std::exception const& e)
         {
@@ -445,6 +558,7 @@ namespace LuaSTGPlus
                     a, b, rect)
             );
             m_AnimationPool.emplace(name, tRes);
+            m_pMgr->IncreaseResourceGeneration();
         }
         catch (std::exception const& e)
         {
@@ -480,6 +594,7 @@ namespace LuaSTGPlus
                 new ResourceAnimationImpl(name, sprite_list, intv, a, b, rect)
             );
             m_AnimationPool.emplace(name, tRes);
+            m_pMgr->IncreaseResourceGeneration();
         }
         catch (std::exception const& e)
         {
@@ -499,6 +614,7 @@ namespace LuaSTGPlus
 
     bool ResourcePool::LoadMusic(const char* name, const char* path, double start, double end, bool once_decode) noexcept
     {
+        FrameProfileScopeN("Resource.LoadMusic");
         if (m_MusicPool.find(std::string_view(name)) != m_MusicPool.end())
         {
             if (ResourceMgr::GetResourceLoadingLog())
@@ -511,9 +627,9 @@ namespace LuaSTGPlus
         using namespace Core;
         using namespace Core::Audio;
 
-        // Create decoder
+        // Create decoder, stream players read the file on demand
         ScopeObject<IDecoder> p_decoder;
-        if (!IDecoder::create(path, ~p_decoder))
+        if (!IDecoder::create(path, !once_decode && m_MusicStreamEnable, ~p_decoder))
         {
             spdlog::error("[luastg] LoadMusic: Cannot decode file '{}', format must be WAV/OGG/MP3/FLAC", path);
             return false;
@@ -591,6 +707,7 @@ namespace LuaSTGPlus
 
     bool ResourcePool::LoadSoundEffect(const char* name, const char* path) noexcept
     {
+        FrameProfileScopeN("Resource.LoadSoundEffect");
         if (m_SoundSpritePool.find(std::string_view(name)) != m_SoundSpritePool.end())
         {
             if (ResourceMgr::GetResourceLoadingLog())
@@ -612,8 +729,9 @@ namespace LuaSTGPlus
         }
 
         // Create audio player
+        IAudioDevice* p_device = LAPP.GetAppModel()->getAudioDevice();
         ScopeObject<IAudioPlayer> p_player;
-        if (!LAPP.GetAppModel()->getAudioDevice()->createAudioPlayer(p_decoder.get(), ~p_player))
+        if (!p_device->createAudioPlayer(p_decoder.get(), ~p_player))
         {
             spdlog::error("[luastg] LoadSoundEffect: Unable to create audiio player");
             return false;
@@ -622,7 +740,7 @@ namespace LuaSTGPlus
         try
         {
             Core::ScopeObject<IResourceSoundEffect> tRes;
-            tRes.attach(new ResourceSoundEffectImpl(name, p_player.get()));
+            tRes.attach(new ResourceSoundEffectImpl(name, p_device, p_player.get()));
             m_SoundSpritePool.emplace(name, tRes);
         }
         catch (std::exception const& e)
@@ -644,6 +762,7 @@ namespace LuaSTGPlus
     bool ResourcePool::LoadParticle(const char* name, const hgeParticleSystemInfo& info, const char* img_name,
                                     double a,double b, bool rect, bool _nolog) noexcept
     {
+        FrameProfileScopeN("Resource.LoadParticle");
         if (m_ParticlePool.find(std::string_view(name)) != m_ParticlePool.end())
         {
             if (ResourceMgr::GetResourceLoadingLog())
@@ -690,6 +809,7 @@ namespace LuaSTGPlus
     bool ResourcePool::LoadParticle(const char* name, const char* path, const char* img_name,
                                     double a, double b,bool rect) noexcept
     {
+        FrameProfileScopeN("Resource.LoadParticle");
         std::vector<uint8_t> src;
         if (!GFileManager().loadEx(path, src))
         {
@@ -722,6 +842,7 @@ namespace LuaSTGPlus
 
     bool ResourcePool::LoadSpriteFont(const char* name, const char* path, bool mipmaps) noexcept
     {
+        FrameProfileScopeN("Resource.LoadSpriteFont");
         if (m_SpriteFontPool.find(std::string_view(name)) != m_SpriteFontPool.end())
         {
             if (ResourceMgr::GetResourceLoadingLog())
@@ -756,6 +877,7 @@ namespace LuaSTGPlus
 
     bool ResourcePool::LoadSpriteFont(const char* name, const char* path, const char* tex_path, bool mipmaps) noexcept
     {
+        FrameProfileScopeN("Resource.LoadSpriteFont");
         if (m_SpriteFontPool.find(std::string_view(name)) != m_SpriteFontPool.end())
         {
             if (ResourceMgr::GetResourceLoadingLog())
@@ -790,6 +912,7 @@ namespace LuaSTGPlus
 
     bool ResourcePool::LoadTTFFont(const char* name, const char* path, float width, float height) noexcept
     {
+        FrameProfileScopeN("Resource.LoadTTFFont");
         if (m_TTFFontPool.find(std::string_view(name)) != m_TTFFontPool.end())
         {
             if (ResourceMgr::GetResourceLoadingLog())
@@ -836,6 +959,7 @@ namespace LuaSTGPlus
 
     bool ResourcePool::LoadTrueTypeFont(const char* name, Core::Graphics::TrueTypeFontInfo* fonts, size_t count) noexcept
     {
+        FrameProfileScopeN("Resource.LoadTrueTypeFont");
         if (m_TTFFontPool.find(std::string_view(name)) != m_TTFFontPool.end())
         {
             if (ResourceMgr::GetResourceLoadingLog())
@@ -877,6 +1001,7 @@ namespace LuaSTGPlus
 
     bool ResourcePool::LoadFX(const char* name, const char* path) noexcept
     {
+        FrameProfileScopeN("Resource.LoadFX");
         if (m_FXPool.find(std::string_view(name)) != m_FXPool.end())
         {
             if (ResourceMgr::GetResourceLoadingLog())
@@ -915,6 +1040,7 @@ namespace LuaSTGPlus
 
     bool ResourcePool::LoadModel(const char* name, const char* path) noexcept
     {
+        FrameProfileScopeN("Resource.LoadModel");
         if (m_ModelPool.find(std::string_view(name)) != m_ModelPool.end())
         {
             if (ResourceMgr::GetResourceLoadingLog())
@@ -3,6 +3,20 @@
 
 namespace LuaSTGPlus
 {
+	// 声部用完时抢占哪一个
+	enum class SoundEffectStealPolicy
+	{
+		Oldest,   // 最早开始播放的
+		Quietest, // 音量最低的，音量相同时取最早开始播放的
+	};
+
+	struct SoundEffectVoiceConfig
+	{
+		uint32_t max_voices = 1;          // 同时播放的声部数量上限，为 1 时重新播放会打断正在播放的声音
+		uint32_t max_plays_per_frame = 1; // 每帧最多开始播放的次数，超出的请求合并到最后一次（取最大音量）
+		SoundEffectStealPolicy steal = SoundEffectStealPolicy::Oldest;
+	};
+
 	struct IResourceSoundEffect : public IResourceBase
 	{
 		virtual void FlushCommand() = 0;
@@ -14,5 +28,10 @@ namespace LuaSTGPlus
 		virtual bool IsStopped() = 0;
 		virtual bool SetSpeed(float speed) = 0;
 		virtual float GetSpeed() = 0;
+		// 所有声部共享同一份解码后的数据
+		virtual void SetVoiceConfig(SoundEffectVoiceConfig const& config) = 0;
+		virtual SoundEffectVoiceConfig GetVoiceConfig() = 0;
+		virtual uint32_t GetVoiceCount() = 0;
+		virtual uint32_t GetActiveVoiceCount() = 0;
 	};
 }
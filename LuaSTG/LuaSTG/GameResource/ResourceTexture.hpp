@@ -12,5 +12,11 @@ namespace LuaSTGPlus
 		virtual Core::Graphics::IRenderTarget* GetRenderTarget() = 0;
 		virtual bool IsRenderTarget() = 0;
 		virtual bool HasDepthStencilBuffer() = 0;
+
+		// 打包进图集的纹理，GetTexture 返回图集页，纹理在页上的区域由 GetAtlasRect 给出
+		virtual bool IsAtlasTexture() = 0;
+		virtual Core::RectU GetAtlasRect() = 0;
+		// 纹理本身的大小，图集纹理不是图集页的大小
+		virtual Core::Vector2U GetSize() = 0;
 	};
 };
@@ -0,0 +1,277 @@
+#include "GameResource/ResourceTextureAtlas.hpp"
+#include "Core/FileManager.hpp"
+#include "Core/FrameProfiler.hpp"
+#include "AppFrame.h"
+#include <algorithm>
+#include <cstring>
+
+namespace LuaSTGPlus
+{
+    bool ResourceTextureAtlas::FitSkyline(Page const& page, size_t index, uint32_t width, uint32_t height, uint32_t* p_y)
+    {
+        uint32_t const x = page.skyline[index].x;
+        if (x + width > page_size)
+        {
+            return false;
+        }
+        uint32_t width_left = width;
+        uint32_t y = page.skyline[index].y;
+        for (size_t i = index; i < page.skyline.size(); i += 1)
+        {
+            y = std::max(y, page.skyline[i].y);
+            if (y + height > page_size)
+            {
+                return false;
+            }
+            if (page.skyline[i].width >= width_left)
+            {
+                *p_y = y;
+                return true;
+            }
+            width_left -= page.skyline[i].width;
+        }
+        return false;
+    }
+    bool ResourceTextureAtlas::FindPosition(Page const& page, uint32_t width, uint32_t height, size_t* p_index, uint32_t* p_x, uint32_t* p_y)
+    {
+        // 取放置后顶部最低的位置，相同时取较窄的节点，减少浪费
+        bool found = false;
+        uint32_t best_top = UINT32_MAX;
+        uint32_t best_width = UINT32_MAX;
+        for (size_t i = 0; i < page.skyline.size(); i += 1)
+        {
+            uint32_t y = 0;
+            if (!FitSkyline(page, i, width, height, &y))
+            {
+                continue;
+            }
+            uint32_t const top = y + height;
+            if (top < best_top || (top == best_top && page.skyline[i].width < best_width))
+            {
+                found = true;
+                best_top = top;
+                best_width = page.skyline[i].width;
+                *p_index = i;
+                *p_x = page.skyline[i].x;
+                *p_y = y;
+            }
+        }
+        return found;
+    }
+    void ResourceTextureAtlas::AddSkylineLevel(Page& page, size_t index, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+    {
+        auto& skyline = page.skyline;
+        skyline.insert(skyline.begin() + (ptrdiff_t)index, SkylineNode{ x, y + height, width });
+        // 新节点覆盖了右侧的节点，裁剪或者移除它们
+        for (size_t i = index + 1; i < skyline.size();)
+        {
+            SkylineNode const& prev = skyline[i - 1];
+            uint32_t const prev_right = prev.x + prev.width;
+            if (skyline[i].x >= prev_right)
+            {
+                break;
+            }
+            uint32_t const shrink = prev_right - skyline[i].x;
+            if (skyline[i].width <= shrink)
+            {
+                skyline.erase(skyline.begin() + (ptrdiff_t)i);
+                continue;
+            }
+            skyline[i].x += shrink;
+            skyline[i].width -= shrink;
+            break;
+        }
+        // 合并高度相同的相邻节点
+        for (size_t i = 0; i + 1 < skyline.size();)
+        {
+            if (skyline[i].y == skyline[i + 1].y)
+            {
+                skyline[i].width += skyline[i + 1].width;
+                skyline.erase(skyline.begin() + (ptrdiff_t)(i + 1));
+            }
+            else
+            {
+                i += 1;
+            }
+        }
+    }
+    bool ResourceTextureAtlas::Upload(Page& page, Core::RectU rect, Core::Vector2U size, uint8_t const* pixel)
+    {
+        // 复制边缘像素到填充区域
+        uint32_t const w = size.x + padding * 2;
+        uint32_t const h = size.y + padding * 2;
+        std::vector<uint8_t> buffer((size_t)w * (size_t)h * 4);
+        for (uint32_t y = 0; y < h; y += 1)
+        {
+            uint32_t const sy = (uint32_t)std::clamp<int64_t>((int64_t)y - padding, 0, (int64_t)size.y - 1);
+            uint8_t const* src = pixel + (size_t)sy * size.x * 4;
+            uint8_t* dst = buffer.data() + (size_t)y * w * 4;
+            std::memcpy(dst + padding * 4, src, (size_t)size.x * 4);
+            for (uint32_t i = 0; i < padding; i += 1)
+            {
+                std::memcpy(dst + i * 4, src, 4);
+                std::memcpy(dst + (padding + size.x + i) * 4, src + (size_t)(size.x - 1) * 4, 4);
+            }
+        }
+        if (page.premul)
+        {
+            for (size_t i = 0; i < buffer.size(); i += 4)
+            {
+                uint32_t const a = buffer[i + 3];
+                buffer[i + 0] = (uint8_t)((buffer[i + 0] * a + 127) / 255);
+                buffer[i + 1] = (uint8_t)((buffer[i + 1] * a + 127) / 255);
+                buffer[i + 2] = (uint8_t)((buffer[i + 2] * a + 127) / 255);
+            }
+        }
+        Core::RectU const padded(rect.a.x - padding, rect.a.y - padding, rect.b.x + padding, rect.b.y + padding);
+        return page.texture->uploadPixelData(padded, buffer.data(), w * 4);
+    }
+    bool ResourceTextureAtlas::CreatePage(bool premul)
+    {
+        auto* device = LAPP.GetAppModel()->getDevice();
+        Page page;
+        if (!device->createTexture(Core::Vector2U(page_size, page_size), ~page.texture))
+        {
+            spdlog::error("[luastg] ResourceTextureAtlas: Failed to create atlas page ({}x{})", page_size, page_size);
+            return false;
+        }
+        page.texture->setPremultipliedAlpha(premul);
+        // 新建的纹理内容未定义，分块清零
+        uint32_t const strip = 256;
+        std::vector<uint8_t> zero((size_t)page_size * strip * 4, 0);
+        for (uint32_t y = 0; y < page_size; y += strip)
+        {
+            page.texture->uploadPixelData(Core::RectU(0, y, page_size, y + strip), zero.data(), page_size * 4);
+        }
+        page.skyline.push_back(SkylineNode{ 0, 0, page_size });
+        page.premul = premul;
+        m_Pages.emplace_back(std::move(page));
+        // 重新注册，保证设备重建时在所有图集页之后回调
+        device->addEventListener(this);
+        m_Listening = true;
+        return true;
+    }
+
+    bool ResourceTextureAtlas::IsPackable(Core::Vector2U size) noexcept
+    {
+        return size.x > 0 && size.y > 0 && size.x <= max_image_size && size.y <= max_image_size;
+    }
+    bool ResourceTextureAtlas::Add(std::string_view name, std::string_view path, Core::Vector2U size, Core::IData* p_pixel,
+        Core::Graphics::ITexture2D** pp_page, Core::RectU* p_rect)
+    {
+        if (!IsPackable(size) || p_pixel == nullptr || p_pixel->size() < (size_t)size.x * (size_t)size.y * 4)
+        {
+            return false;
+        }
+        FrameProfileScopeN("Resource.PackTextureAtlas");
+        bool const premul = LAPP.GetAppModel()->getDevice()->getPremultiplyTextureOnLoad();
+        uint32_t const w = size.x + padding * 2;
+        uint32_t const h = size.y + padding * 2;
+
+        Page* target = nullptr;
+        size_t index = 0;
+        uint32_t x = 0, y = 0;
+        for (auto& page : m_Pages)
+        {
+            if (page.premul == premul && FindPosition(page, w, h, &index, &x, &y))
+            {
+                target = &page;
+                break;
+            }
+        }
+        if (!target)
+        {
+            if (!CreatePage(premul))
+            {
+                return false;
+            }
+            target = &m_Pages.back();
+            if (!FindPosition(*target, w, h, &index, &x, &y))
+            {
+                return false;
+            }
+        }
+
+        Core::RectU const rect(x + padding, y + padding, x + padding + size.x, y + padding + size.y);
+        if (!Upload(*target, rect, size, static_cast<uint8_t const*>(p_pixel->data())))
+        {
+            return false;
+        }
+        AddSkylineLevel(*target, index, x, y, w, h);
+        target->entries.push_back(Entry{ std::string(name), std::string(path), rect, true });
+        target->used_area += (uint64_t)w * (uint64_t)h;
+        target->alive_count += 1;
+
+        target->texture->retain();
+        *pp_page = target->texture.get();
+        *p_rect = rect;
+        return true;
+    }
+    void ResourceTextureAtlas::Remove(std::string_view name)
+    {
+        for (auto it = m_Pages.begin(); it != m_Pages.end(); it++)
+        {
+            for (auto& entry : it->entries)
+            {
+                if (entry.alive && entry.name == name)
+                {
+                    entry.alive = false;
+                    it->alive_count -= 1;
+                    if (it->alive_count == 0)
+                    {
+                        // 还在使用这一页的精灵持有纹理的引用
+                        m_Pages.erase(it);
+                    }
+                    if (m_Pages.empty())
+                    {
+                        Clear();
+                    }
+                    return;
+                }
+            }
+        }
+    }
+    void ResourceTextureAtlas::Clear()
+    {
+        m_Pages.clear();
+        if (m_Listening)
+        {
+            LAPP.GetAppModel()->getDevice()->removeEventListener(this);
+            m_Listening = false;
+        }
+    }
+
+    void ResourceTextureAtlas::onDeviceCreate()
+    {
+        // 图集页已经重新创建，内容需要重新加载
+        for (auto& page : m_Pages)
+        {
+            for (auto& entry : page.entries)
+            {
+                if (!entry.alive || entry.path.empty())
+                {
+                    continue;
+                }
+                std::vector<uint8_t> src;
+                Core::Vector2U size;
+                Core::ScopeObject<Core::IData> pixel;
+                if (!GFileManager().loadEx(entry.path, src)
+                    || !Core::Graphics::decodeImageFromMemory(src.data(), src.size(), &size, ~pixel)
+                    || size.x != entry.rect.width() || size.y != entry.rect.height()
+                    || !Upload(page, entry.rect, size, static_cast<uint8_t const*>(pixel->data())))
+                {
+                    spdlog::error("[luastg] ResourceTextureAtlas: Failed to reload texture '{}' from '{}'", entry.name, entry.path);
+                }
+            }
+        }
+    }
+    void ResourceTextureAtlas::onDeviceDestroy()
+    {
+    }
+
+    ResourceTextureAtlas::~ResourceTextureAtlas()
+    {
+        // 正常退出时资源池已经清空
+        m_Pages.clear();
+    }
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include "Core/Type.hpp"
+#include "Core/Graphics/Device.hpp"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace LuaSTGPlus
+{
+    // 运行时纹理图集
+    // 小纹理在加载时用 skyline 算法打包进共享的图集页，使用同一页的精灵可以合批绘制
+    class ResourceTextureAtlas : public Core::Graphics::IDeviceEventListener
+    {
+    public:
+        static constexpr uint32_t page_size = 4096;
+        // 宽或高超过这个值的纹理不打包
+        static constexpr uint32_t max_image_size = 1024;
+        // 每张纹理四周各向外复制 1 像素边缘，避免线性过滤采样到相邻纹理
+        static constexpr uint32_t padding = 1;
+
+        struct Entry
+        {
+            std::string name;
+            std::string path;      // 设备重建时重新加载
+            Core::RectU rect;      // 纹理在图集页上的区域，不包括填充
+            bool alive{ true };
+        };
+        struct SkylineNode
+        {
+            uint32_t x{ 0 };
+            uint32_t y{ 0 };
+            uint32_t width{ 0 };
+        };
+        struct Page
+        {
+            Core::ScopeObject<Core::Graphics::ITexture2D> texture;
+            std::vector<SkylineNode> skyline;
+            std::vector<Entry> entries;
+            uint64_t used_area{ 0 };
+            size_t alive_count{ 0 };
+            bool premul{ false };
+        };
+    private:
+        std::vector<Page> m_Pages;
+        bool m_Listening{ false };
+    private:
+        static bool FitSkyline(Page const& page, size_t index, uint32_t width, uint32_t height, uint32_t* p_y);
+        static bool FindPosition(Page const& page, uint32_t width, uint32_t height, size_t* p_index, uint32_t* p_x, uint32_t* p_y);
+        static void AddSkylineLevel(Page& page, size_t index, uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+        static bool Upload(Page& page, Core::RectU rect, Core::Vector2U size, uint8_t const* pixel);
+        bool CreatePage(bool premul);
+    public:
+        // 纹理是否应该打包进图集
+        static bool IsPackable(Core::Vector2U size) noexcept;
+        // 将 RGBA8 像素数据打包进图集，成功时返回图集页和纹理在页上的区域
+        bool Add(std::string_view name, std::string_view path, Core::Vector2U size, Core::IData* p_pixel,
+            Core::Graphics::ITexture2D** pp_page, Core::RectU* p_rect);
+        // 纹理资源被移除后调用，页上的空间不回收，整页都不再使用时释放这一页
+        void Remove(std::string_view name);
+        void Clear();
+        std::vector<Page> const& GetPages() const noexcept { return m_Pages; }
+    public:
+        void onDeviceCreate();
+        void onDeviceDestroy();
+    public:
+        ResourceTextureAtlas() = default;
+        ResourceTextureAtlas(ResourceTextureAtlas const&) = delete;
+        ResourceTextureAtlas& operator=(ResourceTextureAtlas const&) = delete;
+        ~ResourceTextureAtlas();
+    };
+}
@@ -0,0 +1,212 @@
+#include "GameResource/ResourceTextureLoader.hpp"
+#include "GameResource/ResourceManager.h"
+#include "Core/FileManager.hpp"
+#include "Core/FrameProfiler.hpp"
+#include "AppFrame.h"
+#include <algorithm>
+
+namespace LuaSTGPlus
+{
+    void ResourceTextureLoader::WorkerMain()
+    {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        while (true)
+        {
+            m_Wake.wait(lock, [this]() { return m_Stop || !m_Queue.empty(); });
+            if (m_Stop)
+            {
+                return;
+            }
+            Request request(std::move(m_Queue.front()));
+            m_Queue.pop_front();
+            lock.unlock();
+
+            // 文件读取和解码都不访问图形设备和 lua
+            std::vector<uint8_t> src;
+            if (GFileManager().loadEx(request.path, src))
+            {
+                request.decoded = Core::Graphics::decodeImageFromMemory(src.data(), src.size(), &request.size, ~request.pixel);
+            }
+            src = std::vector<uint8_t>();
+
+            lock.lock();
+            m_Decoded.emplace_back(std::move(request));
+        }
+    }
+    void ResourceTextureLoader::StartWorkers()
+    {
+        if (!m_Workers.empty())
+        {
+            return;
+        }
+        // 主线程还要跑游戏逻辑和渲染，留一个核心给它
+        size_t const n = std::clamp<size_t>(std::thread::hardware_concurrency(), 2, 5) - 1;
+        for (size_t i = 0; i < n; i += 1)
+        {
+            m_Workers.emplace_back(&ResourceTextureLoader::WorkerMain, this);
+        }
+    }
+
+    bool ResourceTextureLoader::Push(ResourcePoolType pool, std::string_view name, std::string_view path, bool mipmap, bool atlas)
+    {
+        Entry& entry = m_State[Key((int)pool, std::string(name))];
+        if (entry.state == State::Pending)
+        {
+            return true;
+        }
+        m_Serial += 1;
+        entry.state = State::Pending;
+        entry.serial = m_Serial;
+        m_PendingCount += 1;
+
+        Request request;
+        request.pool = pool;
+        request.serial = m_Serial;
+        request.name = name;
+        request.path = path;
+        request.mipmap = mipmap;
+        request.atlas = atlas;
+        StartWorkers();
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Queue.emplace_back(std::move(request));
+        }
+        m_Wake.notify_one();
+        return true;
+    }
+    void ResourceTextureLoader::Update()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            if (m_Decoded.empty())
+            {
+                return;
+            }
+        }
+        FrameProfileScopeN("Resource.UploadTexture");
+        size_t uploaded = 0;
+        while (true)
+        {
+            Request request;
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                if (m_Decoded.empty())
+                {
+                    break;
+                }
+                size_t const size = m_Decoded.front().pixel ? m_Decoded.front().pixel->size() : 0;
+                if (uploaded > 0 && uploaded + size > m_UploadBudget)
+                {
+                    break;
+                }
+                request = std::move(m_Decoded.front());
+                m_Decoded.pop_front();
+            }
+
+            auto it = m_State.find(Key((int)request.pool, request.name));
+            if (it == m_State.end() || it->second.state != State::Pending || it->second.serial != request.serial)
+            {
+                continue; // 已经作废
+            }
+            m_PendingCount -= 1;
+
+            ResourcePool* pool = m_pMgr->GetResourcePool(request.pool);
+            Core::ScopeObject<Core::Graphics::ITexture2D> p_texture;
+            if (!request.decoded)
+            {
+                spdlog::error("[luastg] LoadTextureAsync: Failed to load or decode texture '{}' from '{}'", request.name, request.path);
+                it->second.state = State::Failed;
+                continue;
+            }
+            uploaded += request.pixel->size();
+            if (request.atlas)
+            {
+                if (!pool || !pool->AddTexture(request.name.c_str(), request.path.c_str(), request.size, request.pixel.get(), request.mipmap, true))
+                {
+                    it->second.state = State::Failed;
+                    continue;
+                }
+                m_State.erase(it);
+                continue;
+            }
+            if (!LAPP.GetAppModel()->getDevice()->createTextureFromPixelData(request.path, request.size, request.pixel.get(), request.mipmap, ~p_texture))
+            {
+                spdlog::error("[luastg] LoadTextureAsync: Failed to create texture '{}' from '{}'", request.name, request.path);
+                it->second.state = State::Failed;
+                continue;
+            }
+            request.pixel.reset();
+            if (!pool || !pool->AddTexture(request.name.c_str(), request.path.c_str(), p_texture.get()))
+            {
+                it->second.state = State::Failed;
+                continue;
+            }
+            m_State.erase(it);
+        }
+        if (uploaded > 0)
+        {
+            Core::FrameProfiler::get().addCounter("Resource.UploadTextureBytes", (int64_t)uploaded);
+        }
+    }
+    void ResourceTextureLoader::Cancel(ResourcePoolType pool)
+    {
+        for (auto it = m_State.begin(); it != m_State.end();)
+        {
+            if (it->first.first == (int)pool)
+            {
+                if (it->second.state == State::Pending)
+                {
+                    m_PendingCount -= 1;
+                }
+                it = m_State.erase(it);
+            }
+            else
+            {
+                it++;
+            }
+        }
+    }
+    void ResourceTextureLoader::Cancel(ResourcePoolType pool, std::string_view name)
+    {
+        auto it = m_State.find(Key((int)pool, std::string(name)));
+        if (it != m_State.end())
+        {
+            if (it->second.state == State::Pending)
+            {
+                m_PendingCount -= 1;
+            }
+            m_State.erase(it);
+        }
+    }
+    ResourceTextureLoader::State ResourceTextureLoader::GetState(ResourcePoolType pool, std::string_view name)
+    {
+        auto it = m_State.find(Key((int)pool, std::string(name)));
+        if (it != m_State.end())
+        {
+            return it->second.state;
+        }
+        ResourcePool* p = m_pMgr->GetResourcePool(pool);
+        if (p && p->CheckResourceExists(ResourceType::Texture, name))
+        {
+            return State::Loaded;
+        }
+        return State::None;
+    }
+
+    ResourceTextureLoader::ResourceTextureLoader(ResourceMgr* mgr)
+        : m_pMgr(mgr)
+    {
+    }
+    ResourceTextureLoader::~ResourceTextureLoader()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Stop = true;
+        }
+        m_Wake.notify_all();
+        for (auto& t : m_Workers)
+        {
+            t.join();
+        }
+    }
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include "Core/Type.hpp"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+namespace LuaSTGPlus
+{
+    enum class ResourcePoolType;
+    class ResourceMgr;
+
+    // 异步纹理加载器
+    // 文件读取和图片解码在工作线程上完成，主线程每帧在上传预算内创建纹理并放入资源池
+    class ResourceTextureLoader
+    {
+    public:
+        enum class State
+        {
+            None,       // 没有请求，或者已经被取消
+            Pending,    // 正在读取、解码或者等待上传
+            Loaded,     // 已经放入资源池
+            Failed,     // 读取、解码或者创建纹理失败
+        };
+    private:
+        struct Request
+        {
+            ResourcePoolType pool{};
+            uint64_t serial{ 0 };
+            std::string name;
+            std::string path;
+            bool mipmap{ true };
+            bool atlas{ false };
+            bool decoded{ false };
+            Core::Vector2U size;
+            Core::ScopeObject<Core::IData> pixel;
+        };
+        struct Entry
+        {
+            State state{ State::None };
+            uint64_t serial{ 0 };
+        };
+        using Key = std::pair<int, std::string>;
+    private:
+        ResourceMgr* m_pMgr;
+        std::vector<std::thread> m_Workers;
+        std::mutex m_Mutex;
+        std::condition_variable m_Wake;
+        std::deque<Request> m_Queue;      // 等待工作线程处理
+        std::deque<Request> m_Decoded;    // 等待主线程上传
+        bool m_Stop{ false };
+        // 以下只在主线程访问
+        std::map<Key, Entry> m_State;     // 只记录 Pending 和 Failed，Loaded 由资源池判断
+        uint64_t m_Serial{ 0 };           // 解码结果的序号和记录不一致时说明请求已经作废
+        size_t m_PendingCount{ 0 };
+        size_t m_UploadBudget{ 8 * 1024 * 1024 };
+    private:
+        void WorkerMain();
+        void StartWorkers();
+    public:
+        // 提交请求，同一个资源池内同名的请求正在处理时忽略
+        bool Push(ResourcePoolType pool, std::string_view name, std::string_view path, bool mipmap, bool atlas = false);
+        // 在主线程每帧调用一次，上传已经解码完成的纹理，每帧至少上传一张，之后直到用完字节预算
+        void Update();
+        // 作废指定资源池的全部请求
+        void Cancel(ResourcePoolType pool);
+        // 作废同名的请求或清除失败记录
+        void Cancel(ResourcePoolType pool, std::string_view name);
+        State GetState(ResourcePoolType pool, std::string_view name);
+        size_t GetPendingCount() const noexcept { return m_PendingCount; }
+        void SetUploadBudget(size_t bytes) noexcept { m_UploadBudget = bytes; }
+        size_t GetUploadBudget() const noexcept { return m_UploadBudget; }
+    public:
+        explicit ResourceTextureLoader(ResourceMgr* mgr);
+        ResourceTextureLoader(ResourceTextureLoader const&) = delete;
+        ResourceTextureLoader& operator=(ResourceTextureLoader const&) = delete;
+        ~ResourceTextureLoader();
+    };
+}
@@ -69,7 +69,7 @@ namespace LuaSTGPlus::LuaWrapper
             {
                 Mesh* self = Cast(L, 1);
                 uint32_t const index = luaL_checki_uint32(L, 2);
-                Core::Graphics::IRenderer::DrawIndex const value = (Core::Graphics::IRenderer::DrawIndex)luaL_checkinteger(L, 3);
+                Core::Graphics::IRenderer::DrawIndex32 const value = (Core::Graphics::IRenderer::DrawIndex32)luaL_checkinteger(L, 3);
                 self->setIndex(index, value);
                 return 0;
             }
@@ -1,6 +1,7 @@
 #include "LuaBinding/LuaWrapper.hpp"
 #include "LuaBinding/lua_utility.hpp"
 #include "AppFrame.h"
+#include "Core/Audio/Decoder.hpp"
 #include "lauxlib.h"
 #include "lua.h"
 #include <cassert>
@@ -134,6 +135,44 @@ void LuaSTGPlus::LuaWrapper::AudioWrapper::Register(lua_State* L)noexcept
             lua_pushnumber(L, p->GetSpeed());
             return 1;
         }
+        static int SetSEVoice(lua_State* L)
+        {
+            const char* s = luaL_checkstring(L, 1);
+            Core::ScopeObject<IResourceSoundEffect> p = LRES.FindSound(s);
+            if (!p)
+                return luaL_error(L, "sound '%s' not found.", s);
+            SoundEffectVoiceConfig config = p->GetVoiceConfig();
+            lua_Integer const max_voices = luaL_checkinteger(L, 2);
+            luaL_argcheck(L, max_voices >= 1, 2, "at least 1 voice");
+            config.max_voices = (uint32_t)max_voices;
+            if (!lua_isnoneornil(L, 3))
+            {
+                static char const* const policy[] = { "oldest", "quietest", NULL };
+                config.steal = (SoundEffectStealPolicy)luaL_checkoption(L, 3, NULL, policy);
+            }
+            if (!lua_isnoneornil(L, 4))
+            {
+                lua_Integer const max_plays = luaL_checkinteger(L, 4);
+                luaL_argcheck(L, max_plays >= 1, 4, "at least 1 play per frame");
+                config.max_plays_per_frame = (uint32_t)max_plays;
+            }
+            p->SetVoiceConfig(config);
+            return 0;
+        }
+        static int GetSEVoice(lua_State* L)
+        {
+            const char* s = luaL_checkstring(L, 1);
+            Core::ScopeObject<IResourceSoundEffect> p = LRES.FindSound(s);
+            if (!p)
+                return luaL_error(L, "sound '%s' not found.", s);
+            SoundEffectVoiceConfig const config = p->GetVoiceConfig();
+            lua_pushinteger(L, (lua_Integer)config.max_voices);
+            lua_pushstring(L, config.steal == SoundEffectStealPolicy::Quietest ? "quietest" : "oldest");
+            lua_pushinteger(L, (lua_Integer)config.max_plays_per_frame);
+            lua_pushinteger(L, (lua_Integer)p->GetActiveVoiceCount());
+            lua_pushinteger(L, (lua_Integer)p->GetVoiceCount());
+            return 5;
+        }
         static int UpdateSound(lua_State*)noexcept
         {
             // Removed method
@@ -338,6 +377,16 @@ void LuaSTGPlus::LuaWrapper::AudioWrapper::Register(lua_State* L)noexcept
             lua_pushnumber(L, p->GetTotalTime());
             return 1;
         }
+        static int GetAudioSourceMemory(lua_State* L) {
+            // 解码器为源文件占用的内存：整个文件，或者流式读取的缓冲区；参数为 true 时统计完之后重置峰值
+            size_t current = 0, peak = 0;
+            Core::Audio::IDecoder::getSourceMemoryUsage(&current, &peak);
+            if (lua_toboolean(L, 1))
+                Core::Audio::IDecoder::resetSourceMemoryPeak();
+            lua_pushinteger(L, (lua_Integer)current);
+            lua_pushinteger(L, (lua_Integer)peak);
+            return 2;
+        }
     };
 
     luaL_Reg const lib[] = {
@@ -354,6 +403,8 @@ void LuaSTGPlus::LuaWrapper::AudioWrapper::Register(lua_State* L)noexcept
         { "GetSEVolume", &Wrapper::GetSEVolume },
         { "SetSESpeed", &Wrapper::SetSESpeed },
         { "GetSESpeed", &Wrapper::GetSESpeed },
+        { "SetSEVoice", &Wrapper::SetSEVoice },
+        { "GetSEVoice", &Wrapper::GetSEVoice },
         { "UpdateSound", &Wrapper::UpdateSound },
 
         { "PlayMusic", &Wrapper::PlayMusic },
@@ -373,6 +424,7 @@ void LuaSTGPlus::LuaWrapper::AudioWrapper::Register(lua_State* L)noexcept
         { "SetBGMTime", &Wrapper::SetBGMTime },
         { "GetBGMTime", &Wrapper::GetBGMTime },
         { "GetBGMTotalTime", &Wrapper::GetBGMTotalTime },
+        { "GetAudioSourceMemory", &Wrapper::GetAudioSourceMemory },
         { NULL, NULL },
     };
 
@@ -174,9 +174,9 @@ namespace LuaSTGPlus
                     if (lua_istable(L, 3)) {
                         auto const* obj = LPOOL.CastGameObject(L, 3);
                         bool const r = p->handle->CollisionCheckW(
-                            (float)obj->x,
-                            (float)obj->y,
-                            (float)obj->rot,
+                            (float)obj->x(),
+                            (float)obj->y(),
+                            (float)obj->rot(),
                             (float)obj->a,
                             (float)obj->b,
                             obj->rect,
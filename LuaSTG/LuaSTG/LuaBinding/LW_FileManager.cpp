@@ -114,6 +114,16 @@ void LuaSTGPlus::FileManagerWrapper::Register(lua_State* L)noexcept
             }
             return 1;
         }
+        static int SetArchiveIndex(lua_State* L)
+        {
+            GFileManager().setArchiveIndexEnable(lua_toboolean(L, 1));
+            return 0;
+        }
+        static int GetArchiveIndex(lua_State* L)
+        {
+            lua_pushboolean(L, GFileManager().getArchiveIndexEnable());
+            return 1;
+        }
         static int EnumArchives(lua_State* L)
         {
             size_t const count = GFileManager().getFileArchiveCount();
@@ -537,6 +547,8 @@ void LuaSTGPlus::FileManagerWrapper::Register(lua_State* L)noexcept
         { "UnloadAllArchive", &Wrapper::UnloadAllArchive },
         { "ArchiveExist", &Wrapper::ArchiveExist },
         { "GetArchive", &Wrapper::GetArchive },
+        { "SetArchiveIndex", &Wrapper::SetArchiveIndex },
+        { "GetArchiveIndex", &Wrapper::GetArchiveIndex },
 
         { "EnumArchives", &Wrapper::EnumArchives },
         { "EnumFiles", &Wrapper::EnumFiles },
@@ -30,6 +30,17 @@ void LuaSTGPlus::LuaWrapper::GameObjectManagerWrapper::Register(lua_State* L) no
 			LPOOL.DoRender();
 			return 0;
 		}
+		static int SetRenderListSort(lua_State* L)
+		{
+			if (!LPOOL.SetRenderListSort(lua_toboolean(L, 1)))
+				return luaL_error(L, "SetRenderListSort was called in 'lstg.ObjRender', which is disallowed");
+			return 0;
+		}
+		static int GetRenderListSort(lua_State* L) noexcept
+		{
+			lua_pushboolean(L, LPOOL.GetRenderListSort());
+			return 1;
+		}
 		static int BoundCheck(lua_State* L)
 		{
 			if (!LPOOL.CheckIsMainThread(L))
@@ -54,6 +65,26 @@ void LuaSTGPlus::LuaWrapper::GameObjectManagerWrapper::Register(lua_State* L) no
 			LPOOL.CollisionCheck(luaL_checkinteger(L, 1), luaL_checkinteger(L, 2));
 			return 0;
 		}
+		static int SetCollisionBroadPhase(lua_State* L) noexcept
+		{
+			LPOOL.SetCollisionBroadPhase(lua_toboolean(L, 1));
+			return 0;
+		}
+		static int GetCollisionBroadPhase(lua_State* L) noexcept
+		{
+			lua_pushboolean(L, LPOOL.GetCollisionBroadPhase());
+			return 1;
+		}
+		static int SetCollisionParallel(lua_State* L) noexcept
+		{
+			LPOOL.SetCollisionParallel(lua_toboolean(L, 1));
+			return 0;
+		}
+		static int GetCollisionParallel(lua_State* L) noexcept
+		{
+			lua_pushboolean(L, LPOOL.GetCollisionParallel());
+			return 1;
+		}
 		static int UpdateXY(lua_State* L)
 		{
 			if (!LPOOL.CheckIsMainThread(L))
@@ -61,6 +92,59 @@ void LuaSTGPlus::LuaWrapper::GameObjectManagerWrapper::Register(lua_State* L) no
 			LPOOL.UpdateXY();
 			return 0;
 		}
+		static int SetKinematicsBatch(lua_State* L) noexcept
+		{
+			LPOOL.SetKinematicsBatch(lua_toboolean(L, 1));
+			return 0;
+		}
+		static int GetKinematicsBatch(lua_State* L) noexcept
+		{
+			lua_pushboolean(L, LPOOL.GetKinematicsBatch());
+			return 1;
+		}
+		static int SetTwoPassFrame(lua_State* L) noexcept
+		{
+			LPOOL.SetTwoPassFrame(lua_toboolean(L, 1));
+			return 0;
+		}
+		static int GetTwoPassFrame(lua_State* L) noexcept
+		{
+			lua_pushboolean(L, LPOOL.GetTwoPassFrame());
+			return 1;
+		}
+		static int SetBatchDispatch(lua_State* L) noexcept
+		{
+			LPOOL.SetBatchDispatch(lua_toboolean(L, 1));
+			return 0;
+		}
+		static int GetBatchDispatch(lua_State* L) noexcept
+		{
+			lua_pushboolean(L, LPOOL.GetBatchDispatch());
+			return 1;
+		}
+		static int SetTableRecycle(lua_State* L) noexcept
+		{
+			LPOOL.SetTableRecycle(lua_toboolean(L, 1));
+			return 0;
+		}
+		static int GetTableRecycle(lua_State* L) noexcept
+		{
+			lua_pushboolean(L, LPOOL.GetTableRecycle());
+			lua_pushinteger(L, (lua_Integer)LPOOL.GetRecycledTableCount());
+			return 2;
+		}
+		static int GetObjectView(lua_State* L) noexcept
+		{
+			lua_pushlightuserdata(L, LPOOL.GetObjectView());
+			return 1;
+		}
+		static int SetObjectViewMetatable(lua_State* L) noexcept
+		{
+			if (!lua_isnil(L, 1))
+				luaL_checktype(L, 1, LUA_TTABLE);
+			LPOOL.SetObjectViewMetatable(L, 1);
+			return 0;
+		}
 		static int AfterFrame(lua_State* L)
 		{
 			if (!LPOOL.CheckIsMainThread(L))
@@ -144,10 +228,26 @@ void LuaSTGPlus::LuaWrapper::GameObjectManagerWrapper::Register(lua_State* L) no
 		{ "GetnObj", &Wrapper::GetnObj },
 		{ "ObjFrame", &Wrapper::ObjFrame },
 		{ "ObjRender", &Wrapper::ObjRender },
+		{ "SetRenderListSort", &Wrapper::SetRenderListSort },
+		{ "GetRenderListSort", &Wrapper::GetRenderListSort },
 		{ "BoundCheck", &Wrapper::BoundCheck },
 		{ "SetBound", &Wrapper::SetBound },
 		{ "CollisionCheck", &Wrapper::CollisionCheck },
+		{ "SetCollisionBroadPhase", &Wrapper::SetCollisionBroadPhase },
+		{ "GetCollisionBroadPhase", &Wrapper::GetCollisionBroadPhase },
+		{ "SetCollisionParallel", &Wrapper::SetCollisionParallel },
+		{ "GetCollisionParallel", &Wrapper::GetCollisionParallel },
 		{ "UpdateXY", &Wrapper::UpdateXY },
+		{ "SetKinematicsBatch", &Wrapper::SetKinematicsBatch },
+		{ "GetKinematicsBatch", &Wrapper::GetKinematicsBatch },
+		{ "SetTwoPassFrame", &Wrapper::SetTwoPassFrame },
+		{ "GetTwoPassFrame", &Wrapper::GetTwoPassFrame },
+		{ "SetBatchDispatch", &Wrapper::SetBatchDispatch },
+		{ "GetBatchDispatch", &Wrapper::GetBatchDispatch },
+		{ "SetTableRecycle", &Wrapper::SetTableRecycle },
+		{ "GetTableRecycle", &Wrapper::GetTableRecycle },
+		{ "GetObjectView", &Wrapper::GetObjectView },
+		{ "SetObjectViewMetatable", &Wrapper::SetObjectViewMetatable },
 		{ "AfterFrame", &Wrapper::AfterFrame },
 		{ "ResetPool", &Wrapper::ResetPool },
 		// 对象遍历
@@ -1,6 +1,7 @@
 ﻿#include "LuaBinding/LuaWrapper.hpp"
 #include "LuaBinding/lua_utility.hpp"
 #include "AppFrame.h"
+#include "Core/FrameProfiler.hpp"
 
 inline Core::RectI lua_to_Core_RectI(lua_State* L, int idx)
 {
@@ -247,6 +248,108 @@ void LuaSTGPlus::BuiltInFunctionWrapper::Register(lua_State* L)noexcept
 		// 	return 1;
 		// }
 		#pragma endregion
+
+		#pragma region 性能分析
+		static int SetFrameProfile(lua_State* L)noexcept
+		{
+			auto& profiler = Core::FrameProfiler::get();
+			profiler.setEnable(lua_toboolean(L, 1));
+			if (lua_gettop(L) >= 2)
+				profiler.setSampleEnable(lua_toboolean(L, 2));
+			return 0;
+		}
+		static int SetGCStepLimit(lua_State* L)noexcept
+		{
+			// 毫秒
+			LAPP.SetGCStepLimit(luaL_checknumber(L, 1) * 0.001);
+			return 0;
+		}
+		static int GetGCStatistics(lua_State* L)
+		{
+			auto const& info = LAPP.GetGCStatistics();
+			lua_createtable(L, 0, 6);
+			lua_pushnumber(L, LAPP.GetGCStepLimit() * 1000.0);
+			lua_setfield(L, -2, "limit");
+			lua_pushnumber(L, info.budget * 1000.0);
+			lua_setfield(L, -2, "budget");
+			lua_pushnumber(L, info.step_time * 1000.0);
+			lua_setfield(L, -2, "step_time");
+			lua_pushinteger(L, (lua_Integer)info.step_count);
+			lua_setfield(L, -2, "step_count");
+			lua_pushnumber(L, (lua_Number)info.heap_size);
+			lua_setfield(L, -2, "heap_size");
+			lua_pushboolean(L, info.cycle_finished);
+			lua_setfield(L, -2, "cycle_finished");
+			return 1;
+		}
+		static int GetFrameProfile(lua_State* L)
+		{
+			auto& profiler = Core::FrameProfiler::get();
+			auto const* frame = profiler.getFrame((size_t)luaL_optinteger(L, 1, 0));
+			if (!frame)
+			{
+				lua_pushnil(L);
+				return 1;
+			}
+			lua_createtable(L, 0, 6);													// t
+			lua_pushnumber(L, (lua_Number)frame->index);
+			lua_setfield(L, -2, "index");
+			lua_pushnumber(L, (lua_Number)(frame->end - frame->begin) * 1e-9);
+			lua_setfield(L, -2, "time");
+			lua_pushnumber(L, (lua_Number)frame->dropped_event_count);
+			lua_setfield(L, -2, "dropped");
+			// 计时区间，按开始时间排列，start 为相对帧开始的时间
+			lua_createtable(L, (int)frame->event_count, 0);								// t scopes
+			for (uint64_t i = 0; i < frame->event_count; i += 1)
+			{
+				auto const& e = profiler.getEvent(frame->first_event + i);
+				lua_createtable(L, 0, 4);												// t scopes scope
+				lua_pushstring(L, e.name);
+				lua_setfield(L, -2, "name");
+				lua_pushinteger(L, (lua_Integer)e.depth);
+				lua_setfield(L, -2, "depth");
+				lua_pushnumber(L, (lua_Number)(e.begin - frame->begin) * 1e-9);
+				lua_setfield(L, -2, "start");
+				lua_pushnumber(L, (lua_Number)(e.end - e.begin) * 1e-9);
+				lua_setfield(L, -2, "time");
+				lua_rawseti(L, -2, (int)i + 1);										// t scopes
+			}
+			lua_setfield(L, -2, "scopes");												// t
+			// 计数器
+			lua_createtable(L, 0, (int)frame->counters.size());						// t counters
+			for (auto const& v : frame->counters)
+			{
+				lua_pushnumber(L, (lua_Number)v.value);
+				lua_setfield(L, -2, v.name);
+			}
+			lua_setfield(L, -2, "counters");											// t
+			// 按类汇总的回调
+			lua_createtable(L, (int)frame->samples.size(), 0);						// t callbacks
+			for (size_t i = 0; i < frame->samples.size(); i += 1)
+			{
+				auto const& v = frame->samples[i];
+				lua_createtable(L, 0, 4);												// t callbacks item
+				LPOOL.PushProfileClass(L, v.key);
+				lua_setfield(L, -2, "class");
+				lua_pushstring(L, v.name);
+				lua_setfield(L, -2, "callback");
+				lua_pushnumber(L, (lua_Number)v.count);
+				lua_setfield(L, -2, "count");
+				lua_pushnumber(L, (lua_Number)v.time * 1e-9);
+				lua_setfield(L, -2, "time");
+				lua_rawseti(L, -2, (int)i + 1);										// t callbacks
+			}
+			lua_setfield(L, -2, "callbacks");											// t
+			return 1;
+		}
+		static int DumpFrameProfile(lua_State* L)
+		{
+			std::string_view const path = luaL_check_string_view(L, 1);
+			size_t const count = (size_t)luaL_optinteger(L, 2, (lua_Integer)Core::FrameProfiler::FrameCapacity);
+			lua_pushboolean(L, Core::FrameProfiler::get().dumpChromeTrace(path, count));
+			return 1;
+		}
+		#pragma endregion
 	};
 	
 	luaL_Reg tFunctions[] = {
@@ -274,6 +377,14 @@ void LuaSTGPlus::BuiltInFunctionWrapper::Register(lua_State* L)noexcept
 		// { "ChangeGPU", &WrapperImplement::ChangeGPU },
 		// { "GetCurrentGpuName", &WrapperImplement::GetCurrentGpuName },
 		#pragma endregion
+
+		#pragma region 性能分析
+		{ "SetFrameProfile", &WrapperImplement::SetFrameProfile },
+		{ "GetFrameProfile", &WrapperImplement::GetFrameProfile },
+		{ "DumpFrameProfile", &WrapperImplement::DumpFrameProfile },
+		{ "SetGCStepLimit", &WrapperImplement::SetGCStepLimit },
+		{ "GetGCStatistics", &WrapperImplement::GetGCStatistics },
+		#pragma endregion
 		
 		{ NULL, NULL },
 	};
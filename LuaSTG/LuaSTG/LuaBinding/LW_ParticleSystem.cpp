@@ -157,6 +157,32 @@ namespace LuaSTGPlus::LuaWrapper
 					return luaL_error(L, "invalid particle system instance.");
 				}
 			}
+			static int GetParticleState(lua_State* L)
+			{
+				UserData* self = (UserData*)luaL_checkudata(L, 1, ClassID.data());
+				if (self->ptr)
+				{
+					lua_Integer const index = luaL_checkinteger(L, 2);
+					ParticleState state{};
+					if (index < 1 || !self->ptr->GetParticleState((size_t)(index - 1), state))
+					{
+						return 0;
+					}
+					lua_pushnumber(L, state.position.x);
+					lua_pushnumber(L, state.position.y);
+					lua_pushnumber(L, state.size);
+					lua_pushnumber(L, state.spin);
+					for (float const c : state.color)
+					{
+						lua_pushnumber(L, c);
+					}
+					return 8;
+				}
+				else
+				{
+					return luaL_error(L, "invalid particle system instance.");
+				}
+			}
 			static int SetEmission(lua_State* L)
 			{
 				UserData* self = (UserData*)luaL_checkudata(L, 1, ClassID.data());
@@ -1147,11 +1173,23 @@ namespace LuaSTGPlus::LuaWrapper
 				
 				return 1;
 			}
+
+			static int SetParticleBatch(lua_State* L)
+			{
+				LAPP.SetParticleBatch(lua_toboolean(L, 1));
+				return 0;
+			}
+			static int GetParticleBatch(lua_State* L)
+			{
+				lua_pushboolean(L, LAPP.GetParticleBatch());
+				return 1;
+			}
 		};
 
 		luaL_Reg const lib[] = {
 			{ "SetActive", &Wrapper::SetActive },
 			{ "GetAliveCount", &Wrapper::GetAliveCount },
+			{ "GetParticleState", &Wrapper::GetParticleState },
 			{ "SetEmission", &Wrapper::SetEmission },
 			{ "GetEmission", &Wrapper::GetEmission },
 			{ "Update", &Wrapper::Update },
@@ -1236,6 +1274,8 @@ namespace LuaSTGPlus::LuaWrapper
 
 		luaL_Reg const ins[] = {
 			{ "ParticleSystemData", Wrapper::ParticleSystemInstance },
+			{ "SetParticleBatch", Wrapper::SetParticleBatch },
+			{ "GetParticleBatch", Wrapper::GetParticleBatch },
 			{ NULL, NULL }
 		};
 
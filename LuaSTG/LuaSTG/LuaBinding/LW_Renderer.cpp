@@ -1,8 +1,11 @@
 ﻿#include "LuaBinding/LuaWrapper.hpp"
 #include "LuaBinding/lua_utility.hpp"
 #include "LuaBinding/PostEffectShader.hpp"
+#include "LuaBinding/RenderBundle.hpp"
+#include "LuaBinding/Resource.hpp"
 #include "AppFrame.h"
 #include "spdlog/spdlog.h"
+#include <array>
 
 inline Core::Graphics::IRenderer* LR2D() { return LAPP.GetAppModel()->getRenderer(); }
 inline LuaSTGPlus::ResourceMgr& LRESMGR() { return LAPP.GetResourceMgr(); }
@@ -15,13 +18,6 @@ inline LuaSTGPlus::ResourceMgr& LRESMGR() { return LAPP.GetResourceMgr(); }
 
 #define validate_render_scope() if (!LR2D()->isBatchScope()) return luaL_error(L, "invalid render operation");
 
-enum class RenderError
-{
-    None,
-    SpriteNotFound,
-    SpriteSequenceNotFound,
-};
-
 inline void rotate_float2(float& x, float& y, const float r)
 {
     float const sinv = sinf(r);
@@ -124,81 +120,113 @@ inline Core::Graphics::IRenderer::BlendState translate_blend_3d(const LuaSTGPlus
     }
 }
 
-inline RenderError api_drawSprite(LuaSTGPlus::IResourceSprite* pimg2dres, float const x, float const y, float const rot, float const hscale, float const vscale, float const z)
-{
-    pimg2dres->Render(x, y, rot, hscale, vscale, z);
-    return RenderError::None;
-}
-inline RenderError api_drawSprite(char const* name, float const x, float const y, float const rot, float const hscale, float const vscale, float const z)
+// 以 lua 字符串地址为键的精灵查找缓存
+// lua 字符串是驻留的，同一个名字通常是同一个地址，命中后仍比较内容，防止字符串被回收后地址被复用
+// 资源池发生变化时整个缓存作废，缓存只保存裸指针，资源由资源池持有
+template<typename T>
+class ResourceNameCache
 {
-    Core::ScopeObject<LuaSTGPlus::IResourceSprite> pimg2dres = LRESMGR().FindSprite(name);
-    if (!pimg2dres)
+private:
+    struct Slot
+    {
+        char const* key{ nullptr };
+        std::string name;
+        uint64_t generation{ 0 };
+        T* value{ nullptr };
+    };
+    std::array<Slot, 256> m_slot;
+public:
+    template<typename F>
+    T* find(char const* name, F&& find_resource)
     {
-        spdlog::error("[luastg] lstg.Renderer.drawSprite failed, can't find sprite '{}'", name);
-        return RenderError::SpriteNotFound;
+        uint64_t const generation = LRESMGR().GetResourceGeneration();
+        Slot& slot = m_slot[(reinterpret_cast<uintptr_t>(name) >> 4) % m_slot.size()];
+        if (slot.key == name && slot.generation == generation && slot.name == name)
+        {
+            return slot.value;
+        }
+        auto res = find_resource(name);
+        if (!res)
+        {
+            return nullptr;
+        }
+        slot.key = name;
+        slot.name = name;
+        slot.generation = generation;
+        slot.value = res.get();
+        return slot.value;
     }
-    return api_drawSprite(*pimg2dres, x, y, rot, hscale, vscale, z);
-}
-inline RenderError api_drawSpriteRect(LuaSTGPlus::IResourceSprite* pimg2dres, float const l, float const r, float const b, float const t, float const z)
+};
+
+static bool g_ResourceNameCacheEnable = true;
+static ResourceNameCache<LuaSTGPlus::IResourceSprite> g_SpriteNameCache;
+static ResourceNameCache<LuaSTGPlus::IResourceAnimation> g_SpriteSequenceNameCache;
+
+// 第一个参数可以是 lstg.ResourceManager.findSprite 等接口返回的精灵对象，也可以是精灵名
+inline LuaSTGPlus::IResourceSprite* api_findSprite(lua_State* L, int const idx, char const* api)
 {
-    pimg2dres->RenderRect(l, r, b, t, z);
-    return RenderError::None;
+    if (auto* p_sprite = LuaSTG::Sub::LuaBinding::toResourceSprite(L, idx))
+    {
+        return p_sprite;
+    }
+    char const* name = luaL_checkstring(L, idx);
+    LuaSTGPlus::IResourceSprite* p_sprite = nullptr;
+    if (g_ResourceNameCacheEnable)
+    {
+        p_sprite = g_SpriteNameCache.find(name, [](char const* s) { return LRESMGR().FindSprite(s); });
+    }
+    else
+    {
+        p_sprite = LRESMGR().FindSprite(name).get(); // 资源池仍然持有
+    }
+    if (!p_sprite)
+    {
+        spdlog::error("[luastg] lstg.Renderer.{} failed, can't find sprite '{}'", api, name);
+    }
+    return p_sprite;
 }
-inline RenderError api_drawSpriteRect(char const* name, float const l, float const r, float const b, float const t, float const z)
+inline LuaSTGPlus::IResourceAnimation* api_findSpriteSequence(lua_State* L, int const idx, char const* api)
 {
-    Core::ScopeObject<LuaSTGPlus::IResourceSprite> pimg2dres = LRESMGR().FindSprite(name);
-    if (!pimg2dres)
+    if (auto* p_sprite_seq = LuaSTG::Sub::LuaBinding::toResourceSpriteSequence(L, idx))
+    {
+        return p_sprite_seq;
+    }
+    char const* name = luaL_checkstring(L, idx);
+    LuaSTGPlus::IResourceAnimation* p_sprite_seq = nullptr;
+    if (g_ResourceNameCacheEnable)
+    {
+        p_sprite_seq = g_SpriteSequenceNameCache.find(name, [](char const* s) { return LRESMGR().FindAnimation(s); });
+    }
+    else
+    {
+        p_sprite_seq = LRESMGR().FindAnimation(name).get(); // 资源池仍然持有
+    }
+    if (!p_sprite_seq)
     {
-        spdlog::error("[luastg] lstg.Renderer.drawSpriteRect failed, can't find sprite '{}'", name);
-        return RenderError::SpriteNotFound;
+        spdlog::error("[luastg] lstg.Renderer.{} failed, can't find sprite sequence '{}'", api, name);
     }
-    return api_drawSpriteRect(*pimg2dres, l, r, b, t, z);
+    return p_sprite_seq;
 }
-inline RenderError api_drawSprite4V(LuaSTGPlus::IResourceSprite* pimg2dres, float const x1, float const y1, float const z1, float const x2, float const y2, float const z2, float const x3, float const y3, float const z3, float const x4, float const y4, float const z4)
+
+inline void api_drawSprite(LuaSTGPlus::IResourceSprite* pimg2dres, float const x, float const y, float const rot, float const hscale, float const vscale, float const z)
 {
-    pimg2dres->Render4V(x1, y1, z1, x2, y2, z2, x3, y3, z3, x4, y4, z4);
-    return RenderError::None;
+    pimg2dres->Render(x, y, rot, hscale, vscale, z);
 }
-inline RenderError api_drawSprite4V(char const* name, float const x1, float const y1, float const z1, float const x2, float const y2, float const z2, float const x3, float const y3, float const z3, float const x4, float const y4, float const z4)
+inline void api_drawSpriteRect(LuaSTGPlus::IResourceSprite* pimg2dres, float const l, float const r, float const b, float const t, float const z)
 {
-    Core::ScopeObject<LuaSTGPlus::IResourceSprite> pimg2dres = LRESMGR().FindSprite(name);
-    if (!pimg2dres)
-    {
-        spdlog::error("[luastg] lstg.Renderer.drawSprite4V failed, can't find sprite '{}'", name);
-        return RenderError::SpriteNotFound;
-    }
-    return api_drawSprite4V(*pimg2dres, x1, y1, z1, x2, y2, z2, x3, y3, z3, x4, y4, z4);
+    pimg2dres->RenderRect(l, r, b, t, z);
 }
-inline RenderError api_drawSprite3D(LuaSTGPlus::IResourceSprite* pimg2dres, float const x, float const y, float const z, float const rx, float const ry, float const rz, float const sx, float const sy)
+inline void api_drawSprite4V(LuaSTGPlus::IResourceSprite* pimg2dres, float const x1, float const y1, float const z1, float const x2, float const y2, float const z2, float const x3, float const y3, float const z3, float const x4, float const y4, float const z4)
 {
-    pimg2dres->Render3D(x, y, z, rx, ry, rz, sx, sy);
-    return RenderError::None;
+    pimg2dres->Render4V(x1, y1, z1, x2, y2, z2, x3, y3, z3, x4, y4, z4);
 }
-inline RenderError api_drawSprite3D(char const* name, float const x, float const y, float const z, float const rx, float const ry, float const rz, float const sx, float const sy)
+inline void api_drawSprite3D(LuaSTGPlus::IResourceSprite* pimg2dres, float const x, float const y, float const z, float const rx, float const ry, float const rz, float const sx, float const sy)
 {
-    Core::ScopeObject<LuaSTGPlus::IResourceSprite> pimg2dres = LRESMGR().FindSprite(name);
-    if (!pimg2dres)
-    {
-        spdlog::error("[luastg] lstg.Renderer.drawSprite3D failed, can't find sprite '{}'", name);
-        return RenderError::SpriteNotFound;
-    }
-    return api_drawSprite3D(*pimg2dres, x, y, z, rx, ry, rz, sx, sy);
+    pimg2dres->Render3D(x, y, z, rx, ry, rz, sx, sy);
 }
-
-inline RenderError api_drawSpriteSequence(LuaSTGPlus::IResourceAnimation* pani2dres, int const ani_timer, float const x, float const y, float const rot, float const hscale, float const vscale, float const z)
+inline void api_drawSpriteSequence(LuaSTGPlus::IResourceAnimation* pani2dres, int const ani_timer, float const x, float const y, float const rot, float const hscale, float const vscale, float const z)
 {
     pani2dres->Render(ani_timer, x, y, rot, hscale, vscale, z);
-    return RenderError::None;
-}
-inline RenderError api_drawSpriteSequence(char const* name, int const ani_timer, float const x, float const y, float const rot, float const hscale, float const vscale, float const z)
-{
-    Core::ScopeObject<LuaSTGPlus::IResourceAnimation> pani2dres = LRESMGR().FindAnimation(name);
-    if (!pani2dres)
-    {
-        spdlog::error("[luastg] lstg.Renderer.drawSpriteSequence failed, can't find sprite sequence '{}'", name);
-        return RenderError::SpriteSequenceNotFound;
-    }
-    return api_drawSpriteSequence(*pani2dres, ani_timer, x, y, rot, hscale, vscale, z);
 }
 
 static void api_setFogState(float start, float end, Core::Color4B color)
@@ -524,79 +552,135 @@ static int lib_drawQuad(lua_State* L)
 static int lib_drawSprite(lua_State* L)
 {
     validate_render_scope();
+    LuaSTGPlus::IResourceSprite* pimg2dres = api_findSprite(L, 1, "drawSprite");
+    if (!pimg2dres)
+    {
+        return luaL_error(L, "can't find sprite '%s'", luaL_checkstring(L, 1));
+    }
     float const hscale = (float)luaL_optnumber(L, 5, 1.0);
-    RenderError re = api_drawSprite(
-        luaL_checkstring(L, 1),
+    api_drawSprite(
+        pimg2dres,
         (float)luaL_checknumber(L, 2), (float)luaL_checknumber(L, 3),
         (float)(luaL_optnumber(L, 4, 0.0) * L_DEG_TO_RAD),
         hscale * LRESMGR().GetGlobalImageScaleFactor(), (float)luaL_optnumber(L, 6, hscale) * LRESMGR().GetGlobalImageScaleFactor(),
         (float)luaL_optnumber(L, 7, 0.5));
-    if (re == RenderError::SpriteNotFound)
-    {
-        return luaL_error(L, "can't find sprite '%s'", luaL_checkstring(L, 1));
-    }
     return 0;
 }
 static int lib_drawSpriteRect(lua_State* L)
 {
     validate_render_scope();
-    RenderError re = api_drawSpriteRect(
-        luaL_checkstring(L, 1),
-        (float)luaL_checknumber(L, 2), (float)luaL_checknumber(L, 3),
-        (float)luaL_checknumber(L, 4), (float)luaL_checknumber(L, 5),
-        (float)luaL_optnumber(L, 6, 0.5));
-    if (re == RenderError::SpriteNotFound)
+    LuaSTGPlus::IResourceSprite* pimg2dres = api_findSprite(L, 1, "drawSpriteRect");
+    if (!pimg2dres)
     {
         return luaL_error(L, "can't find sprite '%s'", luaL_checkstring(L, 1));
     }
+    api_drawSpriteRect(
+        pimg2dres,
+        (float)luaL_checknumber(L, 2), (float)luaL_checknumber(L, 3),
+        (float)luaL_checknumber(L, 4), (float)luaL_checknumber(L, 5),
+        (float)luaL_optnumber(L, 6, 0.5));
     return 0;
 }
 static int lib_drawSprite4V(lua_State* L)
 {
     validate_render_scope();
-    RenderError re = api_drawSprite4V(
-        luaL_checkstring(L, 1),
+    LuaSTGPlus::IResourceSprite* pimg2dres = api_findSprite(L, 1, "drawSprite4V");
+    if (!pimg2dres)
+    {
+        return luaL_error(L, "can't find sprite '%s'", luaL_checkstring(L, 1));
+    }
+    api_drawSprite4V(
+        pimg2dres,
         (float)luaL_checknumber(L, 2), (float)luaL_checknumber(L, 3), (float)luaL_checknumber(L, 4),
         (float)luaL_checknumber(L, 5), (float)luaL_checknumber(L, 6), (float)luaL_checknumber(L, 7),
         (float)luaL_checknumber(L, 8), (float)luaL_checknumber(L, 9), (float)luaL_checknumber(L, 10),
         (float)luaL_checknumber(L, 11), (float)luaL_checknumber(L, 12), (float)luaL_checknumber(L, 13));
-    if (re == RenderError::SpriteNotFound)
-    {
-        return luaL_error(L, "can't find sprite '%s'", luaL_checkstring(L, 1));
-    }
     return 0;
 }
 static int lib_drawSprite3D(lua_State* L)
 {
-    RenderError re = api_drawSprite3D(
-        luaL_checkstring(L, 1),
+    LuaSTGPlus::IResourceSprite* pimg2dres = api_findSprite(L, 1, "drawSprite3D");
+    if (!pimg2dres)
+    {
+        return luaL_error(L, "can't find sprite '%s'", luaL_checkstring(L, 1));
+    }
+    api_drawSprite3D(
+        pimg2dres,
         (float)luaL_checknumber(L, 2), (float)luaL_checknumber(L, 3), (float)luaL_checknumber(L, 4),
         (float)(L_DEG_TO_RAD * luaL_checknumber(L, 5)), (float)(L_DEG_TO_RAD * luaL_checknumber(L, 6)), (float)(L_DEG_TO_RAD * luaL_checknumber(L, 7)),
         (float)luaL_optnumber(L, 8, 1), (float)luaL_optnumber(L, 9, luaL_optnumber(L, 8, 1))
     );
-    if (re == RenderError::SpriteNotFound)
-    {
-        return luaL_error(L, "can't find sprite '%s'", luaL_checkstring(L, 1));
-    }
     return 0;
 }
 static int lib_drawSpriteSequence(lua_State* L)
 {
     validate_render_scope();
+    LuaSTGPlus::IResourceAnimation* pani2dres = api_findSpriteSequence(L, 1, "drawSpriteSequence");
+    if (!pani2dres)
+    {
+        return luaL_error(L, "can't find animation '%s'", luaL_checkstring(L, 1));
+    }
     float const hscale = (float)luaL_optnumber(L, 6, 1.0);
-    RenderError re = api_drawSpriteSequence(
-        luaL_checkstring(L, 1),
+    api_drawSpriteSequence(
+        pani2dres,
         (int)luaL_checkinteger(L, 2),
         (float)luaL_checknumber(L, 3), (float)luaL_checknumber(L, 4),
         (float)(luaL_optnumber(L, 5, 0.0) * L_DEG_TO_RAD),
         hscale * LRESMGR().GetGlobalImageScaleFactor(), (float)luaL_optnumber(L, 7, hscale) * LRESMGR().GetGlobalImageScaleFactor(),
         (float)luaL_optnumber(L, 8, 0.5));
-    if (re == RenderError::SpriteNotFound)
-    {
-        return luaL_error(L, "can't find animation '%s'", luaL_checkstring(L, 1));
-    }
     return 0;
 }
+static int lib_setResourceNameCache(lua_State* L)
+{
+    g_ResourceNameCacheEnable = lua_toboolean(L, 1);
+    return 0;
+}
+static int lib_getResourceNameCache(lua_State* L)
+{
+    lua_pushboolean(L, g_ResourceNameCacheEnable);
+    return 1;
+}
+static int lib_setSpriteInstancing(lua_State* L)
+{
+    LAPP.SetSpriteInstancing(lua_toboolean(L, 1));
+    return 0;
+}
+static int lib_getSpriteInstancing(lua_State* L)
+{
+    lua_pushboolean(L, LAPP.GetSpriteInstancing());
+    return 1;
+}
+static int lib_setPremultipliedAlphaMode(lua_State* L)
+{
+    LAPP.SetPremultipliedAlphaMode(lua_toboolean(L, 1));
+    return 0;
+}
+static int lib_getPremultipliedAlphaMode(lua_State* L)
+{
+    lua_pushboolean(L, LAPP.GetPremultipliedAlphaMode());
+    return 1;
+}
+static int lib_setDrawListConfig(lua_State* L)
+{
+    // 顶点数、索引数、绘制命令数、是否使用 32 位索引，省略的参数保持不变
+    Core::Graphics::IRenderer::DrawListConfig config = LR2D()->getDrawListConfig();
+    config.vertex_count = (uint32_t)luaL_optinteger(L, 1, (lua_Integer)config.vertex_count);
+    config.index_count = (uint32_t)luaL_optinteger(L, 2, (lua_Integer)config.index_count);
+    config.command_count = (uint32_t)luaL_optinteger(L, 3, (lua_Integer)config.command_count);
+    if (lua_gettop(L) >= 4)
+        config.index32 = lua_toboolean(L, 4);
+    LR2D()->setDrawListConfig(config);
+    return 0;
+}
+static int lib_getDrawListConfig(lua_State* L)
+{
+    Core::Graphics::IRenderer::DrawListConfig const config = LR2D()->getDrawListConfig();
+    lua_pushinteger(L, (lua_Integer)config.vertex_count);
+    lua_pushinteger(L, (lua_Integer)config.index_count);
+    lua_pushinteger(L, (lua_Integer)config.command_count);
+    lua_pushboolean(L, config.index32);
+    return 4;
+}
 
 static int lib_drawTexture(lua_State* L) 
 {
@@ -656,10 +740,11 @@ static int lib_drawTexture(lua_State* L)
     Core::Graphics::ITexture2D* ptex2d = ptex2dres->GetTexture();
     float const uscale = 1.0f / (float)ptex2d->getSize().x;
     float const vscale = 1.0f / (float)ptex2d->getSize().y;
+    auto const origin = ptex2dres->GetAtlasRect().a; // 图集纹理的坐标偏移
     for (int i = 0; i < 4; ++i)
     {
-        vertex[i].u *= uscale;
-        vertex[i].v *= vscale;
+        vertex[i].u = (vertex[i].u + (float)origin.x) * uscale;
+        vertex[i].v = (vertex[i].v + (float)origin.y) * vscale;
     }
     ctx->setTexture(ptex2d);
 
@@ -710,9 +795,11 @@ static int lib_drawTextureRect(lua_State* L)
     auto* ctx = LR2D();
     check_rendertarget_usage(ptex2dres);
     Core::Graphics::ITexture2D* ptex2d = ptex2dres->GetTexture();
+    auto const origin = ptex2dres->GetAtlasRect().a; // 图集纹理的坐标偏移
+    Core::RectF const uv = *uvrect + Core::Vector2F((float)origin.x, (float)origin.y);
 
-    float const w_2 = uvrect->width()  / 2.f;
-    float const h_2 = uvrect->height() / 2.f;
+    float const w_2 = uv.width()  / 2.f;
+    float const h_2 = uv.height() / 2.f;
 
     Core::Vector2U const size = ptex2d->getSize();
     float const uscale = 1.0f / (float)size.x;
@@ -725,10 +812,10 @@ static int lib_drawTextureRect(lua_State* L)
     );
 
     Core::Graphics::IRenderer::DrawVertex vert[4] = {
-        Core::Graphics::IRenderer::DrawVertex(rect.a.x, rect.a.y, 0.0f, uvrect->a.x*uscale, uvrect->b.y*vscale, tColors[0].color()),
-        Core::Graphics::IRenderer::DrawVertex(rect.b.x, rect.a.y, 0.0f, uvrect->b.x*uscale, uvrect->b.y*vscale, tColors[1].color()),
-        Core::Graphics::IRenderer::DrawVertex(rect.b.x, rect.b.y, 0.0f, uvrect->b.x*uscale, uvrect->a.y*vscale, tColors[2].color()),
-        Core::Graphics::IRenderer::DrawVertex(rect.a.x, rect.b.y, 0.0f, uvrect->a.x*uscale, uvrect->a.y*vscale, tColors[3].color()),
+        Core::Graphics::IRenderer::DrawVertex(rect.a.x, rect.a.y, 0.0f, uv.a.x*uscale, uv.b.y*vscale, tColors[0].color()),
+        Core::Graphics::IRenderer::DrawVertex(rect.b.x, rect.a.y, 0.0f, uv.b.x*uscale, uv.b.y*vscale, tColors[1].color()),
+        Core::Graphics::IRenderer::DrawVertex(rect.b.x, rect.b.y, 0.0f, uv.b.x*uscale, uv.a.y*vscale, tColors[2].color()),
+        Core::Graphics::IRenderer::DrawVertex(rect.a.x, rect.b.y, 0.0f, uv.a.x*uscale, uv.a.y*vscale, tColors[3].color()),
     };
 
 
@@ -818,6 +905,47 @@ static int lib_drawModel(lua_State* L)
     return 0;
 }
 
+static int lib_beginBundle(lua_State* L)
+{
+    validate_render_scope();
+    if (!LR2D()->beginBundle())
+    {
+        return luaL_error(L, "lstg.Renderer.beginBundle failed, see 'engine.log' for more detail");
+    }
+    return 0;
+}
+static int lib_endBundle(lua_State* L)
+{
+    validate_render_scope();
+    Core::ScopeObject<Core::Graphics::IRenderBundle> bundle;
+    if (!LR2D()->endBundle(~bundle))
+    {
+        return luaL_error(L, "lstg.Renderer.endBundle failed, see 'engine.log' for more detail");
+    }
+    LuaSTG::LuaBinding::RenderBundle::Create(L, bundle.get());
+    return 1;
+}
+static int lib_drawBundle(lua_State* L)
+{
+    validate_render_scope();
+    Core::Graphics::IRenderBundle* bundle = LuaSTG::LuaBinding::RenderBundle::Cast(L, 1);
+
+    Core::Graphics::IRenderer::RenderBundleTransform transform;
+    transform.position.x = (float)luaL_optnumber(L, 2, 0.0);
+    transform.position.y = (float)luaL_optnumber(L, 3, 0.0);
+    transform.position.z = (float)luaL_optnumber(L, 4, 0.0);
+    transform.rotation = (float)(L_DEG_TO_RAD * luaL_optnumber(L, 5, 0.0));
+    transform.scale.x = (float)luaL_optnumber(L, 6, 1.0);
+    transform.scale.y = (float)luaL_optnumber(L, 7, transform.scale.x);
+    transform.scale.z = (float)luaL_optnumber(L, 8, 1.0);
+
+    if (!LR2D()->drawBundle(bundle, transform))
+    {
+        spdlog::error("[luastg] lstg.Renderer.drawBundle failed");
+    }
+    return 0;
+}
+
 #define MKFUNC(X) {#X, &lib_##X}
 
 static luaL_Reg const lib_func[] = {
@@ -851,6 +979,10 @@ static luaL_Reg const lib_func[] = {
 
     MKFUNC(drawTexture),
 
+    MKFUNC(beginBundle),
+    MKFUNC(endBundle),
+    MKFUNC(drawBundle),
+
     { NULL, NULL },
 };
 
@@ -1121,6 +1253,14 @@ static luaL_Reg const lib_compat[] = {
     { "Render4V", &lib_drawSprite4V },
     { "Render3D", &lib_drawSprite3D },
     { "RenderAnimation", &lib_drawSpriteSequence },
+    { "SetResourceNameCache", &lib_setResourceNameCache },
+    { "GetResourceNameCache", &lib_getResourceNameCache },
+    { "SetSpriteInstancing", &lib_setSpriteInstancing },
+    { "GetSpriteInstancing", &lib_getSpriteInstancing },
+    { "SetPremultipliedAlphaMode", &lib_setPremultipliedAlphaMode },
+    { "GetPremultipliedAlphaMode", &lib_getPremultipliedAlphaMode },
+    { "SetDrawListConfig", &lib_setDrawListConfig },
+    { "GetDrawListConfig", &lib_getDrawListConfig },
     { "RenderTexture", &lib_drawTexture },
     { "RenderTextureRect", &lib_drawTextureRect },
     { "RenderMesh", &lib_drawMesh },
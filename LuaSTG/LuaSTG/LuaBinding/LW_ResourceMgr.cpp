@@ -14,6 +14,10 @@ void LuaSTGPlus::LuaWrapper::ResourceMgrWrapper::Register(lua_State* L) noexcept
             ResourceMgr::SetResourceLoadingLog((bool)lua_toboolean(L, 1));
             return 0;
         }
+        static int GetResLoadInfo(lua_State* L) noexcept {
+            lua_pushboolean(L, ResourceMgr::GetResourceLoadingLog());
+            return 1;
+        }
         static int SetResourceStatus(lua_State* L)
         {
             const char* s = luaL_checkstring(L, 1);
@@ -70,6 +74,116 @@ void LuaSTGPlus::LuaWrapper::ResourceMgrWrapper::Register(lua_State* L) noexcept
                 return luaL_error(L, "can't load texture '%s' from binary data.", name);
             return 0;
         }
+        static int LoadTextureAsync(lua_State* L)
+        {
+            ResourcePool* pActivedPool = LRES.GetActivedPool();
+            if (!pActivedPool)
+                return luaL_error(L, "can't load resource at this time.");
+            if (lua_istable(L, 1))
+            {
+                // { { name, path, mipmap }, ... }
+                int const n = (int)lua_objlen(L, 1);
+                for (int i = 1; i <= n; i += 1)
+                {
+                    lua_rawgeti(L, 1, i);
+                    luaL_checktype(L, -1, LUA_TTABLE);
+                    lua_rawgeti(L, -1, 1);
+                    lua_rawgeti(L, -2, 2);
+                    lua_rawgeti(L, -3, 3);
+                    const char* name = luaL_checkstring(L, -3);
+                    const char* path = luaL_checkstring(L, -2);
+                    bool const mipmap = lua_isnoneornil(L, -1) ? true : (lua_toboolean(L, -1) != 0);
+                    if (!pActivedPool->LoadTextureAsync(name, path, mipmap))
+                        return luaL_error(L, "can't load texture from file '%s'.", path);
+                    lua_pop(L, 4);
+                }
+                return 0;
+            }
+            const char* name = luaL_checkstring(L, 1);
+            const char* path = luaL_checkstring(L, 2);
+            if (!pActivedPool->LoadTextureAsync(name, path, lua_toboolean(L, 3) == 0 ? false : true))
+                return luaL_error(L, "can't load texture from file '%s'.", path);
+            return 0;
+        }
+        static int GetTextureLoadState(lua_State* L)
+        {
+            const char* name = luaL_checkstring(L, 1);
+            switch (LRES.GetTextureLoader().GetState(LRES.GetActivedPoolType(), name))
+            {
+            case ResourceTextureLoader::State::Pending:
+                lua_pushstring(L, "pending");
+                break;
+            case ResourceTextureLoader::State::Loaded:
+                lua_pushstring(L, "loaded");
+                break;
+            case ResourceTextureLoader::State::Failed:
+                lua_pushstring(L, "failed");
+                break;
+            default:
+                lua_pushstring(L, "none");
+                break;
+            }
+            return 1;
+        }
+        static int GetTextureLoadCount(lua_State* L) noexcept
+        {
+            lua_pushinteger(L, (lua_Integer)LRES.GetTextureLoader().GetPendingCount());
+            return 1;
+        }
+        static int SetTextureUploadBudget(lua_State* L)
+        {
+            lua_Integer const bytes = luaL_checkinteger(L, 1);
+            LRES.GetTextureLoader().SetUploadBudget(bytes > 0 ? (size_t)bytes : 0);
+            return 0;
+        }
+        static int GetTextureUploadBudget(lua_State* L) noexcept
+        {
+            lua_pushinteger(L, (lua_Integer)LRES.GetTextureLoader().GetUploadBudget());
+            return 1;
+        }
+        static int SetTextureAtlas(lua_State* L)
+        {
+            // 只影响当前资源池之后加载的纹理
+            ResourcePool* pActivedPool = LRES.GetActivedPool();
+            if (!pActivedPool)
+                return luaL_error(L, "can't load resource at this time.");
+            pActivedPool->SetTextureAtlasEnable(lua_toboolean(L, 1));
+            return 0;
+        }
+        static int GetTextureAtlas(lua_State* L)
+        {
+            ResourcePool* pActivedPool = LRES.GetActivedPool();
+            if (!pActivedPool)
+                return luaL_error(L, "can't load resource at this time.");
+            lua_pushboolean(L, pActivedPool->GetTextureAtlasEnable());
+            return 1;
+        }
+        static int SetMusicStream(lua_State* L)
+        {
+            // 只影响当前资源池之后加载的音乐
+            ResourcePool* pActivedPool = LRES.GetActivedPool();
+            if (!pActivedPool)
+                return luaL_error(L, "can't load resource at this time.");
+            pActivedPool->SetMusicStreamEnable(lua_toboolean(L, 1));
+            return 0;
+        }
+        static int GetMusicStream(lua_State* L)
+        {
+            ResourcePool* pActivedPool = LRES.GetActivedPool();
+            if (!pActivedPool)
+                return luaL_error(L, "can't load resource at this time.");
+            lua_pushboolean(L, pActivedPool->GetMusicStreamEnable());
+            return 1;
+        }
+        static int IsAtlasTexture(lua_State* L)
+        {
+            const char* name = luaL_checkstring(L, 1);
+            Core::ScopeObject<IResourceTexture> p = LRES.FindTexture(name);
+            if (!p)
+                return luaL_error(L, "texture '%s' not found.", name);
+            lua_pushboolean(L, p->IsAtlasTexture());
+            return 1;
+        }
         static int LoadSprite(lua_State* L)
         {
             const char* name = luaL_checkstring(L, 1);
@@ -666,10 +780,21 @@ void LuaSTGPlus::LuaWrapper::ResourceMgrWrapper::Register(lua_State* L) noexcept
 
     luaL_Reg const lib[] = {
         { "SetResLoadInfo", &Wrapper::SetResLoadInfo },
+        { "GetResLoadInfo", &Wrapper::GetResLoadInfo },
         { "SetResourceStatus", &Wrapper::SetResourceStatus },
         { "GetResourceStatus", &Wrapper::GetResourceStatus },
         { "LoadTexture", &Wrapper::LoadTexture },
         { "LoadTextureBin", &Wrapper::LoadTextureBin },
+        { "LoadTextureAsync", &Wrapper::LoadTextureAsync },
+        { "GetTextureLoadState", &Wrapper::GetTextureLoadState },
+        { "GetTextureLoadCount", &Wrapper::GetTextureLoadCount },
+        { "SetTextureUploadBudget", &Wrapper::SetTextureUploadBudget },
+        { "GetTextureUploadBudget", &Wrapper::GetTextureUploadBudget },
+        { "SetTextureAtlas", &Wrapper::SetTextureAtlas },
+        { "GetTextureAtlas", &Wrapper::GetTextureAtlas },
+        { "IsAtlasTexture", &Wrapper::IsAtlasTexture },
+        { "SetMusicStream", &Wrapper::SetMusicStream },
+        { "GetMusicStream", &Wrapper::GetMusicStream },
         { "LoadImage", &Wrapper::LoadSprite },
         { "LoadAnimation", &Wrapper::LoadAnimation },
         { "LoadPS", &Wrapper::LoadPS },
@@ -99,6 +99,139 @@ function lstg.acos(x) return deg(acos(x)) end
 function lstg.atan(...) return deg(atan(...)) end
 function lstg.atan2(y, x) return deg(atan2(y, x)) end
 
+-- 游戏对象数据视图，需要 LuaJIT FFI
+-- 启用了数据视图的对象类，其对象的常用属性直接读写对象池的内存，不经过 lstg.GetAttr、lstg.SetAttr
+-- 结构体布局与 GameObject/GameObjectView.hpp 一致
+
+local object_view_metatable
+
+local function create_object_view_metatable()
+    local ffi = require("ffi")
+    ffi.cdef[[
+        typedef struct lstg_GameObjectView {
+            float* x;
+            float* y;
+            float* vx;
+            float* vy;
+            float* ax;
+            float* ay;
+            float* rot;
+            float* omega;
+            ptrdiff_t* timer;
+            uint8_t* object;
+            uint32_t object_stride;
+            uint32_t hscale_offset;
+            uint32_t vscale_offset;
+            uint32_t status_offset;
+            uint64_t* position_version;
+            uint32_t write_barrier;
+            uint32_t reserved;
+            double deg_to_rad;
+            double rad_to_deg;
+        } lstg_GameObjectView;
+    ]]
+
+    local view = ffi.cast("lstg_GameObjectView*", lstg.GetObjectView())
+    local x, y, vx, vy, ax, ay = view.x, view.y, view.vx, view.vy, view.ax, view.ay
+    local rot, omega, timer = view.rot, view.omega, view.timer
+    local object, stride = view.object, view.object_stride
+    local hscale_offset, vscale_offset, status_offset = view.hscale_offset, view.vscale_offset, view.status_offset
+    local position_version = view.position_version
+    local deg_to_rad, rad_to_deg = view.deg_to_rad, view.rad_to_deg
+    local float_ptr = ffi.typeof("float*")
+    local uint32_ptr = ffi.typeof("uint32_t*")
+    local void_ptr = ffi.typeof("void*")
+    local cast = ffi.cast
+    local rawget = rawget
+    local tonumber = tonumber
+    local error = error
+    local GetAttr = lstg.GetAttr
+    local SetAttr = lstg.SetAttr
+    local status_name = { [1] = "normal", [2] = "del", [4] = "kill" }
+
+    -- 已经回收的对象，[3] 为空指针
+    local function object_id(self)
+        if cast(void_ptr, rawget(self, 3)) == nil then
+            error("invalid lstg object", 3)
+        end
+        return rawget(self, 2)
+    end
+
+    local getter = {
+        x = function(id) return x[id] end,
+        y = function(id) return y[id] end,
+        vx = function(id) return vx[id] end,
+        vy = function(id) return vy[id] end,
+        ax = function(id) return ax[id] end,
+        ay = function(id) return ay[id] end,
+        rot = function(id) return rot[id] * rad_to_deg end,
+        omiga = function(id) return omega[id] * rad_to_deg end,
+        timer = function(id) return tonumber(timer[id]) end,
+        hscale = function(id) return cast(float_ptr, object + id * stride + hscale_offset)[0] end,
+        vscale = function(id) return cast(float_ptr, object + id * stride + vscale_offset)[0] end,
+        status = function(id) return status_name[cast(uint32_ptr, object + id * stride + status_offset)[0]] end,
+    }
+
+    -- 碰撞检测粗筛期间修改坐标需要通知网格，交给 lstg.SetAttr 处理
+    local setter = {
+        x = function(self, id, v)
+            if view.write_barrier ~= 0 then return SetAttr(self, "x", v) end
+            x[id] = v
+            position_version[0] = position_version[0] + 1
+        end,
+        y = function(self, id, v)
+            if view.write_barrier ~= 0 then return SetAttr(self, "y", v) end
+            y[id] = v
+            position_version[0] = position_version[0] + 1
+        end,
+        vx = function(self, id, v) vx[id] = v end,
+        vy = function(self, id, v) vy[id] = v end,
+        ax = function(self, id, v) ax[id] = v end,
+        ay = function(self, id, v) ay[id] = v end,
+        rot = function(self, id, v)
+            rot[id] = v * deg_to_rad
+            position_version[0] = position_version[0] + 1
+        end,
+        omiga = function(self, id, v) omega[id] = v * deg_to_rad end,
+        timer = function(self, id, v) timer[id] = v end,
+        hscale = function(self, id, v) cast(float_ptr, object + id * stride + hscale_offset)[0] = v end,
+        vscale = function(self, id, v) cast(float_ptr, object + id * stride + vscale_offset)[0] = v end,
+    }
+
+    local mt = {}
+    function mt.__index(self, k)
+        local f = getter[k]
+        if f then
+            return f(object_id(self))
+        end
+        return GetAttr(self, k)
+    end
+    function mt.__newindex(self, k, v)
+        local f = setter[k]
+        if f then
+            return f(self, object_id(self), v)
+        end
+        return SetAttr(self, k, v)
+    end
+    return mt
+end
+
+--- 对象类启用数据视图，只影响之后创建的对象
+--- 需要 LuaJIT FFI，不可用时返回 false，对象类保持原样
+function lstg.EnableObjectView(class)
+    if not object_view_metatable then
+        local ok, mt = pcall(create_object_view_metatable)
+        if not ok then
+            lstg.Log(3, "lstg.EnableObjectView: " .. tostring(mt))
+            return false
+        end
+        object_view_metatable = mt
+        lstg.SetObjectViewMetatable(mt)
+    end
+    class[".object_view"] = true
+    return true
+end
+
 )";
 #pragma endregion
 
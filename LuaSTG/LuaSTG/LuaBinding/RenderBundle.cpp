@@ -0,0 +1,96 @@
+#include "LuaBinding/RenderBundle.hpp"
+#include "LuaBinding/lua_utility.hpp"
+#include "LuaBinding/LuaWrapperMisc.hpp"
+
+namespace LuaSTG::LuaBinding
+{
+	namespace
+	{
+		constexpr std::string_view const ClassID("lstg.RenderBundle");
+		struct Wrapper
+		{
+			Core::Graphics::IRenderBundle* bundle;
+		};
+	}
+
+	void RenderBundle::Register(lua_State* L)
+	{
+		struct Class
+		{
+			static int getVertexCount(lua_State* L)
+			{
+				lua::stack_t S(L);
+				auto* self = Cast(L, 1);
+				S.push_value<uint32_t>(self->getVertexCount());
+				return 1;
+			}
+			static int getIndexCount(lua_State* L)
+			{
+				lua::stack_t S(L);
+				auto* self = Cast(L, 1);
+				S.push_value<uint32_t>(self->getIndexCount());
+				return 1;
+			}
+			static int getCommandCount(lua_State* L)
+			{
+				lua::stack_t S(L);
+				auto* self = Cast(L, 1);
+				S.push_value<uint32_t>(self->getCommandCount());
+				return 1;
+			}
+
+			static int __tostring(lua_State* L)
+			{
+				lua::stack_t S(L);
+				auto* self = Cast(L, 1);
+				std::ignore = self;
+				S.push_value<std::string_view>(ClassID);
+				return 1;
+			}
+			static int __gc(lua_State* L)
+			{
+				Wrapper* self = (Wrapper*)luaL_checkudata(L, 1, ClassID.data());
+				if (self->bundle)
+				{
+					self->bundle->release();
+					self->bundle = nullptr;
+				}
+				return 0;
+			}
+		};
+
+		luaL_Reg const lib[] = {
+			{ "getVertexCount", &Class::getVertexCount },
+			{ "getIndexCount", &Class::getIndexCount },
+			{ "getCommandCount", &Class::getCommandCount },
+			{ NULL, NULL },
+		};
+
+		luaL_Reg const mt[] = {
+			{ "__tostring", &Class::__tostring },
+			{ "__gc", &Class::__gc },
+			{ NULL, NULL },
+		};
+
+		lua_getglobal(L, "lstg"); // ??? lstg
+		LuaSTGPlus::RegisterClassIntoTable(L, ".RenderBundle", lib, ClassID.data(), mt);
+		lua_pop(L, 1);
+	}
+	void RenderBundle::Create(lua_State* L, Core::Graphics::IRenderBundle* p_bundle)
+	{
+		assert(p_bundle);
+		Wrapper* self = (Wrapper*)lua_newuserdata(L, sizeof(Wrapper));
+		self->bundle = p_bundle;
+		if (self->bundle)
+		{
+			self->bundle->retain();
+		}
+		luaL_getmetatable(L, ClassID.data());
+		lua_setmetatable(L, -2);
+	}
+	Core::Graphics::IRenderBundle* RenderBundle::Cast(lua_State* L, int idx)
+	{
+		Wrapper* self = (Wrapper*)luaL_checkudata(L, idx, ClassID.data());
+		return self->bundle;
+	}
+}
@@ -0,0 +1,14 @@
+#pragma once
+#include "Core/Graphics/Renderer.hpp"
+#include "lua.hpp"
+
+namespace LuaSTG::LuaBinding
+{
+	class RenderBundle
+	{
+	public:
+		static void Register(lua_State* L);
+		static void Create(lua_State* L, Core::Graphics::IRenderBundle* p_bundle);
+		static Core::Graphics::IRenderBundle* Cast(lua_State* L, int idx);
+	};
+}
@@ -1,4 +1,5 @@
 #include "lua_utility.hpp"
+#include "LuaBinding/Resource.hpp"
 #include "AppFrame.h"
 
 namespace LuaSTG::Sub::LuaBinding
@@ -29,7 +30,7 @@ namespace LuaSTG::Sub::LuaBinding
 		{
 			lua::stack_t S(L);
 			auto* self = cast(L, 1);
-			auto const result = self->data->GetTexture()->getSize();
+			auto const result = self->data->GetSize();
 			S.push_value(result.x);
 			S.push_value(result.y);
 			return 2;
@@ -38,7 +39,7 @@ namespace LuaSTG::Sub::LuaBinding
 		{
 			lua::stack_t S(L);
 			auto* self = cast(L, 1);
-			auto const result = self->data->GetTexture()->getSize();
+			auto const result = self->data->GetSize();
 			S.push_value(result.x);
 			return 1;
 		}
@@ -46,7 +47,7 @@ namespace LuaSTG::Sub::LuaBinding
 		{
 			lua::stack_t S(L);
 			auto* self = cast(L, 1);
-			auto const result = self->data->GetTexture()->getSize();
+			auto const result = self->data->GetSize();
 			S.push_value(result.y);
 			return 1;
 		}
@@ -227,6 +228,17 @@ namespace LuaSTG::Sub::LuaBinding
 		{
 			return nullptr != luaL_testudata(L, idx, ClassID.data());
 		}
+		// 渲染接口每次调用都要检查，直接比较元表地址，省去在注册表中按名字查找元表
+		static inline void const* metatable_pointer{ nullptr };
+		static ResourceSprite* to(lua_State* L, int idx)
+		{
+			if (lua_type(L, idx) != LUA_TUSERDATA || !lua_getmetatable(L, idx)) {
+				return nullptr;
+			}
+			bool const match = lua_topointer(L, -1) == metatable_pointer;
+			lua_pop(L, 1);
+			return match ? static_cast<ResourceSprite*>(lua_touserdata(L, idx)) : nullptr;
+		}
 		static void registerClass(lua_State* L)
 		{
 			[[maybe_unused]] lua::stack_balancer_t SB(L);
@@ -243,6 +255,7 @@ namespace LuaSTG::Sub::LuaBinding
 			// metatable
 
 			auto const metatable = S.create_metatable(ClassID);
+			metatable_pointer = lua_topointer(L, metatable.value);
 			S.set_map_value(metatable, "__gc", &api___gc);
 			S.set_map_value(metatable, "__tostring", &api___tostring);
 			S.set_map_value(metatable, "__eq", &api___eq);
@@ -333,6 +346,16 @@ namespace LuaSTG::Sub::LuaBinding
 		{
 			return nullptr != luaL_testudata(L, idx, ClassID.data());
 		}
+		static inline void const* metatable_pointer{ nullptr };
+		static ResourceSpriteSequence* to(lua_State* L, int idx)
+		{
+			if (lua_type(L, idx) != LUA_TUSERDATA || !lua_getmetatable(L, idx)) {
+				return nullptr;
+			}
+			bool const match = lua_topointer(L, -1) == metatable_pointer;
+			lua_pop(L, 1);
+			return match ? static_cast<ResourceSpriteSequence*>(lua_touserdata(L, idx)) : nullptr;
+		}
 		static void registerClass(lua_State* L)
 		{
 			[[maybe_unused]] lua::stack_balancer_t SB(L);
@@ -347,6 +370,7 @@ namespace LuaSTG::Sub::LuaBinding
 			// metatable
 
 			auto const metatable = S.create_metatable(ClassID);
+			metatable_pointer = lua_topointer(L, metatable.value);
 			S.set_map_value(metatable, "__gc", &api___gc);
 			S.set_map_value(metatable, "__tostring", &api___tostring);
 			S.set_map_value(metatable, "__eq", &api___eq);
@@ -406,7 +430,7 @@ namespace LuaSTG::Sub::LuaBinding
 			}
 			auto const x = S.get_value<float>(4, 0.0f);
 			auto const y = S.get_value<float>(5, 0.0f);
-			auto const texture_size = texture->GetTexture()->getSize();
+			auto const texture_size = texture->GetSize();
 			auto const width = S.get_value<float>(6, float(texture_size.x));
 			auto const height = S.get_value<float>(7, float(texture_size.y));
 			auto const a = S.get_value<float>(8, 0.0f);
@@ -723,6 +747,30 @@ namespace LuaSTG::Sub::LuaBinding
 			}
 			return 0;
 		}
+		static int api_findSprite(lua_State* L)
+		{
+			lua::stack_t S(L);
+			auto const sprite_name = S.get_value<std::string_view>(1);
+			auto res = LRES.FindSprite(sprite_name.data());
+			if (!res) {
+				return luaL_error(L, "can't find sprite '%s'.", sprite_name.data());
+			}
+			auto* sprite = ResourceSprite::create(L);
+			sprite->data = res.detach(); // 转移所有权
+			return 1;
+		}
+		static int api_findSpriteSequence(lua_State* L)
+		{
+			lua::stack_t S(L);
+			auto const sprite_sequence_name = S.get_value<std::string_view>(1);
+			auto res = LRES.FindAnimation(sprite_sequence_name.data());
+			if (!res) {
+				return luaL_error(L, "can't find animation '%s'.", sprite_sequence_name.data());
+			}
+			auto* sprite_sequence = ResourceSpriteSequence::create(L);
+			sprite_sequence->data = res.detach(); // 转移所有权
+			return 1;
+		}
 		static int api_getCurrentResourceCollection(lua_State* L)
 		{
 			lua::stack_t S(L);
@@ -750,6 +798,8 @@ namespace LuaSTG::Sub::LuaBinding
 			S.set_map_value(class_table, "getResourceCollection", &api_getResourceCollection);
 			S.set_map_value(class_table, "setCurrentResourceCollection", &api_setCurrentResourceCollection);
 			S.set_map_value(class_table, "getCurrentResourceCollection", &api_getCurrentResourceCollection);
+			S.set_map_value(class_table, "findSprite", &api_findSprite);
+			S.set_map_value(class_table, "findSpriteSequence", &api_findSpriteSequence);
 
 			// register
 
@@ -759,6 +809,20 @@ namespace LuaSTG::Sub::LuaBinding
 	};
 }
 
+namespace LuaSTG::Sub::LuaBinding
+{
+	LuaSTGPlus::IResourceSprite* toResourceSprite(lua_State* L, int idx)
+	{
+		auto* self = ResourceSprite::to(L, idx);
+		return self ? self->data : nullptr;
+	}
+	LuaSTGPlus::IResourceAnimation* toResourceSpriteSequence(lua_State* L, int idx)
+	{
+		auto* self = ResourceSpriteSequence::to(L, idx);
+		return self ? self->data : nullptr;
+	}
+}
+
 int luaopen_LuaSTG_Sub(lua_State* L)
 {
 	LuaSTG::Sub::LuaBinding::ResourceTexture::registerClass(L);
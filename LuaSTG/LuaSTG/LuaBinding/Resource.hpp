@@ -1,4 +1,18 @@
 #pragma once
 #include "lua.hpp"
 
+namespace LuaSTGPlus
+{
+	struct IResourceSprite;
+	struct IResourceAnimation;
+}
+
+namespace LuaSTG::Sub::LuaBinding
+{
+	// 如果 idx 处是 ResourceSprite 对象则返回其持有的资源，否则返回 nullptr，不增加引用计数
+	LuaSTGPlus::IResourceSprite* toResourceSprite(lua_State* L, int idx);
+	// 如果 idx 处是 ResourceSpriteSequence 对象则返回其持有的资源，否则返回 nullptr，不增加引用计数
+	LuaSTGPlus::IResourceAnimation* toResourceSpriteSequence(lua_State* L, int idx);
+}
+
 int luaopen_LuaSTG_Sub(lua_State* L);
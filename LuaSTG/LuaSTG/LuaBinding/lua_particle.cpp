@@ -25,6 +25,123 @@ std::string_view const ID_TexParticle2D("particle.TexParticle2D");
 std::string_view const ID_TexPool3D("particle.TexParticlePool3D");
 std::string_view const ID_TexParticle3D("particle.TexParticle3D");
 
+static float lua_field_float(lua_State* L, int idx, char const* name, float def)
+{
+    lua_getfield(L, idx, name);
+    float const v = lua_isnil(L, -1) ? def : (float)luaL_checknumber(L, -1);
+    lua_pop(L, 1);
+    return v;
+}
+
+static uint32_t lua_field_life(lua_State* L, int idx)
+{
+    lua_getfield(L, idx, "life");
+    lua_Integer const v = luaL_checkinteger(L, -1);
+    lua_pop(L, 1);
+    if (v <= 0)
+        luaL_error(L, "particle affector life must be greater than 0");
+    return (uint32_t)v;
+}
+
+// keys 为关键帧数组，按 fn 读取每个元素
+template<typename Fn>
+static void lua_field_keys(lua_State* L, int idx, ParticleAffector& a, Fn&& fn)
+{
+    lua_getfield(L, idx, "keys");
+    luaL_checktype(L, -1, LUA_TTABLE);
+    size_t const n = lua_objlen(L, -1);
+    if (n == 0 || n > ParticleAffector::max_key_count)
+        luaL_error(L, "particle affector must have 1 to %d keys", (int)ParticleAffector::max_key_count);
+    a.key_count = (uint32_t)n;
+    for (size_t i = 0; i < n; i += 1)
+    {
+        lua_rawgeti(L, -1, (int)(i + 1));
+        fn(i);
+        lua_pop(L, 1);
+    }
+    lua_pop(L, 1);
+}
+
+// 影响器列表，每一项是带 type 字段的表：
+// { type = "gravity", x, y, z }、{ type = "drag", k }、{ type = "attractor", x, y, z, strength, radius }、
+// { type = "color", life, keys = { lstg.Color, ... } }、{ type = "scale", life, keys = { number, ... } }、
+// { type = "bounds", left, right, bottom, top, near, far }、{ type = "timer", life }
+// nil 表示清空
+static void lua_check_affectors(lua_State* L, int idx, std::vector<ParticleAffector>& affectors)
+{
+    if (lua_isnoneornil(L, idx))
+        return;
+    luaL_checktype(L, idx, LUA_TTABLE);
+    size_t const n = lua_objlen(L, idx);
+    affectors.reserve(n);
+    for (size_t i = 0; i < n; i += 1)
+    {
+        lua_rawgeti(L, idx, (int)(i + 1));
+        luaL_checktype(L, -1, LUA_TTABLE);
+        int const t = lua_gettop(L);
+        lua_getfield(L, t, "type");
+        std::string_view const type = luaL_checkstring(L, -1);
+
+        ParticleAffector a;
+        if (type == "gravity")
+        {
+            a.type = ParticleAffector::Type::Gravity;
+            a.vector = Core::Vector3F(lua_field_float(L, t, "x", 0.0f), lua_field_float(L, t, "y", 0.0f), lua_field_float(L, t, "z", 0.0f));
+        }
+        else if (type == "drag")
+        {
+            a.type = ParticleAffector::Type::Drag;
+            a.strength = lua_field_float(L, t, "k", 0.0f);
+        }
+        else if (type == "attractor")
+        {
+            a.type = ParticleAffector::Type::Attractor;
+            a.vector = Core::Vector3F(lua_field_float(L, t, "x", 0.0f), lua_field_float(L, t, "y", 0.0f), lua_field_float(L, t, "z", 0.0f));
+            a.strength = lua_field_float(L, t, "strength", 0.0f);
+            a.radius = lua_field_float(L, t, "radius", 0.0f);
+        }
+        else if (type == "color")
+        {
+            a.type = ParticleAffector::Type::ColorOverLife;
+            a.life = lua_field_life(L, t);
+            lua_field_keys(L, t, a, [&](size_t k)
+            {
+                if (lua_type(L, -1) == LUA_TNUMBER)
+                    a.color[k] = Core::Color4B((uint32_t)lua_tonumber(L, -1));
+                else
+                    a.color[k] = *LuaWrapper::ColorWrapper::Cast(L, -1);
+            });
+        }
+        else if (type == "scale")
+        {
+            a.type = ParticleAffector::Type::ScaleOverLife;
+            a.life = lua_field_life(L, t);
+            lua_field_keys(L, t, a, [&](size_t k)
+            {
+                a.scale[k] = (float)luaL_checknumber(L, -1);
+            });
+        }
+        else if (type == "bounds")
+        {
+            float const inf = std::numeric_limits<float>::infinity();
+            a.type = ParticleAffector::Type::BoundsKill;
+            a.bounds_min = Core::Vector3F(lua_field_float(L, t, "left", -inf), lua_field_float(L, t, "bottom", -inf), lua_field_float(L, t, "near", -inf));
+            a.bounds_max = Core::Vector3F(lua_field_float(L, t, "right", inf), lua_field_float(L, t, "top", inf), lua_field_float(L, t, "far", inf));
+        }
+        else if (type == "timer")
+        {
+            a.type = ParticleAffector::Type::TimerKill;
+            a.life = lua_field_life(L, t);
+        }
+        else
+        {
+            luaL_error(L, "unknown particle affector type '%s'", type.data());
+        }
+        affectors.push_back(a);
+        lua_pop(L, 2);
+    }
+}
+
 int lua_NewPool2D(lua_State* L)
 {
     int const argc = lua_gettop(L);
@@ -98,18 +215,18 @@ int lua_pool2d_Render(lua_State* L)
 int lua_pool2d_Apply(lua_State* L)
 {
     ParticlePool2D** self = static_cast<ParticlePool2D**>(luaL_checkudata(L, 1, ID_Pool2D.data()));
+    luaL_checktype(L, 2, LUA_TFUNCTION);
+    lua_settop(L, 2);
 
-    int r_fn = luaL_ref(L, LUA_REGISTRYINDEX);
+    // 所有粒子共用同一个代理 userdata，回调返回后它会指向下一个粒子，不要保存它
+    ParticlePool2D::Particle** ud = static_cast<ParticlePool2D::Particle**>(lua_newuserdata(L, sizeof(**ud)));
+    luaL_getmetatable(L, ID_Particle2D.data());
+    lua_setmetatable(L, -2);
 
     (*self)->Apply([&](auto p) {
-        lua_rawgeti(L, LUA_REGISTRYINDEX, r_fn);
-
-        ParticlePool2D::Particle** ud = static_cast<ParticlePool2D::Particle**>(lua_newuserdata(L, sizeof(**ud)));
         *ud = p;
-        luaL_getmetatable(L, ID_Particle2D.data());
-        lua_setmetatable(L, -2);
-
-
+        lua_pushvalue(L, 2);
+        lua_pushvalue(L, 3);
         lua_call(L, 1, 1);
         bool ret = lua_toboolean(L, -1);
         lua_pop(L, 1);
@@ -117,7 +234,15 @@ int lua_pool2d_Apply(lua_State* L)
         return ret;
     });
 
-    luaL_unref(L, LUA_REGISTRYINDEX, r_fn);
+    return 0;
+}
+
+int lua_pool2d_SetAffectors(lua_State* L)
+{
+    ParticlePool2D** self = static_cast<ParticlePool2D**>(luaL_checkudata(L, 1, ID_Pool2D.data()));
+    std::vector<ParticleAffector> affectors;
+    lua_check_affectors(L, 2, affectors);
+    (*self)->SetAffectors(std::move(affectors));
     return 0;
 }
 
@@ -408,18 +533,18 @@ int lua_pool3d_Render(lua_State* L)
 int lua_pool3d_Apply(lua_State* L)
 {
     ParticlePool3D** self = static_cast<ParticlePool3D**>(luaL_checkudata(L, 1, ID_Pool3D.data()));
+    luaL_checktype(L, 2, LUA_TFUNCTION);
+    lua_settop(L, 2);
 
-    int r_fn = luaL_ref(L, LUA_REGISTRYINDEX);
+    // 所有粒子共用同一个代理 userdata，回调返回后它会指向下一个粒子，不要保存它
+    ParticlePool3D::Particle** ud = static_cast<ParticlePool3D::Particle**>(lua_newuserdata(L, sizeof(**ud)));
+    luaL_getmetatable(L, ID_Particle3D.data());
+    lua_setmetatable(L, -2);
 
     (*self)->Apply([&](auto p) {
-        lua_rawgeti(L, LUA_REGISTRYINDEX, r_fn);
-
-        ParticlePool3D::Particle** ud = static_cast<ParticlePool3D::Particle**>(lua_newuserdata(L, sizeof(**ud)));
         *ud = p;
-        luaL_getmetatable(L, ID_Particle3D.data());
-        lua_setmetatable(L, -2);
-
-
+        lua_pushvalue(L, 2);
+        lua_pushvalue(L, 3);
         lua_call(L, 1, 1);
         bool ret = lua_toboolean(L, -1);
         lua_pop(L, 1);
@@ -427,7 +552,15 @@ int lua_pool3d_Apply(lua_State* L)
         return ret;
     });
 
-    luaL_unref(L, LUA_REGISTRYINDEX, r_fn);
+    return 0;
+}
+
+int lua_pool3d_SetAffectors(lua_State* L)
+{
+    ParticlePool3D** self = static_cast<ParticlePool3D**>(luaL_checkudata(L, 1, ID_Pool3D.data()));
+    std::vector<ParticleAffector> affectors;
+    lua_check_affectors(L, 2, affectors);
+    (*self)->SetAffectors(std::move(affectors));
     return 0;
 }
 
@@ -768,18 +901,18 @@ int lua_texpool2d_Render(lua_State* L)
 int lua_texpool2d_Apply(lua_State* L)
 {
     TexParticlePool2D** self = static_cast<TexParticlePool2D**>(luaL_checkudata(L, 1, ID_TexPool2D.data()));
+    luaL_checktype(L, 2, LUA_TFUNCTION);
+    lua_settop(L, 2);
 
-    int r_fn = luaL_ref(L, LUA_REGISTRYINDEX);
+    // 所有粒子共用同一个代理 userdata，回调返回后它会指向下一个粒子，不要保存它
+    TexParticlePool2D::Particle** ud = static_cast<TexParticlePool2D::Particle**>(lua_newuserdata(L, sizeof(**ud)));
+    luaL_getmetatable(L, ID_TexParticle2D.data());
+    lua_setmetatable(L, -2);
 
     (*self)->Apply([&](auto p) {
-        lua_rawgeti(L, LUA_REGISTRYINDEX, r_fn);
-
-        TexParticlePool2D::Particle** ud = static_cast<TexParticlePool2D::Particle**>(lua_newuserdata(L, sizeof(**ud)));
         *ud = p;
-        luaL_getmetatable(L, ID_TexParticle2D.data());
-        lua_setmetatable(L, -2);
-
-
+        lua_pushvalue(L, 2);
+        lua_pushvalue(L, 3);
         lua_call(L, 1, 1);
         bool ret = lua_toboolean(L, -1);
         lua_pop(L, 1);
@@ -787,7 +920,15 @@ int lua_texpool2d_Apply(lua_State* L)
         return ret;
     });
 
-    luaL_unref(L, LUA_REGISTRYINDEX, r_fn);
+    return 0;
+}
+
+int lua_texpool2d_SetAffectors(lua_State* L)
+{
+    TexParticlePool2D** self = static_cast<TexParticlePool2D**>(luaL_checkudata(L, 1, ID_TexPool2D.data()));
+    std::vector<ParticleAffector> affectors;
+    lua_check_affectors(L, 2, affectors);
+    (*self)->SetAffectors(std::move(affectors));
     return 0;
 }
 
@@ -1102,18 +1243,18 @@ int lua_texpool3d_Render(lua_State* L)
 int lua_texpool3d_Apply(lua_State* L)
 {
     TexParticlePool3D** self = static_cast<TexParticlePool3D**>(luaL_checkudata(L, 1, ID_TexPool3D.data()));
+    luaL_checktype(L, 2, LUA_TFUNCTION);
+    lua_settop(L, 2);
 
-    int r_fn = luaL_ref(L, LUA_REGISTRYINDEX);
+    // 所有粒子共用同一个代理 userdata，回调返回后它会指向下一个粒子，不要保存它
+    TexParticlePool3D::Particle** ud = static_cast<TexParticlePool3D::Particle**>(lua_newuserdata(L, sizeof(**ud)));
+    luaL_getmetatable(L, ID_TexParticle3D.data());
+    lua_setmetatable(L, -2);
 
     (*self)->Apply([&](auto p) {
-        lua_rawgeti(L, LUA_REGISTRYINDEX, r_fn);
-
-        TexParticlePool3D::Particle** ud = static_cast<TexParticlePool3D::Particle**>(lua_newuserdata(L, sizeof(**ud)));
         *ud = p;
-        luaL_getmetatable(L, ID_TexParticle3D.data());
-        lua_setmetatable(L, -2);
-
-
+        lua_pushvalue(L, 2);
+        lua_pushvalue(L, 3);
         lua_call(L, 1, 1);
         bool ret = lua_toboolean(L, -1);
         lua_pop(L, 1);
@@ -1121,7 +1262,15 @@ int lua_texpool3d_Apply(lua_State* L)
         return ret;
     });
 
-    luaL_unref(L, LUA_REGISTRYINDEX, r_fn);
+    return 0;
+}
+
+int lua_texpool3d_SetAffectors(lua_State* L)
+{
+    TexParticlePool3D** self = static_cast<TexParticlePool3D**>(luaL_checkudata(L, 1, ID_TexPool3D.data()));
+    std::vector<ParticleAffector> affectors;
+    lua_check_affectors(L, 2, affectors);
+    (*self)->SetAffectors(std::move(affectors));
     return 0;
 }
 
@@ -1418,6 +1567,7 @@ luaL_Reg const pool2d_methods[] = {
     { "Update", &lua_pool2d_Update },
     { "Render", &lua_pool2d_Render },
     { "Apply", &lua_pool2d_Apply },
+    { "SetAffectors", &lua_pool2d_SetAffectors },
     { "Clear", &lua_pool2d_Clear },
     { "GetSize", &lua_pool2d_GetSize },
 
@@ -1444,6 +1594,7 @@ luaL_Reg const pool3d_methods[] = {
     { "Update", &lua_pool3d_Update },
     { "Render", &lua_pool3d_Render },
     { "Apply", &lua_pool3d_Apply },
+    { "SetAffectors", &lua_pool3d_SetAffectors },
     { "Clear", &lua_pool3d_Clear },
     { "GetSize", &lua_pool3d_GetSize },
 
@@ -1470,6 +1621,7 @@ luaL_Reg const texpool2d_methods[] = {
     { "Update", &lua_texpool2d_Update },
     { "Render", &lua_texpool2d_Render },
     { "Apply", &lua_texpool2d_Apply },
+    { "SetAffectors", &lua_texpool2d_SetAffectors },
     { "Clear", &lua_texpool2d_Clear },
     { "GetSize", &lua_texpool2d_GetSize },
 
@@ -1496,6 +1648,7 @@ luaL_Reg const texpool3d_methods[] = {
     { "Update", &lua_texpool3d_Update },
     { "Render", &lua_texpool3d_Render },
     { "Apply", &lua_texpool3d_Apply },
+    { "SetAffectors", &lua_texpool3d_SetAffectors },
     { "Clear", &lua_texpool3d_Clear },
     { "GetSize", &lua_texpool3d_GetSize },
 
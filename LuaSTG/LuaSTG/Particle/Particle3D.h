@@ -3,6 +3,7 @@
 #include "GameResource/ResourceBase.hpp"
 #include "GameResource/ResourceSprite.hpp"
 #include "Particle/ParticleList.h"
+#include "Particle/ParticleAffector.h"
 
 namespace LuaSTGPlus::Particle
 {
@@ -27,8 +28,11 @@ namespace LuaSTGPlus::Particle
 
     public:
         Particle* AddParticle(Particle p) { plist.insert(p); return plist.GetFront(); }
-        void Apply(std::function<bool(Particle*)> fn) { plist.foreach(fn); }
+        template<typename Fn>
+        void Apply(Fn&& fn) { plist.foreach(fn); }
         void Clear() { plist.clear(); }
+        void SetAffectors(std::vector<ParticleAffector> value) { affectors = std::move(value); }
+        std::vector<ParticleAffector> const& GetAffectors() const noexcept { return affectors; }
         Index GetSize() { return plist.GetSize(); }
 
         void Update();
@@ -40,6 +44,7 @@ namespace LuaSTGPlus::Particle
 
     private:
         ParticleList<Particle> plist;
+        std::vector<ParticleAffector> affectors;
         Core::ScopeObject<IResourceSprite> img;
         BlendMode blend;
     };
@@ -0,0 +1,166 @@
+#pragma once
+#include "Core/Type.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace LuaSTGPlus::Particle
+{
+    // 原生粒子影响器，由粒子池在 Update 中按顺序执行，代替逐粒子的 Lua 回调
+    struct ParticleAffector
+    {
+        enum class Type : uint8_t
+        {
+            Gravity,       // 速度加上 vector
+            Drag,          // 速度乘以 (1 - strength)
+            Attractor,     // 速度加上指向 vector 的、大小为 strength 的加速度，radius 为 0 时不限距离
+            ColorOverLife, // 按 timer / life 在关键帧之间插值颜色
+            ScaleOverLife, // 按 timer / life 在关键帧之间插值缩放
+            BoundsKill,    // 位置离开 [bounds_min, bounds_max] 时移除
+            TimerKill,     // timer 达到 life 时移除
+        };
+        static constexpr size_t max_key_count = 8;
+
+        Type type{ Type::Gravity };
+        Core::Vector3F vector;
+        float strength{ 0.0f };
+        float radius{ 0.0f };
+        uint32_t life{ 1 };
+        Core::Vector3F bounds_min;
+        Core::Vector3F bounds_max;
+        // 关键帧在寿命内均匀分布
+        uint32_t key_count{ 0 };
+        Core::Color4B color[max_key_count];
+        float scale[max_key_count]{};
+
+        // 在 [0, 1] 上取关键帧位置，返回左侧关键帧和插值系数
+        inline void FindKey(uint32_t timer, size_t* p_index, float* p_t) const noexcept
+        {
+            if (key_count < 2)
+            {
+                *p_index = 0;
+                *p_t = 0.0f;
+                return;
+            }
+            float const life_t = std::min((float)timer / (float)std::max<uint32_t>(life, 1), 1.0f);
+            float const k = life_t * (float)(key_count - 1);
+            size_t const i = std::min((size_t)k, (size_t)key_count - 2);
+            *p_index = i;
+            *p_t = k - (float)i;
+        }
+
+        // 在积分之前执行：改变速度
+        template<typename P>
+        inline void ApplyForce(P& p) const noexcept
+        {
+            constexpr bool is_3d = requires { p.pos.z; };
+            switch (type)
+            {
+            case Type::Gravity:
+                p.vel.x += vector.x;
+                p.vel.y += vector.y;
+                if constexpr (is_3d) p.vel.z += vector.z;
+                break;
+            case Type::Drag:
+                p.vel = p.vel * (1.0f - strength);
+                break;
+            case Type::Attractor: {
+                float const dx = vector.x - p.pos.x;
+                float const dy = vector.y - p.pos.y;
+                float dz = 0.0f;
+                if constexpr (is_3d) dz = vector.z - p.pos.z;
+                float const d2 = dx * dx + dy * dy + dz * dz;
+                if (d2 <= std::numeric_limits<float>::epsilon() || (radius > 0.0f && d2 > radius * radius))
+                    break;
+                float const k = strength / std::sqrt(d2);
+                p.vel.x += dx * k;
+                p.vel.y += dy * k;
+                if constexpr (is_3d) p.vel.z += dz * k;
+                break;
+            }
+            default:
+                break;
+            }
+        }
+
+        // 在积分之后执行：随寿命变化的属性，返回 true 表示移除粒子
+        template<typename P>
+        inline bool ApplyLife(P& p) const noexcept
+        {
+            constexpr bool is_3d = requires { p.pos.z; };
+            switch (type)
+            {
+            case Type::ColorOverLife: {
+                if (key_count == 0)
+                    break;
+                size_t i = 0;
+                float t = 0.0f;
+                FindKey(p.timer, &i, &t);
+                if (key_count < 2)
+                {
+                    p.color = color[0];
+                    break;
+                }
+                Core::Color4B const& c0 = color[i];
+                Core::Color4B const& c1 = color[i + 1];
+                auto const lerp = [t](uint8_t a, uint8_t b) -> uint8_t
+                {
+                    return (uint8_t)((float)a + ((float)b - (float)a) * t + 0.5f);
+                };
+                p.color = Core::Color4B(lerp(c0.r, c1.r), lerp(c0.g, c1.g), lerp(c0.b, c1.b), lerp(c0.a, c1.a));
+                break;
+            }
+            case Type::ScaleOverLife: {
+                if (key_count == 0)
+                    break;
+                size_t i = 0;
+                float t = 0.0f;
+                FindKey(p.timer, &i, &t);
+                float const s = (key_count < 2) ? scale[0] : (scale[i] + (scale[i + 1] - scale[i]) * t);
+                p.scale = Core::Vector2F(s, s);
+                break;
+            }
+            case Type::BoundsKill:
+                if (p.pos.x < bounds_min.x || p.pos.x > bounds_max.x || p.pos.y < bounds_min.y || p.pos.y > bounds_max.y)
+                    return true;
+                if constexpr (is_3d)
+                {
+                    if (p.pos.z < bounds_min.z || p.pos.z > bounds_max.z)
+                        return true;
+                }
+                break;
+            case Type::TimerKill:
+                return p.timer >= life;
+            default:
+                break;
+            }
+            return false;
+        }
+    };
+
+    template<typename P>
+    inline void IntegrateParticle(P& p) noexcept
+    {
+        p.vel += p.accel;
+        p.pos += p.vel;
+        p.rot += p.omiga;
+        p.timer += 1;
+    }
+
+    // 粒子池的更新：影响器施加的速度变化、积分、随寿命变化的属性和移除，返回 true 表示移除粒子
+    template<typename P>
+    inline bool UpdateParticle(std::vector<ParticleAffector> const& affectors, P& p)
+    {
+        for (auto const& a : affectors)
+            a.ApplyForce(p);
+        IntegrateParticle(p);
+        for (auto const& a : affectors)
+        {
+            if (a.ApplyLife(p))
+                return true;
+        }
+        return false;
+    }
+}
@@ -53,7 +53,9 @@ namespace LuaSTGPlus::Particle
             }
         }
 
-        void foreach(std::function<bool(P* const)> fn)
+        // fn 返回 true 时移除粒子
+        template<typename Fn>
+        void foreach(Fn&& fn)
         {
             if (back == INVALID_INDEX)
                 return;
@@ -84,6 +86,14 @@ namespace LuaSTGPlus::Particle
             }
         }
 
+        // 按存储顺序对所有用过的槽位调用 fn，包括已移除的粒子，不沿链表跳转，便于编译器向量化
+        template<typename Fn>
+        void foreach_slot(Fn&& fn)
+        {
+            for (Index i = 0; i < maxn; i += 1)
+                fn(arr[i].val);
+        }
+
         void clear()
         {
             maxn = 0;
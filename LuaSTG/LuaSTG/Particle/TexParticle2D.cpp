@@ -7,13 +7,13 @@ namespace LuaSTGPlus::Particle
 {
     void TexParticlePool2D::Update()
     {
-        for (Particle& p : plist)
+        if (affectors.empty())
         {
-            p.vel += p.accel;
-            p.pos += p.vel;
-            p.rot += p.omiga;
-            p.timer += 1;
+            // 没有粒子会被移除，已移除的粒子也一起积分，插入时会被覆盖
+            plist.foreach_slot([](Particle& p) { IntegrateParticle(p); });
+            return;
         }
+        plist.foreach([this](Particle* p) { return UpdateParticle(affectors, *p); });
     }
 
     void TexParticlePool2D::Render()
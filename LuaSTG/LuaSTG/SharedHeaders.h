@@ -24,6 +24,7 @@
 #include <string_view>
 #include <set>
 #include <unordered_map>
+#include <unordered_set>
 
 // 输入输出、文件系统库
 #include <fstream>
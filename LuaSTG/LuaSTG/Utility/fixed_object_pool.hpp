@@ -48,6 +48,10 @@ namespace cpp {
             }
         };
         
+        T* data() noexcept {
+            return _data;
+        };
+        
         [[nodiscard]]
         size_t size() const noexcept {
             return N - _free_size;
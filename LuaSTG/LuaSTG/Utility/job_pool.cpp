@@ -0,0 +1,94 @@
+#include "Utility/job_pool.hpp"
+
+namespace cpp {
+    job_pool::job_pool(size_t worker_count)
+        : _slices(std::make_unique<slice[]>(worker_count + 1)) {
+        _threads.reserve(worker_count);
+        for (size_t i = 0; i < worker_count; i += 1) {
+            _threads.emplace_back(&job_pool::_worker_main, this, i + 1);
+        }
+    }
+    job_pool::~job_pool() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _wake.notify_all();
+        for (auto& t : _threads) {
+            t.join();
+        }
+    }
+
+    void job_pool::_worker_main(size_t worker) {
+        uint64_t generation = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _wake.wait(lock, [&] { return _stop || _generation != generation; });
+                if (_stop) {
+                    return;
+                }
+                generation = _generation;
+            }
+            _run(worker);
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _running -= 1;
+                if (_running == 0) {
+                    _done.notify_one();
+                }
+            }
+        }
+    }
+    void job_pool::_run(size_t worker) noexcept {
+        size_t const n = concurrency();
+        // 先处理自己的段，然后依次窃取其他段
+        for (size_t k = 0; k < n; k += 1) {
+            slice& s = _slices[(worker + k) % n];
+            while (true) {
+                size_t const block = s.next.fetch_add(1, std::memory_order_relaxed);
+                if (block >= s.end) {
+                    break;
+                }
+                size_t const begin = block * _grain;
+                size_t const end = (begin + _grain < _count) ? (begin + _grain) : _count;
+                _function(_context, begin, end, worker);
+            }
+        }
+    }
+
+    void job_pool::parallel_for(size_t count, size_t grain, job_function function, void* context) {
+        if (count == 0) {
+            return;
+        }
+        if (grain == 0) {
+            grain = 1;
+        }
+        size_t const blocks = (count + grain - 1) / grain;
+        if (_threads.empty() || blocks == 1) {
+            function(context, 0, count, 0);
+            return;
+        }
+        _function = function;
+        _context = context;
+        _count = count;
+        _grain = grain;
+        size_t const n = concurrency();
+        for (size_t i = 0; i < n; i += 1) {
+            _slices[i].next.store(blocks * i / n, std::memory_order_relaxed);
+            _slices[i].end = blocks * (i + 1) / n;
+        }
+        {
+            // 加锁同时保证上面写入的任务参数对工作线程可见
+            std::lock_guard<std::mutex> lock(_mutex);
+            _running = _threads.size();
+            _generation += 1;
+        }
+        _wake.notify_all();
+        _run(0);
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _done.wait(lock, [&] { return _running == 0; });
+        }
+    }
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <vector>
+#include <memory>
+
+namespace cpp {
+    // 工作窃取线程池，只用于互不相关、不访问 lua 的纯计算任务
+    // [0, count) 按 grain 分块，每个参与者（工作线程和调用线程）先处理自己的一段，
+    // 做完后从其他参与者的段里窃取剩余的块，调用线程等待全部完成后返回
+    class job_pool {
+    public:
+        // worker 为参与者编号，范围 [0, concurrency())，可以用来索引每个参与者独占的输出缓冲区
+        using job_function = void(*)(void* context, size_t begin, size_t end, size_t worker);
+
+    private:
+        struct alignas(64) slice {
+            std::atomic<size_t> next{ 0 };
+            size_t end{ 0 };
+        };
+
+        std::vector<std::thread> _threads;
+        std::unique_ptr<slice[]> _slices;
+        std::mutex _mutex;
+        std::condition_variable _wake;
+        std::condition_variable _done;
+        uint64_t _generation{ 0 };
+        size_t _running{ 0 };
+        bool _stop{ false };
+
+        job_function _function{ nullptr };
+        void* _context{ nullptr };
+        size_t _count{ 0 };
+        size_t _grain{ 1 };
+
+    private:
+        void _worker_main(size_t worker);
+        void _run(size_t worker) noexcept;
+
+    public:
+        // 参与者数量（工作线程数 + 1）
+        size_t concurrency() const noexcept { return _threads.size() + 1; }
+
+        void parallel_for(size_t count, size_t grain, job_function function, void* context);
+
+        template<typename F>
+        void parallel_for(size_t count, size_t grain, F& f) {
+            parallel_for(count, grain, [](void* context, size_t begin, size_t end, size_t worker) {
+                (*static_cast<F*>(context))(begin, end, worker);
+            }, &f);
+        }
+
+    public:
+        // worker_count 为 0 时所有任务都在调用线程上执行
+        explicit job_pool(size_t worker_count);
+        job_pool(job_pool const&) = delete;
+        job_pool& operator=(job_pool const&) = delete;
+        ~job_pool();
+    };
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+namespace cpp {
+    // 64 位键值的稳定 LSD 基数排序，每轮 8 位
+    // 所有键值在某一字节上都相同时跳过该轮，常见的少量不同键值只需要很少的轮数
+    template<typename T>
+    struct radix_sort_item {
+        uint64_t key;
+        T value;
+    };
+
+    template<typename T>
+    radix_sort_item<T>* radix_sort(radix_sort_item<T>* data, radix_sort_item<T>* temp, size_t count) noexcept {
+        constexpr size_t radix_bits = 8;
+        constexpr size_t radix_size = size_t(1) << radix_bits;
+        constexpr size_t pass_count = 64 / radix_bits;
+
+        size_t histogram[pass_count][radix_size];
+        std::memset(histogram, 0, sizeof(histogram));
+        for (size_t i = 0; i < count; i += 1) {
+            uint64_t const key = data[i].key;
+            for (size_t pass = 0; pass < pass_count; pass += 1) {
+                histogram[pass][(key >> (pass * radix_bits)) & (radix_size - 1)] += 1;
+            }
+        }
+
+        radix_sort_item<T>* src = data;
+        radix_sort_item<T>* dst = temp;
+        for (size_t pass = 0; pass < pass_count; pass += 1) {
+            size_t* const bucket = histogram[pass];
+            // 该字节全部相同，顺序不变
+            if (count == 0 || bucket[(src[0].key >> (pass * radix_bits)) & (radix_size - 1)] == count) {
+                continue;
+            }
+            size_t offset = 0;
+            for (size_t i = 0; i < radix_size; i += 1) {
+                size_t const n = bucket[i];
+                bucket[i] = offset;
+                offset += n;
+            }
+            for (size_t i = 0; i < count; i += 1) {
+                size_t const b = (src[i].key >> (pass * radix_bits)) & (radix_size - 1);
+                dst[bucket[b]++] = src[i];
+            }
+            std::swap(src, dst);
+        }
+        return src; // 结果所在的缓冲区
+    };
+
+    // 将 double 转换为保持大小顺序的 64 位无符号整数，+0.0 和 -0.0 视为相等
+    inline uint64_t radix_sort_key(double value) noexcept {
+        if (value == 0.0) {
+            value = 0.0;
+        }
+        uint64_t bits = 0;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return (bits & 0x8000000000000000ull) ? ~bits : (bits | 0x8000000000000000ull);
+    };
+}
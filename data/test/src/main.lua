@@ -96,6 +96,8 @@ require("test_model")
 require("test_render3d")
 require("test_particle2d")
 require("test_particle2d_apply")
+require("test_particle_affector")
+require("test_particle_batch")
 require("test_particle2d_remove")
 require("test_particle2d_object")
 require("test_particle3d")
@@ -106,6 +108,28 @@ require("test_log")
 require("test_filesys")
 require("test_dwrite")
 require("test_colli")
+require("test_colli_parallel")
+require("test_colli_broadphase")
+require("test_render_list")
+require("test_kinematics")
+require("test_frame_scheduler")
+require("test_frame_profile")
+require("test_texture_async")
+require("test_archive_index")
+require("test_sprite_handle")
+require("test_sound_voice")
+require("test_sprite_instancing")
+require("test_gl_state")
+require("test_premul_batching")
+require("test_texture_atlas")
+require("test_draw_list")
+require("test_render_bundle")
+require("test_render_bundle_objects")
+require("test_object_view")
+require("test_batch_dispatch")
+require("test_table_recycle")
+require("test_gc_pacing")
+require("test_music_stream")
 require("test_posteffect")
 require("test_blend_color_burn")
 require("test_monitor")
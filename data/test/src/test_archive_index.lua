@@ -0,0 +1,165 @@
+local test = require("test")
+local imgui = require("imgui")
+local ziputil = require("ziputil")
+
+local archive_count = 5
+local files_per_archive = 2000
+local shared_count = 100
+
+local function archive_path(k)
+    return string.format("test_archive_index_%d.zip", k)
+end
+
+local function file_name(k, i)
+    return string.format("bench/%d/file_%05d.txt", k, i)
+end
+
+local function shared_name(i)
+    return string.format("bench/shared/file_%05d.txt", i)
+end
+
+local function create_archives()
+    for k = 1, archive_count do
+        local entries = {}
+        for i = 1, files_per_archive do
+            local name = file_name(k, i)
+            entries[#entries + 1] = { name, name }
+        end
+        -- 每个文件包都有的同名文件，内容是文件包编号，后加载的文件包优先
+        for i = 1, shared_count do
+            entries[#entries + 1] = { shared_name(i), tostring(k) }
+        end
+        ziputil.write_zip(archive_path(k), entries)
+    end
+end
+
+local function load_archives()
+    for k = 1, archive_count do
+        lstg.FileManager.LoadArchive(archive_path(k))
+    end
+end
+
+local function unload_archives()
+    for k = 1, archive_count do
+        lstg.FileManager.UnloadArchive(archive_path(k))
+    end
+end
+
+---@param names string[]
+local function resolve(names)
+    local result = {}
+    for i, name in ipairs(names) do
+        result[i] = (lstg.FileManager.FileExist(name, true) and lstg.LoadTextFile(name)) or false
+    end
+    return result
+end
+
+---@class test.Module.ArchiveIndex : test.Base
+local M = {}
+
+function M:onCreate()
+    self.index = lstg.FileManager.GetArchiveIndex()
+    self.log = lstg.GetResLoadInfo()
+    self.stopwatch = lstg.StopWatch()
+    self.names = {}
+    for k = 1, archive_count do
+        for i = 1, files_per_archive do
+            self.names[#self.names + 1] = file_name(k, i)
+        end
+    end
+    self.shared_names = {}
+    for i = 1, shared_count do
+        self.shared_names[i] = shared_name(i)
+    end
+    self.time = { [true] = 0, [false] = 0 }
+    self.verify_result = "not run"
+    create_archives()
+    load_archives()
+end
+
+function M:onDestroy()
+    unload_archives()
+    for k = 1, archive_count do
+        os.remove(archive_path(k))
+    end
+    lstg.FileManager.SetArchiveIndex(self.index)
+end
+
+---@param index boolean
+function M:bench(index)
+    lstg.FileManager.SetArchiveIndex(index)
+    lstg.SetResLoadInfo(false)
+    local sw = self.stopwatch
+    sw:Reset()
+    local result = resolve(self.names)
+    self.time[index] = sw:GetElapsed()
+    local shared = resolve(self.shared_names)
+    lstg.SetResLoadInfo(self.log)
+    lstg.FileManager.SetArchiveIndex(self.index)
+    return result, shared
+end
+
+function M:verify()
+    local a, sa = self:bench(false)
+    local b, sb = self:bench(true)
+    local same = (#a == #b) and (#sa == #sb)
+    for i = 1, #a do
+        -- 文件内容就是文件名
+        if a[i] ~= b[i] or b[i] ~= self.names[i] then
+            same = false
+        end
+    end
+    for i = 1, #sa do
+        if sa[i] ~= sb[i] or sb[i] ~= tostring(archive_count) then
+            same = false
+        end
+    end
+    -- 卸载优先级最高的文件包后，同名文件来自下一个文件包
+    lstg.FileManager.UnloadArchive(archive_path(archive_count))
+    for _, v in ipairs(resolve(self.shared_names)) do
+        if v ~= tostring(archive_count - 1) then
+            same = false
+        end
+    end
+    lstg.FileManager.LoadArchive(archive_path(archive_count))
+    -- 和 minizip 查找条目的规则一致，'\\' 和 '/' 是同一个分隔符
+    local backslash_names = {}
+    for i = 1, files_per_archive do
+        backslash_names[i] = (self.names[i]:gsub("/", "\\"))
+    end
+    for _, index in ipairs({ false, true }) do
+        lstg.FileManager.SetArchiveIndex(index)
+        for i, v in ipairs(resolve(backslash_names)) do
+            if v ~= self.names[i] then
+                same = false
+            end
+        end
+    end
+    lstg.FileManager.SetArchiveIndex(self.index)
+    self.verify_result = same and "identical" or "MISMATCH"
+end
+
+function M:onUpdate()
+    local ImGui = imgui.ImGui
+    if ImGui.Begin("Archive Index Benchmark") then
+        if ImGui.Button("Hashed Index") then
+            self:bench(true)
+        end
+        if ImGui.Button("Linear Scan") then
+            self:bench(false)
+        end
+        if ImGui.Button("Verify") then
+            self:verify()
+        end
+        ImGui.Text(string.format("%d names across %d archives", #self.names, archive_count))
+        ImGui.Text(string.format("hashed index: %.3fms", 1000.0 * self.time[true]))
+        ImGui.Text(string.format("linear scan: %.3fms", 1000.0 * self.time[false]))
+        ImGui.Text(string.format("index vs linear: %s", self.verify_result))
+    end
+    ImGui.End()
+end
+
+function M:onRender()
+end
+
+test.registerTest("test.Module.ArchiveIndex", M)
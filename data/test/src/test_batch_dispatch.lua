@@ -0,0 +1,214 @@
+local test = require("test")
+local imgui = require("imgui")
+
+local del_count = 0
+
+-- 回调只读写对象自身，逐个调用和批量调用的结果相同
+local function create_class(k)
+    return {
+        function() end,
+        function(self)
+            del_count = del_count + 1
+        end,
+        function(self)
+            self.rot = self.rot + k
+            if self.timer % 30 == 0 then
+                self.vx = self.vx * 0.5 + k * 0.1
+            end
+        end,
+        function(self)
+            lstg.DefaultRenderFunc(self)
+        end,
+        function() end,
+        function() end;
+        is_class = true,
+        -- 只有 del、frame、render 回调使用脚本
+        default_function = 98,
+    }
+end
+
+local classes = { create_class(1), create_class(2), create_class(3), create_class(4) }
+
+local object_count = 10000
+local verify_count = 2000
+local verify_frames = 120
+
+local function spawn(count)
+    for i = 1, count do
+        local obj = lstg.New(classes[(math.floor(i / 100) % #classes) + 1])
+        obj.img = "test:batch_dispatch:img"
+        obj.x = math.random() * 600 - 300
+        obj.y = math.random() * 600 - 300
+        obj.vx = math.random() * 4 - 2
+        obj.vy = math.random() * 4 - 2
+        obj.colli = false
+    end
+end
+
+local function snapshot()
+    local result = {}
+    for _, obj in lstg.ObjList(-1) do
+        result[#result + 1] = { obj.x, obj.y, obj.vx, obj.vy, obj.rot, obj.timer }
+    end
+    result[#result + 1] = { del_count }
+    return result
+end
+
+---@param batch boolean
+local function simulate(batch)
+    lstg.SetBatchDispatch(batch)
+    lstg.ResetPool()
+    lstg.SetBound(-320, 320, -320, 320)
+    math.randomseed(1919810)
+    del_count = 0
+    spawn(verify_count)
+    for _ = 1, verify_frames do
+        lstg.ObjFrame()
+        lstg.BoundCheck()
+        lstg.UpdateXY()
+        lstg.AfterFrame()
+    end
+    return snapshot()
+end
+
+-- 第 error_at 个对象的 frame 回调出错
+local error_at = 50
+local error_class = {
+    function() end,
+    function() end,
+    function(self)
+        if self.error_index == error_at then
+            error("test error")
+        end
+        self.checked = true
+    end,
+    function() end,
+    function() end,
+    function() end;
+    is_class = true,
+    default_function = 126 - 8,
+}
+
+--- 批量回调出错后错误信息带有调用栈，之后仍然可以正常批量回调
+local function check_error()
+    lstg.SetBatchDispatch(true)
+    lstg.ResetPool()
+    local objects = {}
+    for i = 1, error_at * 2 do
+        local obj = lstg.New(error_class)
+        obj.error_index = i
+        obj.colli = false
+        objects[i] = obj
+    end
+    local ok, message = pcall(lstg.ObjFrame)
+    if ok or not string.find(tostring(message), "stack traceback", 1, true) then
+        return "no traceback: " .. tostring(message)
+    end
+    objects[error_at].error_index = 0
+    ok, message = pcall(lstg.ObjFrame)
+    if not ok then
+        return "second ObjFrame failed: " .. tostring(message)
+    end
+    for i = 1, #objects do
+        if not objects[i].checked then
+            return "object skipped after error"
+        end
+    end
+    return "ok"
+end
+
+---@class test.Module.BatchDispatch : test.Base
+local M = {}
+
+function M:onCreate()
+    self.batch = lstg.GetBatchDispatch()
+    local old_pool = lstg.GetResourceStatus()
+    lstg.SetResourceStatus("global")
+    lstg.LoadTexture("test:batch_dispatch:tex", "res/white.png")
+    lstg.LoadImage("test:batch_dispatch:img", "test:batch_dispatch:tex", 0, 0, 4, 4)
+    lstg.SetResourceStatus(old_pool)
+    self.stopwatch = lstg.StopWatch()
+    self.verify_result = "not run"
+    self.error_result = "not run"
+    self:reset()
+end
+
+function M:onDestroy()
+    lstg.SetBatchDispatch(self.batch)
+    lstg.SetBound(-100, 100, -100, 100)
+    lstg.ResetPool()
+    lstg.RemoveResource("global", 2, "test:batch_dispatch:img")
+    lstg.RemoveResource("global", 1, "test:batch_dispatch:tex")
+end
+
+function M:reset()
+    lstg.ResetPool()
+    lstg.SetBound(-1e9, 1e9, -1e9, 1e9)
+    math.randomseed(114514)
+    spawn(object_count)
+    self.frames = 0
+    self.frame_time = 0
+    self.render_time = 0
+end
+
+function M:verify()
+    local mode = lstg.GetBatchDispatch()
+    local a = simulate(false)
+    local b = simulate(true)
+    local same = (#a == #b)
+    for i = 1, #a do
+        for j = 1, #a[i] do
+            if string.format("%a", a[i][j]) ~= string.format("%a", b[i][j]) then
+                same = false
+            end
+        end
+    end
+    self.verify_result = same and "identical" or "MISMATCH"
+    self.error_result = check_error()
+    lstg.SetBatchDispatch(mode)
+    self:reset()
+end
+
+function M:onUpdate()
+    local ImGui = imgui.ImGui
+    if ImGui.Begin("Batch Dispatch Benchmark") then
+        if ImGui.Button("Batch Dispatch") then
+            lstg.SetBatchDispatch(true)
+            self:reset()
+        end
+        if ImGui.Button("Per Object") then
+            lstg.SetBatchDispatch(false)
+            self:reset()
+        end
+        if ImGui.Button("Verify") then
+            self:verify()
+        end
+        local n = math.max(self.frames, 1)
+        ImGui.Text(string.format("mode: %s, objects: %d", lstg.GetBatchDispatch() and "batch" or "per object", lstg.GetnObj()))
+        ImGui.Text(string.format("ObjFrame: %.3fms", 1000.0 * self.frame_time / n))
+        ImGui.Text(string.format("ObjRender: %.3fms", 1000.0 * self.render_time / n))
+        ImGui.Text(string.format("batch vs per object (%d objects, %d frames): %s", verify_count, verify_frames, self.verify_result))
+        ImGui.Text(string.format("error in callback: %s", self.error_result))
+    end
+    ImGui.End()
+
+    local sw = self.stopwatch
+    sw:Reset()
+    lstg.ObjFrame()
+    self.frame_time = self.frame_time + sw:GetElapsed()
+    lstg.BoundCheck()
+    lstg.UpdateXY()
+    lstg.AfterFrame()
+    self.frames = self.frames + 1
+end
+
+function M:onRender()
+    window:applyCameraV()
+    lstg.RenderClear(lstg.Color(0xFF000000))
+    local sw = self.stopwatch
+    sw:Reset()
+    lstg.ObjRender()
+    self.render_time = self.render_time + sw:GetElapsed()
+end
+
+test.registerTest("test.Module.BatchDispatch", M)
@@ -0,0 +1,204 @@
+local test = require("test")
+local imgui = require("imgui")
+
+local GROUP_PLAYER = 1
+local GROUP_ENEMY_BULLET = 2
+
+local bullet_class = {
+    function() end,
+    function() end,
+    function() end,
+    function() end,
+    function() end,
+    function() end;
+    is_class = true,
+    default_function = 126,
+}
+
+-- 记录回调顺序，在回调中修改碰撞相关的状态；
+-- 还会尝试修改碰撞组 B 中下一个对象的 group，逐对检测时这个对象被锁定，修改会报错，粗筛必须表现一致
+local hit_log = {}
+local hit_count = 0
+local next_serial = 0
+local bullets = {}
+
+local function new_bullet(x, y)
+    local obj = lstg.New(bullet_class)
+    next_serial = next_serial + 1
+    obj.serial = next_serial
+    obj.x = x
+    obj.y = y
+    obj.vx = math.random() * 2 - 1
+    obj.vy = math.random() * 2 - 1
+    obj.group = GROUP_ENEMY_BULLET
+    obj.rect = (math.random() < 0.25)
+    obj.a = math.random(2, 8)
+    obj.b = math.random(2, 8)
+    obj.rot = math.random() * 360
+    bullets[obj.serial] = obj
+    return obj
+end
+
+local player_class = {
+    function() end,
+    function() end,
+    function() end,
+    function() end,
+    function(self, other)
+        hit_count = hit_count + 1
+        hit_log[#hit_log + 1] = self.serial
+        hit_log[#hit_log + 1] = other.serial
+        if hit_count % 97 == 0 then
+            lstg.Del(other)
+        elseif hit_count % 89 == 0 then
+            other.colli = false
+        elseif hit_count % 113 == 0 then
+            other.x = other.x + 50
+        elseif hit_count % 127 == 0 then
+            new_bullet(self.x, self.y)
+        elseif hit_count % 7 == 0 then
+            local next_bullet = bullets[other.serial + 1]
+            if next_bullet and lstg.IsValid(next_bullet) then
+                local ok = pcall(function()
+                    next_bullet.group = GROUP_ENEMY_BULLET
+                end)
+                hit_log[#hit_log + 1] = ok and "moved" or "locked"
+            end
+        end
+    end,
+    function() end;
+    is_class = true,
+    default_function = 0,
+}
+
+local player_count = 32
+local bullet_count = 4096
+local verify_frames = 60
+
+local function spawn()
+    math.randomseed(1919810)
+    next_serial = 0
+    bullets = {}
+    for _ = 1, player_count do
+        local obj = lstg.New(player_class)
+        next_serial = next_serial + 1
+        obj.serial = next_serial
+        obj.x = math.random() * 400 - 200
+        obj.y = math.random() * 400 - 200
+        obj.vx = math.random() * 2 - 1
+        obj.vy = math.random() * 2 - 1
+        obj.group = GROUP_PLAYER
+        obj.a = 16
+        obj.b = 16
+    end
+    for _ = 1, bullet_count do
+        new_bullet(math.random() * 400 - 200, math.random() * 400 - 200)
+    end
+end
+
+---@param broad_phase boolean
+local function simulate(broad_phase)
+    lstg.SetCollisionParallel(false)
+    lstg.SetCollisionBroadPhase(broad_phase)
+    lstg.ResetPool()
+    lstg.SetBound(-300, 300, -300, 300)
+    hit_log = {}
+    hit_count = 0
+    spawn()
+    for _ = 1, verify_frames do
+        lstg.ObjFrame()
+        lstg.BoundCheck()
+        lstg.CollisionCheck(GROUP_PLAYER, GROUP_ENEMY_BULLET)
+        lstg.UpdateXY()
+        lstg.AfterFrame()
+    end
+    return hit_log
+end
+
+---@class test.Module.CollisionBroadPhase : test.Base
+local M = {}
+
+function M:onCreate()
+    self.parallel = lstg.GetCollisionParallel()
+    self.broad_phase = lstg.GetCollisionBroadPhase()
+    self.stopwatch = lstg.StopWatch()
+    self.verify_result = "not run"
+    self:reset()
+end
+
+function M:onDestroy()
+    lstg.SetCollisionParallel(self.parallel)
+    lstg.SetCollisionBroadPhase(self.broad_phase)
+    lstg.SetBound(-100, 100, -100, 100)
+    lstg.ResetPool()
+    bullets = {}
+end
+
+function M:reset()
+    lstg.ResetPool()
+    lstg.SetBound(-1e9, 1e9, -1e9, 1e9)
+    spawn()
+    self.frames = 0
+    self.colli_time = 0
+end
+
+function M:verify()
+    local broad_phase = lstg.GetCollisionBroadPhase()
+    local a = simulate(false)
+    local b = simulate(true)
+    local same = (#a == #b)
+    local locked = 0
+    for i = 1, #a do
+        if a[i] ~= b[i] then
+            same = false
+        end
+        if a[i] == "locked" then
+            locked = locked + 1
+        end
+    end
+    self.verify_result = string.format("%s, %d log entries, %d locked", same and "identical" or "MISMATCH", #a, locked)
+    lstg.SetCollisionParallel(false)
+    lstg.SetCollisionBroadPhase(broad_phase)
+    self:reset()
+end
+
+function M:onUpdate()
+    local ImGui = imgui.ImGui
+    if ImGui.Begin("Collision Broad Phase") then
+        if ImGui.Button("Broad Phase") then
+            lstg.SetCollisionBroadPhase(true)
+            self:reset()
+        end
+        if ImGui.Button("Pairwise") then
+            lstg.SetCollisionBroadPhase(false)
+            self:reset()
+        end
+        if ImGui.Button("Verify") then
+            self:verify()
+        end
+        local n = math.max(self.frames, 1)
+        ImGui.Text(string.format("mode: %s, objects: %d", lstg.GetCollisionBroadPhase() and "broad phase" or "pairwise", lstg.GetnObj()))
+        ImGui.Text(string.format("CollisionCheck: %.3fms", 1000.0 * self.colli_time / n))
+        ImGui.Text(string.format("callback order, hits and locks, pairwise vs broad phase (%d frames): %s", verify_frames, self.verify_result))
+    end
+    ImGui.End()
+
+    lstg.SetCollisionParallel(false)
+    lstg.ObjFrame()
+    lstg.BoundCheck()
+    local sw = self.stopwatch
+    sw:Reset()
+    lstg.CollisionCheck(GROUP_PLAYER, GROUP_ENEMY_BULLET)
+    self.colli_time = self.colli_time + sw:GetElapsed()
+    self.frames = self.frames + 1
+    lstg.UpdateXY()
+    lstg.AfterFrame()
+end
+
+function M:onRender()
+    window:applyCameraV()
+    lstg.RenderGroupCollider(GROUP_PLAYER, lstg.Color(128, 0, 255, 0))
+    lstg.RenderGroupCollider(GROUP_ENEMY_BULLET, lstg.Color(128, 255, 0, 0))
+end
+
+test.registerTest("test.Module.CollisionBroadPhase", M)
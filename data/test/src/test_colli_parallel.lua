@@ -0,0 +1,211 @@
+local test = require("test")
+local imgui = require("imgui")
+
+local GROUP_PLAYER = 1
+local GROUP_ENEMY_BULLET = 2
+
+local bullet_class = {
+    function() end,
+    function() end,
+    function() end,
+    function() end,
+    function() end,
+    function() end;
+    is_class = true,
+    default_function = 126,
+}
+
+-- 记录回调顺序，并且在回调中修改碰撞相关的状态，覆盖回退到逐对检测的路径
+local hit_log = {}
+local hit_count = 0
+local next_serial = 0
+
+local function new_bullet(x, y)
+    local obj = lstg.New(bullet_class)
+    next_serial = next_serial + 1
+    obj.serial = next_serial
+    obj.x = x
+    obj.y = y
+    obj.vx = math.random() * 2 - 1
+    obj.vy = math.random() * 2 - 1
+    obj.group = GROUP_ENEMY_BULLET
+    obj.rect = (math.random() < 0.25)
+    obj.a = math.random(2, 8)
+    obj.b = math.random(2, 8)
+    obj.rot = math.random() * 360
+    return obj
+end
+
+local player_class = {
+    function() end,
+    function() end,
+    function() end,
+    function() end,
+    function(self, other)
+        hit_count = hit_count + 1
+        hit_log[#hit_log + 1] = self.serial
+        hit_log[#hit_log + 1] = other.serial
+        if hit_count % 97 == 0 then
+            lstg.Del(other)
+        elseif hit_count % 89 == 0 then
+            other.colli = false
+        elseif hit_count % 113 == 0 then
+            other.x = other.x + 50
+        elseif hit_count % 127 == 0 then
+            new_bullet(self.x, self.y)
+        end
+    end,
+    function() end;
+    is_class = true,
+    default_function = 0,
+}
+
+local player_count = 32
+local bullet_count = 4096
+local verify_frames = 60
+
+local function spawn()
+    math.randomseed(1919810)
+    next_serial = 0
+    for _ = 1, player_count do
+        local obj = lstg.New(player_class)
+        next_serial = next_serial + 1
+        obj.serial = next_serial
+        obj.x = math.random() * 400 - 200
+        obj.y = math.random() * 400 - 200
+        obj.vx = math.random() * 2 - 1
+        obj.vy = math.random() * 2 - 1
+        obj.group = GROUP_PLAYER
+        obj.a = 16
+        obj.b = 16
+    end
+    for _ = 1, bullet_count do
+        new_bullet(math.random() * 400 - 200, math.random() * 400 - 200)
+    end
+end
+
+local function step()
+    lstg.ObjFrame()
+    lstg.BoundCheck()
+    lstg.CollisionCheck(GROUP_PLAYER, GROUP_ENEMY_BULLET)
+    lstg.UpdateXY()
+    lstg.AfterFrame()
+end
+
+---@param parallel boolean
+---@param broad_phase boolean
+local function simulate(parallel, broad_phase)
+    lstg.SetCollisionParallel(parallel)
+    lstg.SetCollisionBroadPhase(broad_phase)
+    lstg.ResetPool()
+    lstg.SetBound(-300, 300, -300, 300)
+    hit_log = {}
+    hit_count = 0
+    spawn()
+    for _ = 1, verify_frames do
+        step()
+    end
+    return hit_log
+end
+
+local function compare(a, b)
+    if #a ~= #b then
+        return false
+    end
+    for i = 1, #a do
+        if a[i] ~= b[i] then
+            return false
+        end
+    end
+    return true
+end
+
+---@class test.Module.CollisionParallel : test.Base
+local M = {}
+
+function M:onCreate()
+    self.parallel = lstg.GetCollisionParallel()
+    self.broad_phase = lstg.GetCollisionBroadPhase()
+    self.stopwatch = lstg.StopWatch()
+    self.verify_result = "not run"
+    self:reset()
+end
+
+function M:onDestroy()
+    lstg.SetCollisionParallel(self.parallel)
+    lstg.SetCollisionBroadPhase(self.broad_phase)
+    lstg.SetBound(-100, 100, -100, 100)
+    lstg.ResetPool()
+end
+
+function M:reset()
+    lstg.ResetPool()
+    lstg.SetBound(-1e9, 1e9, -1e9, 1e9)
+    spawn()
+    self.frames = 0
+    self.colli_time = 0
+end
+
+function M:verify()
+    local parallel = lstg.GetCollisionParallel()
+    local broad_phase = lstg.GetCollisionBroadPhase()
+    local a = simulate(false, false)
+    local b = simulate(false, true)
+    local c = simulate(true, false)
+    self.verify_result = string.format("%s, %d hits", (compare(a, b) and compare(a, c)) and "identical" or "MISMATCH", math.floor(#a / 2))
+    lstg.SetCollisionParallel(parallel)
+    lstg.SetCollisionBroadPhase(broad_phase)
+    self:reset()
+end
+
+function M:onUpdate()
+    local ImGui = imgui.ImGui
+    if ImGui.Begin("Parallel Collision") then
+        if ImGui.Button("Parallel") then
+            lstg.SetCollisionParallel(true)
+            self:reset()
+        end
+        if ImGui.Button("Broad Phase") then
+            lstg.SetCollisionParallel(false)
+            lstg.SetCollisionBroadPhase(true)
+            self:reset()
+        end
+        if ImGui.Button("Pairwise") then
+            lstg.SetCollisionParallel(false)
+            lstg.SetCollisionBroadPhase(false)
+            self:reset()
+        end
+        if ImGui.Button("Verify") then
+            self:verify()
+        end
+        local mode = "pairwise"
+        if lstg.GetCollisionParallel() then
+            mode = "parallel"
+        elseif lstg.GetCollisionBroadPhase() then
+            mode = "broad phase"
+        end
+        local n = math.max(self.frames, 1)
+        ImGui.Text(string.format("mode: %s, objects: %d", mode, lstg.GetnObj()))
+        ImGui.Text(string.format("CollisionCheck: %.3fms", 1000.0 * self.colli_time / n))
+        ImGui.Text(string.format("pairwise vs broad phase vs parallel (%d frames): %s", verify_frames, self.verify_result))
+    end
+    ImGui.End()
+
+    lstg.ObjFrame()
+    lstg.BoundCheck()
+    local sw = self.stopwatch
+    sw:Reset()
+    lstg.CollisionCheck(GROUP_PLAYER, GROUP_ENEMY_BULLET)
+    self.colli_time = self.colli_time + sw:GetElapsed()
+    self.frames = self.frames + 1
+    lstg.UpdateXY()
+    lstg.AfterFrame()
+end
+
+function M:onRender()
+    window:applyCameraV()
+    lstg.RenderGroupCollider(GROUP_PLAYER, lstg.Color(128, 0, 255, 0))
+    lstg.RenderGroupCollider(GROUP_ENEMY_BULLET, lstg.Color(128, 255, 0, 0))
+end
+
+test.registerTest("test.Module.CollisionParallel", M)
@@ -0,0 +1,106 @@
+local test = require("test")
+local imgui = require("imgui")
+
+-- 300 x 300 个格子，顶点数超过 16 位索引的上限
+local grid_size = 300
+local sprite_counts = { 10000, 40000 }
+
+---@class test.Module.DrawList : test.Base
+local M = {}
+
+function M:onCreate()
+    self.config = { lstg.GetDrawListConfig() }
+    local old_pool = lstg.GetResourceStatus()
+    lstg.SetResourceStatus("global")
+    lstg.LoadTexture("test:draw_list:tex", "res/block.png")
+    lstg.LoadImage("test:draw_list:img", "test:draw_list:tex", 0, 0, 64, 64)
+    lstg.SetResourceStatus(old_pool)
+
+    local n = grid_size + 1
+    local x0, y0 = window.width / 2 - 320, window.height / 2 - 320
+    local step = 640 / grid_size
+    self.mesh = lstg.MeshData(n * n, grid_size * grid_size * 6)
+    for j = 0, grid_size do
+        for i = 0, grid_size do
+            local c = lstg.Color(255, math.floor(255 * i / grid_size), math.floor(255 * j / grid_size), 255)
+            self.mesh:setVertex(j * n + i, x0 + i * step, y0 + j * step, 0, 256 * i / grid_size, 256 * j / grid_size, c)
+        end
+    end
+    local k = 0
+    for j = 0, grid_size - 1 do
+        for i = 0, grid_size - 1 do
+            local v = j * n + i
+            self.mesh:setIndex(k + 0, v)
+            self.mesh:setIndex(k + 1, v + 1)
+            self.mesh:setIndex(k + 2, v + n + 1)
+            self.mesh:setIndex(k + 3, v)
+            self.mesh:setIndex(k + 4, v + n + 1)
+            self.mesh:setIndex(k + 5, v + n)
+            k = k + 6
+        end
+    end
+
+    math.randomseed(114514)
+    self.mode = "mesh"
+    self.count = sprite_counts[1]
+    self.points = {}
+    for i = 1, sprite_counts[#sprite_counts] do
+        self.points[i] = { math.random(0, window.width), math.random(0, window.height), math.random() * 360 }
+    end
+    lstg.SetFrameProfile(true)
+end
+
+function M:onDestroy()
+    lstg.SetFrameProfile(false)
+    lstg.SetDrawListConfig(unpack(self.config))
+    lstg.RemoveResource("global", 2, "test:draw_list:img")
+    lstg.RemoveResource("global", 1, "test:draw_list:tex")
+end
+
+function M:onUpdate()
+    local ImGui = imgui.ImGui
+    if ImGui.Begin("Draw List") then
+        if ImGui.Button("Large Mesh") then
+            self.mode = "mesh"
+        end
+        for _, v in ipairs(sprite_counts) do
+            if ImGui.Button(string.format("%d sprites", v)) then
+                self.mode = "sprites"
+                self.count = v
+            end
+        end
+        if ImGui.Button("Default Draw List") then
+            lstg.SetDrawListConfig(65536, 98304, 4096, false)
+        end
+        if ImGui.Button("Large Draw List") then
+            lstg.SetDrawListConfig(262144, 393216, 4096, true)
+        end
+        local vertex_count, index_count, command_count, index32 = lstg.GetDrawListConfig()
+        ImGui.Text(string.format("draw list: %d vertices, %d indices, %d commands, 32-bit indices: %s",
+            vertex_count, index_count, command_count, tostring(index32)))
+        -- 容量不足导致的提交可以通过调大绘制列表消除，状态变化导致的不行
+        local profile = lstg.GetFrameProfile()
+        if profile then
+            ImGui.Text(string.format("draw calls: %d", profile.counters["Renderer.DrawCalls"] or 0))
+            ImGui.Text(string.format("batch flush (capacity): %d", profile.counters["Renderer.BatchFlushCapacity"] or 0))
+            ImGui.Text(string.format("batch flush (state): %d", profile.counters["Renderer.BatchFlushState"] or 0))
+            ImGui.Text(string.format("draw list grow: %d", profile.counters["Renderer.DrawListGrow"] or 0))
+        end
+    end
+    ImGui.End()
+end
+
+function M:onRender()
+    window:applyCameraV()
+    if self.mode == "mesh" then
+        lstg.RenderMesh("test:draw_list:tex", "", self.mesh)
+    else
+        local points = self.points
+        for i = 1, self.count do
+            local p = points[i]
+            lstg.Render("test:draw_list:img", p[1], p[2], p[3], 0.25)
+        end
+    end
+end
+
+test.registerTest("test.Module.DrawList", M)
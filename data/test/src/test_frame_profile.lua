@@ -0,0 +1,113 @@
+local test = require("test")
+local imgui = require("imgui")
+
+local GROUP_PLAYER = 1
+local GROUP_ENEMY_BULLET = 2
+
+local bullet_class = {
+    function() end,
+    function() end,
+    function(self)
+        self.rot = self.timer * 3
+    end,
+    function() end,
+    function() end,
+    function() end;
+    is_class = true,
+    default_function = 0,
+}
+bullet_class.name = "bullet"
+
+local player_class = {
+    function() end,
+    function() end,
+    function() end,
+    function() end,
+    function(self, other)
+        lstg.Del(other)
+    end,
+    function() end;
+    is_class = true,
+    default_function = 0,
+}
+player_class.name = "player"
+
+local function spawn_bullet()
+    local obj = lstg.New(bullet_class)
+    obj.x = math.random() * 400 - 200
+    obj.y = math.random() * 400 - 200
+    obj.vx = math.random() * 2 - 1
+    obj.vy = math.random() * 2 - 1
+    obj.group = GROUP_ENEMY_BULLET
+    obj.a = 4
+    obj.b = 4
+end
+
+---@class test.Module.FrameProfile : test.Base
+local M = {}
+
+function M:onCreate()
+    math.randomseed(114514)
+    lstg.SetFrameProfile(true, true)
+    lstg.SetBound(-250, 250, -250, 250)
+    lstg.ResetPool()
+    for i = 1, 4 do
+        local obj = lstg.New(player_class)
+        obj.x = i * 80 - 200
+        obj.group = GROUP_PLAYER
+        obj.a = 16
+        obj.b = 16
+    end
+    self.dump_result = ""
+end
+
+function M:onDestroy()
+    lstg.SetFrameProfile(true, false)
+    lstg.SetBound(-100, 100, -100, 100)
+    lstg.ResetPool()
+end
+
+function M:onUpdate()
+    local ImGui = imgui.ImGui
+    if ImGui.Begin("Frame Profile") then
+        if ImGui.Button("Dump Chrome Trace") then
+            local ok = lstg.DumpFrameProfile("frame_profile.json")
+            self.dump_result = ok and "saved to frame_profile.json" or "failed"
+        end
+        ImGui.Text(self.dump_result)
+        local profile = lstg.GetFrameProfile()
+        if profile then
+            ImGui.Text(string.format("frame %d: %.3fms, dropped %d", profile.index, profile.time * 1000.0, profile.dropped))
+            ImGui.Separator()
+            for _, scope in ipairs(profile.scopes) do
+                ImGui.Text(string.format("%s%s: %.3fms", string.rep("  ", scope.depth), scope.name, scope.time * 1000.0))
+            end
+            ImGui.Separator()
+            for name, value in pairs(profile.counters) do
+                ImGui.Text(string.format("%s: %d", name, value))
+            end
+            ImGui.Separator()
+            for _, v in ipairs(profile.callbacks) do
+                local class_name = v.class and v.class.name or "?"
+                ImGui.Text(string.format("%s.%s: %d calls, %.3fms", class_name, v.callback, v.count, v.time * 1000.0))
+            end
+        end
+    end
+    ImGui.End()
+
+    for _ = 1, 20 do
+        spawn_bullet()
+    end
+    lstg.ObjFrame()
+    lstg.BoundCheck()
+    lstg.CollisionCheck(GROUP_PLAYER, GROUP_ENEMY_BULLET)
+    lstg.UpdateXY()
+    lstg.AfterFrame()
+end
+
+function M:onRender()
+    window:applyCameraV()
+    lstg.ObjRender()
+end
+
+test.registerTest("test.Module.FrameProfile", M)
@@ -0,0 +1,233 @@
+local test = require("test")
+local imgui = require("imgui")
+
+-- 子弹：全部使用默认回调，两遍更新时在第一遍批量更新
+local bullet_class = {
+    function() end,
+    function() end,
+    function() end,
+    function() end,
+    function() end,
+    function() end;
+    is_class = true,
+    default_function = 126,
+}
+
+-- 录像输入，每帧一个方向和是否射击
+---@type { dx:number, dy:number, shoot:boolean }[]
+local replay = {}
+
+-- 发射器：只读取录像输入和自身状态，两种更新顺序的结果应当完全相同
+local shooter_class = {
+    function() end,
+    function() end,
+    function(self)
+        local input = replay[self.timer + 1]
+        if input then
+            self.x = self.x + input.dx
+            self.y = self.y + input.dy
+            if input.shoot then
+                for i = 0, 3 do
+                    local obj = lstg.New(bullet_class)
+                    obj.x = self.x
+                    obj.y = self.y
+                    obj.vx = 3 * math.cos(math.rad(self.timer * 7 + i * 90))
+                    obj.vy = 3 * math.sin(math.rad(self.timer * 7 + i * 90))
+                    obj.navi = true
+                    obj.colli = false
+                end
+            end
+        end
+    end,
+    function() end,
+    function() end,
+    function() end;
+    is_class = true,
+    default_function = 0,
+}
+
+-- 追踪者：读取目标（默认回调对象）的坐标，结果依赖更新顺序
+local tracker_class = {
+    function() end,
+    function() end,
+    function(self)
+        local target = self.target
+        if lstg.IsValid(target) then
+            self.vx = (target.x - self.x) * 0.05
+            self.vy = (target.y - self.y) * 0.05
+        end
+    end,
+    function() end,
+    function() end,
+    function() end;
+    is_class = true,
+    default_function = 0,
+}
+
+local replay_frames = 300
+local shooter_count = 16
+local object_count = 32768
+
+local function record_replay(seed)
+    math.randomseed(seed)
+    replay = {}
+    for i = 1, replay_frames do
+        replay[i] = {
+            dx = math.random(-2, 2),
+            dy = math.random(-2, 2),
+            shoot = (math.random() < 0.5),
+        }
+    end
+end
+
+local function step()
+    lstg.ObjFrame()
+    lstg.BoundCheck()
+    lstg.UpdateXY()
+    lstg.AfterFrame()
+end
+
+local function snapshot()
+    local result = {}
+    for _, obj in lstg.ObjList(-1) do
+        result[#result + 1] = { obj.x, obj.y, obj.vx, obj.vy, obj.dx, obj.dy, obj.rot, obj.timer }
+    end
+    return result
+end
+
+local function compare(a, b)
+    if #a ~= #b then
+        return false
+    end
+    for i = 1, #a do
+        for j = 1, #a[i] do
+            -- 转成字符串比较，区分 NaN 和 -0
+            if string.format("%a", a[i][j]) ~= string.format("%a", b[i][j]) then
+                return false
+            end
+        end
+    end
+    return true
+end
+
+---@param two_pass boolean
+---@param with_tracker boolean
+local function simulate(two_pass, with_tracker)
+    lstg.SetTwoPassFrame(two_pass)
+    lstg.ResetPool()
+    lstg.SetBound(-300, 300, -300, 300)
+    record_replay(1919810)
+    for i = 1, shooter_count do
+        local shooter = lstg.New(shooter_class)
+        shooter.x = (i - shooter_count / 2) * 30
+        shooter.colli = false
+        shooter.bound = false
+        if with_tracker then
+            -- 目标排在追踪者后面，交替更新时追踪者读取到的是目标上一帧的坐标
+            local tracker = lstg.New(tracker_class)
+            tracker.colli = false
+            tracker.bound = false
+            local target = lstg.New(bullet_class)
+            target.x = shooter.x
+            target.vx = 1
+            target.vy = 0.5
+            target.colli = false
+            target.bound = false
+            tracker.target = target
+        end
+    end
+    for _ = 1, replay_frames do
+        step()
+    end
+    return snapshot()
+end
+
+---@class test.Module.FrameScheduler : test.Base
+local M = {}
+
+function M:onCreate()
+    self.two_pass = lstg.GetTwoPassFrame()
+    self.stopwatch = lstg.StopWatch()
+    self.verify_result = "not run"
+    self.determinism_result = "not run"
+    self.tracker_result = "not run"
+    lstg.SetBound(-1e9, 1e9, -1e9, 1e9)
+    self:reset()
+end
+
+function M:onDestroy()
+    lstg.SetTwoPassFrame(self.two_pass)
+    lstg.SetBound(-100, 100, -100, 100)
+    lstg.ResetPool()
+end
+
+function M:reset()
+    lstg.ResetPool()
+    math.randomseed(114514)
+    record_replay(114514)
+    -- 少量脚本对象夹在大量默认对象之间
+    for i = 1, object_count do
+        local obj = lstg.New((i % 256 == 0) and shooter_class or bullet_class)
+        obj.x = math.random() * 800 - 400
+        obj.y = math.random() * 800 - 400
+        obj.vx = math.random() * 4 - 2
+        obj.vy = math.random() * 4 - 2
+        obj.colli = false
+    end
+    self.frames = 0
+    self.frame_time = 0
+end
+
+function M:verify()
+    local mode = lstg.GetTwoPassFrame()
+    local a = simulate(false, false)
+    local b = simulate(true, false)
+    local c = simulate(true, false)
+    self.verify_result = compare(a, b) and "identical" or "MISMATCH"
+    self.determinism_result = compare(b, c) and "identical" or "MISMATCH"
+    -- 回调读取默认回调对象时，两遍更新看到的是已经更新过的状态
+    local d = simulate(false, true)
+    local e = simulate(true, true)
+    self.tracker_result = compare(d, e) and "identical" or "different (expected)"
+    lstg.SetTwoPassFrame(mode)
+    lstg.SetBound(-1e9, 1e9, -1e9, 1e9)
+    self:reset()
+end
+
+function M:onUpdate()
+    local ImGui = imgui.ImGui
+    if ImGui.Begin("Frame Scheduler") then
+        if ImGui.Button("Two Pass") then
+            lstg.SetTwoPassFrame(true)
+            self:reset()
+        end
+        if ImGui.Button("Interleaved") then
+            lstg.SetTwoPassFrame(false)
+            self:reset()
+        end
+        if ImGui.Button("Verify") then
+            self:verify()
+        end
+        local n = math.max(self.frames, 1)
+        ImGui.Text(string.format("mode: %s, objects: %d", lstg.GetTwoPassFrame() and "two pass" or "interleaved", lstg.GetnObj()))
+        ImGui.Text(string.format("ObjFrame: %.3fms", 1000.0 * self.frame_time / n))
+        ImGui.Text(string.format("interleaved vs two pass (%d frames replay): %s", replay_frames, self.verify_result))
+        ImGui.Text(string.format("two pass vs two pass: %s", self.determinism_result))
+        ImGui.Text(string.format("order dependent script: %s", self.tracker_result))
+    end
+    ImGui.End()
+
+    local sw = self.stopwatch
+    sw:Reset()
+    lstg.ObjFrame()
+    self.frame_time = self.frame_time + sw:GetElapsed()
+    self.frames = self.frames + 1
+    lstg.BoundCheck()
+    lstg.UpdateXY()
+    lstg.AfterFrame()
+end
+
+function M:onRender()
+end
+
+test.registerTest("test.Module.FrameScheduler", M)
@@ -0,0 +1,73 @@
+local test = require("test")
+local imgui = require("imgui")
+
+-- 每帧产生大量短命的小表，同时保留一部分长期存活的数据，让每次回收都有一定的标记工作量
+local garbage_per_frame = 20000
+local retained_count = 200000
+
+---@class test.Module.GCPacing : test.Base
+local M = {}
+
+function M:onCreate()
+    self.limit = lstg.GetGCStatistics().limit
+    self.stopwatch = lstg.StopWatch()
+    self.retained = {}
+    for i = 1, retained_count do
+        self.retained[i] = { i, tostring(i) }
+    end
+    self:reset(2)
+end
+
+function M:onDestroy()
+    lstg.SetGCStepLimit(self.limit)
+    self.retained = nil
+    collectgarbage()
+end
+
+---@param limit number
+function M:reset(limit)
+    lstg.SetGCStepLimit(limit)
+    collectgarbage()
+    self.frames = 0
+    self.sum = 0
+    self.sum2 = 0
+    self.max = 0
+end
+
+function M:onUpdate()
+    local ImGui = imgui.ImGui
+    if ImGui.Begin("Lua GC Pacing") then
+        if ImGui.Button("Paced (2ms)") then
+            self:reset(2)
+        end
+        if ImGui.Button("Collector Only") then
+            self:reset(0)
+        end
+        local info = lstg.GetGCStatistics()
+        local n = math.max(self.frames, 1)
+        local mean = self.sum / n
+        local variance = math.max(self.sum2 / n - mean * mean, 0)
+        ImGui.Text(string.format("limit: %.3fms, last step: %.3fms (%d steps, budget %.3fms)", info.limit, info.step_time, info.step_count, info.budget))
+        ImGui.Text(string.format("heap: %.1fKB", info.heap_size / 1024))
+        ImGui.Text(string.format("update: mean %.3fms, stddev %.3fms, max %.3fms", 1000.0 * mean, 1000.0 * math.sqrt(variance), 1000.0 * self.max))
+    end
+    ImGui.End()
+
+    local sw = self.stopwatch
+    sw:Reset()
+    local sink
+    for i = 1, garbage_per_frame do
+        sink = { i, i * 2, i * 3 }
+    end
+    self.sink = sink
+    local t = sw:GetElapsed()
+    self.frames = self.frames + 1
+    self.sum = self.sum + t
+    self.sum2 = self.sum2 + t * t
+    self.max = math.max(self.max, t)
+end
+
+function M:onRender()
+end
+
+test.registerTest("test.Module.GCPacing", M)
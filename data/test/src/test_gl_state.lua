@@ -0,0 +1,81 @@
+local test = require("test")
+local imgui = require("imgui")
+
+local sprite_counts = { 1000, 10000 }
+
+---@class test.Module.GLState : test.Base
+local M = {}
+
+function M:onCreate()
+    local old_pool = lstg.GetResourceStatus()
+    lstg.SetResourceStatus("global")
+    -- 一张纹理用默认采样器，另一张用纹理自己的采样器
+    lstg.LoadTexture("test:gl_state:tex1", "res/block.png")
+    lstg.LoadTexture("test:gl_state:tex2", "res/particles.png")
+    lstg.SetTextureSamplerState("test:gl_state:tex2", "point+wrap")
+    lstg.LoadImage("test:gl_state:img1", "test:gl_state:tex1", 0, 0, 64, 64)
+    lstg.LoadImage("test:gl_state:img2", "test:gl_state:tex2", 0, 0, 32, 32)
+    lstg.SetResourceStatus(old_pool)
+
+    math.randomseed(114514)
+    self.count = sprite_counts[1]
+    self.interleave = true
+    self.points = {}
+    for i = 1, sprite_counts[#sprite_counts] do
+        self.points[i] = { math.random(0, window.width), math.random(0, window.height), math.random() * 360 }
+    end
+    lstg.SetFrameProfile(true)
+end
+
+function M:onDestroy()
+    lstg.SetFrameProfile(false)
+    lstg.RemoveResource("global", 2, "test:gl_state:img1")
+    lstg.RemoveResource("global", 2, "test:gl_state:img2")
+    lstg.RemoveResource("global", 1, "test:gl_state:tex1")
+    lstg.RemoveResource("global", 1, "test:gl_state:tex2")
+end
+
+function M:onUpdate()
+    local ImGui = imgui.ImGui
+    if ImGui.Begin("GL State") then
+        for _, v in ipairs(sprite_counts) do
+            if ImGui.Button(string.format("%d sprites", v)) then
+                self.count = v
+            end
+        end
+        if ImGui.Button(self.interleave and "Group By Texture" or "Interleave Textures") then
+            self.interleave = not self.interleave
+        end
+        ImGui.Text(string.format("sprites: %d, interleave: %s", self.count, tostring(self.interleave)))
+        -- 跳过的调用是没有状态缓存时会多出来的调用
+        local profile = lstg.GetFrameProfile()
+        if profile then
+            ImGui.Text(string.format("GL calls: %d", profile.counters["Renderer.GLCalls"] or 0))
+            ImGui.Text(string.format("GL calls skipped: %d", profile.counters["Renderer.GLCallsSkipped"] or 0))
+            ImGui.Text(string.format("batch flush: %d", profile.counters["Renderer.BatchFlush"] or 0))
+        end
+    end
+    ImGui.End()
+end
+
+function M:onRender()
+    window:applyCameraV()
+    local points = self.points
+    if self.interleave then
+        for i = 1, self.count do
+            local p = points[i]
+            lstg.Render((i % 2 == 0) and "test:gl_state:img1" or "test:gl_state:img2", p[1], p[2], p[3], 0.5)
+        end
+    else
+        for i = 1, self.count, 2 do
+            local p = points[i]
+            lstg.Render("test:gl_state:img2", p[1], p[2], p[3], 0.5)
+        end
+        for i = 2, self.count, 2 do
+            local p = points[i]
+            lstg.Render("test:gl_state:img1", p[1], p[2], p[3], 0.5)
+        end
+    end
+end
+
+test.registerTest("test.Module.GLState", M)
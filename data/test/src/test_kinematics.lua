@@ -0,0 +1,159 @@
+local test = require("test")
+local imgui = require("imgui")
+
+-- 全部使用默认回调，ObjFrame 的耗时基本等于运动学更新
+local object_class = {
+    function() end,
+    function() end,
+    function() end,
+    function() end,
+    function() end,
+    function() end;
+    is_class = true,
+    default_function = 126,
+}
+
+local object_count = 32768
+local verify_count = 4096
+local verify_frames = 120
+
+local function spawn(count)
+    for i = 1, count do
+        local obj = lstg.New(object_class)
+        obj.x = math.random() * 800 - 400
+        obj.y = math.random() * 800 - 400
+        obj.vx = math.random() * 4 - 2
+        obj.vy = math.random() * 4 - 2
+        obj.ax = math.random() * 0.02 - 0.01
+        obj.ay = math.random() * 0.02 - 0.01
+        obj.omega = math.random() * 10 - 5
+        obj.navi = (i % 4 == 0)
+        obj.colli = false
+        -- 少量对象触发速度限制和重力，走逐个对象计算的路径
+        if i % 16 == 0 then
+            obj.maxv = 1.5
+            obj.ag = 0.01
+        end
+    end
+end
+
+local function step()
+    lstg.ObjFrame()
+    lstg.BoundCheck()
+    lstg.UpdateXY()
+    lstg.AfterFrame()
+end
+
+local function snapshot()
+    local result = {}
+    for _, obj in lstg.ObjList(-1) do
+        result[#result + 1] = { obj.x, obj.y, obj.vx, obj.vy, obj.dx, obj.dy, obj.rot, obj.timer }
+    end
+    return result
+end
+
+---@param batch boolean
+local function simulate(batch)
+    lstg.SetKinematicsBatch(batch)
+    lstg.ResetPool()
+    -- 边界较小，对象陆续出界回收，id 不再连续
+    lstg.SetBound(-300, 300, -300, 300)
+    math.randomseed(1919810)
+    spawn(verify_count)
+    for _ = 1, verify_frames do
+        step()
+    end
+    return snapshot()
+end
+
+---@class test.Module.Kinematics : test.Base
+local M = {}
+
+function M:onCreate()
+    self.batch = lstg.GetKinematicsBatch()
+    self.stopwatch = lstg.StopWatch()
+    self.verify_result = "not run"
+    lstg.SetBound(-1e9, 1e9, -1e9, 1e9)
+    self:reset()
+end
+
+function M:onDestroy()
+    lstg.SetKinematicsBatch(self.batch)
+    lstg.SetBound(-100, 100, -100, 100)
+    lstg.ResetPool()
+end
+
+function M:reset()
+    lstg.ResetPool()
+    math.randomseed(114514)
+    spawn(object_count)
+    self.frames = 0
+    self.frame_time = 0
+    self.bound_time = 0
+    self.xy_time = 0
+    self.after_time = 0
+end
+
+function M:verify()
+    local mode = lstg.GetKinematicsBatch()
+    local a = simulate(false)
+    local b = simulate(true)
+    local same = (#a == #b)
+    for i = 1, #a do
+        for j = 1, #a[i] do
+            -- 转成字符串比较，区分 NaN 和 -0
+            if string.format("%a", a[i][j]) ~= string.format("%a", b[i][j]) then
+                same = false
+            end
+        end
+    end
+    self.verify_result = same and "identical" or "MISMATCH"
+    lstg.SetKinematicsBatch(mode)
+    lstg.SetBound(-1e9, 1e9, -1e9, 1e9)
+    self:reset()
+end
+
+function M:onUpdate()
+    local ImGui = imgui.ImGui
+    if ImGui.Begin("Kinematics Benchmark") then
+        if ImGui.Button("Batch (SIMD)") then
+            lstg.SetKinematicsBatch(true)
+            self:reset()
+        end
+        if ImGui.Button("Per Object") then
+            lstg.SetKinematicsBatch(false)
+            self:reset()
+        end
+        if ImGui.Button("Verify") then
+            self:verify()
+        end
+        local n = math.max(self.frames, 1)
+        ImGui.Text(string.format("mode: %s, objects: %d", lstg.GetKinematicsBatch() and "batch" or "per object", lstg.GetnObj()))
+        ImGui.Text(string.format("ObjFrame: %.3fms", 1000.0 * self.frame_time / n))
+        ImGui.Text(string.format("BoundCheck: %.3fms", 1000.0 * self.bound_time / n))
+        ImGui.Text(string.format("UpdateXY: %.3fms", 1000.0 * self.xy_time / n))
+        ImGui.Text(string.format("AfterFrame: %.3fms", 1000.0 * self.after_time / n))
+        ImGui.Text(string.format("batch vs per object (%d objects, %d frames): %s", verify_count, verify_frames, self.verify_result))
+    end
+    ImGui.End()
+
+    local sw = self.stopwatch
+    sw:Reset()
+    lstg.ObjFrame()
+    self.frame_time = self.frame_time + sw:GetElapsed()
+    sw:Reset()
+    lstg.BoundCheck()
+    self.bound_time = self.bound_time + sw:GetElapsed()
+    sw:Reset()
+    lstg.UpdateXY()
+    self.xy_time = self.xy_time + sw:GetElapsed()
+    sw:Reset()
+    lstg.AfterFrame()
+    self.after_time = self.after_time + sw:GetElapsed()
+    self.frames = self.frames + 1
+end
+
+function M:onRender()
+end
+
+test.registerTest("test.Module.Kinematics", M)
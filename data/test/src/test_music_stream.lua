@@ -0,0 +1,159 @@
+local test = require("test")
+local imgui = require("imgui")
+local ziputil = require("ziputil")
+
+-- 10 首 BGM，放在同一个文件包中：一半不压缩（stored），一半 deflate
+local track_count = 10
+local sample_rate = 44100
+local track_seconds = 20
+local archive_path = "test_music_stream.zip"
+
+--------------------------------------------------------------------------------
+--- 生成 wav 文件
+
+local u16 = ziputil.u16
+local u32 = ziputil.u32
+
+--- 单声道 16 位正弦波，周期为整数个采样，重复一个周期得到整首
+---@param period integer
+local function make_wav(period)
+    local samples = {}
+    for i = 0, period - 1 do
+        local v = math.floor(8000 * math.sin(2 * math.pi * i / period))
+        if v < 0 then
+            v = v + 65536
+        end
+        samples[#samples + 1] = u16(v)
+    end
+    local data = string.rep(table.concat(samples), math.floor(sample_rate * track_seconds / period))
+    return table.concat({
+        "RIFF", u32(36 + #data), "WAVE",
+        "fmt ", u32(16), u16(1), u16(1), u32(sample_rate), u32(sample_rate * 2), u16(2), u16(16),
+        "data", u32(#data),
+        data,
+    })
+end
+
+--------------------------------------------------------------------------------
+
+local function track_path(i)
+    return string.format("music_stream/track_%02d.wav", i)
+end
+
+local function track_name(i)
+    return string.format("test:music_stream:%d", i)
+end
+
+---@class test.Module.MusicStream : test.Base
+local M = {}
+
+function M:onCreate()
+    self.old_pool = lstg.GetResourceStatus()
+    lstg.SetResourceStatus("global")
+    self.stream = lstg.GetMusicStream()
+    self.stopwatch = lstg.StopWatch()
+    self.result = {}
+    self.verify_result = "not run"
+    local entries = {}
+    for i = 1, track_count do
+        entries[i] = { track_path(i), make_wav(80 + i * 10), i > track_count / 2 }
+    end
+    ziputil.write_zip(archive_path, entries)
+    lstg.FileManager.LoadArchive(archive_path)
+end
+
+function M:onDestroy()
+    self:unload()
+    lstg.FileManager.UnloadArchive(archive_path)
+    os.remove(archive_path)
+    lstg.SetMusicStream(self.stream)
+    lstg.SetResourceStatus(self.old_pool)
+end
+
+function M:unload()
+    if self.loaded == nil then
+        return
+    end
+    for i = 1, track_count do
+        lstg.StopMusic(track_name(i))
+        lstg.RemoveResource("global", 4, track_name(i))
+    end
+    self.loaded = nil
+end
+
+--- 加载全部音轨并同时播放，记录源文件占用内存的峰值
+---@param stream boolean
+function M:load(stream)
+    self:unload()
+    lstg.SetMusicStream(stream)
+    lstg.GetAudioSourceMemory(true)
+    local sw = self.stopwatch
+    sw:Reset()
+    for i = 1, track_count do
+        lstg.LoadMusic(track_name(i), track_path(i), 0, 0)
+    end
+    local time = sw:GetElapsed()
+    for i = 1, track_count do
+        lstg.PlayMusic(track_name(i), 0.1)
+    end
+    lstg.SetMusicStream(self.stream)
+    self.loaded = stream
+    self.result[stream] = { time = time, peak = 0 }
+end
+
+function M:verify()
+    local total = {}
+    for _, stream in ipairs({ false, true }) do
+        self:load(stream)
+        for i = 1, track_count do
+            total[#total + 1] = lstg.GetBGMTotalTime(track_name(i))
+        end
+    end
+    local same = true
+    for i = 1, track_count do
+        if total[i] ~= total[i + track_count] then
+            same = false
+        end
+    end
+    self.verify_result = same and "identical" or "MISMATCH"
+end
+
+function M:onUpdate()
+    if self.loaded ~= nil then
+        local _, peak = lstg.GetAudioSourceMemory()
+        self.result[self.loaded].peak = peak
+    end
+
+    local ImGui = imgui.ImGui
+    if ImGui.Begin("Music Stream") then
+        if ImGui.Button("Load Streamed") then
+            self:load(true)
+        end
+        if ImGui.Button("Load Into Memory") then
+            self:load(false)
+        end
+        if ImGui.Button("Unload") then
+            self:unload()
+        end
+        if ImGui.Button("Verify") then
+            self:verify()
+        end
+        local current = lstg.GetAudioSourceMemory()
+        ImGui.Text(string.format("tracks: %d (%d stored, %d deflate), loaded: %s", track_count, track_count / 2, track_count / 2, tostring(self.loaded)))
+        ImGui.Text(string.format("source memory: %.1fKB", current / 1024))
+        for _, stream in ipairs({ true, false }) do
+            local r = self.result[stream]
+            if r then
+                ImGui.Text(string.format("%s: load %.3fms, peak source memory %.1fKB",
+                    stream and "streamed" or "in memory", 1000.0 * r.time, r.peak / 1024))
+            end
+        end
+        ImGui.Text(string.format("total time streamed vs in memory: %s", self.verify_result))
+    end
+    ImGui.End()
+end
+
+function M:onRender()
+end
+
+test.registerTest("test.Module.MusicStream", M)
@@ -0,0 +1,155 @@
+local test = require("test")
+local imgui = require("imgui")
+
+-- 脚本 frame 回调，读写对象的常用属性
+local function bullet_frame(self)
+    local t = self.timer
+    if t % 60 == 0 then
+        self.vx = -self.vx
+    end
+    if self.x < -300 or self.x > 300 then
+        self.vx = -self.vx
+        self.x = self.x + self.vx
+    end
+    if self.y < -300 or self.y > 300 then
+        self.vy = -self.vy
+        self.y = self.y + self.vy
+    end
+    self.rot = self.rot + 1
+    self.omiga = self.omiga * 0.99
+    self.hscale = 1 + (t % 30) / 30
+    self.vscale = self.hscale
+    if self.status ~= "normal" then
+        self.ax = 0
+    end
+end
+
+local function create_class(view)
+    local c = {
+        function() end,
+        function() end,
+        bullet_frame,
+        function() end,
+        function() end,
+        function() end;
+        is_class = true,
+        -- 只有 frame 回调使用脚本
+        default_function = 118,
+    }
+    if view then
+        lstg.EnableObjectView(c)
+    end
+    return c
+end
+
+local object_count = 10000
+local verify_count = 2000
+local verify_frames = 120
+
+local function spawn(class, count)
+    for _ = 1, count do
+        local obj = lstg.New(class)
+        obj.x = math.random() * 600 - 300
+        obj.y = math.random() * 600 - 300
+        obj.vx = math.random() * 4 - 2
+        obj.vy = math.random() * 4 - 2
+        obj.omiga = math.random() * 10 - 5
+        obj.colli = false
+    end
+end
+
+local function snapshot()
+    local result = {}
+    for _, obj in lstg.ObjList(-1) do
+        result[#result + 1] = { obj.x, obj.y, obj.vx, obj.vy, obj.rot, obj.omiga, obj.hscale, obj.vscale, obj.timer }
+    end
+    return result
+end
+
+---@param class table
+local function simulate(class)
+    lstg.ResetPool()
+    math.randomseed(1919810)
+    spawn(class, verify_count)
+    for _ = 1, verify_frames do
+        lstg.ObjFrame()
+        lstg.UpdateXY()
+        lstg.AfterFrame()
+    end
+    return snapshot()
+end
+
+---@class test.Module.ObjectView : test.Base
+local M = {}
+
+function M:onCreate()
+    self.classes = { [true] = create_class(true), [false] = create_class(false) }
+    self.view = true
+    self.stopwatch = lstg.StopWatch()
+    self.verify_result = "not run"
+    lstg.SetBound(-1e9, 1e9, -1e9, 1e9)
+    self:reset()
+end
+
+function M:onDestroy()
+    lstg.SetBound(-100, 100, -100, 100)
+    lstg.ResetPool()
+end
+
+function M:reset()
+    lstg.ResetPool()
+    math.randomseed(114514)
+    spawn(self.classes[self.view], object_count)
+    self.frames = 0
+    self.frame_time = 0
+end
+
+function M:verify()
+    local a = simulate(self.classes[false])
+    local b = simulate(self.classes[true])
+    local same = (#a == #b)
+    for i = 1, #a do
+        for j = 1, #a[i] do
+            if string.format("%a", a[i][j]) ~= string.format("%a", b[i][j]) then
+                same = false
+            end
+        end
+    end
+    self.verify_result = same and "identical" or "MISMATCH"
+    self:reset()
+end
+
+function M:onUpdate()
+    local ImGui = imgui.ImGui
+    if ImGui.Begin("Object View Benchmark") then
+        if ImGui.Button("Object View (FFI)") then
+            self.view = true
+            self:reset()
+        end
+        if ImGui.Button("GetAttr/SetAttr") then
+            self.view = false
+            self:reset()
+        end
+        if ImGui.Button("Verify") then
+            self:verify()
+        end
+        local n = math.max(self.frames, 1)
+        ImGui.Text(string.format("mode: %s, objects: %d", self.view and "object view" or "GetAttr/SetAttr", lstg.GetnObj()))
+        ImGui.Text(string.format("ObjFrame: %.3fms", 1000.0 * self.frame_time / n))
+        ImGui.Text(string.format("object view vs GetAttr/SetAttr (%d objects, %d frames): %s", verify_count, verify_frames, self.verify_result))
+    end
+    ImGui.End()
+
+    local sw = self.stopwatch
+    sw:Reset()
+    lstg.ObjFrame()
+    self.frame_time = self.frame_time + sw:GetElapsed()
+    lstg.UpdateXY()
+    lstg.AfterFrame()
+    self.frames = self.frames + 1
+end
+
+function M:onRender()
+end
+
+test.registerTest("test.Module.ObjectView", M)
@@ -0,0 +1,109 @@
+local test = require("test")
+local imgui = require("imgui")
+local particle = require("particle")
+local random = require("random")
+local rnd = random.pcg32_fast()
+rnd:seed(114514)
+
+local emit_count = 64
+
+---@class test.Module.ParticleAffector : test.Base
+local M = {}
+
+function M:onCreate()
+    local old_pool = lstg.GetResourceStatus()
+    lstg.SetResourceStatus("global")
+    lstg.LoadTexture("test:affector:tex", "res/white.png")
+    lstg.LoadImage("test:affector:img", "test:affector:tex", 0, 0, lstg.GetTextureSize("test:affector:tex"))
+    lstg.SetResourceStatus(old_pool)
+
+    self.pool = particle.NewPool2D("test:affector:img", "mul+add", 16384)
+    self.x, self.y = window.width / 2, window.height / 2
+    self.native = true
+    self:setAffectors()
+end
+
+function M:onDestroy()
+    self.pool = nil
+    lstg.RemoveResource("global", 2, "test:affector:img")
+    lstg.RemoveResource("global", 1, "test:affector:tex")
+end
+
+function M:setAffectors()
+    if self.native then
+        self.pool:SetAffectors({
+            { type = "gravity", y = -0.02 },
+            { type = "drag", k = 0.01 },
+            { type = "attractor", x = self.x, y = self.y, strength = 0.05, radius = 256 },
+            { type = "color", life = 120, keys = { lstg.Color(255, 255, 255, 255), lstg.Color(255, 255, 128, 32), lstg.Color(0, 255, 0, 0) } },
+            { type = "scale", life = 120, keys = { 1.0, 0.5, 0.1 } },
+            { type = "bounds", left = 0, right = window.width, bottom = 0, top = window.height },
+            { type = "timer", life = 120 },
+        })
+    else
+        self.pool:SetAffectors(nil)
+    end
+end
+
+-- 与原生影响器相同的效果，用 Apply 回调实现，用于对比耗时
+function M:applyLua()
+    local x, y = self.x, self.y
+    self.pool:Apply(function(p)
+        local dx, dy = x - p.x, y - p.y
+        local d = math.sqrt(dx * dx + dy * dy)
+        if d > 0 and d <= 256 then
+            p.vx = p.vx + dx / d * 0.05
+            p.vy = p.vy + dy / d * 0.05
+        end
+        p.vy = p.vy - 0.02
+        p.vx = p.vx * 0.99
+        p.vy = p.vy * 0.99
+        local t = math.min(p.timer / 120, 1)
+        p.a = 255 * (1 - t)
+        p.sx = 1 - 0.9 * t
+        p.sy = p.sx
+        if p.timer >= 120 or p.x < 0 or p.x > window.width or p.y < 0 or p.y > window.height then
+            return true
+        end
+    end)
+end
+
+function M:onUpdate()
+    if lstg.Input.Mouse.GetKeyState(lstg.Input.Mouse.Left) then
+        self.x, self.y = lstg.Input.Mouse.GetPosition()
+        self:setAffectors()
+    end
+    for _ = 1, emit_count do
+        local p = self.pool:AddParticle(self.x, self.y, rnd:number(0, 360), rnd:number(-3, 3), rnd:number(-3, 3), 1)
+        p.omiga = rnd:number(-2, 2)
+    end
+    local t0 = os.clock()
+    self.pool:Update()
+    if not self.native then
+        self:applyLua()
+    end
+    local dt = os.clock() - t0
+
+    local ImGui = imgui.ImGui
+    if ImGui.Begin("Particle Affector") then
+        if ImGui.Button("Native Affectors") then
+            self.native = true
+            self:setAffectors()
+        end
+        if ImGui.Button("Lua Apply") then
+            self.native = false
+            self:setAffectors()
+        end
+        ImGui.Text(string.format("mode: %s, particles: %d", self.native and "native" or "lua", self.pool:GetSize()))
+        ImGui.Text(string.format("pool update: %.3fms", dt * 1000.0))
+    end
+    ImGui.End()
+end
+
+function M:onRender()
+    window:applyCameraV()
+    lstg.RenderClear(lstg.Color(0xFF000000))
+    self.pool:Render()
+end
+
+test.registerTest("test.Module.ParticleAffector", M)
@@ -0,0 +1,152 @@
+local test = require("test")
+local imgui = require("imgui")
+
+-- 100 个粒子池，每个池都保持 500 个粒子（HGE 粒子池的上限）
+local pool_count = 100
+local verify_frames = 300
+
+local function create_pools()
+    local pools = {}
+    for i = 1, pool_count do
+        local ps = lstg.ParticleSystemData("test:particle_batch:ps")
+        ps:SetOldBehavior(false)
+        ps:setSeed(i)
+        ps:setLifetime(-1)
+        ps:SetEmission(60000)
+        ps:setActive(true)
+        pools[i] = ps
+    end
+    return pools
+end
+
+---@param pools lstg.ParticleSystemData[]
+---@param frame integer
+local function update_pools(pools, frame)
+    for i, ps in ipairs(pools) do
+        local a = (frame + i * 7) * 0.05
+        ps:Update(1 / 60, window.width / 2 + 200 * math.cos(a), window.height / 2 + 200 * math.sin(a), frame % 360)
+    end
+end
+
+--- 两个粒子池的存活数和每个粒子的位置、大小、自旋、颜色逐位相同
+---@param a lstg.ParticleSystemData
+---@param b lstg.ParticleSystemData
+local function same_state(a, b)
+    local n = a:GetAliveCount()
+    if n ~= b:GetAliveCount() then
+        return false
+    end
+    for i = 1, n do
+        local sa = { a:GetParticleState(i) }
+        local sb = { b:GetParticleState(i) }
+        for j = 1, 8 do
+            if string.format("%a", sa[j]) ~= string.format("%a", sb[j]) then
+                return false
+            end
+        end
+    end
+    return true
+end
+
+--- 逐个计算和批量计算的两组粒子池同步更新，每帧比较全部粒子
+local function simulate()
+    local a = create_pools()
+    local b = create_pools()
+    for frame = 1, verify_frames do
+        lstg.SetParticleBatch(false)
+        update_pools(a, frame)
+        lstg.SetParticleBatch(true)
+        update_pools(b, frame)
+        for i = 1, pool_count do
+            if not same_state(a[i], b[i]) then
+                return false
+            end
+        end
+    end
+    return true
+end
+
+---@class test.Module.ParticleBatch : test.Base
+local M = {}
+
+function M:onCreate()
+    self.batch = lstg.GetParticleBatch()
+    local old_pool = lstg.GetResourceStatus()
+    lstg.SetResourceStatus("global")
+    lstg.LoadTexture("test:particle_batch:tex", "res/particles.png")
+    lstg.LoadImage("test:particle_batch:img", "test:particle_batch:tex", 0, 0, 32, 32)
+    lstg.LoadPS("test:particle_batch:ps", "res/ghost_fire_1.psi", "test:particle_batch:img")
+    lstg.SetResourceStatus(old_pool)
+    self.stopwatch = lstg.StopWatch()
+    self.verify_result = "not run"
+    self:reset()
+end
+
+function M:onDestroy()
+    lstg.SetParticleBatch(self.batch)
+    self.pools = nil
+    collectgarbage()
+    lstg.RemoveResource("global", 6, "test:particle_batch:ps")
+    lstg.RemoveResource("global", 2, "test:particle_batch:img")
+    lstg.RemoveResource("global", 1, "test:particle_batch:tex")
+end
+
+function M:reset()
+    self.pools = create_pools()
+    self.frame = 0
+    self.frames = 0
+    self.update_time = 0
+end
+
+function M:verify()
+    local mode = lstg.GetParticleBatch()
+    self.verify_result = simulate() and "identical" or "MISMATCH"
+    lstg.SetParticleBatch(mode)
+    self:reset()
+end
+
+function M:onUpdate()
+    local ImGui = imgui.ImGui
+    if ImGui.Begin("Particle Batch Benchmark") then
+        if ImGui.Button("Batch (SIMD)") then
+            lstg.SetParticleBatch(true)
+            self:reset()
+        end
+        if ImGui.Button("Per Particle") then
+            lstg.SetParticleBatch(false)
+            self:reset()
+        end
+        if ImGui.Button("Verify") then
+            self:verify()
+        end
+        local alive = 0
+        for _, ps in ipairs(self.pools) do
+            alive = alive + ps:GetAliveCount()
+        end
+        local n = math.max(self.frames, 1)
+        ImGui.Text(string.format("mode: %s, pools: %d, particles: %d", lstg.GetParticleBatch() and "batch" or "per particle", pool_count, alive))
+        ImGui.Text(string.format("Update: %.3fms", 1000.0 * self.update_time / n))
+        ImGui.Text(string.format("particle state, batch vs per particle (%d pools, %d frames): %s", pool_count, verify_frames, self.verify_result))
+    end
+    ImGui.End()
+
+    self.frame = self.frame + 1
+    local sw = self.stopwatch
+    sw:Reset()
+    update_pools(self.pools, self.frame)
+    -- 粒子池需要几帧才能填满，之后再计时
+    if self.frame > 60 then
+        self.update_time = self.update_time + sw:GetElapsed()
+        self.frames = self.frames + 1
+    end
+end
+
+function M:onRender()
+    window:applyCameraV()
+    lstg.RenderClear(lstg.Color(0xFF000000))
+    for i = 1, pool_count, 10 do
+        self.pools[i]:Render(1)
+    end
+end
+
+test.registerTest("test.Module.ParticleBatch", M)
@@ -0,0 +1,128 @@
+local test = require("test")
+local imgui = require("imgui")
+
+local bullet_count = 4000
+
+-- 依次测量的配置，"premultiplied off" 就是加入合并之前的绘制方式
+local measure_configs = {
+    { name = "premultiplied off", premul = false, fog = false },
+    { name = "premultiplied on", premul = true, fog = false },
+    { name = "premultiplied on, fog", premul = true, fog = true },
+}
+
+---@class test.Module.PremulBatching : test.Base
+local M = {}
+
+function M:onCreate()
+    self.mode = lstg.GetPremultipliedAlphaMode()
+    local old_pool = lstg.GetResourceStatus()
+    lstg.SetResourceStatus("global")
+    lstg.LoadTexture("test:premul:tex", "res/block.png")
+    -- 同一张纹理的两个精灵，只有混合模式不同
+    lstg.LoadImage("test:premul:alpha", "test:premul:tex", 0, 0, 128, 128)
+    lstg.LoadImage("test:premul:add", "test:premul:tex", 128, 0, 128, 128)
+    lstg.SetImageState("test:premul:alpha", "", lstg.Color(192, 255, 255, 255))
+    lstg.SetImageState("test:premul:add", "mul+add", lstg.Color(128, 255, 160, 64))
+    lstg.SetResourceStatus(old_pool)
+
+    math.randomseed(114514)
+    self.bullets = {}
+    for i = 1, bullet_count do
+        self.bullets[i] = { math.random(0, window.width), math.random(0, window.height), math.random() * 360, math.random() * 4 - 2 }
+    end
+    self.fog = false
+    self.measure = nil
+    self.measure_result = {}
+    lstg.SetFrameProfile(true)
+end
+
+function M:onDestroy()
+    lstg.SetFrameProfile(false)
+    lstg.SetPremultipliedAlphaMode(self.mode)
+    lstg.RemoveResource("global", 2, "test:premul:alpha")
+    lstg.RemoveResource("global", 2, "test:premul:add")
+    lstg.RemoveResource("global", 1, "test:premul:tex")
+end
+
+function M:startMeasure()
+    self.measure = { index = 0, wait = 0, mode = lstg.GetPremultipliedAlphaMode(), fog = self.fog }
+    self.measure_result = {}
+end
+
+--- 每个配置渲染两帧，读取上一帧的计数器，全部测完后写入日志
+function M:updateMeasure()
+    local m = self.measure
+    if not m then
+        return
+    end
+    if m.index > 0 then
+        m.wait = m.wait - 1
+        if m.wait > 0 then
+            return
+        end
+        local profile = lstg.GetFrameProfile()
+        local config = measure_configs[m.index]
+        local draw_calls = profile and profile.counters["Renderer.DrawCalls"] or 0
+        self.measure_result[m.index] = draw_calls
+        lstg.Log(2, string.format("[test_premul_batching] %s: %d draw calls per frame", config.name, draw_calls))
+    end
+    m.index = m.index + 1
+    local config = measure_configs[m.index]
+    if not config then
+        lstg.SetPremultipliedAlphaMode(m.mode)
+        self.fog = m.fog
+        self.measure = nil
+        return
+    end
+    lstg.SetPremultipliedAlphaMode(config.premul)
+    self.fog = config.fog
+    m.wait = 2
+end
+
+function M:onUpdate()
+    for _, b in ipairs(self.bullets) do
+        b[3] = b[3] + b[4]
+    end
+    self:updateMeasure()
+
+    local ImGui = imgui.ImGui
+    if ImGui.Begin("Premultiplied Batching") then
+        if ImGui.Button("Premultiplied On") then
+            lstg.SetPremultipliedAlphaMode(true)
+        end
+        if ImGui.Button("Premultiplied Off") then
+            lstg.SetPremultipliedAlphaMode(false)
+        end
+        -- 开启雾时不合并混合模式，mul+add 的精灵仍然叠加雾的颜色
+        if ImGui.Button(self.fog and "Fog Off" or "Fog On") then
+            self.fog = not self.fog
+        end
+        if ImGui.Button("Measure") and not self.measure then
+            self:startMeasure()
+        end
+        ImGui.Text(string.format("premultiplied: %s, fog: %s, bullets: %d (mul+alpha and mul+add interleaved)", tostring(lstg.GetPremultipliedAlphaMode()), tostring(self.fog), bullet_count))
+        local profile = lstg.GetFrameProfile()
+        if profile then
+            ImGui.Text(string.format("draw calls: %d", profile.counters["Renderer.DrawCalls"] or 0))
+            ImGui.Text(string.format("batch flush: %d", profile.counters["Renderer.BatchFlush"] or 0))
+        end
+        for i, config in ipairs(measure_configs) do
+            local v = self.measure_result[i]
+            ImGui.Text(string.format("%s: %s draw calls", config.name, v and tostring(v) or "-"))
+        end
+    end
+    ImGui.End()
+end
+
+function M:onRender()
+    window:applyCameraV()
+    if self.fog then
+        lstg.SetFog(0, window.width, lstg.Color(255, 64, 96, 255))
+    end
+    for i, b in ipairs(self.bullets) do
+        lstg.Render((i % 2 == 0) and "test:premul:alpha" or "test:premul:add", b[1], b[2], b[3], 0.25)
+    end
+    lstg.SetFog()
+end
+
+test.registerTest("test.Module.PremulBatching", M)
@@ -0,0 +1,102 @@
+local test = require("test")
+local imgui = require("imgui")
+
+-- 64 x 64 个地砖，两种纹理交替，其中一部分使用 mul+add
+local tile_count = 64
+local tile_size = 32
+
+---@class test.Module.RenderBundle : test.Base
+local M = {}
+
+function M:onCreate()
+    local old_pool = lstg.GetResourceStatus()
+    lstg.SetResourceStatus("global")
+    lstg.LoadTexture("test:render_bundle:tex1", "res/block.png")
+    lstg.LoadTexture("test:render_bundle:tex2", "res/image_1.png")
+    lstg.LoadImage("test:render_bundle:img1", "test:render_bundle:tex1", 0, 0, 128, 128)
+    lstg.LoadImage("test:render_bundle:img2", "test:render_bundle:tex2", 0, 0, 256, 256)
+    lstg.LoadImage("test:render_bundle:img3", "test:render_bundle:tex1", 128, 0, 128, 128)
+    lstg.SetImageState("test:render_bundle:img3", "mul+add", lstg.Color(128, 255, 255, 255))
+    lstg.SetResourceStatus(old_pool)
+
+    self.use_bundle = true
+    self.bundle = nil
+    self.timer = 0
+    lstg.SetFrameProfile(true)
+end
+
+function M:onDestroy()
+    lstg.SetFrameProfile(false)
+    self.bundle = nil
+    lstg.RemoveResource("global", 2, "test:render_bundle:img1")
+    lstg.RemoveResource("global", 2, "test:render_bundle:img2")
+    lstg.RemoveResource("global", 2, "test:render_bundle:img3")
+    lstg.RemoveResource("global", 1, "test:render_bundle:tex1")
+    lstg.RemoveResource("global", 1, "test:render_bundle:tex2")
+end
+
+function M:onUpdate()
+    self.timer = self.timer + 1
+
+    local ImGui = imgui.ImGui
+    if ImGui.Begin("Render Bundle") then
+        if ImGui.Button(self.use_bundle and "Draw Every Frame" or "Draw Bundle") then
+            self.use_bundle = not self.use_bundle
+        end
+        if ImGui.Button("Record Again") then
+            self.bundle = nil
+        end
+        ImGui.Text(string.format("tiles: %d, bundle: %s", tile_count * tile_count, tostring(self.use_bundle)))
+        if self.bundle then
+            ImGui.Text(string.format("bundle vertices: %d, indices: %d, commands: %d",
+                self.bundle:getVertexCount(), self.bundle:getIndexCount(), self.bundle:getCommandCount()))
+        end
+        local profile = lstg.GetFrameProfile()
+        if profile then
+            ImGui.Text(string.format("draw calls: %d", profile.counters["Renderer.DrawCalls"] or 0))
+            ImGui.Text(string.format("batch flush: %d", profile.counters["Renderer.BatchFlush"] or 0))
+        end
+    end
+    ImGui.End()
+end
+
+-- 与 drawBundle 的变换相同：先旋转再平移
+function M:renderTiles(dx, dy, rot)
+    local s, c = math.sin(math.rad(rot)), math.cos(math.rad(rot))
+    local scale = tile_size / 128
+    for j = 0, tile_count - 1 do
+        for i = 0, tile_count - 1 do
+            local x, y = (i + 0.5) * tile_size, (j + 0.5) * tile_size
+            local rx, ry = dx + x * c - y * s, dy + x * s + y * c
+            local k = (i + j) % 3
+            if k == 0 then
+                lstg.Render("test:render_bundle:img1", rx, ry, rot, scale)
+            elseif k == 1 then
+                lstg.Render("test:render_bundle:img2", rx, ry, rot, scale / 2)
+            else
+                lstg.Render("test:render_bundle:img3", rx, ry, 45 + rot, scale)
+            end
+        end
+    end
+end
+
+function M:onRender()
+    window:applyCameraV()
+    -- 只有相机在动：地砖整体滚动并绕中心缓慢旋转
+    local size = tile_count * tile_size
+    local dx = -(self.timer % tile_size) - (size - window.width) / 2
+    local dy = -(self.timer * 0.5 % tile_size) - (size - window.height) / 2
+    local rot = math.sin(self.timer / 120) * 5
+    if self.use_bundle then
+        if not self.bundle then
+            lstg.Renderer.beginBundle()
+            self:renderTiles(0, 0, 0)
+            self.bundle = lstg.Renderer.endBundle()
+        end
+        lstg.Renderer.drawBundle(self.bundle, dx, dy, 0, rot, 1, 1)
+    else
+        self:renderTiles(dx, dy, rot)
+    end
+end
+
+test.registerTest("test.Module.RenderBundle", M)
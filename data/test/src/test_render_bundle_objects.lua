@@ -0,0 +1,123 @@
+local test = require("test")
+local imgui = require("imgui")
+
+-- 32 x 32 个默认渲染的对象，使用同一个精灵，开启实例化时整批合并为一次实例化绘制
+local grid_count = 32
+local grid_size = 24
+
+-- 全部使用默认回调
+local tile_class = {
+    function() end,
+    function() end,
+    function() end,
+    function() end,
+    function() end,
+    function() end;
+    is_class = true,
+    default_function = 126,
+}
+
+---@class test.Module.RenderBundleObjects : test.Base
+local M = {}
+
+function M:onCreate()
+    self.instancing = lstg.GetSpriteInstancing()
+    local resource_collection = lstg.ResourceManager.getResourceCollection("global")
+    self.texture = resource_collection:createTextureFromFile("test:render_bundle_objects:tex", "res/block.png")
+    resource_collection:createSprite("test:render_bundle_objects:img", self.texture, 0, 0, 128, 128)
+
+    lstg.ResetPool()
+    for j = 0, grid_count - 1 do
+        for i = 0, grid_count - 1 do
+            local obj = lstg.New(tile_class)
+            obj.img = "test:render_bundle_objects:img"
+            obj.x = (i + 0.5) * grid_size
+            obj.y = (j + 0.5) * grid_size
+            obj.rot = (i + j) * 15
+            obj.hscale = grid_size / 128
+            obj.vscale = grid_size / 128
+            obj.bound = false
+            obj.colli = false
+        end
+    end
+
+    lstg.SetSpriteInstancing(true)
+    self.bundle = nil
+    self.timer = 0
+    self.verify_result = "not run"
+    lstg.SetFrameProfile(true)
+end
+
+function M:onDestroy()
+    lstg.SetFrameProfile(false)
+    self.bundle = nil
+    lstg.ResetPool()
+    lstg.SetSpriteInstancing(self.instancing)
+    local resource_collection = lstg.ResourceManager.getResourceCollection("global")
+    resource_collection:removeSprite("test:render_bundle_objects:img")
+    resource_collection:removeTexture(self.texture)
+end
+
+function M:record()
+    lstg.Renderer.beginBundle()
+    lstg.ObjRender()
+    return lstg.Renderer.endBundle()
+end
+
+-- 开启实例化时录制的对象必须和逐个绘制时一样多，每个对象一个四边形
+function M:verify()
+    local result = {}
+    for _, instancing in ipairs({ false, true }) do
+        lstg.SetSpriteInstancing(instancing)
+        local bundle = self:record()
+        result[instancing] = { bundle:getVertexCount(), bundle:getIndexCount() }
+    end
+    lstg.SetSpriteInstancing(true)
+    local n = lstg.GetnObj()
+    local ok = result[true][1] == n * 4 and result[true][2] == n * 6
+        and result[true][1] == result[false][1] and result[true][2] == result[false][2]
+    self.verify_result = string.format("%s (instanced %d/%d, per sprite %d/%d, objects %d)",
+        ok and "identical" or "MISMATCH", result[true][1], result[true][2], result[false][1], result[false][2], n)
+end
+
+function M:onUpdate()
+    self.timer = self.timer + 1
+
+    local ImGui = imgui.ImGui
+    if ImGui.Begin("Render Bundle Objects") then
+        if ImGui.Button(lstg.GetSpriteInstancing() and "Instancing Off" or "Instancing On") then
+            lstg.SetSpriteInstancing(not lstg.GetSpriteInstancing())
+            self.bundle = nil
+        end
+        if ImGui.Button("Record Again") then
+            self.bundle = nil
+        end
+        if ImGui.Button("Verify") then
+            self:verify()
+        end
+        ImGui.Text(string.format("objects: %d, instancing: %s", lstg.GetnObj(), tostring(lstg.GetSpriteInstancing())))
+        if self.bundle then
+            ImGui.Text(string.format("bundle vertices: %d, indices: %d, commands: %d",
+                self.bundle:getVertexCount(), self.bundle:getIndexCount(), self.bundle:getCommandCount()))
+        end
+        ImGui.Text(string.format("verify: %s", self.verify_result))
+        local profile = lstg.GetFrameProfile()
+        if profile then
+            ImGui.Text(string.format("draw calls: %d", profile.counters["Renderer.DrawCalls"] or 0))
+            ImGui.Text(string.format("sprite instances: %d", profile.counters["Renderer.SpriteInstances"] or 0))
+        end
+    end
+    ImGui.End()
+end
+
+function M:onRender()
+    window:applyCameraV()
+    if not self.bundle then
+        self.bundle = self:record()
+    end
+    local size = grid_count * grid_size
+    local rot = math.sin(self.timer / 120) * 5
+    lstg.Renderer.drawBundle(self.bundle, (window.width - size) / 2, (window.height - size) / 2, 0, rot, 1, 1)
+end
+
+test.registerTest("test.Module.RenderBundleObjects", M)
@@ -0,0 +1,102 @@
+local test = require("test")
+local imgui = require("imgui")
+
+-- 全部使用默认回调，ObjRender 的耗时基本等于渲染列表的维护和遍历
+local object_class = {
+    function() end,
+    function() end,
+    function() end,
+    function() end,
+    function() end,
+    function() end;
+    is_class = true,
+    default_function = 126,
+}
+
+local object_counts = { 1000, 10000, 32000 }
+local layers = { -700, -600, -300, -200, 0, 100, 200, 300, 500, 600 }
+local churn_rate = 0.02
+
+---@class test.Module.RenderList : test.Base
+local M = {}
+
+function M:onCreate()
+    math.randomseed(114514)
+    self.count = object_counts[1]
+    self.sort = lstg.GetRenderListSort()
+    self.stopwatch = lstg.StopWatch()
+    self:reset()
+end
+
+function M:onDestroy()
+    lstg.SetRenderListSort(self.sort)
+    lstg.ResetPool()
+end
+
+function M:reset()
+    lstg.ResetPool()
+    for _ = 1, self.count do
+        local obj = lstg.New(object_class)
+        obj.layer = layers[math.random(#layers)]
+        obj.bound = false
+        obj.colli = false
+    end
+    self.frames = 0
+    self.update_time = 0
+    self.render_time = 0
+end
+
+function M:onUpdate()
+    local ImGui = imgui.ImGui
+    if ImGui.Begin("Render List Benchmark") then
+        for _, v in ipairs(object_counts) do
+            if ImGui.Button(string.format("%d objects", v)) then
+                self.count = v
+                self:reset()
+            end
+        end
+        if ImGui.Button("Radix Sort") then
+            lstg.SetRenderListSort(true)
+            self:reset()
+        end
+        if ImGui.Button("Tree (std::set)") then
+            lstg.SetRenderListSort(false)
+            self:reset()
+        end
+        local n = math.max(self.frames, 1)
+        ImGui.Text(string.format("mode: %s, objects: %d", lstg.GetRenderListSort() and "radix sort" or "tree", lstg.GetnObj()))
+        ImGui.Text(string.format("new/del/layer: %.3fms", 1000.0 * self.update_time / n))
+        ImGui.Text(string.format("ObjRender: %.3fms", 1000.0 * self.render_time / n))
+    end
+    ImGui.End()
+
+    -- 模拟弹幕的对象生成、回收和图层变化
+    self.stopwatch:Reset()
+    local churn = math.floor(self.count * churn_rate)
+    for _, obj in lstg.ObjList(-1) do
+        local r = math.random()
+        if r < churn_rate then
+            lstg.Del(obj)
+        elseif r < churn_rate * 2 then
+            obj.layer = layers[math.random(#layers)]
+        end
+    end
+    lstg.AfterFrame()
+    for _ = 1, math.min(churn, self.count - lstg.GetnObj()) do
+        local obj = lstg.New(object_class)
+        obj.layer = layers[math.random(#layers)]
+        obj.bound = false
+        obj.colli = false
+    end
+    self.update_time = self.update_time + self.stopwatch:GetElapsed()
+end
+
+function M:onRender()
+    window:applyCameraV()
+    self.stopwatch:Reset()
+    lstg.ObjRender()
+    self.render_time = self.render_time + self.stopwatch:GetElapsed()
+    self.frames = self.frames + 1
+end
+
+test.registerTest("test.Module.RenderList", M)
@@ -0,0 +1,163 @@
+local test = require("test")
+local imgui = require("imgui")
+
+local sound_path = "test_sound_voice.wav"
+local sound_name = "test:voice:se"
+local max_voices = 8
+
+--------------------------------------------------------------------------------
+--- 生成 16 位单声道正弦波 wav 文件
+
+local function u16(v)
+    return string.char(v % 256, math.floor(v / 256) % 256)
+end
+
+local function u32(v)
+    return u16(v % 65536) .. u16(math.floor(v / 65536))
+end
+
+local function write_wav(path, seconds, frequency)
+    local rate = 48000
+    local count = math.floor(rate * seconds)
+    local samples = {}
+    for i = 0, count - 1 do
+        local fade = 1.0 - i / count
+        local v = math.floor(math.sin(2.0 * math.pi * frequency * i / rate) * fade * 12000)
+        samples[#samples + 1] = u16(v % 65536)
+    end
+    local data = table.concat(samples)
+    local f = assert(io.open(path, "wb"))
+    f:write(table.concat({
+        "RIFF", u32(36 + #data), "WAVE",
+        "fmt ", u32(16), u16(1), u16(1), u32(rate), u32(rate * 2), u16(2), u16(16),
+        "data", u32(#data), data,
+    }))
+    f:close()
+end
+
+--------------------------------------------------------------------------------
+
+---@class test.Module.SoundVoice : test.Base
+local M = {}
+
+function M:onCreate()
+    write_wav(sound_path, 0.5, 880)
+    local pool = lstg.GetResourceStatus()
+    lstg.SetResourceStatus("global")
+    lstg.LoadSound(sound_name, sound_path)
+    lstg.SetResourceStatus(pool)
+    lstg.SetSEVoice(sound_name, max_voices, "oldest", 1)
+    self.burst = 0
+    self.steps = nil
+    self.verify_result = "not run"
+end
+
+function M:onDestroy()
+    lstg.RemoveResource("global", 5, sound_name)
+    os.remove(sound_path)
+end
+
+--- 每一步在一帧内执行，检查放在下一帧，这时上一帧的播放请求已经提交
+function M:verify()
+    local ok = true
+    self.steps = {
+        function()
+            lstg.StopSound(sound_name)
+            lstg.SetSEVoice(sound_name, max_voices, "oldest", 1)
+        end,
+        function()
+            -- 同一帧播放 100 次，只开始一个声部
+            for _ = 1, 100 do
+                lstg.PlaySound(sound_name, 0.5)
+            end
+        end,
+        function()
+            local _, _, _, active = lstg.GetSEVoice(sound_name)
+            if active ~= 1 then
+                ok = false
+            end
+            -- 放宽每帧的限制后，一帧内能开始多个声部，但不超过上限
+            lstg.SetSEVoice(sound_name, max_voices, "quietest", 4)
+            for i = 1, 100 do
+                lstg.PlaySound(sound_name, i / 100)
+            end
+        end,
+        function()
+            local _, _, _, active = lstg.GetSEVoice(sound_name)
+            if active ~= 5 then
+                ok = false
+            end
+            for _ = 1, 3 do
+                for i = 1, 4 do
+                    lstg.PlaySound(sound_name, i / 4)
+                end
+            end
+        end,
+        function()
+            local _, _, _, active, count = lstg.GetSEVoice(sound_name)
+            if active ~= max_voices or count ~= max_voices then
+                ok = false
+            end
+            -- 减少声部数量时释放多余的声部
+            lstg.SetSEVoice(sound_name, 2)
+            local _, _, _, _, count2 = lstg.GetSEVoice(sound_name)
+            if count2 ~= 2 then
+                ok = false
+            end
+            lstg.StopSound(sound_name)
+        end,
+        function()
+            local _, _, _, active = lstg.GetSEVoice(sound_name)
+            if active ~= 0 then
+                ok = false
+            end
+            lstg.SetSEVoice(sound_name, max_voices, "oldest", 1)
+            self.verify_result = ok and "ok" or "FAILED"
+        end,
+    }
+end
+
+function M:onUpdate()
+    if self.steps then
+        local step = table.remove(self.steps, 1)
+        step()
+        if #self.steps == 0 then
+            self.steps = nil
+        end
+    end
+    if self.burst > 0 then
+        self.burst = self.burst - 1
+        lstg.PlaySound(sound_name, 0.5, (self.burst % 5 - 2) / 2)
+    end
+
+    local ImGui = imgui.ImGui
+    if ImGui.Begin("Sound Effect Voices") then
+        if ImGui.Button("Burst 30 (one per frame)") then
+            self.burst = 30
+        end
+        if ImGui.Button("100 plays in one frame") then
+            for _ = 1, 100 do
+                lstg.PlaySound(sound_name, 0.5)
+            end
+        end
+        if ImGui.Button("1 voice (legacy)") then
+            lstg.SetSEVoice(sound_name, 1)
+        end
+        if ImGui.Button(string.format("%d voices", max_voices)) then
+            lstg.SetSEVoice(sound_name, max_voices)
+        end
+        if ImGui.Button("Verify") then
+            self:verify()
+        end
+        local voices, policy, plays, active, count = lstg.GetSEVoice(sound_name)
+        ImGui.Text(string.format("max voices: %d, steal: %s, plays per frame: %d", voices, policy, plays))
+        ImGui.Text(string.format("active voices: %d / allocated: %d", active, count))
+        ImGui.Text(string.format("voice pool: %s", self.verify_result))
+    end
+    ImGui.End()
+end
+
+function M:onRender()
+end
+
+test.registerTest("test.Module.SoundVoice", M)
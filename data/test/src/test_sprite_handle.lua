@@ -0,0 +1,139 @@
+local test = require("test")
+local imgui = require("imgui")
+
+local sprite_count = 4
+local draw_count = 20000
+
+local function sprite_name(i)
+    return string.format("test:handle:img:%d", i)
+end
+
+local modes = { "handle", "name (cached)", "name (uncached)" }
+
+---@class test.Module.SpriteHandle : test.Base
+local M = {}
+
+function M:onCreate()
+    self.cache = lstg.GetResourceNameCache()
+    self.stopwatch = lstg.StopWatch()
+    self.timer = 0
+    self.mode = 1
+    self.time = {}
+    for _, m in ipairs(modes) do
+        self.time[m] = 0
+    end
+    self.verify = false
+    self.verify_result = "not run"
+
+    local resource_collection = lstg.ResourceManager.getResourceCollection("global")
+    self.texture = resource_collection:createTextureFromFile("test:handle:tex", "res/block.png")
+    self.names = {}
+    for i = 1, sprite_count do
+        local x = ((i - 1) % 2) * 128
+        local y = math.floor((i - 1) / 2) * 128
+        resource_collection:createSprite(sprite_name(i), self.texture, x, y, 128, 128)
+        self.names[i] = sprite_name(i)
+    end
+    self:resolveHandles()
+    resource_collection:createSpriteSequence("test:handle:ani", "test:handle:tex", 0, 0, 128, 128, 2, 2, 8)
+    self.ani = lstg.ResourceManager.findSpriteSequence("test:handle:ani")
+end
+
+function M:resolveHandles()
+    self.handles = {}
+    for i = 1, sprite_count do
+        self.handles[i] = lstg.ResourceManager.findSprite(sprite_name(i))
+    end
+end
+
+function M:onDestroy()
+    lstg.SetResourceNameCache(self.cache)
+    self.handles = nil
+    self.ani = nil
+    local resource_collection = lstg.ResourceManager.getResourceCollection("global")
+    for i = 1, sprite_count do
+        resource_collection:removeSprite(sprite_name(i))
+    end
+    resource_collection:removeSpriteSequence("test:handle:ani")
+    resource_collection:removeTexture(self.texture)
+end
+
+function M:onUpdate()
+    self.timer = self.timer + 1
+    local ImGui = imgui.ImGui
+    if ImGui.Begin("Sprite Handle Benchmark") then
+        for i, m in ipairs(modes) do
+            if ImGui.Button(m) then
+                self.mode = i
+            end
+        end
+        if ImGui.Button("Verify") then
+            self.verify = true
+        end
+        ImGui.Text(string.format("%d lstg.Render calls per frame", draw_count))
+        for _, m in ipairs(modes) do
+            ImGui.Text(string.format("%s: %.3fms", m, 1000.0 * self.time[m]))
+        end
+        ImGui.Text(string.format("cache invalidation: %s", self.verify_result))
+    end
+    ImGui.End()
+end
+
+--- 名字查找缓存在资源池变化后必须作废：移除后按名字渲染要报错，重新创建后要能找到新的精灵
+function M:runVerify()
+    local resource_collection = lstg.ResourceManager.getResourceCollection("global")
+    local name = sprite_name(1)
+    local ok = true
+    lstg.SetResourceNameCache(true)
+    lstg.Render(name, 0, 0) -- 放入缓存
+    resource_collection:removeSprite(name)
+    if pcall(lstg.Render, name, 0, 0) then
+        ok = false
+    end
+    -- 旧的句柄仍然持有精灵，可以继续使用
+    if not pcall(lstg.Render, self.handles[1], 0, 0) then
+        ok = false
+    end
+    resource_collection:createSprite(name, self.texture, 0, 0, 128, 128)
+    if not pcall(lstg.Render, name, 0, 0) then
+        ok = false
+    end
+    if lstg.ResourceManager.findSprite(name) == self.handles[1] then
+        ok = false -- 应该是新创建的精灵
+    end
+    self:resolveHandles()
+    lstg.SetResourceNameCache(self.cache)
+    self.verify_result = ok and "ok" or "FAILED"
+end
+
+function M:onRender()
+    window:applyCameraV()
+    if self.verify then
+        self.verify = false
+        self:runVerify()
+    end
+
+    local mode = modes[self.mode]
+    local w, h = window.width, window.height
+    local sw = self.stopwatch
+    lstg.SetResourceNameCache(mode ~= "name (uncached)")
+    sw:Reset()
+    if mode == "handle" then
+        local handles = self.handles
+        for i = 1, draw_count do
+            lstg.Render(handles[i % sprite_count + 1], (i * 37) % w, (i * 91) % h, i, 0.1)
+        end
+    else
+        local names = self.names
+        for i = 1, draw_count do
+            lstg.Render(names[i % sprite_count + 1], (i * 37) % w, (i * 91) % h, i, 0.1)
+        end
+    end
+    self.time[mode] = sw:GetElapsed()
+    lstg.SetResourceNameCache(self.cache)
+
+    lstg.RenderAnimation(self.ani, self.timer, w / 2, h / 2)
+    lstg.RenderAnimation("test:handle:ani", self.timer, w / 2 + 160, h / 2)
+end
+
+test.registerTest("test.Module.SpriteHandle", M)
@@ -0,0 +1,149 @@
+local test = require("test")
+local imgui = require("imgui")
+
+local sprite_count = 4
+local object_counts = { 1000, 10000, 30000 }
+local blends = { "", "mul+add", "add+alpha" }
+
+local function sprite_name(i)
+    return string.format("test:instancing:img:%d", i)
+end
+
+-- 全部使用默认回调，同一纹理的精灵对象连续渲染时合并为一次实例化绘制
+local sprite_class = {
+    function() end,
+    function() end,
+    function() end,
+    function() end,
+    function() end,
+    function() end;
+    is_class = true,
+    default_function = 126,
+}
+
+-- 使用对象自己的混合模式和顶点颜色
+local render_class = {
+    function() end,
+    function() end,
+    function() end,
+    function() end,
+    function() end,
+    function() end;
+    is_class = true,
+    [".render"] = true,
+    default_function = 126,
+}
+
+---@class test.Module.SpriteInstancing : test.Base
+local M = {}
+
+function M:onCreate()
+    math.randomseed(114514)
+    self.instancing = lstg.GetSpriteInstancing()
+    self.stopwatch = lstg.StopWatch()
+    self.count = object_counts[1]
+    self.mixed = false
+
+    local resource_collection = lstg.ResourceManager.getResourceCollection("global")
+    self.texture = resource_collection:createTextureFromFile("test:instancing:tex", "res/block.png")
+    for i = 1, sprite_count do
+        local x = ((i - 1) % 2) * 128
+        local y = math.floor((i - 1) / 2) * 128
+        resource_collection:createSprite(sprite_name(i), self.texture, x, y, 128, 128)
+    end
+    resource_collection:createSpriteSequence("test:instancing:ani", "test:instancing:tex", 0, 0, 128, 128, 2, 2, 8)
+
+    lstg.SetFrameProfile(true)
+    self:reset()
+end
+
+function M:onDestroy()
+    lstg.ResetPool()
+    lstg.SetSpriteInstancing(self.instancing)
+    lstg.SetFrameProfile(false)
+    local resource_collection = lstg.ResourceManager.getResourceCollection("global")
+    for i = 1, sprite_count do
+        resource_collection:removeSprite(sprite_name(i))
+    end
+    resource_collection:removeSpriteSequence("test:instancing:ani")
+    resource_collection:removeTexture(self.texture)
+end
+
+function M:reset()
+    lstg.ResetPool()
+    for i = 1, self.count do
+        local obj
+        if self.mixed and i % 3 == 0 then
+            obj = lstg.New(render_class)
+            obj._blend = blends[math.random(#blends)]
+            obj._r = math.random(128, 255)
+            obj._g = math.random(128, 255)
+            obj._b = math.random(128, 255)
+            obj._a = math.random(64, 255)
+        else
+            obj = lstg.New(sprite_class)
+        end
+        if i % 5 == 0 then
+            obj.img = "test:instancing:ani"
+        else
+            obj.img = sprite_name(math.random(sprite_count))
+        end
+        obj.x = math.random(0, window.width)
+        obj.y = math.random(0, window.height)
+        obj.rot = math.random() * 360
+        obj.omiga = math.random() * 4 - 2
+        obj.hscale = 0.05 + math.random() * 0.15
+        obj.vscale = obj.hscale
+        obj.layer = math.random(0, 3)
+        obj.bound = false
+        obj.colli = false
+    end
+    self.frames = 0
+    self.render_time = 0
+end
+
+function M:onUpdate()
+    local ImGui = imgui.ImGui
+    if ImGui.Begin("Sprite Instancing") then
+        for _, v in ipairs(object_counts) do
+            if ImGui.Button(string.format("%d objects", v)) then
+                self.count = v
+                self:reset()
+            end
+        end
+        if ImGui.Button("Instancing On") then
+            lstg.SetSpriteInstancing(true)
+            self:reset()
+        end
+        if ImGui.Button("Instancing Off") then
+            lstg.SetSpriteInstancing(false)
+            self:reset()
+        end
+        if ImGui.Button(self.mixed and "Sprites Only" or "Mix Render Class") then
+            self.mixed = not self.mixed
+            self:reset()
+        end
+        local n = math.max(self.frames, 1)
+        ImGui.Text(string.format("instancing: %s, objects: %d", tostring(lstg.GetSpriteInstancing()), lstg.GetnObj()))
+        ImGui.Text(string.format("ObjRender: %.3fms", 1000.0 * self.render_time / n))
+        local profile = lstg.GetFrameProfile()
+        if profile then
+            ImGui.Text(string.format("batch flush: %d", profile.counters["Renderer.BatchFlush"] or 0))
+            ImGui.Text(string.format("sprite instances: %d", profile.counters["Renderer.SpriteInstances"] or 0))
+        end
+    end
+    ImGui.End()
+
+    lstg.ObjFrame()
+    lstg.AfterFrame()
+end
+
+function M:onRender()
+    window:applyCameraV()
+    self.stopwatch:Reset()
+    lstg.ObjRender()
+    self.render_time = self.render_time + self.stopwatch:GetElapsed()
+    self.frames = self.frames + 1
+end
+
+test.registerTest("test.Module.SpriteInstancing", M)
@@ -0,0 +1,115 @@
+local test = require("test")
+local imgui = require("imgui")
+
+local spawn_per_frame = 2000
+local life = 15
+
+-- init 中添加十几个字段，接近弹幕脚本中常见的对象
+local bullet_class = {
+    function(self, x, y, a, v)
+        self.x, self.y = x, y
+        self.vx, self.vy = v * lstg.cos(a), v * lstg.sin(a)
+        self.angle = a
+        self.speed = v
+        self.style = 1
+        self.color = 2
+        self.fogtime = 10
+        self.stay = false
+        self.index = 0
+        self.destroyable = true
+        self.grazed = false
+        self.pattern = "ring"
+        self.owner = false
+        self.tag = 0
+    end,
+    function() end,
+    function(self)
+        if self.timer >= life then
+            lstg.Del(self)
+        end
+    end,
+    function() end,
+    function() end,
+    function() end;
+    is_class = true,
+    -- 只有 init、frame 回调使用脚本
+    default_function = 116,
+}
+
+---@class test.Module.TableRecycle : test.Base
+local M = {}
+
+function M:onCreate()
+    self.recycle = lstg.GetTableRecycle()
+    self.stopwatch = lstg.StopWatch()
+    lstg.SetBound(-1e9, 1e9, -1e9, 1e9)
+    self:reset(true)
+end
+
+function M:onDestroy()
+    lstg.SetTableRecycle(self.recycle)
+    lstg.SetBound(-100, 100, -100, 100)
+    lstg.ResetPool()
+end
+
+---@param recycle boolean
+function M:reset(recycle)
+    lstg.ResetPool()
+    lstg.SetTableRecycle(recycle)
+    collectgarbage()
+    self.frame = 0
+    self.frames = 0
+    self.sum = 0
+    self.sum2 = 0
+    self.max = 0
+end
+
+function M:step()
+    self.frame = self.frame + 1
+    local a0 = self.frame * 7
+    for i = 1, spawn_per_frame do
+        lstg.New(bullet_class, 0, 0, a0 + i * 360 / spawn_per_frame, 2 + (i % 4))
+    end
+    lstg.ObjFrame()
+    lstg.BoundCheck()
+    lstg.UpdateXY()
+    lstg.AfterFrame()
+end
+
+function M:onUpdate()
+    local ImGui = imgui.ImGui
+    if ImGui.Begin("Object Table Recycle Benchmark") then
+        if ImGui.Button("Recycle") then
+            self:reset(true)
+        end
+        if ImGui.Button("No Recycle") then
+            self:reset(false)
+        end
+        local enabled, parked = lstg.GetTableRecycle()
+        local n = math.max(self.frames, 1)
+        local mean = self.sum / n
+        local variance = math.max(self.sum2 / n - mean * mean, 0)
+        ImGui.Text(string.format("recycle: %s, parked tables: %d, objects: %d", tostring(enabled), parked, lstg.GetnObj()))
+        ImGui.Text(string.format("spawn %d/frame, life %d frames", spawn_per_frame, life))
+        ImGui.Text(string.format("frame: mean %.3fms, stddev %.3fms, max %.3fms", 1000.0 * mean, 1000.0 * math.sqrt(variance), 1000.0 * self.max))
+        ImGui.Text(string.format("lua memory: %.1fKB", collectgarbage("count")))
+    end
+    ImGui.End()
+
+    local sw = self.stopwatch
+    sw:Reset()
+    self:step()
+    local t = sw:GetElapsed()
+    -- 对象池需要几帧才能进入稳定状态，之后再计时
+    if self.frame > life * 2 then
+        self.frames = self.frames + 1
+        self.sum = self.sum + t
+        self.sum2 = self.sum2 + t * t
+        self.max = math.max(self.max, t)
+    end
+end
+
+function M:onRender()
+end
+
+test.registerTest("test.Module.TableRecycle", M)
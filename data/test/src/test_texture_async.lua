@@ -0,0 +1,150 @@
+local test = require("test")
+local imgui = require("imgui")
+
+local files = {
+    "block.png",
+    "block.qoi",
+    "sRGB.png",
+    "linear.png",
+    "cave.png",
+    "image_1.png",
+    "particles.png",
+    "mask_1.png",
+}
+local copies = 4
+
+local function texture_name(prefix, i, f)
+    return string.format("%s:%d:%s", prefix, i, f)
+end
+
+local function remove_textures(prefix)
+    for i = 1, copies do
+        for _, f in ipairs(files) do
+            local name = texture_name(prefix, i, f)
+            if lstg.CheckRes(1, name) or lstg.GetTextureLoadState(name) ~= "none" then
+                lstg.RemoveResource("global", 1, name)
+            end
+        end
+    end
+end
+
+---@class test.Module.TextureAsync : test.Base
+local M = {}
+
+function M:onCreate()
+    self.old_pool = lstg.GetResourceStatus()
+    self.budget = lstg.GetTextureUploadBudget()
+    lstg.SetResourceStatus("global")
+    self.stopwatch = lstg.StopWatch()
+    self.loading = false
+    self.load_frames = 0
+    self.load_time = 0
+    self.max_frame_time = 0
+    self.sync_time = 0
+    self.verify_result = "not run"
+end
+
+function M:onDestroy()
+    remove_textures("async")
+    remove_textures("sync")
+    lstg.RemoveResource("global", 1, "async:missing")
+    lstg.SetTextureUploadBudget(self.budget)
+    lstg.SetResourceStatus(self.old_pool)
+end
+
+function M:loadSync()
+    remove_textures("sync")
+    local sw = self.stopwatch
+    sw:Reset()
+    for i = 1, copies do
+        for _, f in ipairs(files) do
+            lstg.LoadTexture(texture_name("sync", i, f), "res/" .. f, false)
+        end
+    end
+    self.sync_time = sw:GetElapsed()
+end
+
+function M:loadAsync()
+    remove_textures("async")
+    local list = {}
+    for i = 1, copies do
+        for _, f in ipairs(files) do
+            list[#list + 1] = { texture_name("async", i, f), "res/" .. f, false }
+        end
+    end
+    -- 不存在的文件，最终状态应该是 failed
+    list[#list + 1] = { "async:missing", "res/not_exist.png", false }
+    lstg.LoadTextureAsync(list)
+    self.loading = true
+    self.load_frames = 0
+    self.load_time = 0
+    self.max_frame_time = 0
+    self.stopwatch:Reset()
+end
+
+function M:verify()
+    self:loadSync()
+    local same = true
+    for i = 1, copies do
+        for _, f in ipairs(files) do
+            local a = texture_name("async", i, f)
+            local b = texture_name("sync", i, f)
+            if lstg.GetTextureLoadState(a) ~= "loaded" then
+                same = false
+            else
+                local w1, h1 = lstg.GetTextureSize(a)
+                local w2, h2 = lstg.GetTextureSize(b)
+                if w1 ~= w2 or h1 ~= h2 then
+                    same = false
+                end
+            end
+        end
+    end
+    if lstg.GetTextureLoadState("async:missing") ~= "failed" then
+        same = false
+    end
+    self.verify_result = same and "identical" or "MISMATCH"
+end
+
+function M:onUpdate()
+    if self.loading then
+        local t = self.stopwatch:GetElapsed()
+        self.stopwatch:Reset()
+        self.load_frames = self.load_frames + 1
+        self.load_time = self.load_time + t
+        self.max_frame_time = math.max(self.max_frame_time, t)
+        if lstg.GetTextureLoadCount() == 0 then
+            self.loading = false
+        end
+    end
+
+    local ImGui = imgui.ImGui
+    if ImGui.Begin("Async Texture Loading") then
+        if ImGui.Button("Load Async") then
+            self:loadAsync()
+        end
+        if ImGui.Button("Load Sync") then
+            self:loadSync()
+        end
+        if ImGui.Button("Budget 1MB") then
+            lstg.SetTextureUploadBudget(1024 * 1024)
+        end
+        if ImGui.Button("Budget 64MB") then
+            lstg.SetTextureUploadBudget(64 * 1024 * 1024)
+        end
+        if ImGui.Button("Verify") then
+            self:verify()
+        end
+        ImGui.Text(string.format("upload budget: %d bytes, pending: %d", lstg.GetTextureUploadBudget(), lstg.GetTextureLoadCount()))
+        ImGui.Text(string.format("async: %d frames, %.3fms, max frame %.3fms", self.load_frames, 1000.0 * self.load_time, 1000.0 * self.max_frame_time))
+        ImGui.Text(string.format("sync: %.3fms (single frame)", 1000.0 * self.sync_time))
+        ImGui.Text(string.format("missing file: %s", lstg.GetTextureLoadState("async:missing")))
+        ImGui.Text(string.format("async vs sync (%d textures): %s", copies * #files, self.verify_result))
+    end
+    ImGui.End()
+end
+
+function M:onRender()
+end
+
+test.registerTest("test.Module.TextureAsync", M)
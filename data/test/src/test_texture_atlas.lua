@@ -0,0 +1,119 @@
+local test = require("test")
+local imgui = require("imgui")
+
+local files = {
+    { "block.png", 256, 256 },
+    { "block.qoi", 256, 256 },
+    { "image_1.png", 256, 256 },
+    { "mask_1.png", 256, 256 },
+    { "hgefont.png", 256, 256 },
+    { "white.png", 16, 16 },
+}
+local copies = 8
+local sprite_count = 4000
+
+local function texture_name(i, k)
+    return string.format("test:atlas:tex:%d:%d", i, k)
+end
+
+local function sprite_name(i, k)
+    return string.format("test:atlas:img:%d:%d", i, k)
+end
+
+---@class test.Module.TextureAtlas : test.Base
+local M = {}
+
+function M:onCreate()
+    self.old_pool = lstg.GetResourceStatus()
+    lstg.SetResourceStatus("global")
+    self.atlas = lstg.GetTextureAtlas()
+    self.verify_result = "not run"
+    math.randomseed(114514)
+    self.points = {}
+    for i = 1, sprite_count do
+        self.points[i] = { math.random(0, window.width), math.random(0, window.height), math.random() * 360 }
+    end
+    self:load(true)
+    lstg.SetFrameProfile(true)
+end
+
+function M:onDestroy()
+    lstg.SetFrameProfile(false)
+    self:unload()
+    lstg.SetTextureAtlas(self.atlas)
+    lstg.SetResourceStatus(self.old_pool)
+end
+
+function M:unload()
+    for k = 1, copies do
+        for i = 1, #files do
+            lstg.RemoveResource("global", 2, sprite_name(i, k))
+            lstg.RemoveResource("global", 1, texture_name(i, k))
+        end
+    end
+end
+
+---@param atlas boolean
+function M:load(atlas)
+    if self.loaded ~= nil then
+        self:unload()
+    end
+    lstg.SetTextureAtlas(atlas)
+    -- 每个文件加载多份，相当于很多张小纹理
+    for k = 1, copies do
+        for i, f in ipairs(files) do
+            lstg.LoadTexture(texture_name(i, k), "res/" .. f[1], false)
+            lstg.LoadImage(sprite_name(i, k), texture_name(i, k), 0, 0, f[2], f[3])
+        end
+    end
+    lstg.SetTextureAtlas(self.atlas)
+    self.loaded = atlas
+end
+
+function M:verify()
+    local same = true
+    for k = 1, copies do
+        for i, f in ipairs(files) do
+            local w, h = lstg.GetTextureSize(texture_name(i, k))
+            if w ~= f[2] or h ~= f[3] or lstg.IsAtlasTexture(texture_name(i, k)) ~= self.loaded then
+                same = false
+            end
+        end
+    end
+    self.verify_result = same and "ok" or "MISMATCH"
+end
+
+function M:onUpdate()
+    local ImGui = imgui.ImGui
+    if ImGui.Begin("Texture Atlas") then
+        if ImGui.Button("Load With Atlas") then
+            self:load(true)
+        end
+        if ImGui.Button("Load Without Atlas") then
+            self:load(false)
+        end
+        if ImGui.Button("Verify") then
+            self:verify()
+        end
+        ImGui.Text(string.format("atlas: %s, textures: %d, sprites: %d", tostring(self.loaded), copies * #files, sprite_count))
+        ImGui.Text(string.format("texture size and atlas flag: %s", self.verify_result))
+        local profile = lstg.GetFrameProfile()
+        if profile then
+            ImGui.Text(string.format("draw calls: %d", profile.counters["Renderer.DrawCalls"] or 0))
+            ImGui.Text(string.format("batch flush: %d", profile.counters["Renderer.BatchFlush"] or 0))
+        end
+    end
+    ImGui.End()
+end
+
+function M:onRender()
+    window:applyCameraV()
+    local n = #files
+    for j, p in ipairs(self.points) do
+        local i = (j % n) + 1
+        local k = (math.floor(j / n) % copies) + 1
+        lstg.Render(sprite_name(i, k), p[1], p[2], p[3], 0.125)
+    end
+end
+
+test.registerTest("test.Module.TextureAtlas", M)
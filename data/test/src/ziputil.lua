@@ -0,0 +1,95 @@
+--- 测试用的 zip 文件生成，条目可以不压缩（stored）或者使用 deflate 的不压缩块
+---@class test.ziputil
+local M = {}
+
+local bit = require("bit")
+
+local crc_table = {}
+for i = 0, 255 do
+    local c = i
+    for _ = 1, 8 do
+        if bit.band(c, 1) ~= 0 then
+            c = bit.bxor(bit.rshift(c, 1), 0xEDB88320)
+        else
+            c = bit.rshift(c, 1)
+        end
+    end
+    crc_table[i] = c
+end
+
+---@param s string
+function M.crc32(s)
+    local c = 0xFFFFFFFF
+    for i = 1, #s do
+        c = bit.bxor(crc_table[bit.band(bit.bxor(c, s:byte(i)), 0xFF)], bit.rshift(c, 8))
+    end
+    return bit.bnot(c)
+end
+
+---@param v integer
+function M.u16(v)
+    return string.char(bit.band(v, 0xFF), bit.band(bit.rshift(v, 8), 0xFF))
+end
+
+---@param v integer
+function M.u32(v)
+    return string.char(bit.band(v, 0xFF), bit.band(bit.rshift(v, 8), 0xFF), bit.band(bit.rshift(v, 16), 0xFF), bit.band(bit.rshift(v, 24), 0xFF))
+end
+
+local u16 = M.u16
+local u32 = M.u32
+
+--- deflate 的不压缩块（BTYPE = 00），每块最多 65535 字节，解压时每个块结束都是块边界
+---@param content string
+function M.deflate_stored(content)
+    local blocks = {}
+    local n = #content
+    local i = 1
+    repeat
+        local len = math.min(65535, n - i + 1)
+        local final = (i + len > n) and 1 or 0
+        blocks[#blocks + 1] = string.char(final) .. u16(len) .. u16(bit.band(bit.bnot(len), 0xFFFF)) .. content:sub(i, i + len - 1)
+        i = i + len
+    until i > n
+    return table.concat(blocks)
+end
+
+--- 条目为 { 文件名, 内容, 是否使用 deflate }
+---@param path string
+---@param entries { [1]:string, [2]:string, [3]:boolean? }[]
+function M.write_zip(path, entries)
+    local data = {}
+    local directory = {}
+    local offset = 0
+    for _, e in ipairs(entries) do
+        local name, content, deflate = e[1], e[2], e[3]
+        local crc = M.crc32(content)
+        local stored = deflate and M.deflate_stored(content) or content
+        local method = deflate and 8 or 0
+        local header = table.concat({
+            u32(0x04034b50), u16(20), u16(0), u16(method), u16(0), u16(0x21),
+            u32(crc), u32(#stored), u32(#content), u16(#name), u16(0),
+            name,
+        })
+        data[#data + 1] = header
+        data[#data + 1] = stored
+        directory[#directory + 1] = table.concat({
+            u32(0x02014b50), u16(20), u16(20), u16(0), u16(method), u16(0), u16(0x21),
+            u32(crc), u32(#stored), u32(#content), u16(#name), u16(0), u16(0),
+            u16(0), u16(0), u32(0), u32(offset),
+            name,
+        })
+        offset = offset + #header + #stored
+    end
+    local cd = table.concat(directory)
+    data[#data + 1] = cd
+    data[#data + 1] = table.concat({
+        u32(0x06054b50), u16(0), u16(0), u16(#entries), u16(#entries),
+        u32(#cd), u32(offset), u16(0),
+    })
+    local f = assert(io.open(path, "wb"))
+    f:write(table.concat(data))
+    f:close()
+end
+
+return M